@@ -4,6 +4,13 @@
 #include <random>
 #include <chrono>
 #include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <string>
+#include <memory>
 
 using namespace std;
 
@@ -92,24 +99,256 @@ vector<int> kahns(const vector<vector<int>>& graph) {
     return topological_order;
 }
 
-int main() {
+// Граф в формате CSR: соседи вершины v лежат в targets[offsets[v] .. offsets[v + 1])
+struct csr_graph {
+    vector<int> offsets;
+    vector<int> targets;
+};
+
+csr_graph to_csr(const vector<vector<int>>& graph) {
+    int total_nodes = graph.size();
+    csr_graph csr;
+    csr.offsets.resize(total_nodes + 1, 0);
+    for (int node = 0; node < total_nodes; ++node) {
+        csr.offsets[node + 1] = csr.offsets[node] + graph[node].size();
+    }
+    csr.targets.reserve(csr.offsets[total_nodes]);
+    for (const auto& neighbors : graph) {
+        for (int target_node : neighbors) {
+            if (target_node < 0 || target_node >= total_nodes) {
+                throw out_of_range("Некорректная вершина в списке смежности.");
+            }
+            csr.targets.push_back(target_node);
+        }
+    }
+    return csr;
+}
+
+// Поиск цикла итеративным DFS с раскраской (0 - не посещена, 1 - в стеке, 2 - обработана).
+// Возвращает вершины цикла по порядку или пустой вектор, если цикла нет.
+vector<int> find_cycle(const csr_graph& csr) {
+    int total_nodes = csr.offsets.size() - 1;
+    vector<char> color(total_nodes, 0);
+    vector<int> parent(total_nodes, -1);
+    vector<pair<int, int>> call_stack; // (вершина, позиция следующего ребра)
+
+    for (int start_node = 0; start_node < total_nodes; ++start_node) {
+        if (color[start_node] != 0) continue;
+
+        color[start_node] = 1;
+        call_stack.push_back({start_node, csr.offsets[start_node]});
+        while (!call_stack.empty()) {
+            int current_node = call_stack.back().first;
+            int& edge_position = call_stack.back().second;
+
+            if (edge_position == csr.offsets[current_node + 1]) {
+                color[current_node] = 2;
+                call_stack.pop_back();
+                continue;
+            }
+
+            int neighbor = csr.targets[edge_position++];
+            if (color[neighbor] == 0) {
+                color[neighbor] = 1;
+                parent[neighbor] = current_node;
+                call_stack.push_back({neighbor, csr.offsets[neighbor]});
+            } else if (color[neighbor] == 1) {
+                // Обратное ребро current_node -> neighbor замыкает цикл
+                vector<int> cycle;
+                for (int node = current_node; node != neighbor; node = parent[node]) {
+                    cycle.push_back(node);
+                }
+                cycle.push_back(neighbor);
+                reverse(cycle.begin(), cycle.end());
+                return cycle;
+            }
+        }
+    }
+    return {};
+}
+
+// Барьер для потоков, обрабатывающих один уровень
+class level_barrier {
+public:
+    explicit level_barrier(int num_threads) : total_threads(num_threads) {}
+
+    void wait() {
+        unique_lock<mutex> lock(barrier_mutex);
+        int current_generation = generation;
+        if (++waiting_threads == total_threads) {
+            waiting_threads = 0;
+            ++generation;
+            barrier_condition.notify_all();
+        } else {
+            barrier_condition.wait(lock, [&] { return generation != current_generation; });
+        }
+    }
+
+private:
+    mutex barrier_mutex;
+    condition_variable barrier_condition;
+    int total_threads;
+    int waiting_threads = 0;
+    int generation = 0;
+};
+
+// Поуровневый параллельный алгоритм Кана.
+// Уровень k - вершины, все предшественники которых лежат на уровнях < k;
+// вершины одного уровня независимы и могут выполняться параллельно.
+// Счётчики входящих степеней атомарные, каждый поток собирает следующий
+// фронт в собственный буфер, буферы сливаются между уровнями.
+vector<vector<int>> kahns_levels_parallel(const vector<vector<int>>& graph, int num_threads) {
+    if (graph.empty()) {
+        throw invalid_argument("Граф пуст.");
+    }
+    if (num_threads <= 0) {
+        throw invalid_argument("Число потоков должно быть положительным.");
+    }
+
+    csr_graph csr = to_csr(graph);
+    int total_nodes = graph.size();
+    const int chunk_size = 1024;
+
+    unique_ptr<atomic<int>[]> in_degree_count(new atomic<int>[total_nodes]);
+    for (int node = 0; node < total_nodes; ++node) {
+        in_degree_count[node].store(0, memory_order_relaxed);
+    }
+    for (int target_node : csr.targets) {
+        in_degree_count[target_node].fetch_add(1, memory_order_relaxed);
+    }
+
+    vector<vector<int>> levels;
+    vector<int> frontier;
+    for (int node = 0; node < total_nodes; ++node) {
+        if (in_degree_count[node].load(memory_order_relaxed) == 0) {
+            frontier.push_back(node);
+        }
+    }
+
+    vector<vector<int>> thread_buffers(num_threads);
+    atomic<size_t> next_chunk(0);
+    level_barrier barrier(num_threads);
+    size_t processed_nodes = 0;
+
+    auto worker = [&](int thread_index) {
+        vector<int>& buffer = thread_buffers[thread_index];
+        while (true) {
+            barrier.wait(); // фронт готов (или пуст - тогда работа закончена)
+            if (frontier.empty()) break;
+
+            for (size_t begin = next_chunk.fetch_add(chunk_size); begin < frontier.size();
+                 begin = next_chunk.fetch_add(chunk_size)) {
+                size_t end = min(frontier.size(), begin + chunk_size);
+                for (size_t index = begin; index < end; ++index) {
+                    int current_node = frontier[index];
+                    for (int position = csr.offsets[current_node]; position < csr.offsets[current_node + 1]; ++position) {
+                        int neighbor = csr.targets[position];
+                        if (in_degree_count[neighbor].fetch_sub(1, memory_order_acq_rel) == 1) {
+                            buffer.push_back(neighbor);
+                        }
+                    }
+                }
+            }
+
+            barrier.wait(); // все буферы уровня заполнены
+            if (thread_index == 0) {
+                processed_nodes += frontier.size();
+                levels.push_back(move(frontier));
+                frontier.clear();
+                for (auto& thread_buffer : thread_buffers) {
+                    frontier.insert(frontier.end(), thread_buffer.begin(), thread_buffer.end());
+                    thread_buffer.clear();
+                }
+                next_chunk.store(0);
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (int thread_index = 1; thread_index < num_threads; ++thread_index) {
+        threads.emplace_back(worker, thread_index);
+    }
+    worker(0);
+    for (auto& thread_item : threads) {
+        thread_item.join();
+    }
+
+    if (processed_nodes != (size_t)total_nodes) {
+        vector<int> cycle = find_cycle(csr);
+        string message = "Граф содержит цикл:";
+        for (int node : cycle) {
+            message += " " + to_string(node);
+        }
+        throw runtime_error(message);
+    }
+
+    return levels;
+}
+
+// Проверка уровней: каждое ребро ведёт на более поздний уровень, все вершины учтены
+bool check_levels(const vector<vector<int>>& graph, const vector<vector<int>>& levels) {
+    vector<int> level_of_node(graph.size(), -1);
+    for (size_t level = 0; level < levels.size(); ++level) {
+        for (int node : levels[level]) {
+            if (level_of_node[node] != -1) return false;
+            level_of_node[node] = level;
+        }
+    }
+    for (size_t node = 0; node < graph.size(); ++node) {
+        if (level_of_node[node] == -1) return false;
+        for (int neighbor : graph[node]) {
+            if (level_of_node[neighbor] <= level_of_node[node]) return false;
+        }
+    }
+    return true;
+}
+
+template <typename Function>
+double average_time(int runs, Function function) {
+    double total_time = 0;
+    for (int run_index = 0; run_index < runs; ++run_index) {
+        auto start_time = chrono::high_resolution_clock::now();
+        function();
+        auto end_time = chrono::high_resolution_clock::now();
+        total_time += chrono::duration<double>(end_time - start_time).count();
+    }
+    return total_time / runs;
+}
+
+int main(int argc, char** argv) {
     try {
-        int num_nodes = 100000;
+        int max_nodes = argc > 1 ? stoi(argv[1]) : 10000000;
         int max_edges_per_node = 5;
+        int runs = 3;
+        int max_threads = max(1u, thread::hardware_concurrency());
 
-        vector<vector<int>> graph = generate_dag(num_nodes, max_edges_per_node);
+        // Масштабирование: размер графа и число потоков
+        for (int num_nodes = 100000; num_nodes <= max_nodes; num_nodes *= 10) {
+            vector<vector<int>> graph = generate_dag(num_nodes, max_edges_per_node);
 
-        int runs = 10;
-        double total_time = 0;
+            double serial_time = average_time(runs, [&] { kahns(graph); });
+            cout << "Вершин: " << num_nodes << "\n";
+            cout << "  Последовательный алгоритм Кана: " << serial_time << " сек\n";
 
-        for (int run_index = 0; run_index < runs; ++run_index) {
-            auto start_time = chrono::high_resolution_clock::now();
-            auto order = kahns(graph);
-            auto end_time = chrono::high_resolution_clock::now();
-            total_time += chrono::duration<double>(end_time - start_time).count();
+            for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+                vector<vector<int>> levels;
+                double parallel_time = average_time(runs, [&] { levels = kahns_levels_parallel(graph, num_threads); });
+                if (!check_levels(graph, levels)) {
+                    throw runtime_error("Некорректное разбиение на уровни.");
+                }
+                cout << "  Параллельный, потоков " << num_threads << ": " << parallel_time
+                     << " сек, уровней " << levels.size()
+                     << ", ускорение " << serial_time / parallel_time << "\n";
+            }
         }
 
-        cout << "Среднее время алгоритма Кана: " << (total_time / runs) << " сек\n";
+        // Граф с циклом: 0 -> 1 -> 2 -> 0
+        vector<vector<int>> cyclic_graph = {{1}, {2}, {0, 3}, {}};
+        try {
+            kahns_levels_parallel(cyclic_graph, 2);
+        } catch (const runtime_error& e) {
+            cout << e.what() << "\n";
+        }
     } catch (const exception& e) {
         cerr << "Ошибка: " << e.what() << endl;
         return 1;
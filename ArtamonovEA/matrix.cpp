@@ -2,6 +2,7 @@
 #include <iostream>
 #include <math.h>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <stdio.h>
 #include <string>
@@ -14,21 +15,29 @@
 
 
 class Matrix {
+    public:
+        // Storage draws memory from a pluggable resource (see MatrixPool)
+        using Storage = std::pmr::vector<double>;
+
     protected:
         size_t rows;
         size_t cols;
-        std::vector<double> data;
+        Storage data;
 
     public:
         // Constructors
-        Matrix() : rows(0), cols(0) {}
-        Matrix(size_t rows, size_t cols): rows(rows), cols(cols), data(rows * cols, 0.0) {}
-        Matrix(const Matrix &M) : rows(M.rows), cols(M.cols), data(M.data) {}
+        Matrix() : rows(0), cols(0), data(memory_resource()) {}
+        Matrix(size_t rows, size_t cols): rows(rows), cols(cols), data(rows * cols, 0.0, memory_resource()) {}
+        Matrix(const Matrix &M) : rows(M.rows), cols(M.cols), data(M.data, memory_resource()) {}
         Matrix(Matrix &&M) noexcept : rows(M.rows), cols(M.cols), data(std::move(M.data)) {}
 
         // Destructor
         ~Matrix() = default;
 
+        // Memory resource used by matrices created from now on
+        static std::pmr::memory_resource* memory_resource() noexcept { return current_resource(); }
+        static void set_memory_resource(std::pmr::memory_resource *resource) noexcept;
+
         double& operator()(const size_t row_num,const size_t col_num);
         const double& operator()(const size_t row_num, const size_t col_num) const;
 
@@ -36,20 +45,28 @@ class Matrix {
         size_t get_rows() const noexcept { return rows; }
         size_t get_cols() const noexcept { return rows; }
 
-        // Arithmetic operations with other matrices
-        Matrix operator+(const Matrix &Other);
-        Matrix operator-(const Matrix &Other);
-        Matrix operator*(const Matrix &Other);
+        // Arithmetic operations with other matrices.
+        // Rvalue versions reuse storage of the temporary instead of allocating
+        Matrix operator+(const Matrix &Other) const &;
+        Matrix operator+(const Matrix &Other) &&;
+        Matrix operator-(const Matrix &Other) const &;
+        Matrix operator-(const Matrix &Other) &&;
+        Matrix operator*(const Matrix &Other) const;
         Matrix operator/(const Matrix &Other)  { throw UndefinedOperationException(); };
 
         // Arithmetic operations with scalars
-        Matrix operator+(const double &Scalar);
-        Matrix operator-(const double &Scalar);
-        Matrix operator*(const double &Scalar);
-        Matrix operator/(const double &Scalar);
+        Matrix operator+(const double &Scalar) const &;
+        Matrix operator+(const double &Scalar) &&;
+        Matrix operator-(const double &Scalar) const &;
+        Matrix operator-(const double &Scalar) &&;
+        Matrix operator*(const double &Scalar) const &;
+        Matrix operator*(const double &Scalar) &&;
+        Matrix operator/(const double &Scalar) const &;
+        Matrix operator/(const double &Scalar) &&;
         
         // Assignment operations with other matrices
         Matrix& operator=(const Matrix &Other);
+        Matrix& operator=(Matrix &&Other) noexcept;
         Matrix& operator+=(const Matrix &Other);
         Matrix& operator-=(const Matrix &Other);
         Matrix& operator*=(const Matrix &Other);
@@ -73,9 +90,70 @@ class Matrix {
         // Friend classes
         friend class SquareMatrix;
         friend class ZeroMatrix;
+
+    private:
+        static std::pmr::memory_resource*& current_resource() noexcept;
+
+        // C = A * B on raw buffers, C must not overlap A or B
+        static void multiply(double *C, const double *A, const double *B,
+                             size_t rows, size_t inner, size_t cols) noexcept;
+};
+
+
+// ------------------ Matrix Pool ----------------- //
+
+
+// Pool of matrix buffers. While an object of this class is alive, all new
+// matrices take their storage from it, so freed buffers are reused instead of
+// going back to the heap. Matrices created inside the scope must be destroyed
+// before the pool. Not thread safe, like the matrices themselves.
+class MatrixPool {
+    private:
+        std::pmr::unsynchronized_pool_resource pool;
+        std::pmr::memory_resource *previous;
+
+    public:
+        explicit MatrixPool(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+            : pool(std::pmr::pool_options{0, 1 << 20}, upstream), previous(Matrix::memory_resource())
+        {
+            Matrix::set_memory_resource(&pool);
+        }
+
+        ~MatrixPool() { Matrix::set_memory_resource(previous); }
+
+        MatrixPool(const MatrixPool&) = delete;
+        MatrixPool& operator=(const MatrixPool&) = delete;
 };
 
 
+std::pmr::memory_resource*& Matrix::current_resource() noexcept
+{
+    static std::pmr::memory_resource *resource = std::pmr::new_delete_resource();
+    return resource;
+}
+
+
+void Matrix::set_memory_resource(std::pmr::memory_resource *resource) noexcept
+{
+    current_resource() = resource ? resource : std::pmr::new_delete_resource();
+}
+
+
+void Matrix::multiply(double *C, const double *A, const double *B,
+                      size_t rows, size_t inner, size_t cols) noexcept
+{
+    std::fill(C, C + rows * cols, 0.0);
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t idx = 0; idx < inner; ++idx) {
+            const double a = A[row * inner + idx];
+            for (size_t col = 0; col < cols; ++col) {
+                C[row * cols + col] += a * B[idx * cols + col];
+            }
+        }
+    }
+}
+
+
 double& Matrix::operator()(const size_t row_num, const size_t col_num) {
     if (row_num >= rows || col_num >= cols) {
         throw SizeMismatchException();
@@ -94,38 +172,37 @@ const double& Matrix::operator()(const size_t row_num, const size_t col_num) con
 }
 
 
-Matrix Matrix::operator+(const Matrix &Other) {
-    if (!equal_size(Other)) {
-        throw SizeMismatchException();
-    }
-
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] + Other.data[idx];
-    }
-
+Matrix Matrix::operator+(const Matrix &Other) const &
+{
+    Matrix result(*this);
+    result += Other;
     return result;
 }
 
 
-Matrix Matrix::operator-(const Matrix &Other) 
+Matrix Matrix::operator+(const Matrix &Other) &&
 {
-    if (!equal_size(Other)) {
-        throw SizeMismatchException();
-    }
+    *this += Other;
+    return std::move(*this);
+}
 
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] - Other.data[idx];
-    }
 
+Matrix Matrix::operator-(const Matrix &Other) const &
+{
+    Matrix result(*this);
+    result -= Other;
     return result;
 }
 
 
-Matrix Matrix::operator*(const Matrix &Other) 
+Matrix Matrix::operator-(const Matrix &Other) &&
+{
+    *this -= Other;
+    return std::move(*this);
+}
+
+
+Matrix Matrix::operator*(const Matrix &Other) const
 {
     if (cols != Other.rows) {
         throw SizeMismatchException(
@@ -135,69 +212,77 @@ Matrix Matrix::operator*(const Matrix &Other)
     }
 
     Matrix result(rows, Other.cols);
+    multiply(result.data.data(), data.data(), Other.data.data(), rows, cols, Other.cols);
 
-    for (size_t row = 0; row < rows; ++row) {
-        for (size_t col = 0; col < Other.cols; ++col) {
-            result.data[row * Other.cols + col] = 0;
-            for (size_t idx = 0; idx < cols; ++idx) {
-                result.data[row * Other.cols + col] += data[row * cols + idx] * Other.data[idx * Other.cols + col];
-            }
-        }
-    }
+    return result;
+}
 
+
+Matrix Matrix::operator+(const double &Scalar) const &
+{
+    Matrix result(*this);
+    result += Scalar;
     return result;
 }
 
 
-Matrix Matrix::operator+(const double &Scalar) 
+Matrix Matrix::operator+(const double &Scalar) &&
 {
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] + Scalar;
-    }
+    *this += Scalar;
+    return std::move(*this);
+}
+
 
+Matrix Matrix::operator-(const double &Scalar) const &
+{
+    Matrix result(*this);
+    result -= Scalar;
     return result;
 }
 
 
-Matrix Matrix::operator-(const double &Scalar) 
+Matrix Matrix::operator-(const double &Scalar) &&
 {
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] - Scalar;
-    }
+    *this -= Scalar;
+    return std::move(*this);
+}
 
+
+Matrix Matrix::operator*(const double &Scalar) const &
+{
+    Matrix result(*this);
+    result *= Scalar;
     return result;
 }
 
 
-Matrix Matrix::operator*(const double &Scalar) 
+Matrix Matrix::operator*(const double &Scalar) &&
 {
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] * Scalar;
+    *this *= Scalar;
+    return std::move(*this);
+}
+
+
+Matrix Matrix::operator/(const double &Scalar) const &
+{
+    if (Scalar == 0) {
+        throw DivisionByZeroException();
     }
 
+    Matrix result(*this);
+    result /= Scalar;
     return result;
 }
 
 
-Matrix Matrix::operator/(const double &Scalar) 
+Matrix Matrix::operator/(const double &Scalar) &&
 {
     if (Scalar == 0) {
         throw DivisionByZeroException();
     }
 
-    Matrix result(rows, cols);
-    
-    for (size_t idx = 0; idx < rows * cols; ++idx) {
-        result.data[idx] = data[idx] / Scalar;
-    }
-
-    return result;
+    *this /= Scalar;
+    return std::move(*this);
 }
 
 
@@ -215,6 +300,20 @@ Matrix& Matrix::operator=(const Matrix &Other)
 }
 
 
+Matrix& Matrix::operator=(Matrix &&Other) noexcept
+{
+    if (this == &Other) {
+        return *this;
+    }
+
+    rows = Other.rows;
+    cols = Other.cols;
+    data = std::move(Other.data);
+
+    return *this;
+}
+
+
 Matrix& Matrix::operator+=(const Matrix &Other) 
 {
     if (rows != Other.rows || cols != Other.cols) {
@@ -249,18 +348,15 @@ Matrix& Matrix::operator*=(const Matrix &Other)
         throw SizeMismatchException();
     }
 
-    Matrix result(rows, Other.cols);
+    // Product goes to a per-thread scratch buffer that keeps its capacity
+    // between calls, then is copied back. For square Other the size of
+    // this matrix does not change and nothing is allocated.
+    thread_local std::vector<double> scratch;
+    scratch.resize(rows * Other.cols);
+    multiply(scratch.data(), data.data(), Other.data.data(), rows, cols, Other.cols);
 
-    for (size_t row = 0; row < rows; ++row) {
-        for (size_t col = 0; col < Other.cols; ++col) {
-            result.data[row * Other.cols + col] = 0;
-            for (size_t idx = 0; idx < cols; ++idx) {
-                result.data[row * Other.cols + col] += data[row * cols + idx] * Other.data[idx * Other.cols + col];
-            }
-        }
-    }
-
-    *this = result;
+    cols = Other.cols;
+    data.assign(scratch.begin(), scratch.end());
     return *this;
 }
 
@@ -344,7 +440,7 @@ std::optional<Matrix> Matrix::transpose(const bool &inplace)
     }
 
     if (inplace) {
-        *this = result;
+        *this = std::move(result);
         return std::nullopt;
     }
 
@@ -375,7 +471,7 @@ class ZeroMatrix : public Matrix {
     public:
         ZeroMatrix(): Matrix() {}
         ZeroMatrix(size_t rows, size_t cols): Matrix(rows, cols) {std::fill(data.begin(), data.end(), 0.0);}
-        ZeroMatrix(const Matrix &M): Matrix(M) {std::fill(data.begin(), data.end(), 0.0);}
+        ZeroMatrix(const Matrix &M): Matrix(M.rows, M.cols) {}
 };
 
 
@@ -386,6 +482,7 @@ class SquareMatrix : public Matrix {
     public:
         SquareMatrix(size_t size): Matrix(size, size) {}
         SquareMatrix(const Matrix &M);
+        SquareMatrix(Matrix &&M);
 
         SquareMatrix identity(const bool &inplace = false);
         SquareMatrix minor(const size_t &row_exclude, const size_t &col_exclude);
@@ -413,6 +510,14 @@ SquareMatrix::SquareMatrix(const Matrix &M): Matrix(M)
 }
 
 
+SquareMatrix::SquareMatrix(Matrix &&M): Matrix(std::move(M))
+{
+    if (rows != cols) {
+        throw SizeMismatchException("Matrix is not square.");
+    }
+}
+
+
 SquareMatrix SquareMatrix::identity(const bool &inplace) 
 {
     SquareMatrix identity_matrix(rows);
@@ -422,7 +527,7 @@ SquareMatrix SquareMatrix::identity(const bool &inplace)
     }
 
     if (inplace) {
-        *this = identity_matrix;
+        *this = std::move(identity_matrix);
         return *this;
     }
 
@@ -505,7 +610,7 @@ std::optional<SquareMatrix> SquareMatrix::inverse(const bool &inplace)
     cofactor_matrix /= det;
 
     if (inplace) {
-        *this = cofactor_matrix;
+        *this = std::move(cofactor_matrix);
         return std::nullopt;
     }
     return cofactor_matrix;
@@ -524,7 +629,7 @@ std::optional<SquareMatrix> SquareMatrix::pow(unsigned int power, const bool &in
     }
 
     if (inplace) {
-        *this = result;
+        *this = std::move(result);
         return *this;
     }
 
@@ -541,17 +646,16 @@ std::optional<SquareMatrix> SquareMatrix::exp(const unsigned int &iterations, co
     SquareMatrix matrix_exponent_term = identity();
     SquareMatrix matrix_exponent_result = identity();
 
-    double factorial = 1.0;
-
+    // term_k = term_{k-1} * A / k, updated in place
     for (unsigned long int idx = 1; idx <= iterations; ++idx) {
         matrix_exponent_term *= *this;
-        factorial *= idx;
+        matrix_exponent_term /= static_cast<double>(idx);
 
-        matrix_exponent_result += matrix_exponent_term / factorial;
+        matrix_exponent_result += matrix_exponent_term;
     }
 
     if (inplace) {
-        *this = matrix_exponent_result;
+        *this = std::move(matrix_exponent_result);
         return *this;
     }
 
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -927,6 +928,155 @@ void test_sq_matrix_scalar_div_inplace()
 }
 
 
+// Memory resource that counts allocations passed to the upstream resource
+class CountingResource : public std::pmr::memory_resource {
+    private:
+        std::pmr::memory_resource *upstream;
+
+    public:
+        size_t allocations = 0;
+
+        CountingResource(): upstream(std::pmr::new_delete_resource()) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+        {
+            upstream->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+};
+
+
+SquareMatrix make_test_matrix(size_t size)
+{
+    SquareMatrix S(size);
+    for (size_t row = 0; row < size; ++row) {
+        for (size_t col = 0; col < size; ++col) {
+            S(row, col) = 1.0 / (1.0 + row + 2 * col);
+        }
+    }
+    return S;
+}
+
+
+void test_matrix_inplace_no_alloc()
+{
+    CountingResource counter;
+    std::pmr::memory_resource *previous = Matrix::memory_resource();
+    Matrix::set_memory_resource(&counter);
+
+    try {
+        SquareMatrix A = make_test_matrix(32);
+        SquareMatrix B = make_test_matrix(32);
+        Matrix C(16, 32);
+        A *= B;  // warms up the scratch buffer
+
+        counter.allocations = 0;
+        A += B;
+        A -= B;
+        A *= B;
+        A *= 2.0;
+        A /= 2.0;
+        C *= B;
+        if (counter.allocations != 0) {
+            throw std::runtime_error("in-place operators allocated");
+        }
+
+        Matrix D = (A + B) - B;
+        Matrix E = A * 2.0 + 1.0;
+        if (counter.allocations != 2) {
+            throw std::runtime_error("temporaries were not reused");
+        }
+        Matrix Diff = D - A;
+        for (size_t row = 0; row < 32; ++row) {
+            for (size_t col = 0; col < 32; ++col) {
+                if (fabs(Diff(row, col)) > 1e-9) {
+                    throw std::runtime_error("wrong result");
+                }
+            }
+        }
+        std::cout << "Test `test_matrix_inplace_no_alloc` passed." << std::endl;
+    } catch(const std::exception& e) {
+        std::cerr << "Test `test_matrix_inplace_no_alloc` failed: " << e.what() << '\n';
+    }
+
+    Matrix::set_memory_resource(previous);
+}
+
+
+void test_matrix_mul_inplace_self()
+{
+    try {
+        SquareMatrix S(2);
+        S(0, 0) = 1;
+        S(0, 1) = 2;
+        S(1, 0) = 3;
+        S(1, 1) = 4;
+
+        SquareMatrix Expected(2);
+        Expected(0, 0) = 7;
+        Expected(0, 1) = 10;
+        Expected(1, 0) = 15;
+        Expected(1, 1) = 22;
+
+        S *= S;
+        if (S != Expected) {
+            throw std::runtime_error("");
+        }
+        std::cout << "Test `test_matrix_mul_inplace_self` passed." << std::endl;
+    } catch(const std::exception& e) {
+        std::cerr << "Test `test_matrix_mul_inplace_self` failed" << '\n';
+    }
+}
+
+
+// Allocation count and time of pow/exp with plain heap storage and with MatrixPool
+void bench_matrix_allocations()
+{
+    const size_t size = 64;
+    const int repeats = 20;
+
+    for (int use_pool = 0; use_pool <= 1; ++use_pool) {
+        CountingResource counter;
+        std::pmr::memory_resource *previous = Matrix::memory_resource();
+        Matrix::set_memory_resource(&counter);
+        {
+            std::optional<MatrixPool> pool;
+            if (use_pool) {
+                pool.emplace(&counter);
+            }
+
+            SquareMatrix S = make_test_matrix(size);
+            counter.allocations = 0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (int idx = 0; idx < repeats; ++idx) {
+                S.pow(20);
+                S.exp(30);
+            }
+            auto stop = std::chrono::steady_clock::now();
+
+            std::cout << "pow(20) + exp(30), " << size << "x" << size << ", "
+                      << (use_pool ? "pool: " : "heap: ")
+                      << counter.allocations / repeats << " allocations, "
+                      << std::chrono::duration<double, std::micro>(stop - start).count() / repeats
+                      << " us per call" << std::endl;
+        }
+        Matrix::set_memory_resource(previous);
+    }
+}
+
+
 void run_tests()
 {
     test_logger_set_level();
@@ -965,6 +1115,10 @@ void run_tests()
     test_sq_matrix_scalar_div_inplace();
 
     test_zero_matrix();
+
+    test_matrix_inplace_no_alloc();
+    test_matrix_mul_inplace_self();
+    bench_matrix_allocations();
 }
 
 int main() 
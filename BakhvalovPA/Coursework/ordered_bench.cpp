@@ -0,0 +1,1082 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <map>
+#include <stack>
+#include <stdexcept>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../../common/red_black_tree/Red-Black-Tree.h"
+
+// Общий стенд для упорядоченных словарей из курсовых работ:
+//   AVL  - BakhvalovPA (File 2.cpp), AkulovAA, Bilyi DA
+//   BST  - KhomenkoVS (splay_tree_2.cpp, поворотов нет - обычное дерево поиска)
+//   RB   - Bryuhanov Denis (common/red_black_tree/Red-Black-Tree.h)
+//   std::map
+// Все деревья проходят одинаковые нагрузки на одних и тех же ключах.
+// Для каждой нагрузки печатаются нс/операцию, промахи кэша на операцию
+// (perf_event_open, если доступен) и контрольная сумма, которая должна совпадать
+// у всех реализаций. Каждое дерево запускается в отдельном процессе, поэтому
+// прирост пиковой памяти (ru_maxrss) относится только к нему.
+//
+// Запуск: ordered_bench [число ключей]
+//
+// Исходные файлы курсовых содержат собственные main, поэтому ниже лежат их
+// копии в отдельных пространствах имён. В копиях добавлены только поиск без
+// исключений и обход диапазона; исправления отмечены комментариями.
+
+
+// Обход по возрастанию с первого ключа >= from, не более count ключей.
+// Стек хранит узлы, в которых спуск ушёл влево, - как итератор lower_bound.
+template <typename NodeT, typename Key, typename Left, typename Right>
+long long scanFrom(NodeT* root, NodeT* nil, int from, int count, Key key, Left left, Right right) {
+    NodeT* path[128];
+    int depth = 0;
+    std::vector<NodeT*> deep;  // для вырожденных деревьев глубже 128
+    auto push = [&](NodeT* p) {
+        if (depth < 128) path[depth++] = p;
+        else deep.push_back(p);
+    };
+    auto pop = [&]() {
+        if (!deep.empty()) {
+            NodeT* p = deep.back();
+            deep.pop_back();
+            return p;
+        }
+        return path[--depth];
+    };
+
+    for (NodeT* p = root; p != nil;) {
+        if (key(p) >= from) {
+            push(p);
+            p = left(p);
+        }
+        else {
+            p = right(p);
+        }
+    }
+
+    long long sum = 0;
+    while ((depth > 0 || !deep.empty()) && count > 0) {
+        NodeT* q = pop();
+        sum += key(q);
+        count--;
+        for (NodeT* p = right(q); p != nil; p = left(p))
+            push(p);
+    }
+    return sum;
+}
+
+
+namespace bakhvalov {
+
+struct node {
+    int key;
+    unsigned short height;
+    node* left;
+    node* right;
+    node(int k) : key(k), height(1), left(nullptr), right(nullptr) {}
+};
+
+class AVLTree {
+private:
+    node* root;
+
+    unsigned short height(node* p) {
+        return p ? p->height : 0;
+    }
+
+    int8_t bfactor(node* p) {
+        return static_cast<int8_t>(height(p->right) - height(p->left));
+    }
+
+    void fixheight(node* p) {
+        unsigned short hleft = height(p->left);
+        unsigned short hright = height(p->right);
+        p->height = (std::max(hleft, hright)) + 1;
+    }
+
+    node* rotateRight(node* p) {
+        node* q = p->left;
+        p->left = q->right;
+        q->right = p;
+        fixheight(p);
+        fixheight(q);
+        return q;
+    }
+
+    node* rotateLeft(node* q) {
+        node* p = q->right;
+        q->right = p->left;
+        p->left = q;
+        fixheight(q);
+        fixheight(p);
+        return p;
+    }
+
+    node* balance(node* p) {
+        fixheight(p);
+        if (bfactor(p) == 2) {
+            if (bfactor(p->right) < 0)
+                p->right = rotateRight(p->right);
+            return rotateLeft(p);
+        }
+        if (bfactor(p) == -2) {
+            if (bfactor(p->left) > 0)
+                p->left = rotateLeft(p->left);
+            return rotateRight(p);
+        }
+        return p;
+    }
+
+    node* insert(node* p, int k) {
+        if (!p) return new node(k);
+        if (k < p->key)
+            p->left = insert(p->left, k);
+        else
+            p->right = insert(p->right, k);
+        return balance(p);
+    }
+
+    node* findmin(node* p) {
+        return p->left ? findmin(p->left) : p;
+    }
+
+    node* removemin(node* p) {
+        if (!p->left) return p->right;
+        p->left = removemin(p->left);
+        return balance(p);
+    }
+
+    node* remove(node* p, int k) {
+        if (!p) return nullptr;
+        if (k < p->key)
+            p->left = remove(p->left, k);
+        else if (k > p->key)
+            p->right = remove(p->right, k);
+        else {
+            node* q = p->left;
+            node* r = p->right;
+            delete p;
+            if (!r) return q;
+            node* min = findmin(r);
+            min->right = removemin(r);
+            min->left = q;
+            return balance(min);
+        }
+        return balance(p);
+    }
+
+public:
+    AVLTree() : root(nullptr) {}
+
+    // В оригинале деструктора нет; здесь узлы освобождаются без рекурсии
+    ~AVLTree() {
+        std::vector<node*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            node* p = stack.back();
+            stack.pop_back();
+            if (p->left) stack.push_back(p->left);
+            if (p->right) stack.push_back(p->right);
+            delete p;
+        }
+    }
+
+    void insert(int k) {
+        root = insert(root, k);
+    }
+
+    void remove(int k) {
+        root = remove(root, k);
+    }
+
+    // Добавлено для стенда: в File 2.cpp поиск ещё не реализован
+    bool search(int k) const {
+        node* p = root;
+        while (p) {
+            if (k == p->key) return true;
+            p = k < p->key ? p->left : p->right;
+        }
+        return false;
+    }
+
+    long long scan(int from, int count) const {
+        return scanFrom<node>(root, nullptr, from, count,
+            [](node* p) { return p->key; },
+            [](node* p) { return p->left; },
+            [](node* p) { return p->right; });
+    }
+};
+
+} // namespace bakhvalov
+
+
+namespace khomenko {
+
+struct Node {
+    int x;
+    Node *left;
+    Node *right;
+
+    Node (int key)
+    {
+        x = key;
+        left = nullptr;
+        right = nullptr;
+    }
+
+    ~Node()
+    {
+        delete left;
+        delete right;
+    }
+};
+
+bool exist(Node * root, int y)
+{
+    while (root != nullptr) {
+        if (root->x == y) return true;
+        root = (y < root->x) ? root->left : root->right;
+    }
+    return false;
+}
+
+Node * insert (Node * root, int y)
+{
+    if (exist(root, y)) return root;
+
+    if (root == nullptr) return new Node(y);
+
+    if (y < root->x) {
+        root->left = insert(root->left, y);
+    }
+    else if (y > root->x) {
+        root->right = insert(root->right, y);
+    }
+
+    return root;
+}
+
+Node* deleteNode(Node* root, int data) {
+    if (root == nullptr) return root;
+
+    if (data < root->x) {
+        root->left = deleteNode(root->left, data);
+    }
+    else if (data > root->x) {
+        root->right = deleteNode(root->right, data);
+    }
+    else {
+        if (root->left == nullptr) {
+            Node *temp = root->right;
+            root->right = nullptr;
+            delete root;
+            return temp;
+        } else if (root->right == nullptr) {
+            Node *temp = root->left;
+            root->left = nullptr;
+            delete root;
+            return temp;
+        }
+
+        Node *temp = root->right;
+        while (temp && temp->left != nullptr) {
+            temp = temp->left;
+        }
+        root->x = temp->x;
+        root->right = deleteNode(root->right, temp->x);
+    }
+
+    return root;
+}
+
+} // namespace khomenko
+
+
+// AkulovAA и Bilyi DA: одно и то же AVL-дерево на указателях на указатели,
+// у Bilyi DA - исправленная версия (удаление освобождает узлы, балансировка
+// проходит весь путь). В копии AkulovAA заменены непереносимый
+// конструктор std::exception(msg) и двойное уничтожение стека в balance,
+// а в del_by_key исправлена запись ключа при удалении узла с двумя детьми
+// (иначе смешанная нагрузка обрывается исключением). Узлы по-прежнему
+// не освобождаются, и балансировка останавливается после первого поворота.
+namespace akulov {
+
+class Tree_Exception : public std::runtime_error
+{
+public:
+	Tree_Exception(const char* const& msg) : std::runtime_error(msg)
+	{}
+};
+
+Tree_Exception ALREADY_EXISTS("Node with this key already exists");
+Tree_Exception DOES_NOT_EXISTS("Node does not exist");
+
+typedef double T;
+T GEN = 0;
+
+class NodeTree {
+protected:
+	T data;
+	int key;
+	NodeTree* left_child;
+	NodeTree* right_child;
+	int height;
+	int bf;
+
+public:
+	NodeTree(int key, NodeTree* left_child = nullptr, NodeTree* right_child = nullptr, int height = 0, int bf = 0);
+	void update();
+
+	friend class Tree;
+};
+
+typedef std::stack<NodeTree**> node_stack;
+
+class Tree {
+protected:
+	NodeTree* root = nullptr;
+
+public:
+	Tree() = default;
+
+	void add(int new_key);
+	void del_by_key(int del_key);
+	bool contains(int key) const;
+	long long scan(int from, int count) const;
+
+	void balance(node_stack stack);
+	void l_rotate(NodeTree** node);
+	void r_rotate(NodeTree** node);
+	void lr_rotate(NodeTree** node);
+	void rl_rotate(NodeTree** node);
+};
+
+NodeTree::NodeTree(int key, NodeTree* left_child, NodeTree* right_child, int height, int bf) {
+	this->data = GEN;
+	this->key = key;
+	this->left_child = left_child;
+	this->right_child = right_child;
+	this->bf = bf;
+	this->height = height;
+	++GEN;
+}
+
+void NodeTree::update() {
+	int lheight = 1 + (left_child == nullptr ? -1 : left_child->height);
+	int rheight = 1 + (right_child == nullptr ? -1 : right_child->height);
+	bf = lheight - rheight;
+	height = lheight > rheight ? lheight : rheight;
+}
+
+void Tree::add(int new_key) {
+	NodeTree** temp = &root;
+	node_stack stack;
+	while (*temp != nullptr) {
+		if ((*temp)->key == new_key) throw ALREADY_EXISTS;
+		stack.push(temp);
+		((*temp)->key > new_key) ? temp = &((*temp)->left_child) : temp = &((*temp)->right_child);
+	}
+	*temp = new NodeTree(new_key);
+	balance(stack);
+}
+
+bool Tree::contains(int key) const {
+	NodeTree* temp = root;
+	while (temp != nullptr) {
+		if (temp->key == key) return true;
+		temp = temp->key > key ? temp->left_child : temp->right_child;
+	}
+	return false;
+}
+
+long long Tree::scan(int from, int count) const {
+	return scanFrom<NodeTree>(root, nullptr, from, count,
+		[](NodeTree* p) { return p->key; },
+		[](NodeTree* p) { return p->left_child; },
+		[](NodeTree* p) { return p->right_child; });
+}
+
+void Tree::del_by_key(int del_key) {
+	NodeTree** temp = &root;
+	node_stack stack;
+	while (*temp != nullptr) {
+		if ((*temp)->key == del_key) {
+
+			if ((*temp)->left_child == nullptr && (*temp)->right_child == nullptr) {
+				*temp = nullptr;
+				balance(stack);
+				return;
+			}
+			if ((*temp)->left_child != nullptr && (*temp)->right_child == nullptr) {
+				*temp = (*temp)->left_child;
+				balance(stack);
+				return;
+			}
+			if ((*temp)->right_child != nullptr && (*temp)->left_child == nullptr) {
+				*temp = (*temp)->right_child;
+				balance(stack);
+				return;
+			}
+			NodeTree* change = (*temp)->left_child;
+			while (change->right_child != nullptr) {
+				change = change->right_child;
+			}
+			int change_key = change->key;
+			T change_data = change->data;
+			// Исправлено: повороты внутри рекурсивного вызова могут поставить
+			// под *temp другой узел, поэтому ключ пишется в запомненный узел
+			NodeTree* node = *temp;
+			del_by_key(change_key);
+			node->key = change_key;
+			node->data = change_data;
+			return;
+		}
+
+		stack.push(temp);
+
+		if ((*temp)->key > del_key) {
+			temp = &((*temp)->left_child);
+		}
+		else {
+			temp = &((*temp)->right_child);
+		}
+	}
+	throw DOES_NOT_EXISTS;
+}
+
+void Tree::balance(node_stack stack) {
+	NodeTree** temp;
+	while (!stack.empty()) {
+		temp = stack.top();
+		(*temp)->update();
+
+		// В оригинале перед return вызывается stack.~stack(), что приводит
+		// к повторному уничтожению стека; поведение (выход после первого
+		// поворота) сохранено
+		if ((*temp)->bf < -1) {
+			(*temp)->right_child->bf <= 0 ? l_rotate(temp) : rl_rotate(temp);
+			return;
+		}
+		else if ((*temp)->bf > 1) {
+			(*temp)->left_child->bf >= 0 ? r_rotate(temp) : lr_rotate(temp);
+			return;
+		}
+		stack.pop();
+	}
+}
+
+void Tree::l_rotate(NodeTree** node) {
+	NodeTree* child = (*node)->right_child;
+
+	(*node)->right_child = child->left_child;
+	child->left_child = *node;
+	*node = child;
+	(*node)->left_child->update();
+	(*node)->update();
+}
+
+void Tree::r_rotate(NodeTree** node) {
+	NodeTree* child = (*node)->left_child;
+
+	(*node)->left_child = child->right_child;
+	child->right_child = *node;
+	*node = child;
+	(*node)->right_child->update();
+	(*node)->update();
+}
+
+void Tree::lr_rotate(NodeTree** node) {
+	l_rotate(&((*node)->left_child));
+	r_rotate(node);
+}
+
+void Tree::rl_rotate(NodeTree** node){
+	r_rotate(&((*node)->right_child));
+	l_rotate(node);
+}
+
+} // namespace akulov
+
+
+namespace bilyi {
+
+class Tree_Exception : public std::runtime_error
+{
+public:
+    Tree_Exception(const char* msg) : std::runtime_error(msg)
+    {
+    }
+};
+
+Tree_Exception ALREADY_EXISTS("Node with this key already exists");
+Tree_Exception DOES_NOT_EXISTS("Node does not exist");
+
+typedef double T;
+
+class NodeTree {
+protected:
+    T data;
+    int key;
+    NodeTree* left_child;
+    NodeTree* right_child;
+    int height;
+    int bf;
+
+public:
+    NodeTree(int key, T data, NodeTree* left_child = nullptr, NodeTree* right_child = nullptr);
+    ~NodeTree();
+    void update();
+
+    friend class Tree;
+};
+
+typedef std::stack<NodeTree**> node_stack;
+
+class Tree {
+protected:
+    NodeTree* root = nullptr;
+
+public:
+    Tree() = default;
+    ~Tree();
+
+    void add(int new_key);
+    void del_by_key(int del_key);
+    T get_data(int key);
+    bool contains(int key) const;
+    long long scan(int from, int count) const;
+
+    void balance(node_stack stack);
+    void l_rotate(NodeTree** node);
+    void r_rotate(NodeTree** node);
+    void lr_rotate(NodeTree** node);
+    void rl_rotate(NodeTree** node);
+};
+
+NodeTree::NodeTree(int key, T data, NodeTree* left_child, NodeTree* right_child) {
+    this->data = data;
+    this->key = key;
+    this->left_child = left_child;
+    this->right_child = right_child;
+    this->height = 0;
+    this->bf = 0;
+    update();
+}
+
+NodeTree::~NodeTree() {
+    delete left_child;
+    delete right_child;
+}
+
+void NodeTree::update() {
+    int lheight = (left_child == nullptr ? -1 : left_child->height);
+    int rheight = (right_child == nullptr ? -1 : right_child->height);
+    height = std::max(lheight, rheight) + 1;
+    bf = lheight - rheight;
+}
+
+Tree::~Tree() {
+    delete root;
+}
+
+void Tree::add(int new_key) {
+    NodeTree** temp = &root;
+    node_stack stack;
+
+    while (*temp != nullptr) {
+        if ((*temp)->key == new_key) throw ALREADY_EXISTS;
+        stack.push(temp);
+
+        if ((*temp)->key > new_key) {
+            temp = &((*temp)->left_child);
+        } else {
+            temp = &((*temp)->right_child);
+        }
+    }
+
+    T new_data = static_cast<T>(new_key);
+    *temp = new NodeTree(new_key, new_data);
+    balance(stack);
+}
+
+T Tree::get_data(int key) {
+    NodeTree** temp = &root;
+    while (*temp != nullptr) {
+        if ((*temp)->key == key) {
+            return (*temp)->data;
+        }
+        if ((*temp)->key > key) {
+            temp = &((*temp)->left_child);
+        } else {
+            temp = &((*temp)->right_child);
+        }
+    }
+    throw DOES_NOT_EXISTS;
+}
+
+bool Tree::contains(int key) const {
+    NodeTree* temp = root;
+    while (temp != nullptr) {
+        if (temp->key == key) return true;
+        temp = temp->key > key ? temp->left_child : temp->right_child;
+    }
+    return false;
+}
+
+long long Tree::scan(int from, int count) const {
+    return scanFrom<NodeTree>(root, nullptr, from, count,
+        [](NodeTree* p) { return p->key; },
+        [](NodeTree* p) { return p->left_child; },
+        [](NodeTree* p) { return p->right_child; });
+}
+
+void Tree::del_by_key(int del_key) {
+    NodeTree** temp = &root;
+    node_stack stack;
+
+    while (*temp != nullptr) {
+        if ((*temp)->key == del_key) {
+            if ((*temp)->left_child == nullptr && (*temp)->right_child == nullptr) {
+                delete *temp;
+                *temp = nullptr;
+                balance(stack);
+                return;
+            }
+
+            if ((*temp)->left_child == nullptr) {
+                NodeTree* to_delete = *temp;
+                *temp = (*temp)->right_child;
+                to_delete->right_child = nullptr;
+                delete to_delete;
+                balance(stack);
+                return;
+            }
+
+            if ((*temp)->right_child == nullptr) {
+                NodeTree* to_delete = *temp;
+                *temp = (*temp)->left_child;
+                to_delete->left_child = nullptr;
+                delete to_delete;
+                balance(stack);
+                return;
+            }
+
+            NodeTree** successor = &((*temp)->right_child);
+            stack.push(temp);
+
+            while ((*successor)->left_child != nullptr) {
+                stack.push(successor);
+                successor = &((*successor)->left_child);
+            }
+
+            (*temp)->key = (*successor)->key;
+            (*temp)->data = (*successor)->data;
+
+            NodeTree* to_delete = *successor;
+            *successor = (*successor)->right_child;
+            to_delete->right_child = nullptr;
+            delete to_delete;
+
+            balance(stack);
+            return;
+        }
+
+        stack.push(temp);
+
+        if ((*temp)->key > del_key) {
+            temp = &((*temp)->left_child);
+        } else {
+            temp = &((*temp)->right_child);
+        }
+    }
+
+    throw DOES_NOT_EXISTS;
+}
+
+void Tree::balance(node_stack stack) {
+    while (!stack.empty()) {
+        NodeTree** temp = stack.top();
+        stack.pop();
+
+        (*temp)->update();
+
+        if ((*temp)->bf < -1) {
+            if ((*temp)->right_child->bf <= 0) {
+                l_rotate(temp);
+            } else {
+                rl_rotate(temp);
+            }
+        } else if ((*temp)->bf > 1) {
+            if ((*temp)->left_child->bf >= 0) {
+                r_rotate(temp);
+            } else {
+                lr_rotate(temp);
+            }
+        }
+    }
+}
+
+void Tree::l_rotate(NodeTree** node) {
+    NodeTree* child = (*node)->right_child;
+    (*node)->right_child = child->left_child;
+    child->left_child = *node;
+    *node = child;
+    (*node)->left_child->update();
+    (*node)->update();
+}
+
+void Tree::r_rotate(NodeTree** node) {
+    NodeTree* child = (*node)->left_child;
+    (*node)->left_child = child->right_child;
+    child->right_child = *node;
+    *node = child;
+    (*node)->right_child->update();
+    (*node)->update();
+}
+
+void Tree::lr_rotate(NodeTree** node) {
+    l_rotate(&((*node)->left_child));
+    r_rotate(node);
+}
+
+void Tree::rl_rotate(NodeTree** node) {
+    r_rotate(&((*node)->right_child));
+    l_rotate(node);
+}
+
+} // namespace bilyi
+
+
+// Адаптеры приводят деревья к одному интерфейсу:
+//   insert(k)  - вставка, повтор ключа не меняет дерево
+//   find(k)    - есть ли ключ
+//   erase(k)   - удаление, отсутствующий ключ пропускается
+//   scan(k, n) - сумма первых n ключей >= k
+// Деревья, которые бросают исключение на повтор или отсутствие ключа,
+// сначала проверяются поиском: иначе стоимость исключений заслонила бы дерево.
+
+struct BakhvalovAdapter {
+    static const char* name() { return "AVL BakhvalovPA"; }
+    static const bool balanced = true;
+    bakhvalov::AVLTree tree;
+
+    void insert(int k) { if (!tree.search(k)) tree.insert(k); }
+    bool find(int k) { return tree.search(k); }
+    void erase(int k) { tree.remove(k); }
+    long long scan(int from, int count) { return tree.scan(from, count); }
+};
+
+struct KhomenkoAdapter {
+    static const char* name() { return "BST KhomenkoVS"; }
+    static const bool balanced = false;
+    khomenko::Node* root = nullptr;
+
+    ~KhomenkoAdapter() { delete root; }
+    void insert(int k) { root = khomenko::insert(root, k); }
+    bool find(int k) { return khomenko::exist(root, k); }
+    void erase(int k) { root = khomenko::deleteNode(root, k); }
+    long long scan(int from, int count) {
+        return scanFrom<khomenko::Node>(root, nullptr, from, count,
+            [](khomenko::Node* p) { return p->x; },
+            [](khomenko::Node* p) { return p->left; },
+            [](khomenko::Node* p) { return p->right; });
+    }
+};
+
+struct AkulovAdapter {
+    static const char* name() { return "AVL AkulovAA"; }
+    static const bool balanced = true;
+    akulov::Tree tree;  // узлы не освобождаются - как в оригинале
+
+    void insert(int k) { if (!tree.contains(k)) tree.add(k); }
+    bool find(int k) { return tree.contains(k); }
+    void erase(int k) { if (tree.contains(k)) tree.del_by_key(k); }
+    long long scan(int from, int count) { return tree.scan(from, count); }
+};
+
+struct BilyiAdapter {
+    static const char* name() { return "AVL Bilyi DA"; }
+    static const bool balanced = true;
+    bilyi::Tree tree;
+
+    void insert(int k) { if (!tree.contains(k)) tree.add(k); }
+    bool find(int k) { return tree.contains(k); }
+    void erase(int k) { if (tree.contains(k)) tree.del_by_key(k); }
+    long long scan(int from, int count) { return tree.scan(from, count); }
+};
+
+struct BryuhanovAdapter {
+    static const char* name() { return "RB Bryuhanov Denis"; }
+    static const bool balanced = true;
+    ::Tree tree;
+
+    void insert(int k) { tree.insert(k, k); }
+    bool find(int k) { int v; return tree.search(k, v); }
+    void erase(int k) { tree.remove(k); }
+    // Итераторов нет, диапазон берётся через rank/select: O(count * log n)
+    long long scan(int from, int count) {
+        long long sum = 0;
+        int key = 0, val = 0;
+        for (int i = tree.rank(from); count > 0 && tree.select(i, key, val); i++, count--)
+            sum += key;
+        return sum;
+    }
+};
+
+struct StdMapAdapter {
+    static const char* name() { return "std::map"; }
+    static const bool balanced = true;
+    std::map<int, int> tree;
+
+    void insert(int k) { tree.emplace(k, k); }
+    bool find(int k) { return tree.find(k) != tree.end(); }
+    void erase(int k) { tree.erase(k); }
+    long long scan(int from, int count) {
+        long long sum = 0;
+        for (auto it = tree.lower_bound(from); it != tree.end() && count > 0; ++it, count--)
+            sum += it->first;
+        return sum;
+    }
+};
+
+
+// Счётчик промахов кэша последнего уровня для текущего процесса.
+// Если perf_event_open недоступен (нет PMU, запрет в контейнере), счётчик молчит.
+class CacheMissCounter {
+    int fd;
+
+public:
+    CacheMissCounter() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    ~CacheMissCounter() {
+        if (fd >= 0) close(fd);
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+    }
+};
+
+long peak_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+
+// Последовательности операций готовятся заранее и одинаковы для всех деревьев
+struct Workloads {
+    int n;
+    std::vector<int> shuffled;    // 0..n-1 в случайном порядке
+    std::vector<int> uniform;     // n ключей из [0, n)
+    std::vector<int> zipf;        // n ключей с распределением Ципфа (s = 0.99)
+    std::vector<int> mixed;       // n ключей из [0, 2n) для смешанной нагрузки
+    std::vector<uint8_t> mixedOp; // 0 - поиск (80%), 1 - вставка (10%), 2 - удаление (10%)
+    std::vector<int> scanStart;   // начала диапазонов
+    static const int SCAN_LENGTH = 100;
+
+    explicit Workloads(int n) : n(n) {
+        std::mt19937 gen(12345);
+        shuffled.resize(n);
+        for (int i = 0; i < n; i++) shuffled[i] = i;
+        std::shuffle(shuffled.begin(), shuffled.end(), gen);
+
+        std::uniform_int_distribution<int> key(0, n - 1);
+        uniform.resize(n);
+        for (int& k : uniform) k = key(gen);
+
+        // Ранг r выбирается с вероятностью ~ 1 / r^s, горячие ключи
+        // разбросаны по дереву через перестановку shuffled
+        std::vector<double> cdf(n);
+        double total = 0;
+        for (int r = 0; r < n; r++) {
+            total += 1.0 / std::pow(r + 1.0, 0.99);
+            cdf[r] = total;
+        }
+        std::uniform_real_distribution<double> unit(0.0, total);
+        zipf.resize(n);
+        for (int& k : zipf) {
+            int r = (int)(std::lower_bound(cdf.begin(), cdf.end(), unit(gen)) - cdf.begin());
+            k = shuffled[std::min(r, n - 1)];
+        }
+
+        std::uniform_int_distribution<int> wide(0, 2 * n - 1);
+        std::uniform_int_distribution<int> percent(0, 99);
+        mixed.resize(n);
+        mixedOp.resize(n);
+        for (int i = 0; i < n; i++) {
+            mixed[i] = wide(gen);
+            int p = percent(gen);
+            mixedOp[i] = p < 80 ? 0 : (p < 90 ? 1 : 2);
+        }
+
+        scanStart.resize(std::max(1, n / SCAN_LENGTH));
+        for (int& k : scanStart) k = key(gen);
+    }
+};
+
+
+template <typename Function>
+void report(const char* tree, const char* workload, long long ops, CacheMissCounter& misses, Function function) {
+    misses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    long long checksum = function();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long missCount = misses.stop();
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::cout << std::setw(20) << tree
+        << std::setw(18) << workload
+        << std::setw(12) << std::fixed << std::setprecision(1) << ns / ops;
+    if (missCount >= 0)
+        std::cout << std::setw(14) << std::setprecision(2) << (double)missCount / ops;
+    else
+        std::cout << std::setw(14) << "-";
+    // Сброс после каждой строки: при падении дерева уже полученные замеры не теряются
+    std::cout << std::setw(16) << checksum << std::endl;
+}
+
+template <typename Map>
+void run_random(const Workloads& w) {
+    CacheMissCounter misses;
+    long baseline = peak_rss_kb();
+    {
+        Map map;
+        const char* name = Map::name();
+
+        report(name, "insert uniform", w.n, misses, [&] {
+            for (int k : w.shuffled) map.insert(k);
+            return 0LL;
+        });
+        report(name, "find uniform", w.n, misses, [&] {
+            long long found = 0;
+            for (int k : w.uniform) found += map.find(k);
+            return found;
+        });
+        report(name, "find zipf", w.n, misses, [&] {
+            long long found = 0;
+            for (int k : w.zipf) found += map.find(k);
+            return found;
+        });
+        report(name, "scan 100", (long long)w.scanStart.size() * Workloads::SCAN_LENGTH, misses, [&] {
+            long long sum = 0;
+            for (int k : w.scanStart) sum += map.scan(k, Workloads::SCAN_LENGTH);
+            return sum;
+        });
+        report(name, "mixed 80/10/10", w.n, misses, [&] {
+            long long found = 0;
+            for (int i = 0; i < w.n; i++) {
+                int k = w.mixed[i];
+                if (w.mixedOp[i] == 0) found += map.find(k);
+                else if (w.mixedOp[i] == 1) map.insert(k);
+                else map.erase(k);
+            }
+            // Итог смешанной нагрузки проверяется по содержимому дерева
+            return found * 1000003 + map.scan(0, 2 * w.n);
+        });
+        std::cout << std::setw(20) << name << std::setw(18) << "peak memory"
+            << std::setw(12) << (peak_rss_kb() - baseline) / 1024 << " MB\n";
+    }
+}
+
+template <typename Map>
+void run_sequential(const Workloads& w) {
+    CacheMissCounter misses;
+    if (!Map::balanced) {
+        // Несбалансированное дерево вырождается в список: O(n^2) и рекурсия глубины n
+        std::cout << std::setw(20) << Map::name() << std::setw(18) << "insert sequential"
+            << std::setw(12) << "skipped" << "\n";
+        return;
+    }
+    Map map;
+    report(Map::name(), "insert sequential", w.n, misses, [&] {
+        for (int k = 0; k < w.n; k++) map.insert(k);
+        return map.scan(0, w.n);
+    });
+}
+
+// Каждое дерево - в дочернем процессе: пиковая память не смешивается,
+// а падение одной реализации не останавливает стенд
+template <typename Function>
+void isolated(const char* name, Function function) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        function();
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        std::cout << std::setw(20) << name << "  terminated abnormally\n";
+}
+
+template <typename Map>
+void run_all(const Workloads& w) {
+    isolated(Map::name(), [&] { run_random<Map>(w); });
+    isolated(Map::name(), [&] { run_sequential<Map>(w); });
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (n <= 0) {
+        std::cerr << "Usage: ordered_bench [keys]\n";
+        return 1;
+    }
+
+    Workloads w(n);
+    std::cout << "Ordered map benchmark, " << n << " keys\n";
+    if (!CacheMissCounter().available())
+        std::cout << "perf_event_open unavailable, cache misses are not reported\n";
+    std::cout << std::setw(20) << "Tree"
+        << std::setw(18) << "Workload"
+        << std::setw(12) << "ns/op"
+        << std::setw(14) << "misses/op"
+        << std::setw(16) << "checksum" << "\n";
+
+    run_all<StdMapAdapter>(w);
+    run_all<BryuhanovAdapter>(w);
+    run_all<BakhvalovAdapter>(w);
+    run_all<BilyiAdapter>(w);
+    run_all<AkulovAdapter>(w);
+    run_all<KhomenkoAdapter>(w);
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include "CommandJournal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char MAGIC[8] = {'C', 'M', 'D', 'J', 'R', 'N', 'L', '2'};
+
+static bool validHeader(const CommandJournal::Header& header)
+{
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.recordSize == sizeof(CommandJournal::Record)
+        && header.indexStride == CommandJournal::INDEX_STRIDE;
+}
+
+CommandJournal::CommandJournal(const std::string& path)
+    : fd(-1),
+      indexFd(-1),
+      records(0),
+      indexed(0)
+{
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[JRN] Failed to open journal: " << path << std::endl;
+        return;
+    }
+
+    struct stat st{};
+    fstat(fd, &st);
+    Header header{};
+
+    // Журнал старого формата начинается заново: он нужен только для отката
+    bool fresh = st.st_size < (off_t)sizeof(Header);
+    if (!fresh && (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || !validHeader(header))) {
+        std::cerr << "[JRN] Incompatible journal format, starting a new journal: " << path << std::endl;
+        header = Header{};
+        fresh = true;
+    }
+
+    if (fresh) {
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.recordSize = sizeof(Record);
+        header.indexStride = INDEX_STRIDE;
+        if (ftruncate(fd, 0) != 0 || pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+            std::cerr << "[JRN] Failed to write journal header: " << path << std::endl;
+            close(fd);
+            fd = -1;
+            return;
+        }
+    } else {
+        records = (st.st_size - sizeof(Header)) / sizeof(Record);
+
+        // Недописанная при сбое запись отрезается
+        if (ftruncate(fd, sizeof(Header) + records * sizeof(Record)) != 0) {
+            std::cerr << "[JRN] Failed to trim journal: " << path << std::endl;
+        }
+    }
+
+    indexFd = open(indexPath(path).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (indexFd < 0) {
+        std::cerr << "[JRN] Failed to open journal index: " << indexPath(path) << std::endl;
+        return;
+    }
+
+    // Индекс может отставать от журнала после сбоя: недостающие точки восстанавливаются
+    fstat(indexFd, &st);
+    uint64_t need = (records + INDEX_STRIDE - 1) / INDEX_STRIDE;
+    indexed = std::min<uint64_t>(st.st_size / sizeof(IndexEntry), need);
+    if (ftruncate(indexFd, indexed * sizeof(IndexEntry)) != 0) {
+        std::cerr << "[JRN] Failed to trim journal index" << std::endl;
+    }
+
+    for (; indexed < need; indexed++) {
+        Record record{};
+        pread(fd, &record, sizeof(record), sizeof(Header) + indexed * INDEX_STRIDE * sizeof(Record));
+        IndexEntry entry{record.timeMs, indexed * INDEX_STRIDE};
+        pwrite(indexFd, &entry, sizeof(entry), indexed * sizeof(IndexEntry));
+    }
+
+    std::cout << "[JRN] Journal opened: " << path << ", records: " << records << std::endl;
+}
+
+CommandJournal::~CommandJournal()
+{
+    if (indexFd >= 0)
+        close(indexFd);
+    if (fd >= 0)
+        close(fd);
+}
+
+bool CommandJournal::isOpen() const
+{
+    return fd >= 0;
+}
+
+int64_t CommandJournal::nowMs()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int64_t CommandJournal::wallMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string CommandJournal::indexPath(const std::string& path)
+{
+    return path + ".idx";
+}
+
+void CommandJournal::append(int direction, int speed, int servo, bool rollback)
+{
+    Record record{};
+    record.timeMs = nowMs();
+    record.wallMs = wallMs();
+    record.type = STATE;
+    record.direction = (uint8_t)direction;
+    record.speed = (uint8_t)speed;
+    record.servo = (uint8_t)servo;
+    record.flags = rollback ? FLAG_ROLLBACK : 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    write(record);
+}
+
+void CommandJournal::beginSession()
+{
+    Record record{};
+    record.timeMs = nowMs();
+    record.wallMs = wallMs();
+    record.type = SESSION;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd < 0) return;
+
+    uint64_t position = records;
+    write(record);
+    pwrite(fd, &position, sizeof(position), offsetof(Header, sessionStart));
+}
+
+// Запись дописывается целиком одним pwrite по известному смещению
+void CommandJournal::write(const Record& record)
+{
+    if (fd < 0) return;
+
+    off_t offset = sizeof(Header) + records * sizeof(Record);
+    if (pwrite(fd, &record, sizeof(record), offset) != (ssize_t)sizeof(record)) {
+        std::cerr << "[JRN] Failed to append record" << std::endl;
+        return;
+    }
+
+    if (records % INDEX_STRIDE == 0 && indexFd >= 0) {
+        IndexEntry entry{record.timeMs, records};
+        pwrite(indexFd, &entry, sizeof(entry), indexed * sizeof(IndexEntry));
+        indexed++;
+    }
+    records++;
+}
+
+static void* mapFile(const std::string& path, size_t& bytes)
+{
+    bytes = 0;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+
+    struct stat st{};
+    void* p = nullptr;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            p = nullptr;
+        } else {
+            bytes = st.st_size;
+        }
+    }
+    close(fd);
+    return p;
+}
+
+JournalReader::JournalReader(const std::string& path)
+    : data(nullptr),
+      dataBytes(0),
+      index(nullptr),
+      indexBytes(0),
+      records(nullptr),
+      count(0),
+      sessionStart(0)
+{
+    data = mapFile(path, dataBytes);
+    if (data == nullptr) return;
+
+    CommandJournal::Header header;
+    if (dataBytes < sizeof(header)) {
+        munmap(data, dataBytes);
+        data = nullptr;
+        return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (!validHeader(header)) {
+        std::cerr << "[JRN] Incompatible journal format: " << path << std::endl;
+        munmap(data, dataBytes);
+        data = nullptr;
+        return;
+    }
+
+    records = (const CommandJournal::Record*)((const char*)data + sizeof(header));
+    count = (dataBytes - sizeof(header)) / sizeof(CommandJournal::Record);
+    sessionStart = std::min<uint64_t>(header.sessionStart, count);
+
+    // Без индекса окно ищется просмотром от начала сессии
+    index = mapFile(CommandJournal::indexPath(path), indexBytes);
+}
+
+JournalReader::~JournalReader()
+{
+    if (index != nullptr)
+        munmap(index, indexBytes);
+    if (data != nullptr)
+        munmap(data, dataBytes);
+}
+
+bool JournalReader::isOpen() const
+{
+    return data != nullptr;
+}
+
+size_t JournalReader::size() const
+{
+    return count;
+}
+
+std::pair<const CommandJournal::Record*, const CommandJournal::Record*>
+JournalReader::window(int64_t sinceMs) const
+{
+    if (!isOpen() || sessionStart >= count)
+        return {records + count, records + count};
+
+    uint64_t first = sessionStart;
+
+    // Последняя точка индекса текущей сессии не позже sinceMs, дальше не больше
+    // INDEX_STRIDE записей. Точки прошлых сессий могут быть с другой загрузки,
+    // их время с текущим не сравнивается
+    const CommandJournal::IndexEntry* entries = (const CommandJournal::IndexEntry*)index;
+    size_t entryCount = indexBytes / sizeof(CommandJournal::IndexEntry);
+    auto session = std::lower_bound(entries, entries + entryCount, sessionStart,
+        [](const CommandJournal::IndexEntry& e, uint64_t record) { return e.record < record; });
+    auto it = std::upper_bound(session, entries + entryCount, sinceMs,
+        [](int64_t t, const CommandJournal::IndexEntry& e) { return t < e.timeMs; });
+    if (it != session) {
+        first = std::max<uint64_t>(first, std::min<uint64_t>((it - 1)->record, count - 1));
+    }
+
+    while (first + 1 < count && records[first + 1].timeMs <= sinceMs) {
+        first++;
+    }
+
+    return {records + first, records + count};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Бинарный журнал команд для отката. Текстовый commands.log остаётся для человека,
+// а RollbackExecutor читает этот журнал: записи фиксированного размера
+// (время, направление, скорость, серво) дописываются в конец файла,
+// каждая 64-я запись попадает в разреженный индекс времени (файл .idx).
+// Начало текущей сессии хранится в заголовке, поэтому откат находит
+// "последние N секунд" бинарным поиском по индексу, не читая журнал целиком.
+// Порядок и поиск идут по монотонным часам CLOCK_BOOTTIME: перевод системных
+// часов (NTP) не ломает индекс. Они сбрасываются при перезагрузке, поэтому
+// сравниваются только записи одной сессии.
+class CommandJournal {
+public:
+    struct Record {
+        int64_t timeMs;      // CLOCK_BOOTTIME, мс с загрузки
+        int64_t wallMs;      // system_clock, мс от эпохи, только для вывода
+        uint8_t type;        // STATE или SESSION
+        uint8_t direction;   // 0-6
+        uint8_t speed;       // 10-100
+        uint8_t servo;       // 0-4
+        uint8_t flags;       // FLAG_ROLLBACK
+        uint8_t reserved[3];
+    };
+
+    enum : uint8_t { STATE = 1, SESSION = 2 };
+    enum : uint8_t { FLAG_ROLLBACK = 1 };
+
+    explicit CommandJournal(const std::string& path);
+    ~CommandJournal();
+
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    bool isOpen() const;
+
+    // Состояние после изменения направления, скорости или серво
+    void append(int direction, int speed, int servo, bool rollback);
+
+    // Начало сессии оператора: откат не заходит за эту запись
+    void beginSession();
+
+    static int64_t nowMs();
+    static int64_t wallMs();
+    static std::string indexPath(const std::string& path);
+
+    static constexpr uint64_t INDEX_STRIDE = 64;
+
+    struct Header {
+        char magic[8];
+        uint32_t recordSize;
+        uint32_t indexStride;
+        uint64_t sessionStart;  // номер записи SESSION текущей сессии
+        uint64_t reserved;
+    };
+
+    struct IndexEntry {
+        int64_t timeMs;
+        uint64_t record;
+    };
+
+private:
+    int fd;
+    int indexFd;
+    uint64_t records;
+    uint64_t indexed;
+    std::mutex mutex;
+
+    void write(const Record& record);
+};
+
+// Журнал, отображённый в память только для чтения
+class JournalReader {
+public:
+    explicit JournalReader(const std::string& path);
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    bool isOpen() const;
+    size_t size() const;
+
+    // Записи текущей сессии начиная с состояния, действовавшего в момент sinceMs.
+    // Первая запись может быть старше sinceMs
+    std::pair<const CommandJournal::Record*, const CommandJournal::Record*> window(int64_t sinceMs) const;
+
+private:
+    void* data;
+    size_t dataBytes;
+    void* index;
+    size_t indexBytes;
+
+    const CommandJournal::Record* records;
+    size_t count;
+    uint64_t sessionStart;
+};
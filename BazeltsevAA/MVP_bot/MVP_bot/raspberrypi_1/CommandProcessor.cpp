@@ -13,6 +13,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <sys/socket.h>
+#include <poll.h>
 
 // Форматирования времени
 static std::string getCurrentTimeMs() {
@@ -34,11 +35,22 @@ static std::string getCurrentTimeMs() {
     return oss.str();
 }
 
+// commands.log -> commands.jnl
+static std::string journalPathFor(const std::string& logPath)
+{
+    std::string path = logPath;
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".log") == 0)
+        path.resize(path.size() - 4);
+    return path + ".jnl";
+}
+
 CommandProcessor::CommandProcessor(const std::string& uartDevice,
                                    const std::string& logPath)
     : uart_fd(-1),
       uartDevicePath(uartDevice),
       logFilePath(logPath),
+      journalPath(journalPathFor(logPath)),
+      journal(journalPath),
       currentDirection(0),
       currentSpeed(50),
       currentServoCommand(0),
@@ -82,12 +94,19 @@ CommandProcessor::CommandProcessor(const std::string& uartDevice,
     
     initUart();
     openLog();
+
+    timerThread = std::thread(&CommandProcessor::timerThreadFunc, this);
     
     std::cout << "[CMD] CommandProcessor initialized with 5-char format" << std::endl;
 }
 
 CommandProcessor::~CommandProcessor()
 {
+    interruptScript();
+    timersRunning = false;
+    if (timerThread.joinable())
+        timerThread.join();
+
     if (uart_fd >= 0) {
         // Остановка перед выходом
         setDirection(0);
@@ -99,8 +118,6 @@ CommandProcessor::~CommandProcessor()
 
     if (logFile.is_open())
         logFile.close();
-    
-    interruptScript();
 }
 
 bool CommandProcessor::isReady() const
@@ -174,6 +191,12 @@ void CommandProcessor::writeLog(const std::string& text)
     logFile.flush(); // Немедленная запись на диск
 }
 
+// Состояние после изменения, по журналу RollbackExecutor восстанавливает движения
+void CommandProcessor::writeJournal()
+{
+    journal.append(currentDirection, currentSpeed, currentServoCommand, rollbackMode);
+}
+
 void CommandProcessor::sendFullCommand(int direction, int speed, int servoCommand)
 {
     if (uart_fd < 0) {
@@ -246,6 +269,7 @@ void CommandProcessor::setDirection(int direction)
         std::string dirNames[] = {"STOP", "FORWARD", "BACKWARD", "RIGHT", "LEFT", "TURN_RIGHT", "TURN_LEFT"};
         std::string dirName = (direction >= 0 && direction <= 6) ? dirNames[direction] : "UNKNOWN";
         writeLog("DIR:" + std::to_string(oldDirection) + "->" + std::to_string(direction) + "(" + dirName + ")");
+        writeJournal();
     }
     
     sendCurrentCommand();
@@ -266,6 +290,7 @@ void CommandProcessor::setServoCommand(int servoCommand)
         std::string servoNames[] = {"SERVO_STOP", "SERVO_RIGHT", "SERVO_UP", "SERVO_DOWN", "SERVO_LEFT"};
         std::string servoName = (servoCommand >= 0 && servoCommand <= 4) ? servoNames[servoCommand] : "UNKNOWN";
         writeLog("SERVO:" + std::to_string(oldServo) + "->" + std::to_string(servoCommand) + "(" + servoName + ")");
+        writeJournal();
     }
     
     sendCurrentCommand();
@@ -365,6 +390,7 @@ void CommandProcessor::processSpeed(int speed)
 
     // Логирование скорости
     writeLog("SPD:" + std::to_string(previousSpeed) + "->" + std::to_string(speed));
+    writeJournal();
     std::cout << "[CMD] Speed set to " << speed << std::endl;
 
     if (directionKeyPressed) {
@@ -449,6 +475,7 @@ void CommandProcessor::setSpeedDirect(int speed)
     // Логирование режиме rollback
     if (rollbackMode) {
         writeLog("SPD:" + std::to_string(oldSpeed) + "->" + std::to_string(speed));
+        writeJournal();
     }
     
     std::cout << "[CMD] Speed direct set to " << speed << std::endl;
@@ -458,29 +485,36 @@ void CommandProcessor::interruptScript()
 {
     if (scriptRunning) {
         std::cout << "[CMD] Interrupting script..." << std::endl;
-        scriptInterrupt = true;
 
-        if (scriptThread.joinable()) {
-            scriptThread.join();
-            std::cout << "[CMD] Script thread joined" << std::endl;
-        }
+        // После cancelGroup ни один шаг скрипта уже не выполняется
+        timers.cancelGroup(SCRIPT_TIMERS);
+        std::cout << "[CMD] Script timers cancelled" << std::endl;
 
         scriptRunning = false;
-        scriptInterrupt = false;
         
         // Останавка при прерывании
         setDirection(0);
     }
 }
 
-void CommandProcessor::scriptThreadFunc(const std::string& path)
+void CommandProcessor::timerThreadFunc()
+{
+    while (timersRunning) {
+        pollfd pfd{timers.fd(), POLLIN, 0};
+        if (poll(&pfd, 1, 100) > 0 && (pfd.revents & POLLIN))
+            timers.runExpired();
+    }
+}
+
+void CommandProcessor::startScriptFromFile(const std::string& path)
 {
-    std::cout << "[CMD] Starting script from: " << path << std::endl;
+    std::cout << "[CMD] Starting script from file: " << path << std::endl;
     
+    interruptScript();
+
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "[CMD] Failed to open script file: " << path << std::endl;
-        scriptRunning = false;
         return;
     }
 
@@ -495,12 +529,18 @@ void CommandProcessor::scriptThreadFunc(const std::string& path)
     }
     file.close();
 
-    for (size_t i = 0; i < lines.size(); ++i) {
-        if (scriptInterrupt) {
-            std::cout << "[CMD] Script interrupted at line " << i << std::endl;
-            break;
-        }
+    // Удаление временного файл
+    if (std::remove(path.c_str()) != 0) {
+        std::cerr << "[CMD] Failed to remove temp script file: " << path << std::endl;
+    }
+
+    scriptRunning = true;
+
+    // Шаги планируются от начала скрипта: шаг не сдвигается,
+    // если предыдущий таймер сработал с опозданием
+    auto at = TimerWheel::Clock::now();
 
+    for (size_t i = 0; i < lines.size(); ++i) {
         const std::string& l = lines[i];
 
         // Парсинг
@@ -534,51 +574,34 @@ void CommandProcessor::scriptThreadFunc(const std::string& path)
             continue;
         }
         
-        // Установка скорости
-        processSpeed(speed);
-        
-        processCommand(cmd);
-        
-        std::cout << "[CMD] Waiting " << duration_ms << " ms..." << std::endl;
-        int slept = 0;
-        while (slept < duration_ms && !scriptInterrupt) {
-            usleep(10 * 1000); // 10 ms шаг
-            slept += 10;
-        }
-        
-        if (!scriptInterrupt) {
-            // Останавка
+        // Установка скорости и команда
+        timers.scheduleAt(at, [this, cmd, speed, duration_ms]() {
+            processSpeed(speed);
+            processCommand(cmd);
+            std::cout << "[CMD] Waiting " << duration_ms << " ms..." << std::endl;
+        }, SCRIPT_TIMERS);
+        at += std::chrono::milliseconds(std::max(duration_ms, 0));
+
+        // Останавка
+        timers.scheduleAt(at, [this]() {
             processCommand('n');
-            usleep(50 * 1000); // 50ms
-        }
+        }, SCRIPT_TIMERS);
+        at += std::chrono::milliseconds(50);
     }
 
-    // Удаление временного файл
-    if (std::remove(path.c_str()) != 0) {
-        std::cerr << "[CMD] Failed to remove temp script file: " << path << std::endl;
-    }
-    
-    std::cout << "[CMD] Script finished" << std::endl;
-    scriptRunning = false;
+    timers.scheduleAt(at, [this]() {
+        std::cout << "[CMD] Script finished" << std::endl;
+        scriptRunning = false;
+
+        TimerWheel::JitterStats j = timers.jitter();
+        std::cout << "[CMD] Timer jitter: " << j.count << " timers, mean " << j.meanUs
+                  << " us, p99 " << j.p99Us << " us, max " << j.maxUs << " us" << std::endl;
+    }, SCRIPT_TIMERS);
 }
 
-void CommandProcessor::startScriptFromFile(const std::string& path)
+TimerWheel& CommandProcessor::getTimers()
 {
-    std::cout << "[CMD] Starting script from file: " << path << std::endl;
-    
-    interruptScript();
-
-    scriptRunning = true;
-    scriptInterrupt = false;
-
-    scriptThread = std::thread(
-        &CommandProcessor::scriptThreadFunc,
-        this,
-        path
-    );
-    
-    // Отделение потока
-    scriptThread.detach();
+    return timers;
 }
 
 bool CommandProcessor::inverseCommand(char cmd, char& outInv) const
@@ -605,6 +628,17 @@ void CommandProcessor::logSystemEvent(const std::string& text)
     std::cout << "[SYS] " << text << std::endl;
 }
 
+void CommandProcessor::beginSession()
+{
+    logSystemEvent("OPERATOR_CONNECTED");
+    journal.beginSession();
+}
+
+const std::string& CommandProcessor::getJournalPath() const
+{
+    return journalPath;
+}
+
 void CommandProcessor::setSensorSocket(int fd)
 {
     sensorSocketFd = fd;
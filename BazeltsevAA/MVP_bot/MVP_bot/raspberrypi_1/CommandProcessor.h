@@ -7,10 +7,16 @@
 #include <thread>
 #include <unordered_map>
 
+#include "../../../../common/timer_wheel/timer_wheel.h"
+#include "CommandJournal.h"
+
 class VideoStreamer;
 
 class CommandProcessor {
 public:
+    // Группы таймеров общего колеса
+    enum TimerGroup { SCRIPT_TIMERS = 1, ROLLBACK_TIMERS, HEARTBEAT_TIMERS };
+
     CommandProcessor(const std::string& uartDevice,
                      const std::string& logPath);
     ~CommandProcessor();
@@ -36,6 +42,10 @@ public:
     void setRollbackMode(bool enabled);
     void logSystemEvent(const std::string& text);
     void setSpeedDirect(int speed);
+
+    // Подключение оператора: начало новой сессии в логе и журнале
+    void beginSession();
+    const std::string& getJournalPath() const;
     
     // Работа с сенсорами
     void startSensorLogging(const std::string& sensorLogPath);
@@ -48,6 +58,9 @@ public:
     // Новый метод для установки видеопотока
     void setVideoStreamer(VideoStreamer* vs);
 
+    // Колесо таймеров со своим потоком: на нём же работают откат и heartbeat
+    TimerWheel& getTimers();
+
 private:
     // Состояние системы
     int currentDirection;
@@ -62,6 +75,8 @@ private:
     std::string uartDevicePath;
     std::string logFilePath;
     std::ofstream logFile;
+    std::string journalPath;
+    CommandJournal journal;
     
     // Словари команд
     struct {
@@ -70,10 +85,14 @@ private:
     } dict;
     
     // Управление потоками
-    std::thread scriptThread;
     std::atomic<bool> scriptRunning{false};
-    std::atomic<bool> scriptInterrupt{false};
     std::atomic<bool> rollbackMode{false};
+
+    // Шаги скрипта выполняются по таймерам в отдельном потоке,
+    // прерывание скрипта отменяет их сразу
+    TimerWheel timers;
+    std::thread timerThread;
+    std::atomic<bool> timersRunning{true};
     
     std::thread sensorThread;
     std::atomic<bool> sensorRunning{false};
@@ -85,7 +104,8 @@ private:
     void initUart();
     void openLog();
     void writeLog(const std::string& text);
-    void scriptThreadFunc(const std::string& path);
+    void writeJournal();
+    void timerThreadFunc();
     void sensorThreadFunc();
 };
 
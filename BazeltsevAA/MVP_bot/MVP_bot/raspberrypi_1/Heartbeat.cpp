@@ -7,10 +7,13 @@
 
 static constexpr char PING_MSG[] = "PING";
 static constexpr char PONG_MSG[] = "PONG";
+static constexpr std::chrono::milliseconds CHECK_PERIOD(100);
 
-Heartbeat::Heartbeat(int socket_fd, int timeout_sec)
+Heartbeat::Heartbeat(int socket_fd, TimerWheel& wheel, int timerGroup, int timeout_sec)
     : sockfd(socket_fd),
       timeout(timeout_sec),
+      timers(wheel),
+      group(timerGroup),
       running(false),
       connected(true)
 {
@@ -23,59 +26,61 @@ Heartbeat::~Heartbeat() {
 
 void Heartbeat::start() {
     running = true;
-    worker = std::thread(&Heartbeat::loop, this);
+    last_ping = std::chrono::steady_clock::now();
+    timers.schedule(CHECK_PERIOD, [this] { check(); }, group);
 }
 
+// cancelGroup ждёт выполняющуюся проверку, поэтому после stop()
+// новых проверок нет и объект можно разрушать
 void Heartbeat::stop() {
     running = false;
-    if (worker.joinable())
-        worker.join();
+    timers.cancelGroup(group);
 }
 
 bool Heartbeat::isOperatorConnected() const {
     return connected;
 }
 
-void Heartbeat::loop()
+void Heartbeat::check()
 {
-    char buffer[16];
+    if (!running)
+        return;
 
-    while (running) {
-        ssize_t r = recv(sockfd,
-                          buffer,
-                          sizeof(buffer) - 1,
-                          MSG_DONTWAIT);
+    char buffer[16];
+    ssize_t r = recv(sockfd,
+                      buffer,
+                      sizeof(buffer) - 1,
+                      MSG_DONTWAIT);
 
-        if (r > 0) {
-            buffer[r] = '\0';
+    if (r > 0) {
+        buffer[r] = '\0';
 
-            if (std::strncmp(buffer, PING_MSG, 4) == 0) {
-                last_ping = std::chrono::steady_clock::now();
+        if (std::strncmp(buffer, PING_MSG, 4) == 0) {
+            last_ping = std::chrono::steady_clock::now();
 
-                // Ответ PONG
-                send(sockfd, PONG_MSG, 4, 0);
-            }
+            // Ответ PONG
+            send(sockfd, PONG_MSG, 4, 0);
         }
-        else if (r == 0) {
-            // TCP закрыт клиентом
-            std::cout << "[CNT] Operator disconnected (TCP closed)\n";
-            connected = false;
-            running = false;
-            break;
-        }
-
-        // Проверка таймаута
-        auto now = std::chrono::steady_clock::now();
-        auto diff = std::chrono::duration_cast<std::chrono::seconds>(
-                        now - last_ping).count();
+    }
+    else if (r == 0) {
+        // TCP закрыт клиентом
+        std::cout << "[CNT] Operator disconnected (TCP closed)\n";
+        connected = false;
+        running = false;
+        return;
+    }
 
-        if (diff > timeout) {
-            std::cout << "[CNT] Operator heartbeat timeout\n";
-            connected = false;
-            running = false;
-            break;
-        }
+    // Проверка таймаута
+    auto now = std::chrono::steady_clock::now();
+    auto diff = std::chrono::duration_cast<std::chrono::seconds>(
+                    now - last_ping).count();
 
-        usleep(100 * 1000); // 100 мс
+    if (diff > timeout) {
+        std::cout << "[CNT] Operator heartbeat timeout\n";
+        connected = false;
+        running = false;
+        return;
     }
+
+    timers.schedule(CHECK_PERIOD, [this] { check(); }, group);
 }
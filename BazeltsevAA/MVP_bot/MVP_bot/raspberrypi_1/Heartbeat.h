@@ -1,12 +1,16 @@
 #pragma once
 
 #include <atomic>
-#include <thread>
 #include <chrono>
 
+#include "../../../../common/timer_wheel/timer_wheel.h"
+
+// Проверка связи с оператором раз в 100 мс на общем колесе таймеров
 class Heartbeat {
 public:
     Heartbeat(int socket_fd,
+              TimerWheel& timers,
+              int timerGroup,
               int timeout_sec = 3);
 
     ~Heartbeat();
@@ -17,15 +21,15 @@ public:
     bool isOperatorConnected() const;
 
 private:
-    void loop();
+    void check();
 
     int sockfd;
     int timeout;
+    TimerWheel& timers;
+    int group;
 
     std::atomic<bool> running;
     std::atomic<bool> connected;
 
-    std::thread worker;
-
     std::chrono::steady_clock::time_point last_ping;
 };
@@ -1,46 +1,22 @@
 #include "RollbackExecutor.h"
 
-#include <fstream>
+#include "CommandJournal.h"
+
+#include <algorithm>
 #include <vector>
-#include <sstream>
 #include <iostream>
 #include <chrono>
-#include <unistd.h>
 #include <map>
 
 
 struct LoggedMove {
     int direction; // 0-6: направление движения
     int speed;     // 10-100: скорость
-    std::chrono::system_clock::time_point start;
+    int64_t startMs; // CLOCK_BOOTTIME, как в журнале
     std::chrono::milliseconds duration;
 };
 
 
-static std::chrono::system_clock::time_point parseTime(const std::string &line) {
-    int d, m, y, hh, mm, ss, ms;
-
-    if (sscanf(
-            line.c_str(),
-            "[%d.%d.%d][%d:%d:%d.%d]",
-            &d, &m, &y,
-            &hh, &mm, &ss, &ms
-        ) != 7) {
-        return {};
-    }
-
-    std::tm tm{};
-    tm.tm_mday = d;
-    tm.tm_mon = m - 1;
-    tm.tm_year = y - 1900;
-    tm.tm_hour = hh;
-    tm.tm_min = mm;
-    tm.tm_sec = ss;
-
-    auto tp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-    return tp + std::chrono::milliseconds(ms);
-}
-
 // Обратные команды
 static char directionToInverseCommand(int direction) {
     static const std::map<int, char> dirToInvCmd = {
@@ -59,116 +35,138 @@ static char directionToInverseCommand(int direction) {
 
 RollbackExecutor::RollbackExecutor(CommandProcessor &c,
                                    const std::string &path,
-                                   std::atomic<bool> &cancelFlag)
-    : cmd(c), logPath(path), cancel(cancelFlag) {
+                                   std::chrono::seconds windowSec)
+    : cmd(c), timers(c.getTimers()), journalPath(path), window(windowSec) {
 }
 
-void RollbackExecutor::executeRollback() {
-    std::ifstream log(logPath);
-    if (!log.is_open()) {
-        std::cerr << "[RB] Failed to open log\n";
+RollbackExecutor::~RollbackExecutor() {
+    cancel();
+}
+
+void RollbackExecutor::scheduleRollback(std::chrono::seconds delay) {
+    cancel();
+    active = true;
+    rollingBack = false;
+    executedCount = 0;
+
+    // Каждую секунду - сообщение об ожидании, последнее запускает откат
+    auto lostTime = TimerWheel::Clock::now();
+    for (long sec = 1; sec <= delay.count(); sec++) {
+        timers.scheduleAt(lostTime + std::chrono::seconds(sec), [this, sec, delay]() {
+            std::cout << "[CNT] Without operator " << sec << " sec\n";
+            if (sec == delay.count()) {
+                std::cout << "[CNT] Starting rollback\n";
+                executeRollback();
+            }
+        }, CommandProcessor::ROLLBACK_TIMERS);
+    }
+}
+
+void RollbackExecutor::cancel() {
+    if (!active)
+        return;
+
+    // cancelGroup ждёт уже выполняющийся шаг; если это был последний,
+    // откат завершился сам и отменять нечего
+    timers.cancelGroup(CommandProcessor::ROLLBACK_TIMERS);
+    if (!active.exchange(false))
         return;
+
+    if (rollingBack) {
+        std::cout << "[RB] Rollback cancelled\n";
+        cmd.processCommand('n');
+        cmd.setRollbackMode(false);
+    } else {
+        std::cout << "[CNT] Operator reconnected, rollback cancelled\n";
     }
+}
 
-    std::cout << "[RB] Parsing log...\n";
+void RollbackExecutor::finishRollback() {
+    if (!active.exchange(false))
+        return;
 
-    std::vector<std::string> sessionLines;
-    std::string line;
+    if (rollingBack)
+        cmd.setRollbackMode(false);
+    std::cout << "[RB] Rollback finished. Executed " << executedCount << " movements.\n";
+}
 
-    while (std::getline(log, line)) {
-        if (line.find("SYS:OPERATOR_CONNECTED") != std::string::npos) {
-            sessionLines.clear(); 
-        }
-        sessionLines.push_back(line);
+void RollbackExecutor::executeRollback() {
+    JournalReader journal(journalPath);
+    if (!journal.isOpen()) {
+        std::cerr << "[RB] Failed to open journal\n";
+        active = false;
+        return;
     }
 
-    log.close();
+    int64_t nowMs = CommandJournal::nowMs();
+    int64_t sinceMs = nowMs - std::chrono::duration_cast<std::chrono::milliseconds>(window).count();
 
-    if (sessionLines.empty()) {
+    // Окно находится по индексу, журнал целиком не читается
+    auto range = journal.window(sinceMs);
+    if (range.first == range.second) {
         std::cout << "[RB] Empty session\n";
+        active = false;
         return;
     }
 
-    // Восстановление движения из логов
+    std::cout << "[RB] Journal records in window: " << (range.second - range.first)
+              << " of " << journal.size() << std::endl;
+
+    // Восстановление движений из журнала
     std::vector<LoggedMove> moves;
 
     bool hasActiveMove = false;
     int activeDirection = 0;
-    std::chrono::system_clock::time_point activeStart;
-    int currentSpeed = 50; // начальная скорость по умолчанию
+    int64_t activeStartMs = 0;
     int activeSpeed = 50;
 
-    for (const auto &l: sessionLines) {
-        if (l.find("SPD:") != std::string::npos) {
-            int from, to;
-            if (sscanf(l.c_str(), "%*[^S]SPD:%d->%d", &from, &to) == 2) {
-                currentSpeed = to;
-                std::cout << "[RB] Speed changed to: " << currentSpeed << std::endl;
-            }
-            continue;
-        }
-
-        if (l.find("DIR:") != std::string::npos) {
-            int from, to;
-            if (sscanf(l.c_str(), "%*[^D]DIR:%d->%d", &from, &to) == 2) {
-                auto ts = parseTime(l);
-                
-                if (hasActiveMove && activeDirection != 0) {
-                    auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        ts - activeStart
-                    );
-
-                    if (dur.count() > 0) {
-                        moves.push_back({
-                            activeDirection,
-                            activeSpeed,
-                            activeStart,
-                            dur
-                        });
-                        std::cout << "[RB] Added move: dir=" << activeDirection 
-                                  << " speed=" << activeSpeed 
-                                  << " duration=" << dur.count() << "ms" << std::endl;
-                    }
-                }
-                
-                // Начало нового дыижения
-                if (to != 0) {
-                    activeDirection = to;
-                    activeStart = ts;
-                    activeSpeed = currentSpeed;
-                    hasActiveMove = true;
-                    std::cout << "[RB] Start move: dir=" << to << std::endl;
-                } else {
-                    hasActiveMove = false;
-                }
-            }
-            continue;
-        }
+    auto closeMove = [&](int64_t endMs) {
+        if (!hasActiveMove)
+            return;
+        hasActiveMove = false;
 
-        if (l.find("SYS:") != std::string::npos) {
-            continue;
-        }
-    }
-
-    if (hasActiveMove && activeDirection != 0) {
-        auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now() - activeStart
-        );
-        
+        std::chrono::milliseconds dur(endMs - activeStartMs);
         if (dur.count() > 0) {
             moves.push_back({
                 activeDirection,
                 activeSpeed,
-                activeStart,
+                activeStartMs,
                 dur
             });
-            std::cout << "[RB] Added final move: dir=" << activeDirection 
+            std::cout << "[RB] Added move: dir=" << activeDirection
+                      << " speed=" << activeSpeed
                       << " duration=" << dur.count() << "ms" << std::endl;
         }
+    };
+
+    for (auto r = range.first; r != range.second; ++r) {
+        // Начало сессии и собственные записи отката движением оператора не считаются
+        int direction = 0;
+        if (r->type == CommandJournal::STATE && !(r->flags & CommandJournal::FLAG_ROLLBACK))
+            direction = r->direction;
+
+        if (hasActiveMove && direction == activeDirection)
+            continue;  // изменилась только скорость или серво
+
+        // Первая запись может быть старше окна, движение обрезается по его началу
+        int64_t ts = std::max(r->timeMs, sinceMs);
+        closeMove(ts);
+
+        // Начало нового движения
+        if (direction != 0) {
+            activeDirection = direction;
+            activeStartMs = ts;
+            activeSpeed = r->speed;
+            hasActiveMove = true;
+            std::cout << "[RB] Start move: dir=" << direction << std::endl;
+        }
     }
 
+    closeMove(nowMs);
+
     if (moves.empty()) {
         std::cout << "[RB] No movements to rollback\n";
+        active = false;
         return;
     }
 
@@ -182,64 +180,54 @@ void RollbackExecutor::executeRollback() {
     }
 
     cmd.setRollbackMode(true);
+    rollingBack = true;
 
+    // Шаги планируются от начала отката, как шаги скрипта
+    auto at = TimerWheel::Clock::now();
     int lastAppliedSpeed = -1;
-    int executedCount = 0;
 
     // Движения в обратном порядке
     for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
-        if (cancel.load()) {
-            std::cout << "[RB] Rollback cancelled\n";
-            break;
-        }
-
         char invCmd = directionToInverseCommand(it->direction);
-        
+
         // Проверка поддержки обратной команды
         char checkInv;
-        if (!cmd.inverseCommand(directionToInverseCommand(it->direction), checkInv)) {
-            std::cerr << "[RB] No inverse for direction: " << it->direction 
+        if (!cmd.inverseCommand(invCmd, checkInv)) {
+            std::cerr << "[RB] No inverse for direction: " << it->direction
                       << " (cmd would be: " << invCmd << ")" << std::endl;
             continue;
         }
 
         if (it->speed != lastAppliedSpeed) {
-            std::cout << "[RB] Setting speed: " << it->speed << std::endl;
-            cmd.setSpeedDirect(it->speed);
-            lastAppliedSpeed = it->speed;
-            
-            usleep(100 * 1000); // 100 мс
+            int speed = it->speed;
+            timers.scheduleAt(at, [this, speed]() {
+                std::cout << "[RB] Setting speed: " << speed << std::endl;
+                cmd.setSpeedDirect(speed);
+            }, CommandProcessor::ROLLBACK_TIMERS);
+            lastAppliedSpeed = speed;
+            at += std::chrono::milliseconds(100);
         }
 
-        std::cout << "[RB] Executing #" << (++executedCount) << ": " 
-                  << "dir=" << it->direction << " -> inv_cmd=" << invCmd
-                  << " for " << it->duration.count() << " ms"
-                  << " at speed " << it->speed << std::endl;
+        LoggedMove move = *it;
+        timers.scheduleAt(at, [this, move, invCmd]() {
+            std::cout << "[RB] Executing #" << (++executedCount) << ": "
+                      << "dir=" << move.direction << " -> inv_cmd=" << invCmd
+                      << " for " << move.duration.count() << " ms"
+                      << " at speed " << move.speed << std::endl;
 
-        // Обратная команда
-        cmd.processCommand(invCmd);
+            // Обратная команда
+            cmd.processCommand(invCmd);
+        }, CommandProcessor::ROLLBACK_TIMERS);
+        at += move.duration;
 
-        int remaining = it->duration.count();
-        while (remaining > 0 && !cancel.load()) {
-            int chunk = (remaining > 100) ? 100 : remaining;
-            usleep(chunk * 1000);
-            remaining -= chunk;
-        }
-        
-        if (cancel.load()) {
-            std::cout << "[RB] Rollback cancelled during movement\n";
-            cmd.processCommand('n');
-            break;
-        }
-        
         // Останавка
-        cmd.processCommand('n');
-        
-        if (!cancel.load()) {
-            usleep(200 * 1000); // 200 мс
-        }
+        timers.scheduleAt(at, [this]() {
+            cmd.processCommand('n');
+        }, CommandProcessor::ROLLBACK_TIMERS);
+        at += std::chrono::milliseconds(200);
     }
 
-    cmd.setRollbackMode(false);
-    std::cout << "[RB] Rollback finished. Executed " << executedCount << " movements.\n";
+    timers.scheduleAt(at, [this]() {
+        finishRollback();
+    }, CommandProcessor::ROLLBACK_TIMERS);
 }
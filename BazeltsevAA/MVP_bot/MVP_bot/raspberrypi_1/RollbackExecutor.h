@@ -4,19 +4,34 @@
 #include "CommandProcessor.h"
 #include <string>
 #include <atomic>
+#include <chrono>
 
+// Ожидание и шаги отката выполняются по таймерам колеса CommandProcessor,
+// поэтому возврат оператора отменяет откат сразу, без опроса флага
 class RollbackExecutor {
 public:
     RollbackExecutor(CommandProcessor &c,
                      const std::string &path,
-                     std::atomic<bool> &cancelFlag);
-    
-    void executeRollback();
+                     std::chrono::seconds windowSec);
+    ~RollbackExecutor();
+
+    // Оператор потерян: через delay начинается откат
+    void scheduleRollback(std::chrono::seconds delay);
+    // Оператор вернулся: ожидание или откат прерываются, робот останавливается
+    void cancel();
 
 private:
+    void executeRollback();
+    void finishRollback();
+
     CommandProcessor &cmd;
-    std::string logPath;
-    std::atomic<bool> &cancel;
+    TimerWheel &timers;
+    std::string journalPath;
+    std::chrono::seconds window;
+
+    std::atomic<bool> active{false};       // ожидание или откат запланированы
+    std::atomic<bool> rollingBack{false};  // робот уже едет обратно
+    int executedCount = 0;
 };
 
 #endif
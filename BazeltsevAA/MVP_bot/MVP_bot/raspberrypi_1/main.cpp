@@ -9,11 +9,10 @@
 #include <iostream>
 #include <unistd.h>
 
-#include <atomic>
-#include <thread>
-
-std::atomic<bool> operatorConnected{false};
-std::atomic<bool> cancelRollback{false};
+// Откат повторяет в обратном порядке движения за последние N секунд сессии
+const int ROLLBACK_WINDOW_SEC = 60;
+// Через сколько секунд без оператора начинается откат
+const int ROLLBACK_DELAY_SEC = 10;
 
 int main() {
     std::string baseDir = std::getenv("HOME") + std::string("/MVP_log");
@@ -47,23 +46,23 @@ int main() {
     
     cmd.startSensorLogging(baseDir + "/sensors.log");
 
-    std::thread rollbackThread;
+    RollbackExecutor rollback(
+        cmd,
+        cmd.getJournalPath(),
+        std::chrono::seconds(ROLLBACK_WINDOW_SEC)
+    );
 
     while (true) {
         ConnectionInfo conn = wait_op_connection(controlServer, 5000, baseDir);
 
-        operatorConnected = true;
-        cancelRollback = true;   // отмена rollback
-
-        if (rollbackThread.joinable())
-            rollbackThread.join();
+        rollback.cancel();   // отмена rollback
 
         // heartbeat
-        Heartbeat hb(conn.socket_fd, 3);
+        Heartbeat hb(conn.socket_fd, cmd.getTimers(), CommandProcessor::HEARTBEAT_TIMERS, 3);
         hb.start();
         std::cout << "[CNT] Heartbeat started\n";
 
-        cmd.logSystemEvent("OPERATOR_CONNECTED");
+        cmd.beginSession();
 
         video.setOperator(conn.operator_ip);
         video.setSendingEnabled(true);
@@ -157,8 +156,6 @@ int main() {
         }
 
         // Потеря связи
-        operatorConnected = false;
-        cancelRollback = false;
 
         cmd.interruptScript();
         cmd.processCommand('n'); // остановка
@@ -176,37 +173,7 @@ int main() {
 
         std::cout << "[CNT] Operator lost\n";
 
-        rollbackThread = std::thread([&] {
-            auto lostTime = std::chrono::steady_clock::now();
-
-            while (true) {
-                usleep(1000 * 1000); // 1 сек
-
-                if (operatorConnected.load()) {
-                    std::cout << "[CNT] Operator reconnected, rollback cancelled\n";
-                    return;
-                }
-
-                auto now = std::chrono::steady_clock::now();
-                auto sec = std::chrono::duration_cast<std::chrono::seconds>(
-                    now - lostTime).count();
-
-                std::cout << "[CNT] Without operator " << sec << " sec\n";
-
-                if (sec >= 10) {
-                    std::cout << "[CNT] Starting rollback\n";
-
-                    RollbackExecutor rb(
-                        cmd,
-                        baseDir + "/commands.log",
-                        cancelRollback
-                    );
-
-                    rb.executeRollback();
-                    return;
-                }
-            }
-        });
+        rollback.scheduleRollback(std::chrono::seconds(ROLLBACK_DELAY_SEC));
     }
     
     return 0;
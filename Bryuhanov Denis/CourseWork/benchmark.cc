@@ -0,0 +1,108 @@
+#include <iostream>
+#include <chrono>
+#include "../../common/red_black_tree/Red-Black-Tree.h"
+
+#include <map>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Сравнение Tree (пул узлов, порядковые статистики) с std::map.
+// Запуск: benchmark [число ключей]
+
+template <typename Function>
+long long measure(Function function)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  function();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main(int argc, char **argv)
+{
+  int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++)
+    keys[i] = i;
+  std::mt19937 gen(1);
+  std::shuffle(keys.begin(), keys.end(), gen);
+
+  Tree t;
+  std::map<int, int> m;
+  long long checksum = 0;
+
+  std::cout << "Keys: " << n << std::endl;
+  std::cout << "Operation;Tree (us);std::map (us)" << std::endl;
+
+  long long treeTime = measure([&] {
+    for (int i = 0; i < n; i++)
+      t.insert(keys[i], keys[i]);
+  });
+  long long mapTime = measure([&] {
+    for (int i = 0; i < n; i++)
+      m[keys[i]] = keys[i];
+  });
+  std::cout << "Random insert;" << treeTime << ";" << mapTime << std::endl;
+
+  treeTime = measure([&] {
+    for (int i = 0; i < n; i++) {
+      int val;
+      if (t.search(keys[i], val))
+        checksum += val;
+    }
+  });
+  mapTime = measure([&] {
+    for (int i = 0; i < n; i++) {
+      auto it = m.find(keys[i]);
+      if (it != m.end())
+        checksum -= it->second;
+    }
+  });
+  std::cout << "Search;" << treeTime << ";" << mapTime << std::endl;
+
+  // rank/select у std::map - только через std::distance/std::next за O(n)
+  const int orderQueries = std::min(n, 100);
+  treeTime = measure([&] {
+    for (int i = 0; i < orderQueries; i++) {
+      int key = 0, val = 0;
+      t.select(keys[i], key, val);
+      checksum += t.rank(key);
+    }
+  });
+  mapTime = measure([&] {
+    for (int i = 0; i < orderQueries; i++) {
+      auto it = std::next(m.begin(), keys[i]);
+      checksum -= std::distance(m.begin(), m.lower_bound(it->first));
+    }
+  });
+  std::cout << "Rank+select x" << orderQueries << ";" << treeTime << ";" << mapTime << std::endl;
+
+  treeTime = measure([&] {
+    for (int i = 0; i < n; i += 2)
+      t.remove(keys[i]);
+  });
+  mapTime = measure([&] {
+    for (int i = 0; i < n; i += 2)
+      m.erase(keys[i]);
+  });
+  std::cout << "Remove half;" << treeTime << ";" << mapTime << std::endl;
+
+  treeTime = measure([&] { t.clear(); });
+  mapTime = measure([&] { m.clear(); });
+  std::cout << "Clear;" << treeTime << ";" << mapTime << std::endl;
+
+  std::vector<std::pair<int, int>> sorted(n);
+  for (int i = 0; i < n; i++)
+    sorted[i] = {i, i};
+  treeTime = measure([&] { t.buildFromSorted(sorted); });
+  mapTime = measure([&] { m = std::map<int, int>(sorted.begin(), sorted.end()); });
+  std::cout << "Bulk build from sorted;" << treeTime << ";" << mapTime << std::endl;
+
+  if (checksum != 0 || !t.isValid() || t.getSize() != (int)m.size()) {
+    std::cout << "Error: results differ" << std::endl;
+    return 1;
+  }
+  return 0;
+}
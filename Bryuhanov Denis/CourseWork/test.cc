@@ -1,7 +1,7 @@
 //#include <bits/stdc++.h>
 #include <iostream>
 #include <chrono> 
-#include "Red-Black-Tea.h"
+#include "../../common/red_black_tree/Red-Black-Tree.h"
 
 #include <vector>
 #include <unordered_set>
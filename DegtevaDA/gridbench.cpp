@@ -0,0 +1,153 @@
+#include <iostream>
+#include <queue>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "gridpath.h"
+
+// Сравнение прежнего astar (открытая сетка, поиск из (0,0) в (size-1,size-1))
+// с библиотекой gridpath и замеры на карте 4096x4096 с препятствиями.
+
+namespace old {
+
+const int MAX_SIZE = 1000;
+
+struct Cell {
+    int x, y;
+    int g, f;
+    bool operator>(const Cell& other) const {
+        return f > other.f;
+    }
+};
+
+int heuristic(int x1, int y1, int x2, int y2) {
+    return abs(x1 - x2) + abs(y1 - y2);
+}
+
+bool isValid(int x, int y, int size) {
+    return x >= 0 && x < size && y >= 0 && y < size;
+}
+
+static bool visited[MAX_SIZE][MAX_SIZE];
+
+void astar(int size) {
+    for (int i = 0; i < MAX_SIZE; i++)
+        for (int j = 0; j < MAX_SIZE; j++)
+            visited[i][j] = false;
+    std::priority_queue<Cell, std::vector<Cell>, std::greater<Cell>> open;
+
+    Cell start;
+    start.x = 0;
+    start.y = 0;
+    start.g = 0;
+    start.f = heuristic(0, 0, size - 1, size - 1);
+    open.push(start);
+
+    int dx[] = { -1, 1, 0, 0 };
+    int dy[] = { 0, 0, -1, 1 };
+
+    while (!open.empty()) {
+        Cell current = open.top();
+        open.pop();
+
+        int x = current.x, y = current.y;
+        if (visited[x][y]) continue;
+        visited[x][y] = true;
+
+        if (x == size - 1 && y == size - 1) return;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+
+            if (isValid(nx, ny, size) && !visited[nx][ny]) {
+                Cell next;
+                next.x = nx;
+                next.y = ny;
+                next.g = current.g + 1;
+                next.f = next.g + heuristic(nx, ny, size - 1, size - 1);
+                open.push(next);
+            }
+        }
+    }
+}
+
+} // namespace old
+
+template <typename Function>
+long long measure(Function function) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    function();
+    auto end_time = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+}
+
+// Карта занятости: случайные прямоугольные препятствия
+GridMap makeMap(int size, int obstacles, std::mt19937& rng) {
+    GridMap map(size, size);
+    std::uniform_int_distribution<int> coord(0, size - 1);
+    std::uniform_int_distribution<int> length(1, size / 16);
+    for (int i = 0; i < obstacles; i++) {
+        int x = coord(rng), y = coord(rng);
+        int w = length(rng), h = length(rng) / 32 + 1;
+        if (rng() % 2) std::swap(w, h);
+        for (int yy = y; yy < std::min(size, y + h); yy++)
+            for (int xx = x; xx < std::min(size, x + w); xx++)
+                map.setBlocked(xx, yy);
+    }
+    return map;
+}
+
+int main() {
+    std::cout << "Открытая сетка\n";
+    std::cout << "Размер;Прежний A* (мкс);A* (мкс);Двунаправленный (мкс);JPS (мкс)\n";
+    for (int size = 200; size <= 1000; size += 200) {
+        GridMap map(size, size);
+        GridPathFinder finder(map);
+        Point start = { 0, 0 }, goal = { size - 1, size - 1 };
+        std::cout << size << ";" << measure([&] { old::astar(size); })
+                  << ";" << measure([&] { finder.findPath(start, goal, SearchMode::AStar); })
+                  << ";" << measure([&] { finder.findPath(start, goal, SearchMode::Bidirectional); })
+                  << ";" << measure([&] { finder.findPath(start, goal, SearchMode::JumpPoint); }) << "\n";
+    }
+
+    const int size = 4096;
+    const int queries = 20;
+    std::mt19937 rng(7);
+    GridMap map = makeMap(size, 3000, rng);
+    GridPathFinder finder(map);
+    std::uniform_int_distribution<int> coord(0, size - 1);
+
+    std::cout << "\nКарта " << size << "x" << size << ", " << queries << " запросов\n";
+    std::cout << "Режим;Время (мкс);Раскрыто вершин;Найдено путей\n";
+
+    std::vector<std::pair<Point, Point>> tasks;
+    while ((int)tasks.size() < queries) {
+        Point a = { coord(rng), coord(rng) }, b = { coord(rng), coord(rng) };
+        if (map.isFree(a.x, a.y) && map.isFree(b.x, b.y)) tasks.push_back({ a, b });
+    }
+
+    const char* names[] = { "A*", "A* (8 соседей)", "Двунаправленный", "JPS" };
+    SearchMode modes[] = { SearchMode::AStar, SearchMode::AStarDiagonal, SearchMode::Bidirectional, SearchMode::JumpPoint };
+    std::vector<std::vector<int>> costs(4);
+    for (int m = 0; m < 4; m++) {
+        size_t expanded = 0;
+        int found = 0;
+        long long time = measure([&] {
+            for (const auto& task : tasks) {
+                PathResult result = finder.findPath(task.first, task.second, modes[m]);
+                costs[m].push_back(result.found ? result.cost : -1);
+                expanded += result.expanded;
+                found += result.found;
+            }
+        });
+        std::cout << names[m] << ";" << time << ";" << expanded << ";" << found << "\n";
+    }
+
+    if (costs[0] != costs[2] || costs[1] != costs[3]) {
+        std::cout << "Ошибка: стоимости путей не совпадают\n";
+        return 1;
+    }
+    return 0;
+}
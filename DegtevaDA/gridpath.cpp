@@ -0,0 +1,366 @@
+#include "gridpath.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+GridMap::GridMap(int width, int height) : width(width), height(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Размер карты должен быть положительным");
+    }
+    blocked.assign(((size_t)width * height + 63) / 64, 0);
+}
+
+void GridMap::setBlocked(int x, int y, bool value) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        throw std::out_of_range("Клетка вне карты");
+    }
+    size_t index = (size_t)y * width + x;
+    if (value) {
+        blocked[index >> 6] |= 1ULL << (index & 63);
+    } else {
+        blocked[index >> 6] &= ~(1ULL << (index & 63));
+    }
+}
+
+
+void BucketQueue::clear() {
+    // Очищаются только использованные корзины, память корзин сохраняется
+    for (size_t i = current; i <= last && i < buckets.size(); i++) {
+        buckets[i].clear();
+    }
+    current = 0;
+    last = 0;
+    count = 0;
+}
+
+void BucketQueue::push(int key, int value) {
+    if ((size_t)key >= buckets.size()) {
+        buckets.resize(key + 1);
+    }
+    if ((size_t)key < current) {
+        current = key;
+    }
+    if ((size_t)key > last) {
+        last = key;
+    }
+    buckets[key].push_back(value);
+    count++;
+}
+
+int BucketQueue::pop() {
+    while (buckets[current].empty()) {
+        current++;
+    }
+    int value = buckets[current].back();
+    buckets[current].pop_back();
+    count--;
+    return value;
+}
+
+
+// Октильное расстояние для 8 соседей: прямой шаг 10, диагональный 14
+static int octile(int x1, int y1, int x2, int y2) {
+    int dx = abs(x1 - x2), dy = abs(y1 - y2);
+    return 10 * std::max(dx, dy) + 4 * std::min(dx, dy);
+}
+
+static int manhattan(int x1, int y1, int x2, int y2) {
+    return abs(x1 - x2) + abs(y1 - y2);
+}
+
+static int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+
+GridPathFinder::GridPathFinder(const GridMap& map)
+    : map(map), width(map.getWidth()), height(map.getHeight()) {
+    size_t cells = (size_t)width * height;
+    seen.assign((cells + 63) / 64, 0);
+    closed.assign((cells + 63) / 64, 0);
+    g.assign(cells, 0);
+    parent.assign(cells, -1);
+}
+
+PathResult GridPathFinder::findPath(Point start, Point goal, SearchMode mode) {
+    if (!map.isFree(start.x, start.y) || !map.isFree(goal.x, goal.y)) {
+        return PathResult();
+    }
+
+    switch (mode) {
+    case SearchMode::AStar:
+        return searchAStar(start, goal, false);
+    case SearchMode::AStarDiagonal:
+        return searchAStar(start, goal, true);
+    case SearchMode::Bidirectional:
+        return searchBidirectional(start, goal);
+    case SearchMode::JumpPoint:
+        return searchJumpPoint(start, goal);
+    }
+    return PathResult();
+}
+
+std::vector<Point> GridPathFinder::buildPath(int goal) const {
+    // Соседние вершины цепочки parent могут быть точками прыжка,
+    // поэтому промежуточные клетки восстанавливаются по прямой
+    std::vector<Point> path;
+    for (int v = goal; v != -1; v = parent[v]) {
+        Point p = { v % width, v / width };
+        if (!path.empty()) {
+            Point q = path.back();
+            int dx = sign(p.x - q.x), dy = sign(p.y - q.y);
+            while (q.x + dx != p.x || q.y + dy != p.y) {
+                q.x += dx;
+                q.y += dy;
+                path.push_back(q);
+            }
+        }
+        path.push_back(p);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+
+PathResult GridPathFinder::searchAStar(Point start, Point goal, bool diagonal) {
+    static const int dx[] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+    static const int dy[] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+    const int directions = diagonal ? 8 : 4;
+
+    std::fill(seen.begin(), seen.end(), 0);
+    std::fill(closed.begin(), closed.end(), 0);
+    open.clear();
+
+    auto heuristic = [&](int x, int y) {
+        return diagonal ? octile(x, y, goal.x, goal.y) : manhattan(x, y, goal.x, goal.y);
+    };
+
+    PathResult result;
+    int s = indexOf(start.x, start.y);
+    int t = indexOf(goal.x, goal.y);
+    g[s] = 0;
+    parent[s] = -1;
+    setBit(seen, s);
+    open.push(heuristic(start.x, start.y), s);
+
+    while (!open.empty()) {
+        int v = open.pop();
+        if (testBit(closed, v)) continue;
+        setBit(closed, v);
+        result.expanded++;
+
+        if (v == t) {
+            result.found = true;
+            result.cost = g[v];
+            result.path = buildPath(t);
+            return result;
+        }
+
+        int x = v % width, y = v / width;
+        for (int i = 0; i < directions; i++) {
+            int nx = x + dx[i], ny = y + dy[i];
+            if (!map.isFree(nx, ny)) continue;
+            if (i >= 4 && (!map.isFree(nx, y) || !map.isFree(x, ny))) continue;
+
+            int u = indexOf(nx, ny);
+            if (testBit(closed, u)) continue;
+            int cost = g[v] + (diagonal ? (i >= 4 ? 14 : 10) : 1);
+            if (!testBit(seen, u) || cost < g[u]) {
+                setBit(seen, u);
+                g[u] = cost;
+                parent[u] = v;
+                open.push(cost + heuristic(nx, ny), u);
+            }
+        }
+    }
+    return result;
+}
+
+
+// Прыжок из (x, y) в направлении (dx, dy) до ближайшей точки прыжка:
+// цели, клетки с вынужденным соседом или (для диагонали) клетки,
+// из которой прямой прыжок находит точку прыжка. -1, если упёрлись в препятствие.
+int GridPathFinder::jump(int x, int y, int dx, int dy, int goal) const {
+    while (true) {
+        int nx = x + dx, ny = y + dy;
+        if (!map.isFree(nx, ny)) return -1;
+        if (dx != 0 && dy != 0 && (!map.isFree(nx, y) || !map.isFree(x, ny))) return -1;
+        x = nx;
+        y = ny;
+
+        int v = indexOf(x, y);
+        if (v == goal) return v;
+
+        if (dx != 0 && dy != 0) {
+            if (jump(x, y, dx, 0, goal) != -1 || jump(x, y, 0, dy, goal) != -1) return v;
+        } else if (dx != 0) {
+            if ((map.isFree(x, y - 1) && !map.isFree(x - dx, y - 1)) ||
+                (map.isFree(x, y + 1) && !map.isFree(x - dx, y + 1))) return v;
+        } else {
+            if ((map.isFree(x - 1, y) && !map.isFree(x - 1, y - dy)) ||
+                (map.isFree(x + 1, y) && !map.isFree(x + 1, y - dy))) return v;
+        }
+    }
+}
+
+PathResult GridPathFinder::searchJumpPoint(Point start, Point goal) {
+    std::fill(seen.begin(), seen.end(), 0);
+    std::fill(closed.begin(), closed.end(), 0);
+    open.clear();
+
+    PathResult result;
+    int s = indexOf(start.x, start.y);
+    int t = indexOf(goal.x, goal.y);
+    g[s] = 0;
+    parent[s] = -1;
+    setBit(seen, s);
+    open.push(octile(start.x, start.y, goal.x, goal.y), s);
+
+    int ndx[8], ndy[8];
+    while (!open.empty()) {
+        int v = open.pop();
+        if (testBit(closed, v)) continue;
+        setBit(closed, v);
+        result.expanded++;
+
+        if (v == t) {
+            result.found = true;
+            result.cost = g[v];
+            result.path = buildPath(t);
+            return result;
+        }
+
+        int x = v % width, y = v / width;
+        int count = 0;
+
+        // Отсечение соседей по направлению прихода
+        if (parent[v] == -1) {
+            for (int ddy = -1; ddy <= 1; ddy++) {
+                for (int ddx = -1; ddx <= 1; ddx++) {
+                    if (ddx != 0 || ddy != 0) {
+                        ndx[count] = ddx;
+                        ndy[count++] = ddy;
+                    }
+                }
+            }
+        } else {
+            int px = parent[v] % width, py = parent[v] / width;
+            int dx = sign(x - px), dy = sign(y - py);
+            if (dx != 0 && dy != 0) {
+                ndx[count] = 0; ndy[count++] = dy;
+                ndx[count] = dx; ndy[count++] = 0;
+                ndx[count] = dx; ndy[count++] = dy;
+            } else if (dx != 0) {
+                ndx[count] = dx; ndy[count++] = 0;
+                ndx[count] = dx; ndy[count++] = 1;
+                ndx[count] = dx; ndy[count++] = -1;
+                ndx[count] = 0; ndy[count++] = 1;
+                ndx[count] = 0; ndy[count++] = -1;
+            } else {
+                ndx[count] = 0; ndy[count++] = dy;
+                ndx[count] = 1; ndy[count++] = dy;
+                ndx[count] = -1; ndy[count++] = dy;
+                ndx[count] = 1; ndy[count++] = 0;
+                ndx[count] = -1; ndy[count++] = 0;
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            int u = jump(x, y, ndx[i], ndy[i], t);
+            if (u == -1 || testBit(closed, u)) continue;
+
+            int ux = u % width, uy = u / width;
+            int cost = g[v] + octile(x, y, ux, uy);
+            if (!testBit(seen, u) || cost < g[u]) {
+                setBit(seen, u);
+                g[u] = cost;
+                parent[u] = v;
+                open.push(cost + octile(ux, uy, goal.x, goal.y), u);
+            }
+        }
+    }
+    return result;
+}
+
+
+PathResult GridPathFinder::searchBidirectional(Point start, Point goal) {
+    static const int dx[] = { -1, 1, 0, 0 };
+    static const int dy[] = { 0, 0, -1, 1 };
+
+    if (gGoal.empty()) {
+        seenGoal.assign(seen.size(), 0);
+        gGoal.assign(g.size(), 0);
+        parentGoal.assign(parent.size(), -1);
+    }
+    std::fill(seen.begin(), seen.end(), 0);
+    std::fill(seenGoal.begin(), seenGoal.end(), 0);
+
+    PathResult result;
+    int s = indexOf(start.x, start.y);
+    int t = indexOf(goal.x, goal.y);
+    g[s] = 0;
+    parent[s] = -1;
+    setBit(seen, s);
+    gGoal[t] = 0;
+    parentGoal[t] = -1;
+    setBit(seenGoal, t);
+
+    frontier.assign(1, s);
+    frontierGoal.assign(1, t);
+    int best = -1, meetFrom = -1, meetTo = -1; // ребро meetFrom -> meetTo соединяет половины
+    if (s == t) {
+        best = 0;
+        meetFrom = meetTo = s;
+    }
+
+    // Поуровневый поиск: расширяется меньший фронт, уровень доводится до конца,
+    // после первого уровня с пересечением берётся лучшее из найденных соединений
+    while (best == -1 && !frontier.empty() && !frontierGoal.empty()) {
+        bool forward = frontier.size() <= frontierGoal.size();
+        std::vector<int>& current = forward ? frontier : frontierGoal;
+        std::vector<uint64_t>& mine = forward ? seen : seenGoal;
+        std::vector<uint64_t>& other = forward ? seenGoal : seen;
+        std::vector<int>& dist = forward ? g : gGoal;
+        std::vector<int>& otherDist = forward ? gGoal : g;
+        std::vector<int>& from = forward ? parent : parentGoal;
+
+        next.clear();
+        for (int v : current) {
+            result.expanded++;
+            int x = v % width, y = v / width;
+            for (int i = 0; i < 4; i++) {
+                int nx = x + dx[i], ny = y + dy[i];
+                if (!map.isFree(nx, ny)) continue;
+                int u = indexOf(nx, ny);
+                if (testBit(other, u)) {
+                    int length = dist[v] + 1 + otherDist[u];
+                    if (best == -1 || length < best) {
+                        best = length;
+                        meetFrom = forward ? v : u;
+                        meetTo = forward ? u : v;
+                    }
+                }
+                if (!testBit(mine, u)) {
+                    setBit(mine, u);
+                    dist[u] = dist[v] + 1;
+                    from[u] = v;
+                    next.push_back(u);
+                }
+            }
+        }
+        current.swap(next);
+    }
+
+    if (best == -1) return result;
+
+    result.found = true;
+    result.cost = best;
+    result.path = buildPath(meetFrom);
+    if (meetTo != meetFrom) {
+        for (int v = meetTo; v != -1; v = parentGoal[v]) {
+            result.path.push_back({ v % width, v / width });
+        }
+    }
+    return result;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Поиск пути на сетке с препятствиями.
+// Карта хранится битами (1 - препятствие), посещённые клетки - тоже битами.
+// Буферы поиска выделяются один раз и переиспользуются между запросами.
+
+struct Point {
+    int x, y;
+    bool operator==(const Point& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+enum class SearchMode {
+    AStar,          // A*, 4 соседа, шаг стоит 1, очередь Дейкстры-Дайла
+    AStarDiagonal,  // A*, 8 соседей, прямой шаг 10, диагональ 14, без срезания углов
+    Bidirectional,  // двунаправленный поиск в ширину, 4 соседа, шаг стоит 1
+    JumpPoint       // Jump Point Search, стоимости как у AStarDiagonal
+};
+
+struct PathResult {
+    bool found = false;
+    int cost = 0;
+    std::vector<Point> path;   // все клетки от старта до цели включительно
+    size_t expanded = 0;       // число раскрытых вершин
+};
+
+class GridMap {
+    int width, height;
+    std::vector<uint64_t> blocked;
+
+public:
+    GridMap(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    void setBlocked(int x, int y, bool value = true);
+
+    bool isFree(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return false;
+        size_t index = (size_t)y * width + x;
+        return !((blocked[index >> 6] >> (index & 63)) & 1);
+    }
+};
+
+// Очередь с приоритетами для целых ключей (корзины Дайла).
+// При монотонной эвристике ключи извлекаются в неубывающем порядке,
+// поэтому указатель на текущую корзину движется только вперёд.
+class BucketQueue {
+    std::vector<std::vector<int>> buckets;
+    size_t current = 0;
+    size_t last = 0;
+    size_t count = 0;
+
+public:
+    void clear();
+    void push(int key, int value);
+    int pop();
+    bool empty() const { return count == 0; }
+};
+
+class GridPathFinder {
+    const GridMap& map;
+    int width, height;
+
+    std::vector<uint64_t> seen, closed;     // биты: g известно / вершина раскрыта
+    std::vector<int> g, parent;
+    BucketQueue open;
+
+    // Для обратного направления двунаправленного поиска, выделяются при первом использовании
+    std::vector<uint64_t> seenGoal;
+    std::vector<int> gGoal, parentGoal;
+    std::vector<int> frontier, frontierGoal, next;
+
+    static bool testBit(const std::vector<uint64_t>& bits, int index) {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+    static void setBit(std::vector<uint64_t>& bits, int index) {
+        bits[index >> 6] |= 1ULL << (index & 63);
+    }
+
+    int indexOf(int x, int y) const { return y * width + x; }
+
+    PathResult searchAStar(Point start, Point goal, bool diagonal);
+    PathResult searchJumpPoint(Point start, Point goal);
+    PathResult searchBidirectional(Point start, Point goal);
+
+    int jump(int x, int y, int dx, int dy, int goal) const;
+    std::vector<Point> buildPath(int goal) const;
+
+public:
+    explicit GridPathFinder(const GridMap& map);
+
+    PathResult findPath(Point start, Point goal, SearchMode mode = SearchMode::AStar);
+};
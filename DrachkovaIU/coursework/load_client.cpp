@@ -0,0 +1,278 @@
+//Нагрузочный клиент для server_epoll.cpp. Имитирует множество пользователей, рассаженных по комнатам.
+//Сборка: g++ -O2 -std=c++17 load_client.cpp -o load_client
+//Запуск: ./load_client [пользователей] [в комнате] [период, мс] [длительность, с] [адрес] [порт]
+//
+//Каждый пользователь раз в период отправляет в свою комнату сообщение со временем отправки.
+//По времени получения считаются задержка доставки (p50/p99) и число доставленных сообщений в секунду.
+
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#define FrameHeaderLength 4
+#define MessageLength 64              //Длина тестового сообщения.
+#define MaxEvents 1024
+
+typedef std::chrono::steady_clock Clock;
+
+struct User
+{
+	int Fd = -1;
+	std::string ReadBuffer;
+	std::string WriteBuffer;
+	size_t WriteOffset = 0;
+	bool WantWrite = false;
+	bool Joined = false;
+};
+
+int EpollFd = -1;
+std::vector<User> Users;
+std::vector<int> UserByFd;
+std::vector<uint32_t> Latencies;      //Задержки доставки в микросекундах.
+size_t JoinedCount = 0;
+size_t DeliveredCount = 0;
+bool IsMeasuring = false;
+
+int64_t NowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void UpdateEpoll(User& u, bool WantWrite)
+{
+	if (u.WantWrite == WantWrite)
+		return;
+	epoll_event Event = {};
+	Event.events = WantWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+	Event.data.fd = u.Fd;
+	epoll_ctl(EpollFd, EPOLL_CTL_MOD, u.Fd, &Event);
+	u.WantWrite = WantWrite;
+}
+
+void Flush(User& u)
+{
+	while (u.WriteOffset < u.WriteBuffer.size())
+	{
+		ssize_t Written = send(u.Fd, u.WriteBuffer.data() + u.WriteOffset, u.WriteBuffer.size() - u.WriteOffset, MSG_NOSIGNAL);
+		if (Written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				UpdateEpoll(u, true);
+				return;
+			}
+			std::cout << "Error: send " << strerror(errno) << std::endl;
+			exit(1);
+		}
+		u.WriteOffset += Written;
+	}
+	u.WriteBuffer.clear();
+	u.WriteOffset = 0;
+	UpdateEpoll(u, false);
+}
+
+void SendFrame(User& u, const std::string& Message)
+{
+	uint32_t NetLength = htonl((uint32_t)Message.size());
+	u.WriteBuffer.append((const char*)&NetLength, FrameHeaderLength);
+	u.WriteBuffer.append(Message);
+	if (!u.WantWrite)
+		Flush(u);
+}
+
+void HandleFrame(User& u, const char* Text, size_t Length)
+{
+	if (Length > 0 && Text[0] == '#')                              //Тестовое сообщение: "#<время отправки в нс> ...".
+	{
+		int64_t SentNs = strtoll(Text + 1, NULL, 10);
+		if (IsMeasuring)
+		{
+			Latencies.push_back((uint32_t)((NowNs() - SentNs) / 1000));
+			DeliveredCount++;
+		}
+		return;
+	}
+	if (!u.Joined && Length > 12 && memcmp(Text, "Opened room:", 12) == 0)
+	{
+		u.Joined = true;
+		JoinedCount++;
+	}
+}
+
+void ReadFromServer(User& u)
+{
+	char Buffer[64 * 1024];
+	while (true)
+	{
+		ssize_t Received = recv(u.Fd, Buffer, sizeof(Buffer), 0);
+		if (Received > 0)
+		{
+			u.ReadBuffer.append(Buffer, Received);
+			continue;
+		}
+		if (Received < 0 && errno == EINTR)
+			continue;
+		if (Received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		std::cout << "Server disconnected" << std::endl;
+		exit(1);
+	}
+
+	size_t Position = 0;
+	while (u.ReadBuffer.size() - Position >= FrameHeaderLength)
+	{
+		uint32_t NetLength;
+		memcpy(&NetLength, u.ReadBuffer.data() + Position, FrameHeaderLength);
+		size_t Length = ntohl(NetLength);
+		if (u.ReadBuffer.size() - Position < FrameHeaderLength + Length)
+			break;
+		HandleFrame(u, u.ReadBuffer.data() + Position + FrameHeaderLength, Length);
+		Position += FrameHeaderLength + Length;
+	}
+	u.ReadBuffer.erase(0, Position);
+}
+
+void PollOnce(int TimeoutMs)
+{
+	epoll_event Events[MaxEvents];
+	int EventCount = epoll_wait(EpollFd, Events, MaxEvents, TimeoutMs);
+	for (int i = 0; i < EventCount; i++)
+	{
+		User& u = Users[UserByFd[Events[i].data.fd]];
+		if (Events[i].events & (EPOLLERR | EPOLLHUP))
+		{
+			std::cout << "Server disconnected" << std::endl;
+			exit(1);
+		}
+		if (Events[i].events & EPOLLIN)
+			ReadFromServer(u);
+		if (Events[i].events & EPOLLOUT)
+			Flush(u);
+	}
+}
+
+bool ConnectUser(User& u, sockaddr_in& addr)
+{
+	u.Fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (u.Fd < 0 || connect(u.Fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+	{
+		std::cout << "Error: failed connect to server. " << strerror(errno) << std::endl;
+		return false;
+	}
+	fcntl(u.Fd, F_SETFL, fcntl(u.Fd, F_GETFL) | O_NONBLOCK);
+	int Flag = 1;
+	setsockopt(u.Fd, IPPROTO_TCP, TCP_NODELAY, &Flag, sizeof(Flag));
+
+	epoll_event Event = {};
+	Event.events = EPOLLIN;
+	Event.data.fd = u.Fd;
+	epoll_ctl(EpollFd, EPOLL_CTL_ADD, u.Fd, &Event);
+
+	if ((size_t)u.Fd >= UserByFd.size())
+		UserByFd.resize(u.Fd + 1, -1);
+	return true;
+}
+
+uint32_t Percentile(std::vector<uint32_t>& Values, double P)
+{
+	if (Values.empty())
+		return 0;
+	size_t Index = std::min(Values.size() - 1, (size_t)(P * Values.size()));
+	std::nth_element(Values.begin(), Values.begin() + Index, Values.end());
+	return Values[Index];
+}
+
+int main(int argc, char* argv[])
+{
+	size_t UserCount = (argc > 1) ? atoi(argv[1]) : 10000;
+	size_t RoomSize = (argc > 2) ? atoi(argv[2]) : 10;
+	int PeriodMs = (argc > 3) ? atoi(argv[3]) : 1000;
+	int DurationSec = (argc > 4) ? atoi(argv[4]) : 10;
+	const char* Address = (argc > 5) ? argv[5] : "127.0.0.1";
+	int Port = (argc > 6) ? atoi(argv[6]) : 51111;
+	if (RoomSize == 0 || PeriodMs <= 0)
+	{
+		std::cout << "Error: room size and period must be positive" << std::endl;
+		return 1;
+	}
+
+	rlimit Limit;
+	if (getrlimit(RLIMIT_NOFILE, &Limit) == 0)
+	{
+		Limit.rlim_cur = Limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &Limit);
+		if (Limit.rlim_cur < UserCount + 16)
+			std::cout << "Warning: open file limit " << Limit.rlim_cur << " is too low" << std::endl;
+	}
+
+	sockaddr_in addr = {};
+	addr.sin_addr.s_addr = inet_addr(Address);
+	addr.sin_port = htons(Port);
+	addr.sin_family = AF_INET;
+
+	EpollFd = epoll_create1(EPOLL_CLOEXEC);
+	Users.resize(UserCount);
+
+	//Подключение и вход в комнаты. Каждый пользователь сначала пытается создать свою комнату,
+	//поэтому к моменту команды open комната уже существует.
+	for (size_t i = 0; i < UserCount; i++)
+	{
+		if (!ConnectUser(Users[i], addr))
+			return 1;
+		UserByFd[Users[i].Fd] = i;
+		std::string RoomName = "load" + std::to_string(i / RoomSize);
+		SendFrame(Users[i], "create " + RoomName + " pass");
+		SendFrame(Users[i], "open " + RoomName + " pass");
+		if (i % 256 == 0)
+			PollOnce(0);
+	}
+	while (JoinedCount < UserCount)
+		PollOnce(100);
+	std::cout << "Users joined: " << JoinedCount << ", rooms: " << (UserCount + RoomSize - 1) / RoomSize << std::endl;
+
+	//Отправка сообщений равномерно распределена по периоду.
+	std::string Padding(MessageLength, 'x');
+	Latencies.reserve((size_t)UserCount * RoomSize * DurationSec * 1000 / PeriodMs);
+	size_t SentCount = 0;
+	IsMeasuring = true;
+	Clock::time_point Start = Clock::now();
+	Clock::time_point Stop = Start + std::chrono::seconds(DurationSec);
+	while (Clock::now() < Stop)
+	{
+		double ElapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+		size_t Due = (size_t)(ElapsedMs * UserCount / PeriodMs);
+		for (; SentCount < Due; SentCount++)
+		{
+			std::string Message = "#" + std::to_string(NowNs()) + " ";
+			Message.append(Padding, 0, MessageLength - std::min(Message.size(), (size_t)MessageLength));
+			SendFrame(Users[SentCount % UserCount], Message);
+		}
+		PollOnce(1);
+	}
+	IsMeasuring = false;
+	double Seconds = std::chrono::duration<double>(Clock::now() - Start).count();
+
+	std::cout << "Sent:      " << SentCount << " (" << (size_t)(SentCount / Seconds) << " msg/s)" << std::endl;
+	std::cout << "Delivered: " << DeliveredCount << " (" << (size_t)(DeliveredCount / Seconds) << " msg/s)" << std::endl;
+	std::cout << "Latency p50: " << Percentile(Latencies, 0.50) << " us" << std::endl;
+	std::cout << "Latency p99: " << Percentile(Latencies, 0.99) << " us" << std::endl;
+
+	for (auto& u : Users)
+		close(u.Fd);
+	return 0;
+}
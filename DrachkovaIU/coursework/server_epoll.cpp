@@ -0,0 +1,468 @@
+//Linux-версия сервера чата на epoll. Один поток обслуживает все соединения.
+//Сборка: g++ -O2 -std=c++17 server_epoll.cpp -o server_epoll
+//Запуск: ./server_epoll [порт] [адрес]
+//
+//Протокол: каждое сообщение передаётся кадром "4 байта длины (big-endian) + текст".
+//Команды те же, что и у server.cpp (ls, create, remove, open, !exit).
+
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+#define MaxMessageLength 4096              //Максимальная длина текста в одном кадре.
+#define FrameHeaderLength 4                //Длина заголовка кадра (длина сообщения).
+#define MaxQueuedBytes (4 * 1024 * 1024)   //Если клиент не успевает забирать сообщения, он отключается.
+#define MaxEvents 1024
+#define MaxIovecs 64
+
+typedef std::shared_ptr<const std::string> Frame;   //Готовый кадр (заголовок + текст). Один буфер на всех получателей.
+
+struct Room           //Комната принимает имя и пароль (задаются при создании комнаты клиентом командой create)
+{
+	Room(std::string name, std::string password)
+	{
+		Name = name;
+		Password = password;
+	}
+	std::string Name;
+	std::string Password;
+	std::vector<int> Users;   //Дескрипторы сокетов пользователей комнаты.
+};
+
+struct Connection     //Состояние одного клиента.
+{
+	int Fd = -1;
+	std::string ReadBuffer;          //Принятые, но ещё не разобранные байты.
+	std::deque<Frame> WriteQueue;    //Очередь кадров на отправку.
+	size_t WriteOffset = 0;          //Сколько байт первого кадра очереди уже отправлено.
+	size_t QueuedBytes = 0;
+	std::string RoomName;            //Пустая строка - клиент не в комнате.
+	bool WantWrite = false;          //Подписан ли сокет на EPOLLOUT.
+	bool IsDirty = false;            //Есть новые кадры, которые нужно попробовать отправить.
+	bool IsClosing = false;
+};
+
+int EpollFd = -1;
+std::vector<std::unique_ptr<Connection>> Connections;   //Соединения по номеру дескриптора.
+std::unordered_map<std::string, Room> Rooms;             //Комнаты по имени.
+std::vector<int> DirtyConnections;                       //Клиенты, которым добавили кадры за текущую итерацию.
+std::vector<int> ClosingConnections;                     //Клиенты, которые будут закрыты в конце итерации.
+
+std::vector<std::string> Split(const std::string& StringToSplit, const std::string& SplitterString)
+{
+	std::vector<std::string> ReturnVector;
+	size_t Start = 0;
+	size_t Position;
+	while ((Position = StringToSplit.find(SplitterString, Start)) != std::string::npos)
+	{
+		ReturnVector.push_back(StringToSplit.substr(Start, Position - Start));
+		Start = Position + SplitterString.size();
+	}
+	ReturnVector.push_back(StringToSplit.substr(Start));
+	return ReturnVector;
+}
+
+void RemoveUserFromRoom(Room& room, int UserFd)      //Порядок пользователей в комнате не важен, поэтому удаляем обменом с последним.
+{
+	for (size_t i = 0; i < room.Users.size(); i++)
+	{
+		if (room.Users[i] == UserFd)
+		{
+			room.Users[i] = room.Users.back();
+			room.Users.pop_back();
+			return;
+		}
+	}
+}
+
+Frame MakeFrame(const char* Text, size_t Length)
+{
+	auto Buffer = std::make_shared<std::string>();
+	Buffer->resize(FrameHeaderLength + Length);
+	uint32_t NetLength = htonl((uint32_t)Length);
+	memcpy(&(*Buffer)[0], &NetLength, FrameHeaderLength);
+	memcpy(&(*Buffer)[FrameHeaderLength], Text, Length);
+	return Buffer;
+}
+
+void UpdateEpoll(Connection& c, bool WantWrite)
+{
+	if (c.WantWrite == WantWrite)
+		return;
+	epoll_event Event = {};
+	Event.events = WantWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+	Event.data.fd = c.Fd;
+	epoll_ctl(EpollFd, EPOLL_CTL_MOD, c.Fd, &Event);
+	c.WantWrite = WantWrite;
+}
+
+void MarkClosing(Connection& c)
+{
+	if (c.IsClosing)
+		return;
+	c.IsClosing = true;
+	ClosingConnections.push_back(c.Fd);
+}
+
+void QueueFrame(Connection& c, const Frame& frame)   //Ставит кадр в очередь. Сам send выполняется в конце итерации цикла.
+{
+	if (c.IsClosing)
+		return;
+	if (c.QueuedBytes + frame->size() > MaxQueuedBytes)
+	{
+		std::cout << "Client too slow, disconnecting. id: " << c.Fd << std::endl;
+		MarkClosing(c);
+		return;
+	}
+	c.WriteQueue.push_back(frame);
+	c.QueuedBytes += frame->size();
+	if (!c.IsDirty && !c.WantWrite)
+	{
+		c.IsDirty = true;
+		DirtyConnections.push_back(c.Fd);
+	}
+}
+
+void SendText(Connection& c, const std::string& Message)
+{
+	QueueFrame(c, MakeFrame(Message.data(), Message.size()));
+}
+
+void FlushWriteQueue(Connection& c)    //Отправляет сколько возможно одним writev, остаток ждёт EPOLLOUT.
+{
+	while (!c.WriteQueue.empty())
+	{
+		iovec Iov[MaxIovecs];
+		int IovCount = 0;
+		for (auto it = c.WriteQueue.begin(); it != c.WriteQueue.end() && IovCount < MaxIovecs; it++, IovCount++)
+		{
+			size_t Offset = (IovCount == 0) ? c.WriteOffset : 0;
+			Iov[IovCount].iov_base = (void*)((*it)->data() + Offset);
+			Iov[IovCount].iov_len = (*it)->size() - Offset;
+		}
+
+		ssize_t Written = writev(c.Fd, Iov, IovCount);
+		if (Written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				UpdateEpoll(c, true);
+				return;
+			}
+			MarkClosing(c);
+			return;
+		}
+
+		c.QueuedBytes -= Written;
+		size_t Left = Written;
+		while (Left > 0)
+		{
+			size_t Rest = c.WriteQueue.front()->size() - c.WriteOffset;
+			if (Left < Rest)
+			{
+				c.WriteOffset += Left;
+				break;
+			}
+			Left -= Rest;
+			c.WriteOffset = 0;
+			c.WriteQueue.pop_front();
+		}
+	}
+	UpdateEpoll(c, false);
+}
+
+void BroadcastToRoom(Room& room, int SenderFd, const char* Text, size_t Length)   //Один буфер кадра разделяется всеми получателями.
+{
+	Frame frame = MakeFrame(Text, Length);
+	for (int it : room.Users)
+	{
+		if (it != SenderFd)
+			QueueFrame(*Connections[it], frame);
+	}
+}
+
+void MessageHandler(Connection& c, const char* msg, size_t Length)    //Обработчик сообщений.
+{
+	if (c.RoomName.empty() == false)                                    //Если клиент находится в какой-то комнате.
+	{
+		auto RoomIt = Rooms.find(c.RoomName);
+		if (Length == 5 && memcmp(msg, "!exit", 5) == 0)                //Выход из комнаты.
+		{
+			if (RoomIt != Rooms.end())
+				RemoveUserFromRoom(RoomIt->second, c.Fd);
+			SendText(c, "Your exit room with name: " + c.RoomName);
+			c.RoomName.clear();
+			return;
+		}
+		if (RoomIt != Rooms.end())
+		{
+			BroadcastToRoom(RoomIt->second, c.Fd, msg, Length);
+			return;
+		}
+		c.RoomName.clear();                                             //Комнату удалили, пока клиент был в ней.
+	}
+
+	std::vector<std::string> MessageVector = Split(std::string(msg, Length), " ");
+	std::string Message;
+
+	if (MessageVector[0] == "ls")                                       //Показывает комнаты, которые уже созданы.
+	{
+		for (auto& it : Rooms)
+			SendText(c, it.first);
+		return;
+	}
+
+	if (MessageVector[0] == "create" || MessageVector[0] == "remove" || MessageVector[0] == "open")
+	{
+		if (MessageVector.size() < 3)                                   //Заданы не все параметры команды.
+		{
+			Message = "Wrong command. You have to specify room name and password\nCommand usage: " + MessageVector[0] + " room_name room_password";
+			SendText(c, Message);
+			return;
+		}
+	}
+
+	if (MessageVector[0] == "create")                                   //Создание новой комнаты.
+	{
+		Message = "You are created room: " + MessageVector[1];
+		if (Rooms.count(MessageVector[1]) != 0)
+			Message = "This room name alredy taken";
+		else
+			Rooms.emplace(MessageVector[1], Room(MessageVector[1], MessageVector[2]));
+		SendText(c, Message);
+		return;
+	}
+
+	if (MessageVector[0] == "remove")                                   //Удаление комнаты. Пользователи комнаты из неё выходят.
+	{
+		auto RoomIt = Rooms.find(MessageVector[1]);
+		if (RoomIt == Rooms.end())
+			Message = "Wrong name";
+		else if (RoomIt->second.Password != MessageVector[2])
+			Message = "Wrong password";
+		else
+		{
+			for (int it : RoomIt->second.Users)
+				Connections[it]->RoomName.clear();
+			Rooms.erase(RoomIt);
+			Message = "You are remove room: " + MessageVector[1];
+		}
+		SendText(c, Message);
+		return;
+	}
+
+	if (MessageVector[0] == "open")                                     //Присоединение к какой-то комнате.
+	{
+		auto RoomIt = Rooms.find(MessageVector[1]);
+		if (RoomIt == Rooms.end() || RoomIt->second.Password != MessageVector[2])
+		{
+			SendText(c, "Wrong room name or password");
+			return;
+		}
+		RoomIt->second.Users.push_back(c.Fd);
+		c.RoomName = MessageVector[1];
+		SendText(c, "Opened room: " + MessageVector[1]);
+		return;
+	}
+}
+
+void ReadFromClient(Connection& c)    //Читает всё доступное и разбирает полные кадры.
+{
+	char Buffer[64 * 1024];
+	bool PeerClosed = false;
+	while (true)
+	{
+		ssize_t Received = recv(c.Fd, Buffer, sizeof(Buffer), 0);
+		if (Received > 0)
+		{
+			c.ReadBuffer.append(Buffer, Received);
+			if ((size_t)Received < sizeof(Buffer))
+				break;
+			continue;
+		}
+		if (Received < 0 && errno == EINTR)
+			continue;
+		if (Received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		PeerClosed = true;              //Обрыв соединения: сначала разбираются уже пришедшие кадры.
+		break;
+	}
+
+	size_t Position = 0;
+	while (c.ReadBuffer.size() - Position >= FrameHeaderLength && !c.IsClosing)
+	{
+		uint32_t NetLength;
+		memcpy(&NetLength, c.ReadBuffer.data() + Position, FrameHeaderLength);
+		size_t Length = ntohl(NetLength);
+		if (Length > MaxMessageLength)
+		{
+			std::cout << "Too long message, disconnecting. id: " << c.Fd << std::endl;
+			MarkClosing(c);
+			return;
+		}
+		if (c.ReadBuffer.size() - Position < FrameHeaderLength + Length)
+			break;
+		MessageHandler(c, c.ReadBuffer.data() + Position + FrameHeaderLength, Length);
+		Position += FrameHeaderLength + Length;
+	}
+	c.ReadBuffer.erase(0, Position);
+	if (PeerClosed)
+		MarkClosing(c);
+}
+
+void AcceptClients(int ListenFd)
+{
+	while (true)
+	{
+		int Fd = accept4(ListenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (Fd < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				std::cout << "Error: Client connection failure. " << strerror(errno) << std::endl;
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+
+		int Flag = 1;
+		setsockopt(Fd, IPPROTO_TCP, TCP_NODELAY, &Flag, sizeof(Flag));
+
+		if ((size_t)Fd >= Connections.size())
+			Connections.resize(Fd + 1);
+		Connections[Fd].reset(new Connection());
+		Connections[Fd]->Fd = Fd;
+
+		epoll_event Event = {};
+		Event.events = EPOLLIN;
+		Event.data.fd = Fd;
+		epoll_ctl(EpollFd, EPOLL_CTL_ADD, Fd, &Event);
+
+		SendText(*Connections[Fd], "Welcome. You are connected to server.");   //Приветственное сообщение клиенту.
+	}
+}
+
+void CloseConnection(int Fd)
+{
+	Connection& c = *Connections[Fd];
+	if (c.RoomName.empty() == false)
+	{
+		auto RoomIt = Rooms.find(c.RoomName);
+		if (RoomIt != Rooms.end())
+			RemoveUserFromRoom(RoomIt->second, Fd);      //Удаление пользователя из комнаты.
+	}
+	epoll_ctl(EpollFd, EPOLL_CTL_DEL, Fd, NULL);
+	close(Fd);
+	Connections[Fd].reset();
+}
+
+void RaiseFileLimit()           //Для тысяч клиентов нужен большой лимит открытых дескрипторов.
+{
+	rlimit Limit;
+	if (getrlimit(RLIMIT_NOFILE, &Limit) == 0 && Limit.rlim_cur < Limit.rlim_max)
+	{
+		Limit.rlim_cur = Limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &Limit);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int Port = (argc > 1) ? atoi(argv[1]) : 51111;
+	const char* Address = (argc > 2) ? argv[2] : "127.0.0.1";
+
+	RaiseFileLimit();
+	signal(SIGPIPE, SIG_IGN);      //Обрыв соединения обрабатывается по коду ошибки writev.
+
+	sockaddr_in addr = {};
+	addr.sin_addr.s_addr = inet_addr(Address);
+	addr.sin_port = htons(Port);
+	addr.sin_family = AF_INET;
+
+	//Сокет для получения запросов на подключение.
+	int ListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	int Flag = 1;
+	setsockopt(ListenFd, SOL_SOCKET, SO_REUSEADDR, &Flag, sizeof(Flag));
+	if (bind(ListenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(ListenFd, SOMAXCONN) != 0)
+	{
+		std::cout << "Error: " << strerror(errno) << std::endl;
+		exit(1);
+	}
+
+	EpollFd = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event Event = {};
+	Event.events = EPOLLIN;
+	Event.data.fd = ListenFd;
+	epoll_ctl(EpollFd, EPOLL_CTL_ADD, ListenFd, &Event);
+
+	std::cout << "Server started on " << Address << ":" << Port << std::endl;
+
+	epoll_event Events[MaxEvents];
+	while (true)
+	{
+		int EventCount = epoll_wait(EpollFd, Events, MaxEvents, -1);
+		if (EventCount < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			std::cout << "Error: epoll_wait " << strerror(errno) << std::endl;
+			exit(1);
+		}
+
+		for (int i = 0; i < EventCount; i++)
+		{
+			int Fd = Events[i].data.fd;
+			if (Fd == ListenFd)
+			{
+				AcceptClients(ListenFd);
+				continue;
+			}
+
+			Connection* c = Connections[Fd].get();
+			if (c == NULL || c->IsClosing)
+				continue;
+			if (Events[i].events & (EPOLLERR | EPOLLHUP))
+			{
+				MarkClosing(*c);
+				continue;
+			}
+			if (Events[i].events & EPOLLIN)
+				ReadFromClient(*c);
+			if ((Events[i].events & EPOLLOUT) && !c->IsClosing)
+				FlushWriteQueue(*c);
+		}
+
+		//Все кадры, накопленные за итерацию, отправляются одним writev на клиента.
+		for (size_t i = 0; i < DirtyConnections.size(); i++)
+		{
+			Connection* c = Connections[DirtyConnections[i]].get();
+			if (c == NULL)
+				continue;
+			c->IsDirty = false;
+			if (!c->IsClosing)
+				FlushWriteQueue(*c);
+		}
+		DirtyConnections.clear();
+
+		for (int Fd : ClosingConnections)
+			CloseConnection(Fd);
+		ClosingConnections.clear();
+	}
+}
@@ -1,16 +1,18 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <array>
+#include <fstream>
+#include <iterator>
 #include <stdexcept>
 #include <chrono>
 
 class BoyerMooreHorspool 
 {
 private:
-    std::unordered_map<char, int> build_shift_table(const std::string& pattern) 
+    std::array<int, 256> build_shift_table(const std::string& pattern) 
     {
-        std::unordered_map<char, int> shift_table;
+        std::array<int, 256> shift_table;
         int pattern_length = pattern.length();
         
 
@@ -18,11 +20,10 @@ private:
             throw std::invalid_argument("Pattern cannot be empty");
         }
         
+        shift_table.fill(pattern_length);
         for (int i = 0; i < pattern_length - 1; i++) {
-            shift_table[pattern[i]] = pattern_length - 1 - i;
+            shift_table[static_cast<unsigned char>(pattern[i])] = pattern_length - 1 - i;
         }
-
-        shift_table[pattern[pattern_length - 1]] = pattern_length;
         
         return shift_table;
     }
@@ -37,11 +38,8 @@ private:
             throw std::runtime_error("Cannot open file");
         }
         
-        std::string content;
-        std::string line;
-        while (std::getline(file, line)) {
-            content += line + "\n";
-        }
+        // файл читается целиком одним блоком, без построчной конкатенации
+        std::string content(std::istreambuf_iterator<char>(file), {});
         file.close();
 
         if (content.empty()) {
@@ -81,7 +79,7 @@ private:
             throw std::invalid_argument("Pattern length longer than text length");
         }
 
-        std::unordered_map<char, int> shift_table = build_shift_table(pattern);
+        std::array<int, 256> shift_table = build_shift_table(pattern);
         
         int i = 0;
         while (i <= text_length - pattern_length) {
@@ -96,14 +94,8 @@ private:
                 occurrences.push_back(i);
                 i++;
             } else {
-                char mismatch_char = text[i + pattern_length - 1];
-                
-                int shift = pattern_length;
-                if (shift_table.find(mismatch_char) != shift_table.end()) {
-                    shift = shift_table[mismatch_char];
-                }
-                
-                i += shift;
+                unsigned char mismatch_char = text[i + pattern_length - 1];
+                i += shift_table[mismatch_char];
             }
         }
 
@@ -2,26 +2,28 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <iterator>
+#include <cstdint>
 #include <stdexcept>
 #include <chrono>
 
 class RabinKarp 
 {
 private:
-    const int base = 256;   // для ASCII
-    const int module = 101;  // Большое простое число
+    // Хеш считается по модулю 2^64 (естественное переполнение uint64_t):
+    // при модуле 101 почти каждое сотое окно давало ложное совпадение хеша.
+    const uint64_t base = 0x100000001b3ULL;  // нечётное, чтобы умножение было обратимо
     
 
-    int pow(int a, int b) const 
+    uint64_t pow(uint64_t a, int b) const 
     {
-        int result = 1;
-        a %= module;
+        uint64_t result = 1;
         
         while (b > 0) {
             if (b & 1) {
-                result = (result * a) % module;
+                result *= a;
             }
-            a = (a * a) % module;
+            a *= a;
             b >>= 1;
         }
         return result;
@@ -37,11 +39,8 @@ private:
             throw std::runtime_error("Cannot open file");
         }
         
-        std::string content;
-        std::string line;
-        while (std::getline(file, line)) {
-            content += line + "\n";
-        }
+        // файл читается целиком одним блоком, без построчной конкатенации
+        std::string content(std::istreambuf_iterator<char>(file), {});
         file.close();
 
         if (content.empty()) {
@@ -79,15 +78,15 @@ private:
             throw std::invalid_argument("Pattern length longer than text length");
         }        
 
-        int h = pow(base, m - 1);
+        uint64_t h = pow(base, m - 1);
         
 
-        int hash_pattern = 0;
-        int hash_text = 0;
+        uint64_t hash_pattern = 0;
+        uint64_t hash_text = 0;
         
         for (int i = 0; i < m; i++) {
-            hash_pattern = (base * hash_pattern + pattern[i]) % module;
-            hash_text = (base * hash_text + text[i]) % module;
+            hash_pattern = base * hash_pattern + static_cast<unsigned char>(pattern[i]);
+            hash_text = base * hash_text + static_cast<unsigned char>(text[i]);
         }
         
 
@@ -107,11 +106,8 @@ private:
             
 
             if (i < n - m) {
-                hash_text = (base * (hash_text - text[i] * h) + text[i + m]) % module;
-                
-                if (hash_text < 0) {
-                    hash_text += module;
-                }
+                hash_text = base * (hash_text - static_cast<unsigned char>(text[i]) * h)
+                            + static_cast<unsigned char>(text[i + m]);
             }
         }
         
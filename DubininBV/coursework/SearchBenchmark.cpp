@@ -0,0 +1,244 @@
+#include "TextSearch.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Сравнение поиска на больших (порядка ГБ) текстах:
+//   - прежние реализации (таблица сдвигов на unordered_map, Рабин-Карп по модулю 101,
+//     чтение файла построчно в std::string) - оставлены здесь только для сравнения;
+//   - Хорспул с таблицей на массиве, SIMD-предфильтр, многообразцовый Рабин-Карп
+//     с 64-битным хешем по отображённому в память файлу.
+//
+// Запуск: SearchBenchmark [файл] [размер в МБ]
+// Если файла нет, он генерируется из случайных слов.
+
+
+
+static size_t old_horspool_count(const char* text, size_t text_length, const std::string& pattern)
+{
+    std::unordered_map<char, int> shift_table;
+    int pattern_length = pattern.length();
+    for (int i = 0; i < pattern_length - 1; i++) {
+        shift_table[pattern[i]] = pattern_length - 1 - i;
+    }
+    shift_table[pattern[pattern_length - 1]] = pattern_length;
+
+    size_t count = 0;
+    size_t i = 0;
+    while (i + pattern_length <= text_length) {
+        int j = pattern_length - 1;
+        while (j >= 0 && text[i + j] == pattern[j]) {
+            j--;
+        }
+        if (j < 0) {
+            count++;
+            i++;
+        } else {
+            char mismatch_char = text[i + pattern_length - 1];
+            int shift = pattern_length;
+            if (shift_table.find(mismatch_char) != shift_table.end()) {
+                shift = shift_table[mismatch_char];
+            }
+            i += shift;
+        }
+    }
+    return count;
+}
+
+
+
+static size_t old_rabin_karp_count(const char* text, size_t text_length, const std::string& pattern,
+                                   size_t& spurious)
+{
+    const int base = 256;
+    const int module = 101;
+    int m = pattern.length();
+
+    int h = 1;
+    for (int i = 0; i < m - 1; i++) {
+        h = (h * base) % module;
+    }
+
+    int hash_pattern = 0;
+    int hash_text = 0;
+    for (int i = 0; i < m; i++) {
+        hash_pattern = (base * hash_pattern + pattern[i]) % module;
+        hash_text = (base * hash_text + text[i]) % module;
+    }
+
+    size_t count = 0;
+    spurious = 0;
+    for (size_t i = 0; i + m <= text_length; i++) {
+        if (hash_pattern == hash_text) {
+            if (pattern.compare(0, m, text + i, m) == 0) {
+                count++;
+            } else {
+                spurious++;
+            }
+        }
+        if (i + m < text_length) {
+            hash_text = (base * (hash_text - text[i] * h) + text[i + m]) % module;
+            if (hash_text < 0) {
+                hash_text += module;
+            }
+        }
+    }
+    return count;
+}
+
+
+
+static std::string old_read_file_content(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file");
+    }
+    std::string content;
+    std::string line;
+    while (std::getline(file, line)) {
+        content += line + "\n";
+    }
+    return content;
+}
+
+
+
+static void generate_corpus(const std::string& filename, size_t megabytes)
+{
+    static const char* words[] = {
+        "search", "pattern", "text", "string", "algorithm", "table", "shift", "hash",
+        "module", "window", "memory", "file", "course", "work", "result", "time",
+        "abc", "abd", "bca", "cab", "the", "and", "of", "to", "in", "is", "for", "on"
+    };
+    const size_t words_count = sizeof(words) / sizeof(words[0]);
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create corpus file");
+    }
+
+    std::mt19937 rng(1);
+    std::string buffer;
+    const size_t total = megabytes * 1024 * 1024;
+    size_t written = 0;
+    size_t line_length = 0;
+    while (written < total) {
+        buffer.clear();
+        while (buffer.size() < (1 << 20)) {
+            buffer += words[rng() % words_count];
+            line_length++;
+            buffer += (line_length % 12 == 0) ? '\n' : ' ';
+        }
+        file.write(buffer.data(), buffer.size());
+        written += buffer.size();
+    }
+}
+
+
+
+template <typename Function>
+static double measure(Function&& function)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    function();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+
+
+static void report(const std::string& name, double seconds, size_t bytes, size_t found)
+{
+    std::cout << name << ": " << seconds * 1000.0 << " мс, "
+              << bytes / seconds / 1e9 << " ГБ/с, найдено " << found << "\n";
+}
+
+
+
+int main(int argc, char** argv)
+{
+    const std::string filename = argc > 1 ? argv[1] : "corpus.txt";
+    const size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 1024;
+
+    try {
+        if (!std::ifstream(filename).good()) {
+            std::cout << "Генерация " << filename << " (" << megabytes << " МБ)\n";
+            generate_corpus(filename, megabytes);
+        }
+
+        double time = 0.0;
+        size_t content_length = 0;
+        time = measure([&] { content_length = old_read_file_content(filename).size(); });
+        report("Чтение построчно в std::string", time, content_length, 0);
+
+        MappedFile file(filename);
+        const char* text = file.data();
+        const size_t n = file.size();
+        size_t checksum = 0;
+        time = measure([&] {
+            for (size_t i = 0; i < n; i += 4096) {
+                checksum += text[i];
+            }
+        });
+        report("Отображение файла (первый проход)", time, n, checksum & 1);
+
+        const std::vector<std::string> patterns = {"abc", "pattern", "algorithm", "shift table", "hash module"};
+
+        std::cout << "\nОдин образец \"" << patterns[1] << "\"\n";
+        size_t found = 0, spurious = 0;
+        time = measure([&] { found = old_horspool_count(text, n, patterns[1]); });
+        report("Хорспул, unordered_map", time, n, found);
+
+        HorspoolSearcher horspool(patterns[1]);
+        time = measure([&] { found = 0; horspool.search(text, n, [&](size_t) { found++; }); });
+        report("Хорспул, массив", time, n, found);
+
+        SimdSearcher simd(patterns[1]);
+        time = measure([&] { found = 0; simd.search(text, n, [&](size_t) { found++; }); });
+        report("SIMD-предфильтр", time, n, found);
+
+        time = measure([&] { found = old_rabin_karp_count(text, n, patterns[1], spurious); });
+        report("Рабин-Карп, модуль 101", time, n, found);
+        std::cout << "  ложных совпадений хеша: " << spurious << "\n";
+
+        MultiPatternSearcher single({patterns[1]});
+        time = measure([&] { found = single.count(text, n)[0]; });
+        report("Рабин-Карп, 64-битный хеш", time, n, found);
+
+        std::cout << "\n" << patterns.size() << " образцов\n";
+        std::vector<size_t> separate(patterns.size(), 0);
+        time = measure([&] {
+            for (size_t id = 0; id < patterns.size(); id++) {
+                SimdSearcher searcher(patterns[id]);
+                searcher.search(text, n, [&](size_t) { separate[id]++; });
+            }
+        });
+        found = 0;
+        for (size_t c : separate) found += c;
+        report("SIMD, отдельный проход на образец", time, n, found);
+
+        MultiPatternSearcher multi(patterns);
+        std::vector<size_t> counts;
+        time = measure([&] { counts = multi.count(text, n); });
+        found = 0;
+        for (size_t c : counts) found += c;
+        report("Рабин-Карп, один проход", time, n, found);
+
+        if (counts != separate) {
+            std::cerr << "Error: results differ\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
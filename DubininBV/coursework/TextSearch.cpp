@@ -0,0 +1,147 @@
+#include "TextSearch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot stat file");
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        throw std::runtime_error("File is empty");
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // отображение остаётся действительным после закрытия дескриптора
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file");
+    }
+    madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+    data_ = static_cast<const char*>(addr);
+    size_ = st.st_size;
+}
+
+
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+
+
+HorspoolSearcher::HorspoolSearcher(const std::string& pattern) : pattern_(pattern)
+{
+    const size_t pattern_length = pattern.length();
+    if (pattern_length == 0) {
+        throw std::invalid_argument("Pattern cannot be empty");
+    }
+
+    // Сдвиг по умолчанию - длина образца; последний символ образца в таблицу не входит,
+    // иначе после совпадения по последнему символу сдвиг был бы нулевым.
+    shift_table_.fill(pattern_length);
+    for (size_t i = 0; i < pattern_length - 1; i++) {
+        shift_table_[static_cast<unsigned char>(pattern[i])] = pattern_length - 1 - i;
+    }
+}
+
+
+
+SimdSearcher::SimdSearcher(const std::string& pattern) : pattern_(pattern)
+{
+    if (pattern.empty()) {
+        throw std::invalid_argument("Pattern cannot be empty");
+    }
+}
+
+
+
+uint64_t MultiPatternSearcher::hash(const char* str, size_t length)
+{
+    uint64_t h = 0;
+    for (size_t i = 0; i < length; i++) {
+        h = h * base + static_cast<unsigned char>(str[i]);
+    }
+    return h;
+}
+
+
+
+MultiPatternSearcher::MultiPatternSearcher(const std::vector<std::string>& patterns) : patterns_(patterns)
+{
+    if (patterns.empty()) {
+        throw std::invalid_argument("Pattern list is empty");
+    }
+
+    window_ = patterns[0].length();
+    for (const std::string& pattern : patterns) {
+        if (pattern.empty()) {
+            throw std::invalid_argument("Pattern cannot be empty");
+        }
+        window_ = std::min(window_, pattern.length());
+    }
+    for (size_t i = 1; i < window_; i++) {
+        power_ *= base;
+    }
+
+    std::vector<std::pair<uint64_t, size_t>> entries;
+    for (size_t id = 0; id < patterns.size(); id++) {
+        entries.push_back({hash(patterns[id].data(), window_), id});
+    }
+    std::sort(entries.begin(), entries.end());
+
+    filter_.assign(filter_bits / 64, 0);
+    for (const auto& entry : entries) {
+        hashes_.push_back(entry.first);
+        pattern_ids_.push_back(entry.second);
+        const size_t idx = filter_index(entry.first);
+        filter_[idx >> 6] |= 1ULL << (idx & 63);
+    }
+
+    for (size_t id = 0; id < patterns.size(); id++) {
+        const uint8_t group = 1 << (id % 8);
+        const unsigned char first = patterns[id][0];
+        const unsigned char last = patterns[id][window_ - 1];
+        first_low_[first & 15] |= group;
+        first_high_[first >> 4] |= group;
+        last_low_[last & 15] |= group;
+        last_high_[last >> 4] |= group;
+    }
+}
+
+
+
+bool MultiPatternSearcher::is_candidate(const char* window) const
+{
+    const unsigned char first = window[0];
+    const unsigned char last = window[window_ - 1];
+    return (first_low_[first & 15] & first_high_[first >> 4] & last_low_[last & 15] & last_high_[last >> 4]) != 0;
+}
+
+
+
+std::vector<size_t> MultiPatternSearcher::count(const char* text, size_t text_length) const
+{
+    std::vector<size_t> counts(patterns_.size(), 0);
+    search(text, text_length, [&counts](size_t pattern_id, size_t) { counts[pattern_id]++; });
+    return counts;
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+
+// Отображение файла в память только для чтения. Файл не копируется в std::string,
+// страницы подгружаются ядром по мере прохода (MADV_SEQUENTIAL).
+class MappedFile
+{
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+
+
+// Поиск одного образца: Бойер-Мур-Хорспул с таблицей сдвигов на массиве
+class HorspoolSearcher
+{
+private:
+    std::string pattern_;
+    std::array<size_t, 256> shift_table_;
+
+public:
+    explicit HorspoolSearcher(const std::string& pattern);
+
+    template <typename Callback>
+    void search(const char* text, size_t text_length, Callback&& on_match) const;
+};
+
+
+
+// Поиск одного образца с SIMD-предфильтром по первому и последнему байту:
+// за одну итерацию проверяются 16 (SSE2) или 32 (AVX2) позиций,
+// полное сравнение выполняется только для кандидатов.
+class SimdSearcher
+{
+private:
+    std::string pattern_;
+
+public:
+    explicit SimdSearcher(const std::string& pattern);
+
+    template <typename Callback>
+    void search(const char* text, size_t text_length, Callback&& on_match) const;
+};
+
+
+
+// Поиск нескольких образцов за один проход: Рабин-Карп с 64-битным
+// полиномиальным хешем (по модулю 2^64). Хеш считается по окну длины самого
+// короткого образца, поэтому на байт текста приходится одно умножение
+// независимо от числа образцов; совпавший хеш префикса проверяется битовым
+// фильтром, затем двоичным поиском и полным сравнением.
+//
+// При наличии SSSE3 скользящий хеш не нужен: позиции отсеиваются по первому
+// и последнему байту окна (таблицы по полубайтам через pshufb, образцы
+// разложены по 8 группам), хеш считается только для кандидатов.
+class MultiPatternSearcher
+{
+private:
+    static constexpr uint64_t base = 0x100000001b3ULL;  // нечётное, чтобы умножение было обратимо
+    static constexpr size_t filter_bits = 1 << 16;
+
+    std::vector<std::string> patterns_;
+    size_t window_ = 0;                 // длина самого короткого образца
+    uint64_t power_ = 1;                // base^(window_ - 1)
+    std::vector<uint64_t> hashes_;      // хеши префиксов длины window_, отсортированы
+    std::vector<size_t> pattern_ids_;   // в том же порядке, что и hashes_
+    std::vector<uint64_t> filter_;      // битовый фильтр по перемешанному хешу
+
+    // Для каждого полубайта - маска групп образцов, у которых он встречается
+    // в первом (first) или последнем (last) байте окна
+    alignas(16) uint8_t first_low_[16] = {};
+    alignas(16) uint8_t first_high_[16] = {};
+    alignas(16) uint8_t last_low_[16] = {};
+    alignas(16) uint8_t last_high_[16] = {};
+
+    static uint64_t hash(const char* str, size_t length);
+    static size_t filter_index(uint64_t h) { return (h * 0x9e3779b97f4a7c15ULL) >> 48; }
+
+    bool is_candidate(const char* window) const;
+
+    template <typename Callback>
+    void check(uint64_t h, const char* text, size_t text_length, size_t pos, Callback& on_match) const;
+
+public:
+    explicit MultiPatternSearcher(const std::vector<std::string>& patterns);
+
+    const std::vector<std::string>& patterns() const { return patterns_; }
+
+    template <typename Callback>
+    void search(const char* text, size_t text_length, Callback&& on_match) const;
+
+    // Количество вхождений каждого образца, индекс совпадает с индексом в patterns()
+    std::vector<size_t> count(const char* text, size_t text_length) const;
+};
+
+
+
+template <typename Callback>
+void HorspoolSearcher::search(const char* text, size_t text_length, Callback&& on_match) const
+{
+    const size_t pattern_length = pattern_.length();
+    if (pattern_length > text_length) {
+        return;
+    }
+
+    const char* pattern = pattern_.data();
+    const unsigned char last = pattern[pattern_length - 1];
+    size_t i = 0;
+    while (i <= text_length - pattern_length) {
+        const unsigned char c = text[i + pattern_length - 1];
+        if (c == last) {
+            size_t j = pattern_length - 1;
+            while (j > 0 && text[i + j - 1] == pattern[j - 1]) {
+                j--;
+            }
+            if (j == 0) {
+                on_match(i);
+            }
+        }
+        i += shift_table_[c];
+    }
+}
+
+
+
+template <typename Callback>
+void MultiPatternSearcher::check(uint64_t h, const char* text, size_t text_length, size_t pos,
+                                 Callback& on_match) const
+{
+    const size_t idx = filter_index(h);
+    if (!(filter_[idx >> 6] & (1ULL << (idx & 63)))) {
+        return;
+    }
+
+    auto it = std::lower_bound(hashes_.begin(), hashes_.end(), h);
+    for (; it != hashes_.end() && *it == h; ++it) {
+        const size_t pattern_id = pattern_ids_[it - hashes_.begin()];
+        const std::string& pattern = patterns_[pattern_id];
+        if (pos + pattern.length() <= text_length
+            && std::memcmp(text + pos, pattern.data(), pattern.length()) == 0) {
+            on_match(pattern_id, pos);
+        }
+    }
+}
+
+
+
+template <typename Callback>
+void MultiPatternSearcher::search(const char* text, size_t text_length, Callback&& on_match) const
+{
+    if (window_ > text_length) {
+        return;
+    }
+
+    const size_t last_pos = text_length - window_;
+    size_t pos = 0;
+
+#if defined(__SSSE3__)
+    const __m128i low_nibble = _mm_set1_epi8(0x0f);
+    const __m128i first_low = _mm_load_si128(reinterpret_cast<const __m128i*>(first_low_));
+    const __m128i first_high = _mm_load_si128(reinterpret_cast<const __m128i*>(first_high_));
+    const __m128i last_low = _mm_load_si128(reinterpret_cast<const __m128i*>(last_low_));
+    const __m128i last_high = _mm_load_si128(reinterpret_cast<const __m128i*>(last_high_));
+
+    for (; pos + 16 <= last_pos + 1; pos += 16) {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos));
+        const __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + window_ - 1));
+        const __m128i first_groups = _mm_and_si128(
+            _mm_shuffle_epi8(first_low, _mm_and_si128(first, low_nibble)),
+            _mm_shuffle_epi8(first_high, _mm_and_si128(_mm_srli_epi16(first, 4), low_nibble)));
+        const __m128i last_groups = _mm_and_si128(
+            _mm_shuffle_epi8(last_low, _mm_and_si128(last, low_nibble)),
+            _mm_shuffle_epi8(last_high, _mm_and_si128(_mm_srli_epi16(last, 4), low_nibble)));
+        const __m128i groups = _mm_and_si128(first_groups, last_groups);
+        uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(groups, _mm_setzero_si128())) & 0xffff;
+        while (mask != 0) {
+            const size_t bit = __builtin_ctz(mask);
+            check(hash(text + pos + bit, window_), text, text_length, pos + bit, on_match);
+            mask &= mask - 1;
+        }
+    }
+
+    for (; pos <= last_pos; pos++) {
+        if (is_candidate(text + pos)) {
+            check(hash(text + pos, window_), text, text_length, pos, on_match);
+        }
+    }
+#else
+    uint64_t h = hash(text, window_);
+    for (;; pos++) {
+        check(h, text, text_length, pos, on_match);
+        if (pos == last_pos) {
+            break;
+        }
+        h = (h - static_cast<unsigned char>(text[pos]) * power_) * base
+            + static_cast<unsigned char>(text[pos + window_]);
+    }
+#endif
+}
+
+
+
+template <typename Callback>
+void SimdSearcher::search(const char* text, size_t text_length, Callback&& on_match) const
+{
+    const size_t pattern_length = pattern_.length();
+    if (pattern_length > text_length) {
+        return;
+    }
+
+    const char* pattern = pattern_.data();
+    const size_t last_pos = text_length - pattern_length;  // последняя допустимая позиция
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last = _mm256_set1_epi8(pattern[pattern_length - 1]);
+    for (; i + 32 <= last_pos + 1; i += 32) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        const __m256i block_last = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(text + i + pattern_length - 1));
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)));
+        while (mask != 0) {
+            const size_t bit = __builtin_ctz(mask);
+            if (std::memcmp(text + i + bit + 1, pattern + 1, pattern_length > 2 ? pattern_length - 2 : 0) == 0) {
+                on_match(i + bit);
+            }
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last = _mm_set1_epi8(pattern[pattern_length - 1]);
+    for (; i + 16 <= last_pos + 1; i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        const __m128i block_last = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(text + i + pattern_length - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+        while (mask != 0) {
+            const size_t bit = __builtin_ctz(mask);
+            if (std::memcmp(text + i + bit + 1, pattern + 1, pattern_length > 2 ? pattern_length - 2 : 0) == 0) {
+                on_match(i + bit);
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // хвост (и вся работа на платформах без SSE2)
+    for (; i <= last_pos; i++) {
+        if (text[i] == pattern[0] && text[i + pattern_length - 1] == pattern[pattern_length - 1]
+            && std::memcmp(text + i, pattern, pattern_length) == 0) {
+            on_match(i);
+        }
+    }
+}
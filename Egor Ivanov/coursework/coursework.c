@@ -3,144 +3,44 @@
 #include <ctime>
 #include <cstdlib>
 
-std::vector<int> t;
-int n;
+#include "../../common/fenwick/fenwick.hpp"
 
-void init(int nn) {
-    n = nn;
-    t.assign(n, 0);
-}
+// Замеры запросов суммы на отрезке для дерева Фенвика из fenwick.hpp.
+// Сравнение с деревом отрезков и прежней версией на глобальных массивах - fenwick_benchmark.cpp
 
-int sum(int right) {
-    int result = 0;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result += t[right];
-    return result;
-}
+int main(int argc, char** argv) {
+    unsigned long int k = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100 * 1000 * 1000;
+    clock_t start, end;
 
-void inc(int idx, int delta) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] += delta;
-}
+    std::vector<long long> a(k);
+    for (unsigned long int i = 0; i < k; ++i) {
+        a[i] = i;
+    }
 
-int sum(int left, int right) {
-    return sum(right) - sum(left - 1);
-}
+    start = clock();
+    FenwickTree<long long> tree(a);
+    end = clock();
+    printf("Build time %.4f\n", ((double)end - start) / ((double)CLOCKS_PER_SEC));
 
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) inc(idx, a[idx]);
-}
+    for (int n = 1; n < 20; n += 1) {
+        unsigned long int left = rand() % k;
+        unsigned long int right = rand() % k;
 
-int main() {
-    unsigned long int k = 1000 * 1000 * 1000;
-        clock_t start, end;
-        init(k);
-
-        for (unsigned long int i = 0; i < k; ++i) {
-            inc(i, i); 
+        if (left > right) {
+            std::swap(left, right);
         }
 
-        for (int n = 1; n < 20; n += 1) {
-            unsigned long int left = rand() % k;
-            unsigned long int right = rand() % k;
-
-            if (left > right) {
-                std::swap(left, right);
-            }
-
         start = clock();
-        sum(left, right); 
+        long long result = tree.query(left, right);
         end = clock();
 
         printf("Time %.7f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", left- right);
+        printf("Elements %lu Sum %lld\n", right - left + 1, result);
     }
-}
-
 
-/*
-#include <iostream>
-#include <algorithm>
-#include <vector>
-
-std:: vector<int> t;
-int n;
-
-const int INF = 1000 * 1000 * 1000;
-
-void init(int nn) {
-    n = nn;
-    t.assign(n, INF);
-}
-
-int getmin(int right) {
-    int result = INF;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result = std::min(result, t[right]);
-    return result;
+    // Минимум и максимум на префиксе - тот же класс с другой операцией
+    FenwickTree<int, MinOp<int>> minimum(std::vector<int>{ 5, 3, 8, 1, 9 });
+    FenwickTree<int, MaxOp<int>> maximum(std::vector<int>{ 5, 3, 8, 1, 9 });
+    minimum.update(2, 0);
+    printf("Min %d Max %d\n", minimum.prefix(4), maximum.prefix(4));
 }
-
-void update(int idx, int new_val) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] = std::min(t[idx], new_val);
-}
-
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) update(idx, a[idx]);
-}
-
-int main() {
-    for (int k = 1;k < 1000 * 1000 * 1000 * 100;k *= 10) {
-        clock_t start, end;
-        start = clock();
-        init(k);
-        for (int i = 0; i < k; i++) { update(i, i); }
-        getmin(k - 1);
-        end = clock();
-        printf("Time %.4f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", k);
-    }
-}
-*/
-
-
-/*
-#include <iostream>
-#include <algorithm>
-#include <vector>
-
-std::vector<int> t;
-int n;
-
-const int INF = -1000 * 1000 * 1000;
-
-void init(int nn) {
-    n = nn;
-    t.assign(n, INF);
-}
-
-int getmax(int right) {
-    int result = INF;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result = std::max(result, t[right]);
-    return result;
-}
-
-void update(int idx, int new_val) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] = std::max(t[idx], new_val);
-}
-
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) update(idx, a[idx]);
-}
-
-int main() {
-    for (int k = 1;k < 1000 * 1000 * 1000 * 100;k *= 10) {
-        clock_t start, end;
-        start = clock();
-        init(k);
-        for (int i = 0; i < k; i++) { update(i, i); }
-        getmax(k - 1);
-        end = clock();
-        printf("Time %.4f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", k);
-    }
-*/
\ No newline at end of file
@@ -0,0 +1,266 @@
+﻿#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include "../../common/fenwick/fenwick.hpp"
+
+// Сравнение FenwickTree / RangeFenwick / Fenwick2D с деревьями отрезков
+// и с прежней версией из coursework.c (глобальные t, n и построение через n вызовов inc).
+// Запуск: fenwick_benchmark [размер массива]
+
+namespace old {
+
+std::vector<long long> t;
+int n;
+
+void init(int nn) {
+    n = nn;
+    t.assign(n, 0);
+}
+
+long long sum(int right) {
+    long long result = 0;
+    for (; right >= 0; right = (right & (right + 1)) - 1) result += t[right];
+    return result;
+}
+
+void inc(int idx, long long delta) {
+    for (; idx < n; idx = (idx | (idx + 1))) t[idx] += delta;
+}
+
+long long sum(int left, int right) {
+    return sum(right) - sum(left - 1);
+}
+
+void init(const std::vector<long long>& a) {
+    init((int)a.size());
+    for (unsigned idx = 0; idx < a.size(); idx++) inc(idx, a[idx]);
+}
+
+} // namespace old
+
+
+// Дерево отрезков снизу вверх: листья в t[n..2n), сумма на отрезке без рекурсии
+class SegmentTree
+{
+private:
+    size_t n;
+    std::vector<long long> t;
+
+public:
+    explicit SegmentTree(const std::vector<long long>& a) : n(a.size()), t(2 * a.size()) {
+        std::copy(a.begin(), a.end(), t.begin() + n);
+        for (size_t i = n - 1; i > 0; i--) t[i] = t[2 * i] + t[2 * i + 1];
+    }
+
+    void add(size_t idx, long long delta) {
+        for (idx += n; idx > 0; idx >>= 1) t[idx] += delta;
+    }
+
+    long long query(size_t left, size_t right) const {
+        long long result = 0;
+        for (left += n, right += n + 1; left < right; left >>= 1, right >>= 1) {
+            if (left & 1) result += t[left++];
+            if (right & 1) result += t[--right];
+        }
+        return result;
+    }
+};
+
+
+// Дерево отрезков с отложенными прибавлениями для сравнения с RangeFenwick
+class LazySegmentTree
+{
+private:
+    size_t n;
+    std::vector<long long> sum, lazy;
+
+    void build(const std::vector<long long>& a, size_t v, size_t l, size_t r) {
+        if (l == r) {
+            sum[v] = a[l];
+            return;
+        }
+        size_t m = (l + r) / 2;
+        build(a, 2 * v, l, m);
+        build(a, 2 * v + 1, m + 1, r);
+        sum[v] = sum[2 * v] + sum[2 * v + 1];
+    }
+
+    void push(size_t v, size_t l, size_t m, size_t r) {
+        if (lazy[v] == 0) return;
+        sum[2 * v] += lazy[v] * (long long)(m - l + 1);
+        lazy[2 * v] += lazy[v];
+        sum[2 * v + 1] += lazy[v] * (long long)(r - m);
+        lazy[2 * v + 1] += lazy[v];
+        lazy[v] = 0;
+    }
+
+    void add(size_t v, size_t l, size_t r, size_t ql, size_t qr, long long x) {
+        if (qr < l || r < ql) return;
+        if (ql <= l && r <= qr) {
+            sum[v] += x * (long long)(r - l + 1);
+            lazy[v] += x;
+            return;
+        }
+        size_t m = (l + r) / 2;
+        push(v, l, m, r);
+        add(2 * v, l, m, ql, qr, x);
+        add(2 * v + 1, m + 1, r, ql, qr, x);
+        sum[v] = sum[2 * v] + sum[2 * v + 1];
+    }
+
+    long long query(size_t v, size_t l, size_t r, size_t ql, size_t qr) {
+        if (qr < l || r < ql) return 0;
+        if (ql <= l && r <= qr) return sum[v];
+        size_t m = (l + r) / 2;
+        push(v, l, m, r);
+        return query(2 * v, l, m, ql, qr) + query(2 * v + 1, m + 1, r, ql, qr);
+    }
+
+public:
+    explicit LazySegmentTree(const std::vector<long long>& a) : n(a.size()), sum(4 * a.size()), lazy(4 * a.size()) {
+        build(a, 1, 0, n - 1);
+    }
+
+    void add(size_t left, size_t right, long long x) { add(1, 0, n - 1, left, right, x); }
+    long long query(size_t left, size_t right) { return query(1, 0, n - 1, left, right); }
+};
+
+
+template <typename Function>
+long long measure(Function function) {
+    auto start = std::chrono::high_resolution_clock::now();
+    function();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void print_row(const char* name, long long fenwick, long long other) {
+    printf("%-36s %12lld %12lld\n", name, fenwick, other);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1 << 22;
+    if (n < 2) {
+        printf("Size must be at least 2\n");
+        return 1;
+    }
+
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<size_t> index(0, n - 1);
+    std::uniform_int_distribution<long long> value(-1000, 1000);
+
+    std::vector<long long> a(n);
+    for (auto& x : a) x = value(gen);
+
+    std::vector<std::pair<size_t, size_t>> ranges(n);
+    for (auto& r : ranges) {
+        r = { index(gen), index(gen) };
+        if (r.first > r.second) std::swap(r.first, r.second);
+    }
+    std::vector<std::pair<size_t, long long>> updates(n);
+    for (auto& u : updates) u = { index(gen), value(gen) };
+
+    long long checkFenwick = 0, checkOther = 0;
+    printf("Size %zu\n", n);
+    printf("%-36s %12s %12s\n", "Operation (us)", "Fenwick", "Other");
+
+    FenwickTree<long long> fenwick;
+    print_row("Build: O(n) vs old n x inc",
+        measure([&] { fenwick = FenwickTree<long long>(a); }),
+        measure([&] { old::init(a); }));
+
+    SegmentTree segment(a);
+    print_row("Build: Fenwick vs segment tree",
+        measure([&] { fenwick = FenwickTree<long long>(a); }),
+        measure([&] { segment = SegmentTree(a); }));
+
+    print_row("Range sum: Fenwick vs segment",
+        measure([&] { for (auto& r : ranges) checkFenwick += fenwick.query(r.first, r.second); }),
+        measure([&] { for (auto& r : ranges) checkOther += segment.query(r.first, r.second); }));
+
+    print_row("Point add: Fenwick vs segment",
+        measure([&] { for (auto& u : updates) fenwick.update(u.first, u.second); }),
+        measure([&] { for (auto& u : updates) segment.add(u.first, u.second); }));
+
+    // Пакет из n обновлений, отсортированный по индексу: верхние узлы общие
+    // у многих путей, проход обновляет каждый из них один раз
+    std::vector<std::pair<size_t, long long>> batch(updates);
+    std::sort(batch.begin(), batch.end());
+    FenwickTree<long long> single = fenwick;
+    print_row("Sorted batch n: one pass vs single",
+        measure([&] { fenwick.batch_update(batch); }),
+        measure([&] { for (auto& u : batch) single.update(u.first, u.second); }));
+    for (size_t i = 0; i < n; i += n / 64 + 1) {
+        checkFenwick += fenwick.prefix(i);
+        checkOther += single.prefix(i);
+    }
+    for (auto& u : batch) segment.add(u.first, u.second);
+    checkFenwick += fenwick.query(0, n - 1);
+    checkOther += segment.query(0, n - 1);
+
+    RangeFenwick<long long> rangeFenwick(a);
+    LazySegmentTree lazySegment(a);
+    size_t half = n / 2;
+    print_row("Range add: Fenwick vs lazy seg",
+        measure([&] {
+            for (size_t i = 0; i < half; i++) rangeFenwick.add(ranges[i].first, ranges[i].second, updates[i].second);
+        }),
+        measure([&] {
+            for (size_t i = 0; i < half; i++) lazySegment.add(ranges[i].first, ranges[i].second, updates[i].second);
+        }));
+    print_row("Range query: Fenwick vs lazy seg",
+        measure([&] { for (size_t i = half; i < n; i++) checkFenwick += rangeFenwick.query(ranges[i].first, ranges[i].second); }),
+        measure([&] { for (size_t i = half; i < n; i++) checkOther += lazySegment.query(ranges[i].first, ranges[i].second); }));
+
+    // Двумерный вариант: сумма на прямоугольниках сетки side x side против префиксных сумм,
+    // которые приходится пересчитывать целиком после каждого изменения
+    size_t side = 1;
+    while (side * side * 4 <= n) side *= 2;
+    std::vector<long long> grid(side * side);
+    for (auto& x : grid) x = value(gen);
+    Fenwick2D<long long> fenwick2d(side, side);
+    long long build2d = measure([&] { fenwick2d = Fenwick2D<long long>(side, side, grid); });
+    std::vector<long long> prefix2d((side + 1) * (side + 1));
+    long long buildPrefix = measure([&] {
+        for (size_t r = 0; r < side; r++)
+            for (size_t c = 0; c < side; c++)
+                prefix2d[(r + 1) * (side + 1) + c + 1] = grid[r * side + c] + prefix2d[r * (side + 1) + c + 1]
+                    + prefix2d[(r + 1) * (side + 1) + c] - prefix2d[r * (side + 1) + c];
+    });
+    printf("2D grid %zu x %zu\n", side, side);
+    print_row("2D build: Fenwick vs prefix sums", build2d, buildPrefix);
+
+    std::uniform_int_distribution<size_t> cell(0, side - 1);
+    const size_t rectangles = 1 << 16;
+    std::vector<size_t> rect(4 * rectangles);
+    for (size_t i = 0; i < rectangles; i++) {
+        size_t r1 = cell(gen), r2 = cell(gen), c1 = cell(gen), c2 = cell(gen);
+        rect[4 * i] = std::min(r1, r2);
+        rect[4 * i + 1] = std::min(c1, c2);
+        rect[4 * i + 2] = std::max(r1, r2);
+        rect[4 * i + 3] = std::max(c1, c2);
+    }
+    auto at = [&](size_t r, size_t c) { return prefix2d[r * (side + 1) + c]; };
+    print_row("2D rect sum: Fenwick vs prefix",
+        measure([&] {
+            for (size_t i = 0; i < rectangles; i++)
+                checkFenwick += fenwick2d.query(rect[4 * i], rect[4 * i + 1], rect[4 * i + 2], rect[4 * i + 3]);
+        }),
+        measure([&] {
+            for (size_t i = 0; i < rectangles; i++) {
+                size_t r1 = rect[4 * i], c1 = rect[4 * i + 1], r2 = rect[4 * i + 2] + 1, c2 = rect[4 * i + 3] + 1;
+                checkOther += at(r2, c2) - at(r1, c2) - at(r2, c1) + at(r1, c1);
+            }
+        }));
+
+    if (checkFenwick != checkOther) {
+        printf("Error: checksums differ (%lld vs %lld)\n", checkFenwick, checkOther);
+        return 1;
+    }
+    printf("Checksums match\n");
+    return 0;
+}
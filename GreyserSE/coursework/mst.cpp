@@ -0,0 +1,232 @@
+#include "mst.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+
+vector<Edge> load_edges_from_file(const string& filename, int& vertex_count) {
+    ifstream in(filename);
+    if (!in.is_open()) throw runtime_error("Невозможно открыть файл");
+
+    int edge_count;
+    in >> vertex_count >> edge_count;
+
+    vector<Edge> edges(edge_count);
+    for (int i = 0; i < edge_count; ++i) {
+        in >> edges[i].from >> edges[i].to >> edges[i].weight;
+    }
+    return edges;
+}
+
+
+MstResult kruskal_mst(int vertex_count, const vector<Edge>& edges) {
+    DisjointSetUnion dsu(vertex_count);
+    MstResult mst = {0, {}};
+
+    vector<Edge> sorted_edges = edges;
+    sort(sorted_edges.begin(), sorted_edges.end());
+
+    for (const Edge& edge : sorted_edges) {
+        if (dsu.unite(edge.from, edge.to)) {
+            mst.second.push_back(edge);
+            mst.first += edge.weight;
+            if ((int)mst.second.size() == vertex_count - 1) break;
+        }
+    }
+
+    return mst;
+}
+
+
+MstResult prim_mst(int vertex_count, const vector<Edge>& edges) {
+    vector<vector<Edge>> graph(vertex_count);
+
+    for (const Edge& edge : edges) {
+        graph[edge.from].push_back({edge.from, edge.to, edge.weight});
+        graph[edge.to].push_back({edge.to, edge.from, edge.weight});
+    }
+
+    // Edge::operator< упорядочивает по возрастанию веса, куче нужен минимум наверху
+    auto heavier = [](const Edge& a, const Edge& b) { return b < a; };
+    priority_queue<Edge, vector<Edge>, decltype(heavier)> pq(heavier);
+    vector<bool> visited(vertex_count, false);
+    MstResult mst = {0, {}};
+
+    pq.push({-1, 0, 0}); // Начинаем с вершины 0, вес 0
+
+    while (!pq.empty()) {
+        Edge edge = pq.top();
+        pq.pop();
+
+        int u = edge.to;
+        if (visited[u]) continue;
+
+        visited[u] = true;
+        mst.first += edge.weight;
+
+        if (edge.from != -1) {
+            mst.second.push_back(edge);
+        }
+
+        for (const auto& neighbor : graph[u]) {
+            if (!visited[neighbor.to]) {
+                pq.push(neighbor);
+            }
+        }
+    }
+
+    return mst;
+}
+
+
+static const ptrdiff_t FILTER_KRUSKAL_THRESHOLD = 1 << 12;
+
+static void filter_kruskal(vector<Edge>::iterator begin, vector<Edge>::iterator end,
+                           DisjointSetUnion& dsu, int vertex_count, MstResult& mst) {
+    if ((int)mst.second.size() == vertex_count - 1) return;
+
+    auto run_kruskal = [&](vector<Edge>::iterator from, vector<Edge>::iterator to) {
+        sort(from, to);
+        for (auto it = from; it != to; ++it) {
+            if (dsu.unite(it->from, it->to)) {
+                mst.second.push_back(*it);
+                mst.first += it->weight;
+                if ((int)mst.second.size() == vertex_count - 1) return;
+            }
+        }
+    };
+
+    if (end - begin <= FILTER_KRUSKAL_THRESHOLD) {
+        run_kruskal(begin, end);
+        return;
+    }
+
+    // Опорный вес - медиана трёх
+    int a = begin->weight, b = (begin + (end - begin) / 2)->weight, c = (end - 1)->weight;
+    int pivot = max(min(a, b), min(max(a, b), c));
+
+    auto middle = partition(begin, end, [pivot](const Edge& e) { return e.weight <= pivot; });
+    if (middle == end) {
+        // Все веса не больше опорного - делим по строгому неравенству
+        middle = partition(begin, end, [pivot](const Edge& e) { return e.weight < pivot; });
+        if (middle == begin) {
+            run_kruskal(begin, end); // все веса равны
+            return;
+        }
+    }
+
+    filter_kruskal(begin, middle, dsu, vertex_count, mst);
+
+    auto heavy_end = partition(middle, end, [&dsu](const Edge& e) { return dsu.find(e.from) != dsu.find(e.to); });
+    filter_kruskal(middle, heavy_end, dsu, vertex_count, mst);
+}
+
+
+MstResult filter_kruskal_mst(int vertex_count, const vector<Edge>& edges) {
+    DisjointSetUnion dsu(vertex_count);
+    MstResult mst = {0, {}};
+    vector<Edge> work = edges;
+    filter_kruskal(work.begin(), work.end(), dsu, vertex_count, mst);
+    return mst;
+}
+
+
+// Диапазон [0, n) делится между потоками, body(номер потока, начало, конец)
+template <typename Body>
+static void parallel_for(size_t n, int thread_count, Body body) {
+    if (thread_count <= 1 || n < (1 << 14)) {
+        body(0, size_t(0), n);
+        return;
+    }
+    vector<thread> threads;
+    size_t chunk = (n + thread_count - 1) / thread_count;
+    for (int t = 1; t < thread_count; ++t) {
+        size_t from = min(n, t * chunk), to = min(n, from + chunk);
+        threads.emplace_back(body, t, from, to);
+    }
+    body(0, size_t(0), min(n, chunk));
+    for (auto& th : threads) th.join();
+}
+
+
+MstResult parallel_boruvka_mst(int vertex_count, const vector<Edge>& edges, int thread_count) {
+    if (thread_count < 1) thread_count = 1;
+    if ((int64_t)edges.size() > numeric_limits<uint32_t>::max())
+        throw length_error("Слишком много рёбер");
+
+    DisjointSetUnion dsu(vertex_count);
+    MstResult mst = {0, {}};
+    vector<Edge> work = edges;
+
+    // component[v] - корень компоненты v на начало раунда
+    vector<int> component(vertex_count);
+    for (int v = 0; v < vertex_count; ++v) component[v] = v;
+
+    // Ключ ребра: старшие 32 бита - вес со сдвигом в беззнаковый диапазон, младшие - номер ребра.
+    // Номер делает порядок строгим, поэтому при равных весах циклы не образуются.
+    const uint64_t NONE = numeric_limits<uint64_t>::max();
+    unique_ptr<atomic<uint64_t>[]> cheapest(new atomic<uint64_t>[vertex_count]);
+
+    while (!work.empty()) {
+        parallel_for(vertex_count, thread_count, [&](int, size_t from, size_t to) {
+            for (size_t v = from; v < to; ++v) cheapest[v].store(NONE, memory_order_relaxed);
+        });
+
+        auto update = [&](int root, uint64_t key) {
+            uint64_t current = cheapest[root].load(memory_order_relaxed);
+            while (key < current && !cheapest[root].compare_exchange_weak(current, key, memory_order_relaxed)) {
+            }
+        };
+
+        parallel_for(work.size(), thread_count, [&](int, size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                int cu = component[work[i].from], cv = component[work[i].to];
+                if (cu == cv) continue;
+                uint64_t key = (uint64_t)((int64_t)work[i].weight - numeric_limits<int>::min()) << 32 | i;
+                update(cu, key);
+                update(cv, key);
+            }
+        });
+
+        size_t added = 0;
+        for (int v = 0; v < vertex_count; ++v) {
+            uint64_t key = cheapest[v].load(memory_order_relaxed);
+            if (component[v] != v || key == NONE) continue;
+            const Edge& edge = work[key & 0xffffffffu];
+            if (dsu.unite(edge.from, edge.to)) {
+                mst.second.push_back(edge);
+                mst.first += edge.weight;
+                ++added;
+            }
+        }
+        if (added == 0) break;
+
+        parallel_for(vertex_count, thread_count, [&](int, size_t from, size_t to) {
+            for (size_t v = from; v < to; ++v) component[v] = dsu.find_const(v);
+        });
+
+        // Удаление рёбер внутри компонент: каждый поток сжимает свой кусок, затем куски склеиваются
+        vector<pair<size_t, size_t>> kept(thread_count, {0, 0});
+        parallel_for(work.size(), thread_count, [&](int t, size_t from, size_t to) {
+            size_t out = from;
+            for (size_t i = from; i < to; ++i) {
+                if (component[work[i].from] != component[work[i].to]) work[out++] = work[i];
+            }
+            kept[t] = {from, out};
+        });
+        size_t size = 0;
+        for (const auto& range : kept) {
+            if (range.first != size)
+                copy(work.begin() + range.first, work.begin() + range.second, work.begin() + size);
+            size += range.second - range.first;
+        }
+        work.resize(size);
+    }
+
+    return mst;
+}
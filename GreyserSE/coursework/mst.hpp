@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+struct Edge {
+    int from;
+    int to;
+    int weight;
+
+    bool operator<(const Edge& other) const {
+        return weight < other.weight;
+    }
+};
+
+// Система непересекающихся множеств в одном массиве:
+// parent[v] >= 0 - родитель v, parent[v] < 0 - v корень, -parent[v] - размер множества.
+// Поиск с делением пути пополам (path halving), объединение по размеру.
+class DisjointSetUnion {
+private:
+    vector<int> parent;
+
+public:
+    explicit DisjointSetUnion(int n) : parent(n, -1) {}
+
+    int find(int v) {
+        while (parent[v] >= 0) {
+            if (parent[parent[v]] >= 0)
+                parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    // Корень без изменения массива - можно вызывать из нескольких потоков одновременно
+    int find_const(int v) const {
+        while (parent[v] >= 0)
+            v = parent[v];
+        return v;
+    }
+
+    // true, если u и v были в разных множествах
+    bool unite(int u, int v) {
+        u = find(u);
+        v = find(v);
+        if (u == v) return false;
+        if (parent[u] > parent[v])
+            swap(u, v);
+        parent[u] += parent[v];
+        parent[v] = u;
+        return true;
+    }
+};
+
+// Результат: суммарный вес и рёбра остовного дерева (леса, если граф несвязный)
+using MstResult = pair<long long, vector<Edge>>;
+
+vector<Edge> load_edges_from_file(const string& filename, int& vertex_count);
+
+// Классический Краскал: сортировка всех рёбер
+MstResult kruskal_mst(int vertex_count, const vector<Edge>& edges);
+
+// Прим с двоичной кучей от вершины 0 (дерево только её компоненты)
+MstResult prim_mst(int vertex_count, const vector<Edge>& edges);
+
+// Filter-Kruskal: рёбра разбиваются по опорному весу как в quicksort, лёгкая часть
+// обрабатывается первой, из тяжёлой перед обработкой выбрасываются рёбра внутри
+// уже связанных компонент. Сортируется только то, что осталось после фильтрации.
+MstResult filter_kruskal_mst(int vertex_count, const vector<Edge>& edges);
+
+// Параллельный Борувка: на каждом раунде потоки находят самое лёгкое ребро
+// каждой компоненты (атомарный минимум по паре вес/номер ребра), затем
+// компоненты сливаются, а рёбра внутри компонент отбрасываются.
+MstResult parallel_boruvka_mst(int vertex_count, const vector<Edge>& edges,
+                               int thread_count = thread::hardware_concurrency());
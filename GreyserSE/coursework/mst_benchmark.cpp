@@ -0,0 +1,148 @@
+#include "mst.hpp"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+// Сравнение алгоритмов модуля mst: Краскал и Прим (их же используют
+// kruskal.cpp и prim.cpp), Filter-Kruskal и параллельный Борувка.
+// Для сравнения СНМ здесь же оставлен исходный Краскал из kruskal.cpp
+// (ранги и рекурсивный find) - только для замеров; вес суммируется в long long.
+// Запуск: mst_benchmark [число вершин] [рёбер на вершину]
+
+namespace old {
+
+class DisjointSetUnion {
+private:
+    vector<int> parent;
+    vector<int> rank;
+
+public:
+    explicit DisjointSetUnion(int n) : parent(n), rank(n, 0) {
+        for (int i = 0; i < n; ++i)
+            parent[i] = i;
+    }
+
+    int find(int v) {
+        if (v != parent[v])
+            parent[v] = find(parent[v]);
+        return parent[v];
+    }
+
+    void unite(int u, int v) {
+        u = find(u);
+        v = find(v);
+        if (u == v) return;
+        if (rank[u] < rank[v])
+            parent[u] = v;
+        else {
+            parent[v] = u;
+            if (rank[u] == rank[v])
+                ++rank[u];
+        }
+    }
+};
+
+pair<long long, vector<Edge>> kruskal_mst(int vertex_count, const vector<Edge>& edges) {
+    DisjointSetUnion dsu(vertex_count);
+    vector<Edge> mst;
+    long long total_weight = 0;
+
+    vector<Edge> sorted_edges = edges;
+    sort(sorted_edges.begin(), sorted_edges.end());
+
+    for (const Edge& edge : sorted_edges) {
+        if (dsu.find(edge.from) != dsu.find(edge.to)) {
+            dsu.unite(edge.from, edge.to);
+            mst.push_back(edge);
+            total_weight += edge.weight;
+            if ((int)mst.size() == vertex_count - 1) break;
+        }
+    }
+
+    return {total_weight, mst};
+}
+
+} // namespace old
+
+
+// Связный граф, похожий на дорожную сеть: вершины на прямой, рёбра в основном
+// между близкими вершинами, вес растёт с расстоянием
+vector<Edge> generate_graph(int vertex_count, int edges_per_vertex) {
+    mt19937 rng(42);
+    uniform_int_distribution<int> noise(0, 1000);
+    uniform_int_distribution<int> offset(1, 200);
+    vector<Edge> edges;
+    edges.reserve((size_t)vertex_count * edges_per_vertex);
+
+    for (int v = 1; v < vertex_count; ++v) {
+        edges.push_back({v - 1, v, 1000 + noise(rng)});
+    }
+    for (int v = 0; v < vertex_count; ++v) {
+        for (int i = 1; i < edges_per_vertex; ++i) {
+            int d = offset(rng);
+            if (v + d >= vertex_count) continue;
+            edges.push_back({v, v + d, 1000 * d / 4 + noise(rng)});
+        }
+    }
+    shuffle(edges.begin(), edges.end(), rng);
+    return edges;
+}
+
+
+template <typename Function>
+double measure(Function function) {
+    auto start = chrono::high_resolution_clock::now();
+    function();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+
+int main(int argc, char** argv) {
+    try {
+        int vertex_count = argc > 1 ? stoi(argv[1]) : 1000000;
+        int edges_per_vertex = argc > 2 ? stoi(argv[2]) : 8;
+        int thread_count = max(1u, thread::hardware_concurrency());
+
+        vector<Edge> edges = generate_graph(vertex_count, edges_per_vertex);
+        cout << "Вершин: " << vertex_count << ", рёбер: " << edges.size()
+             << ", потоков: " << thread_count << "\n";
+
+        long long expected = 0;
+        double time = measure([&] { expected = old::kruskal_mst(vertex_count, edges).first; });
+        cout << "Краскал (исходный СНМ): " << time << " с, вес " << expected << "\n";
+
+        MstResult mst;
+        time = measure([&] { mst = kruskal_mst(vertex_count, edges); });
+        cout << "Краскал:                " << time << " с, вес " << mst.first << "\n";
+        bool ok = mst.first == expected;
+
+        time = measure([&] { mst = prim_mst(vertex_count, edges); });
+        cout << "Прим:                   " << time << " с, вес " << mst.first << "\n";
+        ok = ok && mst.first == expected;
+
+        time = measure([&] { mst = filter_kruskal_mst(vertex_count, edges); });
+        cout << "Filter-Kruskal:         " << time << " с, вес " << mst.first << "\n";
+        ok = ok && mst.first == expected;
+
+        for (int threads = 1; threads <= thread_count; threads *= 2) {
+            time = measure([&] { mst = parallel_boruvka_mst(vertex_count, edges, threads); });
+            cout << "Борувка, потоков " << threads << ":     " << time << " с, вес " << mst.first << "\n";
+            ok = ok && mst.first == expected && (int)mst.second.size() == vertex_count - 1;
+        }
+
+        if (!ok) {
+            cerr << "Ошибка: веса остовных деревьев не совпадают\n";
+            return 1;
+        }
+    } catch (const exception& ex) {
+        cerr << "Ошибка: " << ex.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string.h>
+#include <vector>
 
 class Node {
 public:
@@ -22,6 +23,58 @@ static Node *nill = new Node();
 Node::Node(int key, std::string name): key(key), name(name), left(nill), right(nill), color(1){}
 
 
+//пул узлов: память выделяется блоками, освобожденные узлы
+//связываются в список через left и используются повторно
+class NodePool {
+private:
+    static const int BLOCK_SIZE = 1024;
+    std::vector<Node*> blocks;
+    Node *free_list = nullptr;
+    int used = BLOCK_SIZE;  //занято узлов в последнем блоке
+public:
+    NodePool() {}
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    ~NodePool();
+
+    Node* allocate(int key, const std::string& name);
+    void release(Node *node);
+};
+
+
+NodePool::~NodePool(){
+    for(Node *block : blocks) delete[] block;
+}
+
+
+Node* NodePool::allocate(int key, const std::string& name){
+    Node *node;
+    if(free_list != nullptr){
+        node = free_list;
+        free_list = free_list->left;
+    }
+    else {
+        if(used == BLOCK_SIZE){
+            blocks.push_back(new Node[BLOCK_SIZE]);
+            used = 0;
+        }
+        node = &blocks.back()[used++];
+    }
+    node->key = key;
+    node->name = name;
+    node->left = nill;
+    node->right = nill;
+    node->color = 1;
+    return node;
+}
+
+
+void NodePool::release(Node *node){
+    node->left = free_list;
+    free_list = node;
+}
+
+
 class Tree {
 private:
     void display_subtree(Node* node);
@@ -37,10 +90,15 @@ private:
 
     void right_rotate(Node *node);
     void left_rotate(Node *node);
+
+    NodePool pool;
 public:
     Node *root;
 
     Tree() : root(nullptr) {}
+    ~Tree() { this->clear(); }
+
+    void clear();
 
     void add_node(int key, const std::string& name);
     void delete_node(int d_key);
@@ -54,7 +112,7 @@ public:
 
 
 void Tree::add_node(int key, const std::string& name) {
-    Node *newNode = new Node(key, name);
+    Node *newNode = pool.allocate(key, name);
 
     //создание корня
     if (root == nullptr) {
@@ -76,6 +134,7 @@ void Tree::add_node(int key, const std::string& name) {
         else uncle = grandpa->right == parent ? grandpa->left : grandpa->right;
         if(key == current->key) {  //замена значения если ключ одинаковый
             current->name = name;
+            pool.release(newNode);
             return;
         }
         current = key < current->key ? current->left : current->right;
@@ -127,6 +186,22 @@ void Tree::add_node(int key, const std::string& name) {
 }
 
 
+//обход без рекурсии: глубина дерева не ограничена размером стека
+void Tree::clear(){
+    if(root == nullptr)return;
+    std::vector<Node*> stack;
+    stack.push_back(root);
+    while(!stack.empty()){
+        Node *node = stack.back();
+        stack.pop_back();
+        if(node->left != nill)stack.push_back(node->left);
+        if(node->right != nill)stack.push_back(node->right);
+        pool.release(node);
+    }
+    root = nullptr;
+}
+
+
 void Tree::display_subtree(Node* node){
     if(node->left != nill) this->display_subtree(node->left);
     std::cout << "Name " << node->name << " Key " << node->key << " color " << node->color;
@@ -244,6 +319,7 @@ void Tree::delete_node(int d_key){
     if(this->child_count(current) == 0 && current->color == 1){
         if(current == parent->left)parent->left = nill;
         else parent->right = nill;
+        pool.release(current);
         return;
     }
     //удаление черного узла с 1 красным ребенком
@@ -251,11 +327,13 @@ void Tree::delete_node(int d_key){
         if(current->right->color == 1){
             current->key = current->right->key;
             current->name = current->right->name;
+            pool.release(current->right);
             current->right = nill;
         }
         else {
             current->key = current->left->key;
             current->name = current->left->name;
+            pool.release(current->left);
             current->left = nill;
         }
         return;
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <vector>
+#include <stack>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <pthread.h>
+
+#include "scc_graph.h"
+
+using namespace std;
+
+// Сравнение прежней рекурсивной реализации Косарайю (список смежности,
+// транспонированная копия графа) с итеративными Косарайю/Тарьяном на CSR
+// и параллельным Forward-Backward.
+//
+// Запуск: benchmark_scc [число вершин] [среднее число рёбер на вершину] [потоки]
+
+// Прежняя реализация, оставлена только для сравнения
+class RecursiveGraph {
+    int V;
+    vector<vector<int>> adj;
+
+    void DFSUtil(int v, vector<bool>& visited, vector<int>& component) {
+        visited[v] = true;
+        component.push_back(v);
+        for (int u : adj[v]) {
+            if (!visited[u]) {
+                DFSUtil(u, visited, component);
+            }
+        }
+    }
+
+    void fillOrder(int v, vector<bool>& visited, stack<int>& Stack) {
+        visited[v] = true;
+        for (int u : adj[v]) {
+            if (!visited[u]) {
+                fillOrder(u, visited, Stack);
+            }
+        }
+        Stack.push(v);
+    }
+
+public:
+    RecursiveGraph(int V) : V(V), adj(V) {}
+
+    void addEdge(int v, int w) {
+        adj[v].push_back(w);
+    }
+
+    RecursiveGraph getTranspose() {
+        RecursiveGraph g(V);
+        for (int v = 0; v < V; v++) {
+            for (int u : adj[v]) {
+                g.addEdge(u, v);
+            }
+        }
+        return g;
+    }
+
+    vector<vector<int>> getSCCs() {
+        stack<int> Stack;
+        vector<bool> visited(V, false);
+        for (int i = 0; i < V; i++) {
+            if (!visited[i]) {
+                fillOrder(i, visited, Stack);
+            }
+        }
+        RecursiveGraph gr = getTranspose();
+        fill(visited.begin(), visited.end(), false);
+        vector<vector<int>> sccs;
+        while (!Stack.empty()) {
+            int v = Stack.top();
+            Stack.pop();
+            if (!visited[v]) {
+                vector<int> component;
+                gr.DFSUtil(v, visited, component);
+                sccs.push_back(component);
+            }
+        }
+        return sccs;
+    }
+};
+
+
+// Граф зависимостей: случайные рёбра плюс длинная цепочка, дающая глубокий обход
+static vector<pair<int, int>> makeEdges(int V, int degree) {
+    mt19937 rng(1);
+    vector<pair<int, int>> edges;
+    edges.reserve((size_t)V * degree + V);
+    for (int v = 0; v + 1 < V; v++) {
+        edges.push_back({v, v + 1});
+    }
+    uniform_int_distribution<int> vertex(0, V - 1);
+    for (long long i = 0; i < (long long)V * (degree - 1); i++) {
+        int v = vertex(rng);
+        // большинство рёбер "вперёд", часть - назад, чтобы появились нетривиальные компоненты
+        int u = (rng() % 512 == 0) ? vertex(rng) : min(V - 1, v + 1 + (int)(rng() % 1000));
+        edges.push_back({v, u});
+    }
+    return edges;
+}
+
+
+// Сортированные компоненты, чтобы сравнивать результаты разных алгоритмов
+static vector<vector<int>> normalize(vector<vector<int>> sccs) {
+    for (auto& scc : sccs) {
+        sort(scc.begin(), scc.end());
+    }
+    sort(sccs.begin(), sccs.end());
+    return sccs;
+}
+
+
+template <typename Function>
+static double measure(Function function) {
+    auto start = chrono::high_resolution_clock::now();
+    function();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+
+struct RecursiveRun {
+    const vector<pair<int, int>>* edges;
+    int V;
+    vector<vector<int>> sccs;
+    double seconds;
+};
+
+static void* runRecursive(void* arg) {
+    RecursiveRun* run = static_cast<RecursiveRun*>(arg);
+    run->seconds = measure([run]() {
+        RecursiveGraph g(run->V);
+        for (const auto& e : *run->edges) {
+            g.addEdge(e.first, e.second);
+        }
+        run->sccs = g.getSCCs();
+    });
+    return nullptr;
+}
+
+
+int main(int argc, char** argv) {
+    int V = argc > 1 ? stoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? stoi(argv[2]) : 5;
+    int threads = argc > 3 ? stoi(argv[3]) : (int)thread::hardware_concurrency();
+
+    vector<pair<int, int>> edges = makeEdges(V, degree);
+    cout << "Vertices: " << V << ", edges: " << edges.size() << ", threads: " << threads << "\n";
+
+    // Рекурсии нужна глубина порядка V, поэтому она запускается в потоке с большим стеком
+    RecursiveRun run = {&edges, V, {}, 0.0};
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)V * 256 + (1 << 20));
+    pthread_t th;
+    if (pthread_create(&th, &attr, runRecursive, &run) != 0) {
+        cerr << "Error: cannot start thread\n";
+        return 1;
+    }
+    pthread_join(th, nullptr);
+    pthread_attr_destroy(&attr);
+    cout << "Recursive Kosaraju: " << run.seconds << " s, components: " << run.sccs.size() << "\n";
+    vector<vector<int>> expected = normalize(run.sccs);
+
+    Graph g(V);
+    double buildTime = measure([&]() {
+        for (const auto& e : edges) {
+            g.addEdge(e.first, e.second);
+        }
+        g.getSCCs(); // первый вызов собирает CSR
+    });
+    cout << "CSR build + first run: " << buildTime << " s\n";
+
+    bool ok = true;
+    vector<vector<int>> sccs;
+    double time = measure([&]() { sccs = g.getSCCs(); });
+    cout << "Iterative Kosaraju:  " << time << " s, components: " << sccs.size() << "\n";
+    ok = ok && normalize(sccs) == expected;
+
+    time = measure([&]() { sccs = g.getSCCsTarjan(); });
+    cout << "Iterative Tarjan:    " << time << " s, components: " << sccs.size() << "\n";
+    ok = ok && normalize(sccs) == expected;
+
+    time = measure([&]() { sccs = g.getSCCsParallel(threads); });
+    cout << "Parallel FW-BW:      " << time << " s, components: " << sccs.size() << "\n";
+    ok = ok && normalize(sccs) == expected;
+
+    if (!ok) {
+        cerr << "Error: results differ\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,398 @@
+#include "scc_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// Параллельный цикл: диапазон [0, n) делится на threads равных частей
+template <typename Body>
+static void parallelFor(int n, int threads, Body body) {
+    if (threads <= 1 || n < 4096) {
+        body(0, n);
+        return;
+    }
+    vector<thread> pool;
+    int chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        int begin = t * chunk;
+        int end = min(n, begin + chunk);
+        if (begin >= end) {
+            break;
+        }
+        pool.emplace_back(body, begin, end);
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+}
+
+
+void Graph::addEdge(int v, int w) {
+    edges.push_back({v, w});
+    built = false;
+}
+
+
+void Graph::build() {
+    if (built) {
+        return;
+    }
+
+    // Рёбра, уже собранные в CSR, возвращаются в общий список
+    for (int v = 0; v < (int)outOffset.size() - 1; v++) {
+        for (int pos = outOffset[v]; pos < outOffset[v + 1]; pos++) {
+            edges.push_back({v, outEdges[pos]});
+        }
+    }
+
+    outOffset.assign(V + 1, 0);
+    inOffset.assign(V + 1, 0);
+    for (const auto& e : edges) {
+        outOffset[e.first + 1]++;
+        inOffset[e.second + 1]++;
+    }
+    for (int v = 0; v < V; v++) {
+        outOffset[v + 1] += outOffset[v];
+        inOffset[v + 1] += inOffset[v];
+    }
+
+    outEdges.resize(edges.size());
+    inEdges.resize(edges.size());
+    vector<int> outPos(outOffset.begin(), outOffset.end() - 1);
+    vector<int> inPos(inOffset.begin(), inOffset.end() - 1);
+    for (const auto& e : edges) {
+        outEdges[outPos[e.first]++] = e.second;
+        inEdges[inPos[e.second]++] = e.first;
+    }
+
+    edges.clear();
+    edges.shrink_to_fit();
+    built = true;
+}
+
+
+vector<vector<int>> Graph::groupComponents(const vector<int>& ids, int count) {
+    vector<vector<int>> sccs(count);
+    for (int v = 0; v < (int)ids.size(); v++) {
+        sccs[ids[v]].push_back(v);
+    }
+    return sccs;
+}
+
+
+vector<int> Graph::kosarajuIds(int& count) {
+    build();
+
+    // Первый проход: порядок завершения обработки вершин по прямым рёбрам
+    vector<int> order;
+    order.reserve(V);
+    vector<bool> visited(V, false);
+    vector<pair<int, int>> callStack; // (вершина, позиция следующего ребра)
+
+    for (int i = 0; i < V; i++) {
+        if (visited[i]) {
+            continue;
+        }
+        visited[i] = true;
+        callStack.push_back({i, outOffset[i]});
+
+        while (!callStack.empty()) {
+            int v = callStack.back().first;
+            int& pos = callStack.back().second;
+            if (pos < outOffset[v + 1]) {
+                int u = outEdges[pos++];
+                if (!visited[u]) {
+                    visited[u] = true;
+                    callStack.push_back({u, outOffset[u]});
+                }
+            } else {
+                order.push_back(v);
+                callStack.pop_back();
+            }
+        }
+    }
+
+    // Второй проход: обход по обратным рёбрам в порядке убывания времени выхода
+    vector<int> ids(V, -1);
+    vector<int> stack;
+    count = 0;
+    for (int i = V - 1; i >= 0; i--) {
+        int root = order[i];
+        if (ids[root] != -1) {
+            continue;
+        }
+        ids[root] = count;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int pos = inOffset[v]; pos < inOffset[v + 1]; pos++) {
+                int u = inEdges[pos];
+                if (ids[u] == -1) {
+                    ids[u] = count;
+                    stack.push_back(u);
+                }
+            }
+        }
+        count++;
+    }
+    return ids;
+}
+
+
+vector<int> Graph::tarjanIds(int& count) {
+    vector<int> ids(V, -1);
+    vector<int> all(V);
+    for (int v = 0; v < V; v++) {
+        all[v] = v;
+    }
+    count = 0;
+    tarjanFrom(all,
+               [&ids](int v) { return ids[v] == -1; },
+               [&ids](int v, int id) { ids[v] = id; },
+               count);
+    return ids;
+}
+
+
+vector<int> Graph::parallelIds(int threads, int& count) {
+    build();
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // Алгоритм Multistep (Slota, Rajamanickam, Madduri):
+    // 1) отсечение вершин без входящих или исходящих рёбер - каждая сама по себе компонента;
+    // 2) Forward-Backward от вершины с наибольшей степенью - выделяет гигантскую компоненту;
+    // 3) раскраска: максимальный номер распространяется по прямым рёбрам, затем
+    //    из каждого "корня цвета" обратный обход внутри своего цвета даёт компоненту;
+    // 4) небольшой остаток добивается последовательным Тарьяном.
+    const int serialThreshold = 100000;
+
+    unique_ptr<atomic<int>[]> comp(new atomic<int>[V]);
+    for (int v = 0; v < V; v++) {
+        comp[v].store(-1, memory_order_relaxed);
+    }
+    atomic<int> nextId(0);
+
+    vector<int> active(V);
+    for (int v = 0; v < V; v++) {
+        active[v] = v;
+    }
+
+    auto isFree = [&comp](int v) { return comp[v].load(memory_order_relaxed) == -1; };
+
+    // Удаление уже отнесённых к компонентам вершин из списка активных
+    auto compact = [&]() {
+        active.erase(remove_if(active.begin(), active.end(), [&](int v) { return !isFree(v); }), active.end());
+    };
+
+    // 1. Отсечение
+    for (int round = 0; round < 8; round++) {
+        atomic<int> trimmed(0);
+        parallelFor((int)active.size(), threads, [&](int begin, int end) {
+            int local = 0;
+            for (int i = begin; i < end; i++) {
+                int v = active[i];
+                bool hasOut = false, hasIn = false;
+                for (int pos = outOffset[v]; pos < outOffset[v + 1] && !hasOut; pos++) {
+                    int u = outEdges[pos];
+                    hasOut = u != v && isFree(u);
+                }
+                for (int pos = inOffset[v]; pos < inOffset[v + 1] && !hasIn; pos++) {
+                    int u = inEdges[pos];
+                    hasIn = u != v && isFree(u);
+                }
+                if (!hasOut || !hasIn) {
+                    comp[v].store(nextId.fetch_add(1, memory_order_relaxed), memory_order_relaxed);
+                    local++;
+                }
+            }
+            trimmed.fetch_add(local, memory_order_relaxed);
+        });
+        compact();
+        if (trimmed.load() < (int)active.size() / 100 + 1) {
+            break;
+        }
+    }
+
+    // 2. Forward-Backward от опорной вершины
+    if ((int)active.size() > serialThreshold) {
+        int pivot = active[0];
+        long long best = -1;
+        for (int v : active) {
+            long long degree = (long long)(outOffset[v + 1] - outOffset[v]) * (inOffset[v + 1] - inOffset[v]);
+            if (degree > best) {
+                best = degree;
+                pivot = v;
+            }
+        }
+
+        // Поуровневый параллельный BFS; mark[v] - битовая маска (1 - прямой обход, 2 - обратный)
+        unique_ptr<atomic<unsigned char>[]> mark(new atomic<unsigned char>[V]);
+        for (int v = 0; v < V; v++) {
+            mark[v].store(0, memory_order_relaxed);
+        }
+
+        auto bfs = [&](const vector<int>& offset, const vector<int>& targets, unsigned char bit) {
+            vector<int> frontier = {pivot};
+            mark[pivot].fetch_or(bit);
+            while (!frontier.empty()) {
+                int parts = min(threads, (int)frontier.size() / 1024 + 1);
+                vector<vector<int>> next(parts);
+                int chunk = ((int)frontier.size() + parts - 1) / parts;
+                auto expand = [&](int part) {
+                    int begin = part * chunk;
+                    int end = min((int)frontier.size(), begin + chunk);
+                    for (int i = begin; i < end; i++) {
+                        int v = frontier[i];
+                        for (int pos = offset[v]; pos < offset[v + 1]; pos++) {
+                            int u = targets[pos];
+                            if (isFree(u) && !(mark[u].fetch_or(bit, memory_order_relaxed) & bit)) {
+                                next[part].push_back(u);
+                            }
+                        }
+                    }
+                };
+                vector<thread> pool;
+                for (int part = 1; part < parts; part++) {
+                    pool.emplace_back(expand, part);
+                }
+                expand(0);
+                for (thread& th : pool) {
+                    th.join();
+                }
+                frontier.clear();
+                for (const auto& part : next) {
+                    frontier.insert(frontier.end(), part.begin(), part.end());
+                }
+            }
+        };
+
+        bfs(outOffset, outEdges, 1);
+        bfs(inOffset, inEdges, 2);
+
+        int giant = nextId.fetch_add(1);
+        for (int v : active) {
+            if (mark[v].load(memory_order_relaxed) == 3) {
+                comp[v].store(giant, memory_order_relaxed);
+            }
+        }
+        compact();
+    }
+
+    // 3. Раскраска
+    unique_ptr<atomic<int>[]> color(new atomic<int>[V]());
+    while ((int)active.size() > serialThreshold) {
+        parallelFor((int)active.size(), threads, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                color[active[i]].store(active[i], memory_order_relaxed);
+            }
+        });
+
+        // Распространение максимального цвета по прямым рёбрам до стабилизации
+        atomic<bool> changed(true);
+        while (changed.load()) {
+            changed.store(false);
+            parallelFor((int)active.size(), threads, [&](int begin, int end) {
+                bool localChanged = false;
+                for (int i = begin; i < end; i++) {
+                    int v = active[i];
+                    int c = color[v].load(memory_order_relaxed);
+                    for (int pos = outOffset[v]; pos < outOffset[v + 1]; pos++) {
+                        int u = outEdges[pos];
+                        if (!isFree(u)) {
+                            continue;
+                        }
+                        int cu = color[u].load(memory_order_relaxed);
+                        while (cu < c && !color[u].compare_exchange_weak(cu, c, memory_order_relaxed)) {
+                        }
+                        if (cu < c) {
+                            localChanged = true;
+                        }
+                    }
+                }
+                if (localChanged) {
+                    changed.store(true, memory_order_relaxed);
+                }
+            });
+        }
+
+        // Корни цветов: вершины, сохранившие собственный цвет
+        vector<int> roots;
+        for (int v : active) {
+            if (color[v].load(memory_order_relaxed) == v) {
+                roots.push_back(v);
+            }
+        }
+
+        // Обратный обход из корня внутри его цвета; цвета не пересекаются,
+        // поэтому корни обрабатываются потоками независимо
+        atomic<int> nextRoot(0);
+        auto worker = [&]() {
+            vector<int> stack;
+            for (int r = nextRoot.fetch_add(1); r < (int)roots.size(); r = nextRoot.fetch_add(1)) {
+                int root = roots[r];
+                int id = nextId.fetch_add(1, memory_order_relaxed);
+                comp[root].store(id, memory_order_relaxed);
+                stack.push_back(root);
+                while (!stack.empty()) {
+                    int v = stack.back();
+                    stack.pop_back();
+                    for (int pos = inOffset[v]; pos < inOffset[v + 1]; pos++) {
+                        int u = inEdges[pos];
+                        if (isFree(u) && color[u].load(memory_order_relaxed) == root) {
+                            comp[u].store(id, memory_order_relaxed);
+                            stack.push_back(u);
+                        }
+                    }
+                }
+            }
+        };
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (thread& th : pool) {
+            th.join();
+        }
+        compact();
+    }
+
+    // 4. Остаток
+    int id = nextId.load();
+    tarjanFrom(active, isFree,
+               [&comp](int v, int c) { comp[v].store(c, memory_order_relaxed); },
+               id);
+    count = id;
+
+    vector<int> ids(V);
+    for (int v = 0; v < V; v++) {
+        ids[v] = comp[v].load(memory_order_relaxed);
+    }
+    return ids;
+}
+
+
+vector<vector<int>> Graph::getSCCs() {
+    int count;
+    vector<int> ids = kosarajuIds(count);
+    return groupComponents(ids, count);
+}
+
+
+vector<vector<int>> Graph::getSCCsTarjan() {
+    int count;
+    vector<int> ids = tarjanIds(count);
+    return groupComponents(ids, count);
+}
+
+
+vector<vector<int>> Graph::getSCCsParallel(int threads) {
+    int count;
+    vector<int> ids = parallelIds(threads, count);
+    return groupComponents(ids, count);
+}
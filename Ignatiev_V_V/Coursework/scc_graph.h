@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <thread>
+
+// Ориентированный граф в формате CSR (compressed sparse row).
+// Хранятся и прямые, и обратные рёбра, поэтому для алгоритма Косарайю
+// не нужно строить транспонированный граф. Все обходы итеративные,
+// глубина графа ограничена только памятью, а не размером стека.
+class Graph {
+    int V; // Количество вершин
+    std::vector<std::pair<int, int>> edges; // Рёбра, добавленные после последней сборки CSR
+    bool built = false;
+
+    std::vector<int> outOffset, outEdges; // Прямые рёбра: соседи v в outEdges[outOffset[v] .. outOffset[v + 1])
+    std::vector<int> inOffset, inEdges;   // Обратные рёбра
+
+    // Сборка CSR подсчётом (counting sort по началу и по концу ребра)
+    void build();
+
+    // Итеративный Тарьян по вершинам starts; учитываются только вершины,
+    // для которых isFree(v) истинно. Найденная компонента передаётся в assign(v, id).
+    template <typename IsFree, typename Assign>
+    void tarjanFrom(const std::vector<int>& starts, IsFree isFree, Assign assign, int& nextId);
+
+    // Номер компоненты для каждой вершины
+    std::vector<int> kosarajuIds(int& count);
+    std::vector<int> tarjanIds(int& count);
+    std::vector<int> parallelIds(int threads, int& count);
+
+    static std::vector<std::vector<int>> groupComponents(const std::vector<int>& ids, int count);
+
+public:
+    Graph(int V) : V(V) {}
+
+    // Добавление ребра в граф
+    void addEdge(int v, int w);
+
+    int vertexCount() const { return V; }
+
+    // Итеративный Косарайю (второй проход по обратному CSR)
+    std::vector<std::vector<int>> getSCCs();
+
+    // Итеративный Тарьян, один проход по графу
+    std::vector<std::vector<int>> getSCCsTarjan();
+
+    // Параллельный Forward-Backward с отсечением (trim) и раскраской (coloring)
+    std::vector<std::vector<int>> getSCCsParallel(int threads = std::thread::hardware_concurrency());
+};
+
+
+
+template <typename IsFree, typename Assign>
+void Graph::tarjanFrom(const std::vector<int>& starts, IsFree isFree, Assign assign, int& nextId) {
+    build();
+
+    std::vector<int> index(V, -1);
+    std::vector<int> low(V, 0);
+    std::vector<bool> onStack(V, false);
+    std::vector<int> sccStack;
+    std::vector<std::pair<int, int>> callStack; // (вершина, позиция следующего ребра)
+    int counter = 0;
+
+    for (int start : starts) {
+        if (index[start] != -1 || !isFree(start)) {
+            continue;
+        }
+
+        index[start] = low[start] = counter++;
+        sccStack.push_back(start);
+        onStack[start] = true;
+        callStack.push_back({start, outOffset[start]});
+
+        while (!callStack.empty()) {
+            int v = callStack.back().first;
+            int& pos = callStack.back().second;
+
+            if (pos < outOffset[v + 1]) {
+                int u = outEdges[pos++];
+                if (!isFree(u)) {
+                    continue;
+                }
+                if (index[u] == -1) {
+                    index[u] = low[u] = counter++;
+                    sccStack.push_back(u);
+                    onStack[u] = true;
+                    callStack.push_back({u, outOffset[u]});
+                } else if (onStack[u] && index[u] < low[v]) {
+                    low[v] = index[u];
+                }
+                continue;
+            }
+
+            // Все рёбра v просмотрены - "возврат из рекурсии"
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                int parent = callStack.back().first;
+                if (low[v] < low[parent]) {
+                    low[parent] = low[v];
+                }
+            }
+
+            if (low[v] == index[v]) {
+                int id = nextId++;
+                int u;
+                do {
+                    u = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[u] = false;
+                    assign(u, id);
+                } while (u != v);
+            }
+        }
+    }
+}
@@ -3,146 +3,38 @@
 #include <ctime>
 #include <cstdlib>
 
-std::vector<int> t;
-int n;
+// Общая реализация дерева Фенвика (сумма, минимум, максимум, отрезки, 2D)
+#include "../../common/fenwick/fenwick.hpp"
 
-void init(int nn) {
-    n = nn;
-    t.assign(n, 0);
-}
-
-int sum(int right) {
-    int result = 0;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result += t[right];
-    return result;
-}
-
-#обновление 
-void inc(int idx, int delta) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] += delta;
-}
-
-int sum(int left, int right) {
-    return sum(right) - sum(left - 1);
-}
+int main(int argc, char** argv) {
+    srand(time(0));
+    unsigned long int k = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100 * 1000 * 1000;
+    clock_t start, end;
 
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) inc(idx, a[idx]);
-}
+    std::vector<long long> a(k);
+    for (unsigned long int i = 0; i < k; ++i) {
+        a[i] = i;
+    }
+    // построение за O(n) вместо k вызовов inc
+    FenwickTree<long long> tree(a);
 
-int main() {
-    srand(time(0))
-    unsigned long int k = 1000 * 1000 * 1000;
-        clock_t start, end;
-        init(k);
+    for (int n = 1; n < 20; n += 1) {
+        unsigned long int left = rand() % k;
+        unsigned long int right = rand() % k;
 
-        for (unsigned long int i = 0; i < k; ++i) {
-            inc(i, i); 
+        if (left > right) {
+            std::swap(left, right);
         }
 
-        for (int n = 1; n < 20; n += 1) {
-            unsigned long int left = rand() % k;
-            unsigned long int right = rand() % k;
-
-            if (left > right) {
-                std::swap(left, right);
-            }
-
         start = clock();
-        sum(left, right); 
+        tree.query(left, right);
         end = clock();
 
         printf("Time %.7f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", left- right+1);
+        printf("Elements %lu\n", right - left + 1);
     }
-}
-
-
-/*
-#include <iostream>
-#include <algorithm>
-#include <vector>
-
-std:: vector<int> t;
-int n;
-
-const int INF = 1000 * 1000 * 1000;
-
-void init(int nn) {
-    n = nn;
-    t.assign(n, INF);
-}
-
-int getmin(int right) {
-    int result = INF;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result = std::min(result, t[right]);
-    return result;
-}
-
-void update(int idx, int new_val) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] = std::min(t[idx], new_val);
-}
 
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) update(idx, a[idx]);
+    // минимум на префиксе: тот же класс с операцией MinOp
+    FenwickTree<int, MinOp<int>> minimum(std::vector<int>{ 7, 4, 9, 2, 6 });
+    printf("Min %d\n", minimum.prefix(4));
 }
-
-int main() {
-    for (int k = 1;k < 1000 * 1000 * 1000 * 100;k *= 10) {
-        clock_t start, end;
-        start = clock();
-        init(k);
-        for (int i = 0; i < k; i++) { update(i, i); }
-        getmin(k - 1);
-        end = clock();
-        printf("Time %.4f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", k);
-    }
-}
-*/
-
-
-/*
-#include <iostream>
-#include <algorithm>
-#include <vector>
-
-std::vector<int> t;
-int n;
-
-const int INF = -1000 * 1000 * 1000;
-
-void init(int nn) {
-    n = nn;
-    t.assign(n, INF);
-}
-
-int getmax(int right) {
-    int result = INF;
-    for (; right >= 0; right = (right & (right + 1)) - 1) result = std::max(result, t[right]);
-    return result;
-}
-
-void update(int idx, int new_val) {
-    for (; idx < n; idx = (idx | (idx + 1))) t[idx] = std::max(t[idx], new_val);
-}
-
-void init(std::vector<int> a) {
-    init((int)a.size());
-    for (unsigned idx = 0; idx < a.size(); idx++) update(idx, a[idx]);
-}
-
-int main() {
-    for (int k = 1;k < 1000 * 1000 * 1000 * 100;k *= 10) {
-        clock_t start, end;
-        start = clock();
-        init(k);
-        for (int i = 0; i < k; i++) { update(i, i); }
-        getmax(k - 1);
-        end = clock();
-        printf("Time %.4f ", ((double)end - start) / ((double)CLOCKS_PER_SEC));
-        printf("Elements %d\n", k);
-    }
-*/
@@ -13,7 +13,7 @@ typedef struct MerkleNode {
 } MerkleNode;
 
 // Прототипы внутренних функций
-static void compute_hash(const char* data, char* output);
+static void compute_hash(const char* data, size_t len, char* output);
 static MerkleNode* create_leaf(const char* data);
 static MerkleNode* build_parent(MerkleNode* left, MerkleNode* right);
 static MerkleNode* build_merkle_layer(MerkleNode** nodes, int count);
@@ -23,13 +23,15 @@ MerkleNode* build_merkle_tree(const char** data, int count);
 void destroy_merkle_tree(MerkleNode* root);
 const char* get_merkle_root(const MerkleNode* root);
 
-// Вычисляет SHA-256 и сохраняет в виде HEX-строки
-static void compute_hash(const char* data, char* output) {
+// Вычисляет SHA-256 и сохраняет в виде HEX-строки (по таблице, без sprintf)
+static void compute_hash(const char* data, size_t len, char* output) {
+    static const char digits[] = "0123456789abcdef";
     unsigned char raw[SHA256_DIGEST_LENGTH];
-    SHA256((const unsigned char*)data, strlen(data), raw);
+    SHA256((const unsigned char*)data, len, raw);
 
     for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-        sprintf(output + (i * 2), "%02x", raw[i]);
+        output[i * 2] = digits[raw[i] >> 4];
+        output[i * 2 + 1] = digits[raw[i] & 0x0f];
     }
     output[SHA256_HEX_LENGTH - 1] = '\0';
 }
@@ -39,7 +41,7 @@ static MerkleNode* create_leaf(const char* data) {
     MerkleNode* node = (MerkleNode*)malloc(sizeof(MerkleNode));
     if (!node) return NULL;
 
-    compute_hash(data, node->hash);
+    compute_hash(data, strlen(data), node->hash);
     node->left = node->right = NULL;
     return node;
 }
@@ -49,11 +51,13 @@ static MerkleNode* build_parent(MerkleNode* left, MerkleNode* right) {
     MerkleNode* parent = (MerkleNode*)malloc(sizeof(MerkleNode));
     if (!parent) return NULL;
 
-    char combined[SHA256_HEX_LENGTH * 2 + 1] = {0};
+    // Хеши потомков фиксированной длины склеиваются копированием, без snprintf
+    char combined[(SHA256_HEX_LENGTH - 1) * 2];
     const char* right_hash = right ? right->hash : left->hash;
-    
-    snprintf(combined, sizeof(combined), "%s%s", left->hash, right_hash);
-    compute_hash(combined, parent->hash);
+
+    memcpy(combined, left->hash, SHA256_HEX_LENGTH - 1);
+    memcpy(combined + SHA256_HEX_LENGTH - 1, right_hash, SHA256_HEX_LENGTH - 1);
+    compute_hash(combined, sizeof(combined), parent->hash);
     
     parent->left = left;
     parent->right = right;
@@ -21,6 +21,10 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #include <string.h>
+#include <functional>
+#include <poll.h>
+
+#include "../../../common/timer_wheel/timer_wheel.h"
 
 #define TCP_PORT 8888
 #define UDP_SENSOR_PORT 5601
@@ -28,6 +32,14 @@
 #define SEND_INTERVAL_MS 50
 #define LOST_MAX_SEC 10
 
+enum TimerGroup
+{
+    HEARTBEAT_TIMERS = 1,
+    BATCH_TIMERS,
+    LOST_TIMERS,
+    REVERSE_TIMERS
+};
+
 const std::string PC_IP = "192.168.31.3";
 
 std::mutex log_mutex;
@@ -290,9 +302,9 @@ int main()
         std::chrono::milliseconds duration;
     };
     std::deque<TimedCmd> cmdHistory;
-    std::mutex historyMutex;
-    std::atomic<bool> lostMode{false};
-    std::atomic<bool> batchRunning{false};
+    bool lostMode = false;
+    bool batchRunning = false;
+    bool reverseRunning = false;
 
     auto invertCmd = [](char c) -> char
     {
@@ -312,11 +324,135 @@ int main()
     };
 
     char lastCommand = 'X';
-    auto lastActivity = std::chrono::steady_clock::now();
-    auto lastSend = std::chrono::steady_clock::now();
     auto cmdStart = std::chrono::steady_clock::now();
     int client_fd = -1;
 
+    // Timed motor commands run from the timer wheel in this thread, so the loop
+    // below keeps reading the socket while a batch or a rollback is in progress
+    TimerWheel timers;
+    using Clock = TimerWheel::Clock;
+
+    auto printJitter = [&timers]()
+    {
+        auto j = timers.jitter();
+        if (j.count == 0)
+            return;
+        std::cout << "Timer jitter: " << j.count << " timers, mean " << std::fixed << std::setprecision(1)
+                  << j.meanUs << " us, p99 " << j.p99Us << " us, max " << j.maxUs << " us\n"
+                  << std::defaultfloat << std::flush;
+    };
+
+    // W/S/A/D is repeated every SEND_INTERVAL_MS and stops after INACTIVITY_MS without a key
+    std::function<void()> keepAlive = [&]()
+    {
+        write(serial_fd, &lastCommand, 1);
+        timers.schedule(std::chrono::milliseconds(SEND_INTERVAL_MS), keepAlive, HEARTBEAT_TIMERS);
+    };
+    auto armHeartbeat = [&]()
+    {
+        timers.cancelGroup(HEARTBEAT_TIMERS);
+        timers.schedule(std::chrono::milliseconds(SEND_INTERVAL_MS), keepAlive, HEARTBEAT_TIMERS);
+        timers.schedule(std::chrono::milliseconds(INACTIVITY_MS), [&]()
+                        {
+            timers.cancelGroup(HEARTBEAT_TIMERS);
+            write(serial_fd, "X", 1);
+            lastCommand = 'X';
+            std::cout << "\rCmd: TIMEOUT   " << std::flush; }, HEARTBEAT_TIMERS);
+    };
+
+    auto stopBatch = [&]()
+    {
+        if (!batchRunning)
+            return;
+        timers.cancelGroup(BATCH_TIMERS);
+        write(serial_fd, "X", 1);
+        batchRunning = false;
+        std::cout << "\nBatch command is interrupted\n"
+                  << std::flush;
+    };
+
+    auto stopLost = [&]()
+    {
+        if (!lostMode)
+            return;
+        timers.cancelGroup(LOST_TIMERS);
+        write(serial_fd, "X", 1);
+        cmdHistory.clear();
+        lostMode = false;
+        std::cout << "\nLost is interrupted\n"
+                  << std::flush;
+    };
+
+    // The disconnect reverse always ends with "X", even when it is cut short
+    auto stopReverse = [&]()
+    {
+        if (!reverseRunning)
+            return;
+        timers.cancelGroup(REVERSE_TIMERS);
+        write(serial_fd, "X", 1);
+        reverseRunning = false;
+    };
+
+    // Every step of a batch is planned from the start of the batch, so a late
+    // timer does not shift the steps after it
+    auto startBatch = [&](const std::vector<BatchCmd> &cmds)
+    {
+        batchRunning = true;
+        auto at = Clock::now();
+        for (const auto &bc : cmds)
+        {
+            char cmd = bc.cmd;
+            int ms = bc.ms;
+            timers.scheduleAt(at, [&, cmd, ms]()
+                              {
+                std::cout << "Batch commmand" << cmd << " " << ms << "ms\n" << std::flush;
+                write(serial_fd, &cmd, 1); }, BATCH_TIMERS);
+            for (int t = SEND_INTERVAL_MS; t < ms; t += SEND_INTERVAL_MS)
+                timers.scheduleAt(at + std::chrono::milliseconds(t), [&, cmd]()
+                                  { write(serial_fd, &cmd, 1); }, BATCH_TIMERS);
+            at += std::chrono::milliseconds(ms);
+            timers.scheduleAt(at, [&]()
+                              { write(serial_fd, "X", 1); }, BATCH_TIMERS);
+            at += std::chrono::milliseconds(100);
+        }
+        timers.scheduleAt(at, [&]()
+                          {
+            write(serial_fd, "X", 1);
+            batchRunning = false;
+            std::cout << "Batch command is done\n" << std::flush;
+            printJitter(); }, BATCH_TIMERS);
+    };
+
+    auto startLost = [&]()
+    {
+        auto start = Clock::now();
+        auto at = start;
+        for (auto it = cmdHistory.rbegin(); it != cmdHistory.rend(); ++it)
+        {
+            if (at - start > std::chrono::seconds(LOST_MAX_SEC))
+                break;
+            char inv = invertCmd(it->cmd);
+            if (inv == 'X')
+                continue;
+            auto duration = it->duration;
+            timers.scheduleAt(at, [&, inv, duration]()
+                              {
+                write(serial_fd, &inv, 1);
+                std::cout << "[LOST] " << inv << " " << duration.count() << "ms\n" << std::flush; }, LOST_TIMERS);
+            at += duration;
+            timers.scheduleAt(at, [&]()
+                              { write(serial_fd, "X", 1); }, LOST_TIMERS);
+            at += std::chrono::milliseconds(100);
+        }
+        timers.scheduleAt(at, [&]()
+                          {
+            write(serial_fd, "X", 1);
+            cmdHistory.clear();
+            lostMode = false;
+            std::cout << "Lost is done\n" << std::flush;
+            printJitter(); }, LOST_TIMERS);
+    };
+
     while (running)
     {
         if (client_fd == -1 && !lostMode)
@@ -328,19 +464,16 @@ int main()
             {
                 client_fd = fd;
                 fcntl(client_fd, F_SETFL, O_NONBLOCK);
-                batchRunning = false;
+                stopBatch();
+                stopReverse();
                 std::cout << "Connected: " << inet_ntoa(caddr.sin_addr) << "\n"
                           << std::flush;
                 lastCommand = 'X';
-                lastActivity = std::chrono::steady_clock::now();
-                {
-                    std::lock_guard<std::mutex> lk(historyMutex);
-                    cmdHistory.clear();
-                }
+                cmdHistory.clear();
             }
         }
 
-        if (client_fd >= 0 && !lostMode)
+        if (client_fd >= 0)
         {
             char buf[256];
             ssize_t n = recv(client_fd, buf, sizeof(buf) - 1, 0);
@@ -349,6 +482,9 @@ int main()
             {
                 buf[n] = '\0';
 
+                // A new command from the client preempts a running batch or rollback at once
+                stopLost();
+
                 if (n > 1)
                 {
                     std::string line(buf, n);
@@ -356,37 +492,20 @@ int main()
                         line.pop_back();
                     std::cout << "Batch command\"" << line << "\"\n"
                               << std::flush;
-                    if (!batchRunning)
+                    auto cmds = parseBatch(line);
+                    if (!cmds.empty())
                     {
-                        auto cmds = parseBatch(line);
-                        if (!cmds.empty())
-                        {
-                            batchRunning = true;
-                            std::thread([&, cmds]()
-                                        {
-                                for (auto &bc : cmds) {
-                                    if (!batchRunning || !running) break;
-                                    std::cout << "Batch commmand" << bc.cmd << " " << bc.ms << "ms\n" << std::flush;
-                                    write(serial_fd, &bc.cmd, 1);
-                                    int steps = bc.ms / 50;
-                                    for (int i = 0; i < steps && batchRunning && running; i++) {
-                                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                                        write(serial_fd, &bc.cmd, 1);
-                                    }
-                                    write(serial_fd, "X", 1);
-                                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                                }
-                                write(serial_fd, "X", 1);
-                                batchRunning = false;
-                                std::cout << "Batch command is done\n" << std::flush; })
-                                .detach();
-                        }
+                        stopBatch();
+                        timers.cancelGroup(HEARTBEAT_TIMERS);
+                        lastCommand = 'X';
+                        startBatch(cmds);
                     }
                 }
                 else
                 {
                     char ch = std::toupper(buf[0]);
                     std::cout << "\rCmd: " << ch << "   " << std::flush;
+                    stopBatch();
 
                     if (ch == 'Q')
                     {
@@ -396,43 +515,23 @@ int main()
 
                     if (ch == 'L')
                     {
+                        timers.cancelGroup(HEARTBEAT_TIMERS);
+                        lastCommand = 'X';
                         lostMode = true;
-                        batchRunning = false;
                         write(serial_fd, "X", 1);
                         std::cout << "\nLost starts\n"
                                   << std::flush;
-                        std::thread([&]()
-                                    {
-                            std::deque<TimedCmd> copy;
-                            { std::lock_guard<std::mutex> lk(historyMutex); copy = cmdHistory; }
-                            auto start = std::chrono::steady_clock::now();
-                            for (auto it = copy.rbegin(); it != copy.rend(); ++it) {
-                                if (!running) break;
-                                if (std::chrono::steady_clock::now() - start >
-                                    std::chrono::seconds(LOST_MAX_SEC)) break;
-                                char inv = invertCmd(it->cmd);
-                                if (inv == 'X') continue;
-                                write(serial_fd, &inv, 1);
-                                std::cout << "[LOST] " << inv << " " << it->duration.count() << "ms\n" << std::flush;
-                                std::this_thread::sleep_for(it->duration);
-                                write(serial_fd, "X", 1);
-                                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                            }
-                            write(serial_fd, "X", 1);
-                            { std::lock_guard<std::mutex> lk(historyMutex); cmdHistory.clear(); }
-                            lostMode = false;
-                            std::cout << "Lost is done\n" << std::flush; })
-                            .detach();
+                        startLost();
                     }
                     else if (ch == 'X')
                     {
+                        timers.cancelGroup(HEARTBEAT_TIMERS);
                         if (lastCommand != 'X')
                         {
                             auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(
                                 std::chrono::steady_clock::now() - cmdStart);
                             if (dur.count() > 50)
                             {
-                                std::lock_guard<std::mutex> lk(historyMutex);
                                 if (!cmdHistory.empty() && cmdHistory.back().cmd == lastCommand)
                                     cmdHistory.back().duration += dur;
                                 else
@@ -452,8 +551,7 @@ int main()
                             cmdStart = std::chrono::steady_clock::now();
                         }
                         lastCommand = ch;
-                        lastActivity = std::chrono::steady_clock::now();
-                        lastSend = std::chrono::steady_clock::now();
+                        armHeartbeat();
                     }
                 }
             }
@@ -463,45 +561,46 @@ int main()
                           << std::flush;
                 close(client_fd);
                 client_fd = -1;
-                batchRunning = false;
+                stopBatch();
+                stopLost();
+                timers.cancelGroup(HEARTBEAT_TIMERS);
+                auto at = Clock::now();
+                reverseRunning = true;
                 for (int i = 0; i < 20; i++)
-                {
-                    write(serial_fd, "S", 1);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                }
-                write(serial_fd, "X", 1);
+                    timers.scheduleAt(at + std::chrono::milliseconds(50 * i), [&]()
+                                      { write(serial_fd, "S", 1); }, REVERSE_TIMERS);
+                timers.scheduleAt(at + std::chrono::milliseconds(50 * 20), [&]()
+                                  { write(serial_fd, "X", 1);
+                                    reverseRunning = false; }, REVERSE_TIMERS);
                 lastCommand = 'X';
             }
             else if (errno != EAGAIN && errno != EWOULDBLOCK)
             {
                 close(client_fd);
                 client_fd = -1;
-                batchRunning = false;
+                stopBatch();
+                stopLost();
+                timers.cancelGroup(HEARTBEAT_TIMERS);
                 write(serial_fd, "X", 1);
                 lastCommand = 'X';
             }
         }
 
-        if (!lostMode && !batchRunning && lastCommand != 'X' &&
-            std::chrono::steady_clock::now() - lastActivity >=
-                std::chrono::milliseconds(INACTIVITY_MS))
-        {
-            write(serial_fd, "X", 1);
-            lastCommand = 'X';
-            std::cout << "\rCmd: TIMEOUT   " << std::flush;
-        }
-
-        if (!lostMode && !batchRunning && lastCommand != 'X' &&
-            std::chrono::steady_clock::now() - lastSend >=
-                std::chrono::milliseconds(SEND_INTERVAL_MS))
-        {
-            write(serial_fd, &lastCommand, 1);
-            lastSend = std::chrono::steady_clock::now();
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        // Sleep until a socket is readable or the next timer is due
+        struct pollfd fds[2] = {{timers.fd(), POLLIN, 0}, {-1, POLLIN, 0}};
+        if (client_fd >= 0)
+            fds[1].fd = client_fd;
+        else if (!lostMode)
+            fds[1].fd = server_fd;
+        if (poll(fds, 2, 100) > 0 && (fds[0].revents & POLLIN))
+            timers.runExpired();
     }
 
+    timers.cancelGroup(HEARTBEAT_TIMERS);
+    timers.cancelGroup(BATCH_TIMERS);
+    timers.cancelGroup(LOST_TIMERS);
+    stopReverse();
+    printJitter();
     running = false;
     write(serial_fd, "X", 1);
     if (client_fd >= 0)
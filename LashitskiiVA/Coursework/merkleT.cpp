@@ -26,15 +26,19 @@ public:
     }
 };
 
-MerkleNode* buildMerkleTree(std::vector<std::string> leaves) {
-    if (leaves.size() % 2 != 0) {
-        leaves.push_back(leaves.back());
+MerkleNode* buildMerkleTree(const std::vector<std::string>& leaves) {
+    if (leaves.empty()) {
+        return nullptr;
     }
 
     std::vector<MerkleNode*> nodes;
+    nodes.reserve(leaves.size() + 1);
     for (const auto& leaf : leaves) {
         nodes.push_back(new MerkleNode(leaf));
     }
+    if (nodes.size() % 2 != 0) {
+        nodes.push_back(nodes.back());
+    }
 
     while (nodes.size() > 1) {
         if (nodes.size() % 2 != 0) {
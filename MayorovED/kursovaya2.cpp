@@ -1,96 +1,109 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <openssl/sha.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 
-class MerkleNode {
-public:
-    std::string hash;
-    MerkleNode* left;
-    MerkleNode* right;
+#include "merkle_tree.h"
 
-    // Конструктор для листового узла
-    MerkleNode(const std::string& h) : hash(h), left(nullptr), right(nullptr) {}
+using merkle::Digest;
+using merkle::MerkleTree;
 
-    // Конструктор для внутреннего узла
-    MerkleNode(MerkleNode* l, MerkleNode* r) : left(l), right(r) {
-        hash = computeHash(l->hash + r->hash);
+// Функция построения дерева Меркла из набора блоков данных
+MerkleTree buildMerkleTree(const std::vector<std::string>& dataBlocks) {
+    return MerkleTree(dataBlocks);
+}
+
+// Проверка целостности всего набора данных: дерево строится заново
+bool verifyIntegrity(const std::vector<std::string>& dataBlocks, const Digest& rootHash) {
+    if (dataBlocks.empty()) return false;
+    return buildMerkleTree(dataBlocks).root() == rootHash;
+}
+
+// Проверка одного блока по доказательству включения за O(log n), без остальных данных
+bool verifyBlock(const std::string& block, size_t index, const std::vector<Digest>& proof, const Digest& rootHash) {
+    return MerkleTree::verify(merkle::sha256(block), index, proof, rootHash);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Замер скорости построения, обновления листьев и доказательств на каждой доступной реализации SHA-256
+void runBenchmark(size_t leafCount) {
+    std::vector<std::string> data(leafCount);
+    for (size_t i = 0; i < leafCount; ++i) {
+        data[i] = "block-" + std::to_string(i);
+        data[i].resize(32, '.');
     }
 
-private:
-    // Функция вычисления SHA-256 хеша
-    std::string computeHash(const std::string& data) {
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        SHA256((unsigned char*)data.c_str(), data.size(), hash);
-        std::string hashStr;
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
-            char buf[3];
-            sprintf(buf, "%02x", hash[i]);
-            hashStr += buf;
+    const merkle::Backend backends[] = {merkle::Backend::Scalar, merkle::Backend::Avx2, merkle::Backend::ShaNi};
+    const merkle::Backend detected = merkle::backend();
+
+    std::cout << "Листьев: " << leafCount << ", потоков: " << std::thread::hardware_concurrency() << std::endl;
+    for (merkle::Backend b : backends) {
+        if (!merkle::setBackend(b)) {
+            std::cout << merkle::backendName(b) << ": не поддерживается процессором" << std::endl;
+            continue;
         }
-        return hashStr;
-    }
-};
 
-// Функция построения дерева Меркла из набора блоков данных
-MerkleNode* buildMerkleTree(const std::vector<std::string>& dataBlocks) {
-    if (dataBlocks.empty()) return nullptr;
+        auto start = std::chrono::steady_clock::now();
+        MerkleTree tree(data);
+        double buildTime = secondsSince(start);
 
-    std::vector<MerkleNode*> nodes;
-    // Создаем листовые узлы
-    for (const auto& block : dataBlocks) {
-        nodes.push_back(new MerkleNode(computeHash(block)));
-    }
+        const size_t updates = 200000;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < updates; ++i) {
+            size_t index = (i * 2654435761u) % leafCount;
+            tree.update(index, data[index]);
+        }
+        double updateTime = secondsSince(start);
 
-    // Строим дерево снизу вверх
-    while (nodes.size() > 1) {
-        std::vector<MerkleNode*> newLevel;
-        for (size_t i = 0; i < nodes.size(); i += 2) {
-            MerkleNode* left = nodes[i];
-            // Если узлов нечетное количество, дублируем последний узел
-            MerkleNode* right = (i + 1 < nodes.size()) ? nodes[i + 1] : left;
-            MerkleNode* parent = new MerkleNode(left, right);
-            newLevel.push_back(parent);
+        const size_t proofs = 200000;
+        size_t verified = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < proofs; ++i) {
+            size_t index = (i * 40503u) % leafCount;
+            verified += MerkleTree::verify(tree.leaf(index), index, tree.proof(index), tree.root());
         }
-        nodes = newLevel;
-    }
-    return nodes[0];
-}
+        double proofTime = secondsSince(start);
 
-// Функция вычисления хеша для блока данных (вспомогательная)
-std::string computeHash(const std::string& data) {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256((unsigned char*)data.c_str(), data.size(), hash);
-    std::string hashStr;
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
-        char buf[3];
-        sprintf(buf, "%02x", hash[i]);
-        hashStr += buf;
+        std::cout << merkle::backendName(b) << ": построение " << leafCount / buildTime / 1e6 << " млн листьев/с"
+                  << ", обновление " << updates / updateTime / 1e3 << " тыс/с"
+                  << ", доказательство+проверка " << proofs / proofTime / 1e3 << " тыс/с"
+                  << (verified == proofs ? "" : " (ОШИБКА ПРОВЕРКИ)")
+                  << ", корень " << merkle::toHex(tree.root()).substr(0, 16) << "..." << std::endl;
     }
-    return hashStr;
+    merkle::setBackend(detected);
 }
 
-// Функция проверки целостности данных
-bool verifyIntegrity(const std::vector<std::string>& dataBlocks, const std::string& rootHash) {
-    MerkleNode* root = buildMerkleTree(dataBlocks);
-    if (!root) return false;
-    return root->hash == rootHash;
-}
+// Пример работы алгоритма; с ключом --bench [N] - замер скорости
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        size_t leafCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : (1u << 22);
+        runBenchmark(leafCount > 0 ? leafCount : 1);
+        return 0;
+    }
 
-// Пример работы алгоритма
-int main() {
     // Набор данных
     std::vector<std::string> data = {"data1", "data2", "data3", "data4"};
 
     // Построение дерева и получение корневого хеша
-    MerkleNode* root = buildMerkleTree(data);
-    std::string rootHash = root->hash;
-    std::cout << "Корневой хеш: " << rootHash << std::endl;
+    MerkleTree tree = buildMerkleTree(data);
+    Digest rootHash = tree.root();
+    std::cout << "Корневой хеш: " << merkle::toHex(rootHash) << std::endl;
+    std::cout << "SHA-256: " << merkle::backendName(merkle::backend()) << std::endl;
 
     // Проверка целостности исходных данных
     bool isValid = verifyIntegrity(data, rootHash);
     std::cout << "Целостность данных: " << (isValid ? "Подтверждена" : "Нарушена") << std::endl;
 
+    // Доказательство включения третьего блока
+    std::vector<Digest> proof = tree.proof(2);
+    isValid = verifyBlock(data[2], 2, proof, rootHash);
+    std::cout << "Блок 2 по доказательству из " << proof.size() << " хешей: " << (isValid ? "Подтвержден" : "Не подтвержден") << std::endl;
+
     // Изменение данных
     std::vector<std::string> modifiedData = data;
     modifiedData[2] = "data3_modified";
@@ -98,6 +111,25 @@ int main() {
     // Проверка целостности после изменения
     isValid = verifyIntegrity(modifiedData, rootHash);
     std::cout << "Целостность после изменения: " << (isValid ? "Подтверждена" : "Нарушена") << std::endl;
+    isValid = verifyBlock(modifiedData[2], 2, proof, rootHash);
+    std::cout << "Измененный блок 2 по доказательству: " << (isValid ? "Подтвержден" : "Не подтвержден") << std::endl;
+
+    // Обновление листа пересчитывает только путь до корня
+    tree.update(2, modifiedData[2]);
+    std::cout << "Корень после обновления листа: " << merkle::toHex(tree.root()) << std::endl;
+    std::cout << "Совпадает с полным перестроением: "
+              << (tree.root() == buildMerkleTree(modifiedData).root() ? "Да" : "Нет") << std::endl;
+
+    // Пустое дерево: корень из нулей, листьев нет, доказательство не строится
+    MerkleTree empty = buildMerkleTree({});
+    std::cout << "Пустое дерево: листьев " << empty.size() << ", корень нулевой: "
+              << (empty.root() == Digest{} ? "Да" : "Нет") << std::endl;
+    try {
+        empty.proof(0);
+        std::cout << "Доказательство для пустого дерева: построено" << std::endl;
+    } catch (const std::out_of_range&) {
+        std::cout << "Доказательство для пустого дерева: индекс вне диапазона" << std::endl;
+    }
 
     return 0;
 }
\ No newline at end of file
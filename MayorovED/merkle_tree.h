@@ -0,0 +1,640 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define MERKLE_X86 1
+#endif
+
+// Дерево Меркла в плоском массиве над сырыми 32-байтными хешами SHA-256.
+// Уровни лежат подряд: сначала листья, затем родители, в конце корень.
+// Родитель = SHA-256(левый || правый), при нечетном числе узлов последний
+// узел дублируется. Обновление листа и доказательство включения - O(log n).
+namespace merkle {
+
+using Digest = std::array<uint8_t, 32>;
+
+// Реализация SHA-256 для хеширования пачками выбирается по процессору при первом обращении
+enum class Backend { Scalar, Avx2, ShaNi };
+
+namespace detail {
+
+alignas(32) static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// Второй блок сообщения из 64 байт одинаков для всех узлов:
+// 0x80, нули и длина 512 бит. Его расписание K[t] + W[t] считается один раз
+struct PaddingSchedule {
+    uint32_t kw[64];
+    uint8_t block[64];
+
+    PaddingSchedule() {
+        uint32_t w[64] = {0x80000000};
+        w[15] = 512;
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (int t = 0; t < 64; t++) kw[t] = K[t] + w[t];
+        std::memset(block, 0, sizeof(block));
+        block[0] = 0x80;
+        block[62] = 0x02;
+    }
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+};
+
+inline const PaddingSchedule& padding() {
+    static const PaddingSchedule schedule;
+    return schedule;
+}
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+inline uint32_t loadBE(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+inline void storeBE(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// 64 раунда над готовым расписанием K[t] + W[t]
+inline void roundsScalar(uint32_t state[8], const uint32_t* kw) {
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; t++) {
+        uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kw[t];
+        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+inline void compressScalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    uint32_t w[64];
+    for (; blocks > 0; blocks--, data += 64) {
+        for (int t = 0; t < 16; t++) w[t] = loadBE(data + 4 * t);
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (int t = 0; t < 64; t++) w[t] += K[t];
+        roundsScalar(state, w);
+    }
+}
+
+#ifdef MERKLE_X86
+
+// Инструкции SHA-NI: четыре раунда на пару sha256rnds2
+__attribute__((target("sha,sse4.1")))
+inline void compressShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);        // CDGH
+
+    for (; blocks > 0; blocks--, data += 64) {
+        __m128i abefSave = state0, cdghSave = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16 * i)), byteSwap);
+
+        for (int i = 0; i < 16; i++) {
+            __m128i m = _mm_add_epi32(msg[i & 3], _mm_load_si128((const __m128i*)&K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(m, 0x0E));
+            if (i < 12) {
+                // W[t..t+3] = sigma1(W[t-2]) + W[t-7] + sigma0(W[t-15]) + W[t-16]
+                __m128i x = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                x = _mm_add_epi32(x, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(x, msg[(i + 3) & 3]);
+            }
+        }
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);             // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);          // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);       // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);          // HGFE
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+// Восемь независимых сообщений в полосах AVX2: в каждом регистре
+// одно и то же слово состояния восьми хешей
+struct State8 {
+    __m256i s[8];
+};
+
+#define MERKLE_AVX2 __attribute__((target("avx2")))
+
+MERKLE_AVX2 inline __m256i rotr8(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Транспонирование 8x8 слов: строка i - 32 байта сообщения i, столбец t - слово t всех сообщений
+MERKLE_AVX2 inline void transpose8(__m256i r[8]) {
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+MERKLE_AVX2 inline __m256i byteSwap8(__m256i x) {
+    const __m256i mask = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+MERKLE_AVX2 inline void init8(State8& st) {
+    for (int i = 0; i < 8; i++) st.s[i] = _mm256_set1_epi32((int)H0[i]);
+}
+
+// Раунды над расписанием w; withK - w уже содержит K[t]
+MERKLE_AVX2 inline void rounds8(State8& st, const __m256i* w, bool withK) {
+    __m256i a = st.s[0], b = st.s[1], c = st.s[2], d = st.s[3];
+    __m256i e = st.s[4], f = st.s[5], g = st.s[6], h = st.s[7];
+    for (int t = 0; t < 64; t++) {
+        __m256i kw = withK ? w[t] : _mm256_add_epi32(w[t], _mm256_set1_epi32((int)K[t]));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1), _mm256_add_epi32(ch, kw));
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = _mm256_add_epi32(s0, maj);
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+    st.s[0] = _mm256_add_epi32(st.s[0], a); st.s[1] = _mm256_add_epi32(st.s[1], b);
+    st.s[2] = _mm256_add_epi32(st.s[2], c); st.s[3] = _mm256_add_epi32(st.s[3], d);
+    st.s[4] = _mm256_add_epi32(st.s[4], e); st.s[5] = _mm256_add_epi32(st.s[5], f);
+    st.s[6] = _mm256_add_epi32(st.s[6], g); st.s[7] = _mm256_add_epi32(st.s[7], h);
+}
+
+// Один 64-байтный блок из каждого из восьми сообщений
+MERKLE_AVX2 inline void compress8(State8& st, const uint8_t* const blocks[8]) {
+    __m256i w[64];
+    for (int half = 0; half < 2; half++) {
+        __m256i* r = w + 8 * half;
+        for (int i = 0; i < 8; i++) r[i] = _mm256_loadu_si256((const __m256i*)(blocks[i] + 32 * half));
+        transpose8(r);
+        for (int i = 0; i < 8; i++) r[i] = byteSwap8(r[i]);
+    }
+    for (int t = 16; t < 64; t++) {
+        __m256i x = w[t - 15], y = w[t - 2];
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(x, 7), rotr8(x, 18)), _mm256_srli_epi32(x, 3));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(y, 17), rotr8(y, 19)), _mm256_srli_epi32(y, 10));
+        w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+    }
+    rounds8(st, w, false);
+}
+
+// Общий для всех полос блок дополнения 64-байтного сообщения
+MERKLE_AVX2 inline void compressPadding8(State8& st) {
+    __m256i w[64];
+    const PaddingSchedule& pad = padding();
+    for (int t = 0; t < 64; t++) w[t] = _mm256_set1_epi32((int)pad.kw[t]);
+    rounds8(st, w, true);
+}
+
+MERKLE_AVX2 inline void store8(const State8& st, Digest* const out[8]) {
+    __m256i r[8];
+    for (int i = 0; i < 8; i++) r[i] = byteSwap8(st.s[i]);
+    transpose8(r);
+    for (int i = 0; i < 8; i++) _mm256_storeu_si256((__m256i*)out[i]->data(), r[i]);
+}
+
+#undef MERKLE_AVX2
+
+inline bool cpuHasShaNi() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+}
+
+#endif
+
+inline void finish(const uint32_t state[8], Digest& out) {
+    for (int i = 0; i < 8; i++) storeBE(out.data() + 4 * i, state[i]);
+}
+
+inline void compress(uint32_t state[8], const uint8_t* data, size_t blocks, bool shaNi) {
+#ifdef MERKLE_X86
+    if (shaNi) {
+        compressShaNi(state, data, blocks);
+        return;
+    }
+#endif
+    compressScalar(state, data, blocks);
+}
+
+inline Digest sha256(const void* data, size_t len, bool shaNi) {
+    uint32_t state[8];
+    std::memcpy(state, H0, sizeof(state));
+    size_t full = len / 64;
+    compress(state, (const uint8_t*)data, full, shaNi);
+
+    uint8_t tail[128] = {0};
+    size_t rest = len - full * 64;
+    std::memcpy(tail, (const uint8_t*)data + full * 64, rest);
+    tail[rest] = 0x80;
+    size_t tailBlocks = rest + 9 > 64 ? 2 : 1;
+    uint64_t bits = (uint64_t)len * 8;
+    for (int i = 0; i < 8; i++) tail[tailBlocks * 64 - 1 - i] = (uint8_t)(bits >> (8 * i));
+    compress(state, tail, tailBlocks, shaNi);
+
+    Digest out;
+    finish(state, out);
+    return out;
+}
+
+inline Digest hashPair(const Digest& left, const Digest& right, bool shaNi) {
+    uint8_t block[64];
+    std::memcpy(block, left.data(), 32);
+    std::memcpy(block + 32, right.data(), 32);
+    uint32_t state[8];
+    std::memcpy(state, H0, sizeof(state));
+    compress(state, block, 1, shaNi);
+    if (shaNi) {
+        compress(state, padding().block, 1, true);
+    } else {
+        roundsScalar(state, padding().kw);
+    }
+    Digest out;
+    finish(state, out);
+    return out;
+}
+
+// Сообщение с дополнением SHA-256; возвращает число 64-байтных блоков
+inline size_t padMessage(const void* data, size_t len, std::vector<uint8_t>& buf) {
+    size_t blocks = (len + 9 + 63) / 64;
+    buf.assign(blocks * 64, 0);
+    std::memcpy(buf.data(), data, len);
+    buf[len] = 0x80;
+    uint64_t bits = (uint64_t)len * 8;
+    for (int i = 0; i < 8; i++) buf[buf.size() - 1 - i] = (uint8_t)(bits >> (8 * i));
+    return blocks;
+}
+
+inline void levelSingle(const Digest* level, size_t count, Digest* parents, size_t begin, size_t end, bool shaNi) {
+    for (size_t i = begin; i < end; i++)
+        parents[i] = hashPair(level[2 * i], level[std::min(2 * i + 1, count - 1)], shaNi);
+}
+
+inline void leavesSingle(const std::string* data, Digest* out, size_t begin, size_t end, bool shaNi) {
+    for (size_t i = begin; i < end; i++) out[i] = sha256(data[i].data(), data[i].size(), shaNi);
+}
+
+#ifdef MERKLE_X86
+
+// Родители [begin, end) уровня из count узлов, по восемь за проход
+inline void levelAvx2(const Digest* level, size_t count, Digest* parents, size_t begin, size_t end, bool shaNi) {
+    size_t whole = begin + (end - begin) / 8 * 8;
+    for (size_t i = begin; i < whole; i += 8) {
+        // Пары соседних хешей уже лежат в памяти подряд, кроме дублируемого последнего
+        uint8_t odd[64];
+        const uint8_t* ptrs[8];
+        Digest* outs[8];
+        for (int lane = 0; lane < 8; lane++) {
+            size_t p = i + lane;
+            if (2 * p + 1 < count) {
+                ptrs[lane] = level[2 * p].data();
+            } else {
+                std::memcpy(odd, level[2 * p].data(), 32);
+                std::memcpy(odd + 32, level[2 * p].data(), 32);
+                ptrs[lane] = odd;
+            }
+            outs[lane] = &parents[p];
+        }
+        State8 st;
+        init8(st);
+        compress8(st, ptrs);
+        compressPadding8(st);
+        store8(st, outs);
+    }
+    levelSingle(level, count, parents, whole, end, shaNi);
+}
+
+// Листья по восемь, если у всех восьми одинаковое число блоков
+inline void leavesAvx2(const std::string* data, Digest* out, size_t begin, size_t end, bool shaNi) {
+    std::vector<uint8_t> bufs[8];
+    size_t whole = begin + (end - begin) / 8 * 8;
+    for (size_t i = begin; i < whole; i += 8) {
+        size_t blocks[8];
+        bool same = true;
+        for (int lane = 0; lane < 8; lane++) {
+            blocks[lane] = padMessage(data[i + lane].data(), data[i + lane].size(), bufs[lane]);
+            same = same && blocks[lane] == blocks[0];
+        }
+        if (!same) {
+            leavesSingle(data, out, i, i + 8, shaNi);
+            continue;
+        }
+        State8 st;
+        init8(st);
+        for (size_t b = 0; b < blocks[0]; b++) {
+            const uint8_t* ptrs[8];
+            for (int lane = 0; lane < 8; lane++) ptrs[lane] = bufs[lane].data() + 64 * b;
+            compress8(st, ptrs);
+        }
+        Digest* outs[8];
+        for (int lane = 0; lane < 8; lane++) outs[lane] = &out[i + lane];
+        store8(st, outs);
+    }
+    leavesSingle(data, out, whole, end, shaNi);
+}
+
+#endif
+
+inline bool hasShaNi() {
+#ifdef MERKLE_X86
+    static const bool supported = cpuHasShaNi();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+inline bool hasAvx2() {
+#ifdef MERKLE_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Что быстрее на пачке узлов, SHA-NI по одному сообщению или восемь полос AVX2,
+// зависит от процессора, поэтому при наличии обоих делается короткий замер
+__attribute__((noinline)) inline Backend detectBackend() {
+    if (!hasShaNi()) return hasAvx2() ? Backend::Avx2 : Backend::Scalar;
+    if (!hasAvx2()) return Backend::ShaNi;
+#ifdef MERKLE_X86
+    std::vector<Digest> level(2048), parents(level.size() / 2);
+    auto measure = [&](auto hashLevel) {
+        auto best = std::chrono::steady_clock::duration::max();
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            hashLevel(level.data(), level.size(), parents.data(), 0, parents.size(), true);
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+        }
+        return best;
+    };
+    if (measure(levelAvx2) < measure(levelSingle)) return Backend::Avx2;
+#endif
+    return Backend::ShaNi;
+}
+
+inline Backend& currentBackend() {
+    static Backend backend = detectBackend();
+    return backend;
+}
+
+// Одиночные хеши (обновление листа, доказательства) считаются через SHA-NI,
+// если он есть и не выбрана скалярная реализация
+inline bool useShaNi() {
+    return currentBackend() != Backend::Scalar && hasShaNi();
+}
+
+// Делит [0, count) на куски для потоков, границы кратны восьми для AVX2
+template <class F>
+void parallelFor(size_t count, size_t minPerThread, F f) {
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<size_t>(1, count / minPerThread));
+    if (threads <= 1) {
+        f(0, count);
+        return;
+    }
+    size_t chunk = ((count + threads - 1) / threads + 7) & ~(size_t)7;
+    std::vector<std::thread> pool;
+    for (size_t begin = chunk; begin < count; begin += chunk)
+        pool.emplace_back(f, begin, std::min(count, begin + chunk));
+    f(0, std::min(count, chunk));
+    for (auto& t : pool) t.join();
+}
+
+} // namespace detail
+
+// Реализация для хеширования пачками: построение дерева и уровней
+inline Backend backend() { return detail::currentBackend(); }
+
+// Для сравнения реализаций; неподдерживаемая процессором не выбирается
+inline bool setBackend(Backend b) {
+    if ((b == Backend::ShaNi && !detail::hasShaNi()) || (b == Backend::Avx2 && !detail::hasAvx2()))
+        return false;
+    detail::currentBackend() = b;
+    return true;
+}
+
+inline const char* backendName(Backend b) {
+    switch (b) {
+    case Backend::ShaNi: return "SHA-NI";
+    case Backend::Avx2: return "AVX2 x8";
+    default: return "scalar";
+    }
+}
+
+inline Digest sha256(const void* data, size_t len) {
+    return detail::sha256(data, len, detail::useShaNi());
+}
+
+inline Digest sha256(const std::string& data) {
+    return sha256(data.data(), data.size());
+}
+
+// Хеш пары узлов: SHA-256 от 64 байт left || right
+inline Digest hashPair(const Digest& left, const Digest& right) {
+    return detail::hashPair(left, right, detail::useShaNi());
+}
+
+// Хеши листьев [begin, end)
+inline void hashLeaves(const std::string* data, Digest* out, size_t begin, size_t end) {
+    bool shaNi = detail::useShaNi();
+#ifdef MERKLE_X86
+    if (detail::currentBackend() == Backend::Avx2) {
+        detail::leavesAvx2(data, out, begin, end, shaNi);
+        return;
+    }
+#endif
+    detail::leavesSingle(data, out, begin, end, shaNi);
+}
+
+// Родители [begin, end) уровня из count узлов
+inline void hashLevel(const Digest* level, size_t count, Digest* parents, size_t begin, size_t end) {
+    bool shaNi = detail::useShaNi();
+#ifdef MERKLE_X86
+    if (detail::currentBackend() == Backend::Avx2) {
+        detail::levelAvx2(level, count, parents, begin, end, shaNi);
+        return;
+    }
+#endif
+    detail::levelSingle(level, count, parents, begin, end, shaNi);
+}
+
+class MerkleTree {
+public:
+    MerkleTree() = default;
+
+    explicit MerkleTree(const std::vector<std::string>& blocks) {
+        build(blocks);
+    }
+
+    void build(const std::vector<std::string>& blocks) {
+        layout(blocks.size());
+        if (blocks.empty()) return;
+        detail::parallelFor(blocks.size(), PARALLEL_MIN, [&](size_t begin, size_t end) {
+            hashLeaves(blocks.data(), nodes.data(), begin, end);
+        });
+        buildLevels();
+    }
+
+    // Листья - уже готовые хеши
+    void buildFromDigests(const std::vector<Digest>& leaves) {
+        layout(leaves.size());
+        std::copy(leaves.begin(), leaves.end(), nodes.begin());
+        if (!leaves.empty()) buildLevels();
+    }
+
+    size_t size() const { return offsets.empty() ? 0 : offsets[1]; }
+
+    // У пустого дерева корень из нулей
+    Digest root() const { return nodes.empty() ? Digest{} : nodes.back(); }
+
+    const Digest& leaf(size_t index) const { return nodes.at(index); }
+
+    // Замена блока: пересчитывается только путь до корня
+    void update(size_t index, const std::string& block) {
+        updateDigest(index, sha256(block));
+    }
+
+    void updateDigest(size_t index, const Digest& digest) {
+        if (index >= size()) throw std::out_of_range("merkle: leaf index out of range");
+        nodes[index] = digest;
+        for (size_t level = 0; level + 2 < offsets.size(); level++) {
+            size_t count = offsets[level + 1] - offsets[level];
+            const Digest* base = nodes.data() + offsets[level];
+            size_t left = index & ~(size_t)1;
+            size_t right = std::min(left + 1, count - 1);
+            index /= 2;
+            nodes[offsets[level + 1] + index] = hashPair(base[left], base[right]);
+        }
+    }
+
+    // Соседние хеши снизу вверх; у дублированного узла сосед - он сам
+    std::vector<Digest> proof(size_t index) const {
+        if (index >= size()) throw std::out_of_range("merkle: leaf index out of range");
+        std::vector<Digest> path;
+        for (size_t level = 0; level + 2 < offsets.size(); level++) {
+            size_t count = offsets[level + 1] - offsets[level];
+            size_t sibling = std::min(index ^ 1, count - 1);
+            path.push_back(nodes[offsets[level] + sibling]);
+            index /= 2;
+        }
+        return path;
+    }
+
+    static bool verify(const Digest& leaf, size_t index, const std::vector<Digest>& proof, const Digest& root) {
+        Digest h = leaf;
+        for (const Digest& sibling : proof) {
+            h = (index & 1) ? hashPair(sibling, h) : hashPair(h, sibling);
+            index /= 2;
+        }
+        return index == 0 && h == root;
+    }
+
+private:
+    // Уровни короче этого хешируются в одном потоке
+    static constexpr size_t PARALLEL_MIN = 1 << 14;
+
+    std::vector<Digest> nodes;
+    std::vector<size_t> offsets;  // начало каждого уровня, последний элемент - nodes.size()
+
+    void layout(size_t leafCount) {
+        offsets.clear();
+        if (leafCount == 0) {  // пустое дерево: ни уровней, ни узлов
+            nodes.clear();
+            return;
+        }
+        size_t total = 0;
+        for (size_t count = leafCount; count > 0; count = (count + 1) / 2) {
+            offsets.push_back(total);
+            total += count;
+            if (count == 1) break;
+        }
+        offsets.push_back(total);
+        nodes.assign(total, Digest{});
+    }
+
+    void buildLevels() {
+        for (size_t level = 0; level + 2 < offsets.size(); level++) {
+            size_t count = offsets[level + 1] - offsets[level];
+            const Digest* base = nodes.data() + offsets[level];
+            Digest* parents = nodes.data() + offsets[level + 1];
+            detail::parallelFor((count + 1) / 2, PARALLEL_MIN, [&](size_t begin, size_t end) {
+                hashLevel(base, count, parents, begin, end);
+            });
+        }
+    }
+};
+
+inline std::string toHex(const Digest& d) {
+    static const char digits[] = "0123456789abcdef";
+    std::string s(64, '0');
+    for (size_t i = 0; i < d.size(); i++) {
+        s[2 * i] = digits[d[i] >> 4];
+        s[2 * i + 1] = digits[d[i] & 15];
+    }
+    return s;
+}
+
+} // namespace merkle
+
+#ifdef MERKLE_X86
+#undef MERKLE_X86
+#endif
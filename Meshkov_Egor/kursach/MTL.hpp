@@ -1,15 +1,52 @@
 #pragma once
 #include "vec.hpp"
 #include "point.hpp"
+#include <cstddef>
 #include <vector>
 
 namespace MTL {
 
 
+// Non-owning structure-of-arrays view: x[i], y[i] is the i-th point
+template <typename T>
+struct PointCloud {
+    const T* x;
+    const T* y;
+    size_t size;
+};
+
+
 template <typename T>
 std::vector<Point<T>> jarvis(std::vector<Point<T>> points);
 
 
 template <typename T>
 std::vector<Point<T>> grethem(std::vector<Point<T>> points);
+
+
+// Hulls over a PointCloud return indices of the hull vertices in counterclockwise
+// order starting from the lowest leftmost point, without collinear points.
+// An empty result means there is no hull (fewer than 3 vertices)
+template <typename T>
+std::vector<size_t> monotone_chain(const PointCloud<T>& points);
+
+
+template <typename T>
+std::vector<size_t> monotone_chain(const PointCloud<T>& points, std::vector<size_t>& indices);
+
+
+template <typename T>
+std::vector<size_t> akl_toussaint(const PointCloud<T>& points, unsigned threads = 1);
+
+
+template <typename T>
+std::vector<size_t> quickhull(const PointCloud<T>& points, unsigned threads = 0);
+
+
+template <typename T>
+std::vector<size_t> convex_hull(const PointCloud<T>& points, unsigned threads = 0);
+
+
+template <typename T>
+std::vector<Point<T>> hull_points(const PointCloud<T>& points, const std::vector<size_t>& hull);
 }
@@ -0,0 +1,349 @@
+#include "point.hpp"
+#include "MTL.hpp"
+#include <algorithm>
+#include <array>
+#include <future>
+#include <thread>
+#include <vector>
+
+
+namespace MTL {
+
+
+static const size_t PARALLEL_CUTOFF = 1 << 16;
+
+
+template <typename T>
+static inline T cross(const PointCloud<T>& p, size_t a, size_t b, size_t c) {
+    return (p.x[b] - p.x[a]) * (p.y[c] - p.y[a]) - (p.y[b] - p.y[a]) * (p.x[c] - p.x[a]);
+}
+
+
+template <typename T>
+static inline bool less_xy(const PointCloud<T>& p, size_t a, size_t b) {
+    return p.x[a] < p.x[b] || (p.x[a] == p.x[b] && p.y[a] < p.y[b]);
+}
+
+
+static inline unsigned thread_count(unsigned threads, size_t size) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t useful = std::max<size_t>(1, size / PARALLEL_CUTOFF);
+    return static_cast<unsigned>(std::min<size_t>(threads, useful));
+}
+
+
+// Calls body(part, begin, end) for `parts` contiguous chunks of [0, size), each in its own thread
+template <typename Body>
+static void parallel_chunks(size_t size, unsigned parts, Body body) {
+    if (parts <= 1) {
+        body(0u, size_t(0), size);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned part = 1; part < parts; ++part) {
+        workers.emplace_back(body, part, size * part / parts, size * (part + 1) / parts);
+    }
+    body(0u, size_t(0), size / parts);
+    for (auto& worker : workers) worker.join();
+}
+
+
+template <typename T>
+std::vector<size_t> monotone_chain(const PointCloud<T>& points, std::vector<size_t>& indices) {
+    if (indices.size() < 3) return std::vector<size_t>();
+
+    std::sort(indices.begin(), indices.end(), [&points] (size_t a, size_t b) -> bool {
+        return less_xy(points, a, b);
+    });
+
+    std::vector<size_t> hull(2 * indices.size());
+    size_t size = 0;
+
+    for (size_t idx = 0; idx < indices.size(); ++idx) {
+        while (size >= 2 && cross(points, hull[size - 2], hull[size - 1], indices[idx]) <= 0) --size;
+        hull[size++] = indices[idx];
+    }
+
+    const size_t lower = size + 1;
+    for (size_t idx = indices.size() - 1; idx-- > 0;) {
+        while (size >= lower && cross(points, hull[size - 2], hull[size - 1], indices[idx]) <= 0) --size;
+        hull[size++] = indices[idx];
+    }
+
+    hull.resize(size - 1);
+    if (hull.size() < 3) hull.clear();
+
+    return hull;
+}
+
+
+template <typename T>
+std::vector<size_t> monotone_chain(const PointCloud<T>& points) {
+    std::vector<size_t> indices(points.size);
+    for (size_t idx = 0; idx < points.size; ++idx) indices[idx] = idx;
+
+    return monotone_chain(points, indices);
+}
+
+
+// Akl-Toussaint heuristic: points strictly inside the octagon spanned by the
+// extremes in x, y, x + y and x - y can not be hull vertices and are dropped
+template <typename T>
+std::vector<size_t> akl_toussaint(const PointCloud<T>& points, unsigned threads) {
+    const size_t n = points.size;
+    std::vector<size_t> survivors;
+    if (n < 3) {
+        for (size_t idx = 0; idx < n; ++idx) survivors.push_back(idx);
+        return survivors;
+    }
+
+    // Counterclockwise: left, bottom-left, bottom, bottom-right, right, top-right, top, top-left
+    const unsigned parts = thread_count(threads, n);
+    std::vector<std::array<size_t, 8>> local_extremes(parts);
+
+    parallel_chunks(n, parts, [&points, &local_extremes] (unsigned part, size_t begin, size_t end) {
+        const T* x = points.x;
+        const T* y = points.y;
+        std::array<size_t, 8> e;
+        e.fill(begin);
+        T min_x = x[begin], max_x = min_x, min_y = y[begin], max_y = min_y;
+        T min_sum = min_x + min_y, max_sum = min_sum, min_diff = min_x - min_y, max_diff = min_diff;
+
+        for (size_t idx = begin + 1; idx < end; ++idx) {
+            const T xi = x[idx], yi = y[idx], sum = xi + yi, diff = xi - yi;
+            if (xi < min_x) { min_x = xi; e[0] = idx; }
+            if (sum < min_sum) { min_sum = sum; e[1] = idx; }
+            if (yi < min_y) { min_y = yi; e[2] = idx; }
+            if (diff > max_diff) { max_diff = diff; e[3] = idx; }
+            if (xi > max_x) { max_x = xi; e[4] = idx; }
+            if (sum > max_sum) { max_sum = sum; e[5] = idx; }
+            if (yi > max_y) { max_y = yi; e[6] = idx; }
+            if (diff < min_diff) { min_diff = diff; e[7] = idx; }
+        }
+        local_extremes[part] = e;
+    });
+
+    const T* x = points.x;
+    const T* y = points.y;
+    std::array<size_t, 8> e = local_extremes[0];
+    for (unsigned part = 1; part < parts; ++part) {
+        const std::array<size_t, 8>& l = local_extremes[part];
+        if (x[l[0]] < x[e[0]]) e[0] = l[0];
+        if (x[l[1]] + y[l[1]] < x[e[1]] + y[e[1]]) e[1] = l[1];
+        if (y[l[2]] < y[e[2]]) e[2] = l[2];
+        if (x[l[3]] - y[l[3]] > x[e[3]] - y[e[3]]) e[3] = l[3];
+        if (x[l[4]] > x[e[4]]) e[4] = l[4];
+        if (x[l[5]] + y[l[5]] > x[e[5]] + y[e[5]]) e[5] = l[5];
+        if (y[l[6]] > y[e[6]]) e[6] = l[6];
+        if (x[l[7]] - y[l[7]] < x[e[7]] - y[e[7]]) e[7] = l[7];
+    }
+
+    std::vector<size_t> polygon;
+    for (size_t idx : e) {
+        if (polygon.empty() || (x[polygon.back()] != x[idx] || y[polygon.back()] != y[idx])) polygon.push_back(idx);
+    }
+    while (polygon.size() > 1 && x[polygon.back()] == x[polygon[0]] && y[polygon.back()] == y[polygon[0]]) {
+        polygon.pop_back();
+    }
+
+    // With ties or rounding the octagon may degenerate, then nothing is filtered
+    bool convex = polygon.size() >= 3;
+    for (size_t idx = 0; convex && idx < polygon.size(); ++idx) {
+        size_t next = (idx + 1) % polygon.size();
+        size_t after = (idx + 2) % polygon.size();
+        convex = cross(points, polygon[idx], polygon[next], polygon[after]) > 0;
+    }
+
+    if (!convex) {
+        survivors.resize(n);
+        for (size_t idx = 0; idx < n; ++idx) survivors[idx] = idx;
+        return survivors;
+    }
+
+    // Missing edges repeat the first one, so the test below always runs over exactly 8 edges
+    const size_t edges = polygon.size();
+    T ax[8], ay[8], dx[8], dy[8];
+    for (size_t k = 0; k < 8; ++k) {
+        size_t a = polygon[k < edges ? k : 0];
+        size_t b = polygon[k < edges ? (k + 1) % edges : 1];
+        ax[k] = x[a];
+        ay[k] = y[a];
+        dx[k] = x[b] - x[a];
+        dy[k] = y[b] - y[a];
+    }
+
+    std::vector<std::vector<size_t>> local_survivors(parts);
+    parallel_chunks(n, parts, [&] (unsigned part, size_t begin, size_t end) {
+        // Branch-free compaction into a small buffer: the index is always written,
+        // the counter moves only for survivors
+        const size_t BLOCK = 1024;
+        size_t buffer[BLOCK];
+        std::vector<size_t>& out = local_survivors[part];
+        for (size_t block = begin; block < end; block += BLOCK) {
+            size_t block_end = std::min(end, block + BLOCK);
+            size_t count = 0;
+            for (size_t idx = block; idx < block_end; ++idx) {
+                bool inside = true;
+                for (size_t k = 0; k < 8; ++k) {
+                    inside &= dx[k] * (y[idx] - ay[k]) - dy[k] * (x[idx] - ax[k]) > 0;
+                }
+                buffer[count] = idx;
+                count += !inside;
+            }
+            out.insert(out.end(), buffer, buffer + count);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& part : local_survivors) total += part.size();
+    survivors.reserve(total);
+    for (const auto& part : local_survivors) survivors.insert(survivors.end(), part.begin(), part.end());
+
+    return survivors;
+}
+
+
+// Hull vertices strictly between a and b for the points in [first, last), all of which lie
+// strictly to the right of a -> b. The range is reordered in place
+template <typename T>
+static void quickhull_side(const PointCloud<T>& points, size_t* first, size_t* last, size_t a, size_t b,
+                           unsigned depth, std::vector<size_t>& hull) {
+    if (first == last) return;
+
+    // Among equally far points the one nearest to a along a -> b is taken: a middle point
+    // of a segment parallel to a -> b would not be a vertex
+    const T* x = points.x;
+    const T* y = points.y;
+    auto along = [x, y, a, b] (size_t idx) -> T {
+        return (x[idx] - x[a]) * (x[b] - x[a]) + (y[idx] - y[a]) * (y[b] - y[a]);
+    };
+
+    size_t farthest = *first;
+    T farthest_cross = cross(points, a, b, farthest);
+    for (size_t* it = first + 1; it != last; ++it) {
+        T current = cross(points, a, b, *it);
+        if (current < farthest_cross || (current == farthest_cross && along(*it) < along(farthest))) {
+            farthest_cross = current;
+            farthest = *it;
+        }
+    }
+
+    size_t* middle = std::partition(first, last, [&points, a, farthest] (size_t idx) -> bool {
+        return cross(points, a, farthest, idx) < 0;
+    });
+    size_t* end = std::partition(middle, last, [&points, farthest, b] (size_t idx) -> bool {
+        return cross(points, farthest, b, idx) < 0;
+    });
+
+    std::vector<size_t> right;
+    if (depth > 0 && static_cast<size_t>(middle - first) > PARALLEL_CUTOFF
+                  && static_cast<size_t>(end - middle) > PARALLEL_CUTOFF) {
+        auto left = std::async(std::launch::async, [&] () {
+            quickhull_side(points, first, middle, a, farthest, depth - 1, hull);
+        });
+        quickhull_side(points, middle, end, farthest, b, depth - 1, right);
+        left.get();
+    } else {
+        quickhull_side(points, first, middle, a, farthest, 0, hull);
+        quickhull_side(points, middle, end, farthest, b, 0, right);
+    }
+
+    hull.push_back(farthest);
+    hull.insert(hull.end(), right.begin(), right.end());
+}
+
+
+template <typename T>
+static std::vector<size_t> quickhull_indices(const PointCloud<T>& points, std::vector<size_t>& indices, unsigned threads) {
+    if (indices.size() < 3) return std::vector<size_t>();
+
+    size_t left = indices[0], right = indices[0];
+    for (size_t idx : indices) {
+        if (less_xy(points, idx, left)) left = idx;
+        if (less_xy(points, right, idx)) right = idx;
+    }
+    if (points.x[left] == points.x[right] && points.y[left] == points.y[right]) return std::vector<size_t>();
+
+    // Below a -> b goes to the front, above it to the back, the rest (including a and b) is dropped
+    size_t* first = indices.data();
+    size_t* last = first + indices.size();
+    size_t* lower_end = std::partition(first, last, [&points, left, right] (size_t idx) -> bool {
+        return cross(points, left, right, idx) < 0;
+    });
+    size_t* upper_end = std::partition(lower_end, last, [&points, left, right] (size_t idx) -> bool {
+        return cross(points, left, right, idx) > 0;
+    });
+
+    unsigned depth = 0;
+    while ((2u << depth) <= threads) ++depth;
+
+    std::vector<size_t> hull{left};
+    std::vector<size_t> upper;
+    if (depth > 0 && indices.size() > PARALLEL_CUTOFF) {
+        auto lower = std::async(std::launch::async, [&] () {
+            quickhull_side(points, first, lower_end, left, right, depth - 1, hull);
+        });
+        quickhull_side(points, lower_end, upper_end, right, left, depth - 1, upper);
+        lower.get();
+    } else {
+        quickhull_side(points, first, lower_end, left, right, 0, hull);
+        quickhull_side(points, lower_end, upper_end, right, left, 0, upper);
+    }
+
+    hull.push_back(right);
+    hull.insert(hull.end(), upper.begin(), upper.end());
+    if (hull.size() < 3) hull.clear();
+
+    return hull;
+}
+
+
+template <typename T>
+std::vector<size_t> quickhull(const PointCloud<T>& points, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<size_t> indices(points.size);
+    for (size_t idx = 0; idx < points.size; ++idx) indices[idx] = idx;
+
+    return quickhull_indices(points, indices, threads);
+}
+
+
+template <typename T>
+std::vector<size_t> convex_hull(const PointCloud<T>& points, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // QuickHull is faster on large inputs even in one thread, monotone chain keeps the O(n log n) bound otherwise
+    std::vector<size_t> candidates = akl_toussaint(points, threads);
+    if (candidates.size() > PARALLEL_CUTOFF) return quickhull_indices(points, candidates, threads);
+
+    return monotone_chain(points, candidates);
+}
+
+
+template <typename T>
+std::vector<Point<T>> hull_points(const PointCloud<T>& points, const std::vector<size_t>& hull) {
+    std::vector<Point<T>> result;
+    result.reserve(hull.size());
+    for (size_t idx : hull) result.push_back(Point<T>(points.x[idx], points.y[idx]));
+
+    return result;
+}
+
+
+template std::vector<size_t> monotone_chain(const PointCloud<double>&);
+template std::vector<size_t> monotone_chain(const PointCloud<float>&);
+template std::vector<size_t> monotone_chain(const PointCloud<double>&, std::vector<size_t>&);
+template std::vector<size_t> monotone_chain(const PointCloud<float>&, std::vector<size_t>&);
+template std::vector<size_t> akl_toussaint(const PointCloud<double>&, unsigned);
+template std::vector<size_t> akl_toussaint(const PointCloud<float>&, unsigned);
+template std::vector<size_t> quickhull(const PointCloud<double>&, unsigned);
+template std::vector<size_t> quickhull(const PointCloud<float>&, unsigned);
+template std::vector<size_t> convex_hull(const PointCloud<double>&, unsigned);
+template std::vector<size_t> convex_hull(const PointCloud<float>&, unsigned);
+template std::vector<Point<double>> hull_points(const PointCloud<double>&, const std::vector<size_t>&);
+template std::vector<Point<float>> hull_points(const PointCloud<float>&, const std::vector<size_t>&);
+
+
+}
@@ -23,8 +23,8 @@ static inline size_t find_base_point(const std::vector<Point<T>>& points) {
 size_t idx_base_point = 0;
 
 for(size_t idx = 1; idx < points.size(); ++idx) {
-    if((points[idx].x < points[0].x) 
-        || (points[idx].x == points[0].x && points[idx].y < points[0].y)) {
+    if((points[idx].x < points[idx_base_point].x) 
+        || (points[idx].x == points[idx_base_point].x && points[idx].y < points[idx_base_point].y)) {
         idx_base_point = idx;
     }
 }
@@ -36,8 +36,7 @@ return idx_base_point;
 template <typename T>
 static inline void jarvis_hull_upload(std::vector<Point<T>>& hull, std::vector<Point<T>>& points) {
 hull.push_back(points[0]);
-points.erase(points.begin());
-points.push_back(hull[0]);
+std::swap(points[0], points.back());
 
 bool flag_is_line = true;
 
@@ -57,7 +56,8 @@ while (true) {
         break;
     } else {
         hull.push_back(points[right]);
-        points.erase(points.begin() + right);
+        std::swap(points[right], points.back());
+        points.pop_back();
     }
 }
 
@@ -72,9 +72,7 @@ static inline void grethem_hull_upload(std::vector<Point<T>>& hull, std::vector<
     hull.push_back(points[1]);
     
     for(size_t idx = 2; idx < points.size(); ++idx) {
-        T rotation = rotate( hull[hull.size() - 2], hull.back(), points[idx]);
-
-        if (rotation <= 0) hull.pop_back();
+        while (hull.size() >= 2 && rotate(hull[hull.size() - 2], hull.back(), points[idx]) <= 0) hull.pop_back();
         
         hull.push_back(points[idx]);
     }
@@ -1,11 +1,106 @@
 #include "MTL.hpp"
 #include "point.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <random>
+#include <string>
 #include <vector>
 
+
+// Сравнение оболочек по координатам вершин
+static bool same_hull(const std::vector<MTL::Point2d>& a, const std::vector<MTL::Point2d>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t idx = 0; idx < a.size(); ++idx) {
+        if (a[idx].x != b[idx].x || a[idx].y != b[idx].y) return false;
+    }
+    return true;
+}
+
+
+// Замер на облаке точек, равномерно заполняющих круг (как скан лидара вокруг датчика)
+static void benchmark(size_t count) {
+    using namespace MTL;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> angle(0, 2 * M_PI);
+    std::uniform_real_distribution<> radius(0, 1);
+
+    std::vector<double> xs(count), ys(count);
+    std::vector<Point2d> points;
+    points.reserve(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+        double r = 100 * std::sqrt(radius(gen));
+        double phi = angle(gen);
+        xs[idx] = 250 + r * std::cos(phi);
+        ys[idx] = 250 + r * std::sin(phi);
+        points.push_back(Point2d(xs[idx], ys[idx]));
+    }
+    PointCloud<double> cloud{xs.data(), ys.data(), count};
+
+    auto seconds_since = [] (std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Point2d> reference = hull_points(cloud, monotone_chain(cloud));
+    double reference_time = seconds_since(start);
+
+    std::cout << "Точек: " << count << ", вершин оболочки: " << reference.size() << std::endl;
+    std::cout << "monotone_chain: " << reference_time * 1e3 << " мс" << std::endl;
+
+    auto report = [&] (const std::string& name, double time, const std::vector<Point2d>& hull) {
+        std::cout << name << ": " << time * 1e3 << " мс"
+                  << (same_hull(hull, reference) ? "" : " (ОБОЛОЧКА НЕ СОВПАДАЕТ)") << std::endl;
+    };
+
+    if (count <= 1000000) {
+        start = std::chrono::steady_clock::now();
+        std::vector<Point2d> hull = jarvis(points);
+        report("jarvis", seconds_since(start), hull);
+    } else {
+        std::cout << "jarvis: пропущен, O(nh) на таком объеме слишком долго" << std::endl;
+    }
+
+    start = std::chrono::steady_clock::now();
+    std::vector<Point2d> hull = grethem(points);
+    report("grethem", seconds_since(start), hull);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<size_t> candidates = akl_toussaint(cloud);
+    double filter_time = seconds_since(start);
+    std::cout << "akl_toussaint: " << filter_time * 1e3 << " мс, осталось "
+              << candidates.size() << " точек" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    candidates = akl_toussaint(cloud);
+    hull = hull_points(cloud, monotone_chain(cloud, candidates));
+    report("akl_toussaint + monotone_chain", seconds_since(start), hull);
+
+    start = std::chrono::steady_clock::now();
+    hull = hull_points(cloud, quickhull(cloud, 1));
+    report("quickhull, 1 поток", seconds_since(start), hull);
+
+    start = std::chrono::steady_clock::now();
+    hull = hull_points(cloud, quickhull(cloud));
+    report("quickhull, все потоки", seconds_since(start), hull);
+
+    start = std::chrono::steady_clock::now();
+    hull = hull_points(cloud, convex_hull(cloud));
+    report("convex_hull", seconds_since(start), hull);
+}
+
+
 int main (int argc, char *argv[]) {
     
     using namespace MTL;
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        long long count = argc > 2 ? std::atoll(argv[2]) : 1000000;
+        benchmark(count > 3 ? count : 3);
+        return 0;
+    }
+
     std::random_device rd;
     std::mt19937 gen(rd());
 
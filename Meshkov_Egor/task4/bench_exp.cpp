@@ -0,0 +1,144 @@
+#include "matrix.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+// Accuracy and speed of Matrix::exp (Pade + scaling and squaring)
+// against the former Taylor series implementation with its default 50 terms.
+//
+// Test matrix is Q * B * Q^T, where B is block diagonal with 2x2 blocks
+// [a -b; b a] and Q is a Householder reflection, so the exact exponent
+// Q * exp(B) * Q^T is known: exp of a block is e^a [cos b -sin b; sin b cos b].
+
+
+using namespace MTL;
+using Clock = std::chrono::steady_clock;
+
+
+// Former Matrix::exp(iteration_count = 50), unchanged apart from being a free function
+static Matrix taylor_exp(const Matrix& M, const unsigned int iteration_count = 50) {
+    Matrix exp_matrix = M;
+    exp_matrix += Matrix(M.get_rows(), M.get_cols()).to_unit();
+
+    Matrix tmp = M;
+
+    double number = 1.0;
+
+    for(unsigned int k = 2; k <= iteration_count; ++k) {
+        number *= 1.0 / k;
+        tmp *= M;
+        tmp *= number;
+        exp_matrix += tmp;
+        tmp *= 1.0 / number;
+    }
+
+    return exp_matrix;
+}
+
+
+// Q = I - 2 v v^T / (v^T v), Q is symmetric and orthogonal
+static Matrix householder(const std::vector<double>& v) {
+    const size_t n = v.size();
+    double vv = 0.0;
+    for(double x : v) vv += x * x;
+
+    Matrix Q(n, n);
+    for(size_t row = 0; row < n; ++row) {
+        for(size_t col = 0; col < n; ++col) {
+            Q.at(row, col) = (row == col ? 1.0 : 0.0) - 2.0 * v[row] * v[col] / vv;
+        }
+    }
+    return Q;
+}
+
+
+static double relative_error(Matrix& A, Matrix& exact) {
+    double diff = 0.0, norm = 0.0;
+    for(size_t row = 0; row < A.get_rows(); ++row) {
+        for(size_t col = 0; col < A.get_cols(); ++col) {
+            const double d = A.at(row, col) - exact.at(row, col);
+            diff += d * d;
+            norm += exact.at(row, col) * exact.at(row, col);
+        }
+    }
+    return std::sqrt(diff / norm);
+}
+
+
+// Average time of one call, repeated for at least 0.2 s
+template <typename F>
+static double time_per_call(F&& call) {
+    int reps = 0;
+    const Clock::time_point start = Clock::now();
+    std::chrono::duration<double> elapsed;
+    do {
+        call();
+        ++reps;
+        elapsed = Clock::now() - start;
+    } while(elapsed.count() < 0.2);
+    return elapsed.count() / reps;
+}
+
+
+static void bench(std::mt19937& rng, size_t n, double scale) {
+    std::uniform_real_distribution<double> real(-scale, scale / 4);
+    std::uniform_real_distribution<double> imag(-scale, scale);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    Matrix B(n, n), expB(n, n);
+    B.to_zeros();
+    expB.to_zeros();
+    for(size_t blk = 0; blk + 1 < n; blk += 2) {
+        const double a = real(rng);
+        const double b = imag(rng);
+        B.at(blk, blk) = a;
+        B.at(blk, blk + 1) = -b;
+        B.at(blk + 1, blk) = b;
+        B.at(blk + 1, blk + 1) = a;
+        expB.at(blk, blk) = std::exp(a) * std::cos(b);
+        expB.at(blk, blk + 1) = -std::exp(a) * std::sin(b);
+        expB.at(blk + 1, blk) = std::exp(a) * std::sin(b);
+        expB.at(blk + 1, blk + 1) = std::exp(a) * std::cos(b);
+    }
+    if(n % 2) {
+        const double a = real(rng);
+        B.at(n - 1, n - 1) = a;
+        expB.at(n - 1, n - 1) = std::exp(a);
+    }
+
+    std::vector<double> v(n);
+    for(double& x : v) x = unit(rng);
+    const Matrix Q = householder(v);
+    const Matrix M = Q * B * Q;
+    Matrix exact = Q * expB * Q;
+
+    // Separate results: Matrix move assignment is skipped when operator==
+    // (relative 1e-9) already finds the target equal
+    Matrix taylor, pade;
+    const double taylor_time = time_per_call([&] { taylor = taylor_exp(M); });
+    const double taylor_err = relative_error(taylor, exact);
+
+    const double pade_time = time_per_call([&] { pade = M.exp(); });
+    const double pade_err = relative_error(pade, exact);
+
+    std::printf("n=%4zu ||A||~%6.1f | taylor %10.6f s err %9.2e | pade %10.6f s err %9.2e\n",
+                n, scale, taylor_time, taylor_err, pade_time, pade_err);
+}
+
+
+int main() {
+    // Matrix traces its constructors to std::cout, results go through printf
+    std::cout.rdbuf(nullptr);
+
+    std::mt19937 rng(1);
+    for(size_t n : {4, 16, 64, 256}) {
+        for(double scale : {0.1, 1.0, 10.0, 50.0}) {
+            bench(rng, n, scale);
+        }
+    }
+    return 0;
+}
@@ -577,18 +577,107 @@ Matrix Matrix::reverse() {
 }
 
 
-double Matrix::find_max_element() {
-    double max_element = data[0];
+double Matrix::norm_1() const noexcept {
+    double norm = 0.0;
 
-    for(size_t idx = 1; idx < rows * cols; idx++) {
-        max_element = (data[idx] > max_element) ? data[idx] : max_element;
+    for(size_t col = 0; col < cols; col++) {
+        double sum = 0.0;
+        for(size_t row = 0; row < rows; row++) {
+            sum += std::fabs(data[row * cols + col]);
+        }
+        norm = std::max(norm, sum);
     }
-    
-    return max_element;
+
+    return norm;
 }
 
 
-Matrix Matrix::exp(const unsigned int iteration_count) {
+namespace {
+
+
+// Pade [13/13] coefficients (Higham, 2005)
+const double pade_coef[14] = {
+    64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+    1187353796428800.0, 129060195264000.0, 10559470521600.0,
+    670442572800.0, 33522128640.0, 1323241920.0,
+    40840800.0, 960960.0, 16380.0, 182.0, 1.0
+};
+
+// Max norm of scaled matrix for which Pade [13/13] reaches double precision
+const double pade_theta_13 = 5.371920351148152;
+
+
+// C = A * B for n x n raw buffers
+void mul_square(double *C, const double *A, const double *B, size_t n) {
+    std::fill(C, C + n * n, 0.0);
+    for(size_t row = 0; row < n; ++row) {
+        for(size_t inner = 0; inner < n; ++inner) {
+            const double a = A[row * n + inner];
+            for(size_t col = 0; col < n; ++col) {
+                C[row * n + col] += a * B[inner * n + col];
+            }
+        }
+    }
+}
+
+
+// R = c6 * A6 + c4 * A4 + c2 * A2 + c0 * I
+void pade_poly(double *R, const double *A6, const double *A4, const double *A2,
+               double c6, double c4, double c2, double c0, size_t n) {
+    for(size_t idx = 0; idx < n * n; ++idx) {
+        R[idx] = c6 * A6[idx] + c4 * A4[idx] + c2 * A2[idx];
+    }
+    for(size_t idx = 0; idx < n * n; idx += n + 1) {
+        R[idx] += c0;
+    }
+}
+
+
+// Solve A * X = B in place of B, A is destroyed
+void solve_square(double *A, double *B, size_t n) {
+    for(size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        for(size_t row = col + 1; row < n; ++row) {
+            if(std::fabs(A[row * n + col]) > std::fabs(A[pivot * n + col])) pivot = row;
+        }
+        if(!(std::fabs(A[pivot * n + col]) > 0.0)) { // also catches NaN
+            throw MatrixExceptionDeterminantZero();
+        }
+        if(pivot != col) {
+            std::swap_ranges(A + col * n, A + col * n + n, A + pivot * n);
+            std::swap_ranges(B + col * n, B + col * n + n, B + pivot * n);
+        }
+        for(size_t row = col + 1; row < n; ++row) {
+            double factor = A[row * n + col] / A[col * n + col];
+            for(size_t idx = col + 1; idx < n; ++idx) {
+                A[row * n + idx] -= factor * A[col * n + idx];
+            }
+            for(size_t idx = 0; idx < n; ++idx) {
+                B[row * n + idx] -= factor * B[col * n + idx];
+            }
+        }
+    }
+
+    for(size_t row = n; row-- > 0;) {
+        for(size_t inner = row + 1; inner < n; ++inner) {
+            const double u = A[row * n + inner];
+            for(size_t idx = 0; idx < n; ++idx) {
+                B[row * n + idx] -= u * B[inner * n + idx];
+            }
+        }
+        for(size_t idx = 0; idx < n; ++idx) {
+            B[row * n + idx] /= A[row * n + row];
+        }
+    }
+}
+
+
+}
+
+
+// Scaling and squaring with Pade [13/13]: 6 products, one solve and s squarings,
+// all temporaries in one preallocated workspace
+Matrix Matrix::exp() const {
     if(this->is_empty()) {
         throw MatrixExceptionIsEmpty();
     } 
@@ -597,22 +686,59 @@ Matrix Matrix::exp(const unsigned int iteration_count) {
         throw MatrixExceptionNotSquare();
     }
 
-    Matrix exp_matrix = *this;
-    exp_matrix += Matrix(rows, cols).to_unit();
+    const size_t n = rows;
+    const size_t size = n * n;
+    const double *b = pade_coef;
+
+    std::unique_ptr<double[]> workspace = std::make_unique<double[]>(7 * size);
+    double *A = workspace.get();
+    double *A2 = A + size;
+    double *A4 = A2 + size;
+    double *A6 = A4 + size;
+    double *T1 = A6 + size;
+    double *T2 = T1 + size;
+    double *T3 = T2 + size;
 
-    Matrix tmp = *this;
+    double norm = norm_1();
+    int squarings = (norm > pade_theta_13) ? static_cast<int>(std::ceil(std::log2(norm / pade_theta_13))) : 0;
+    double scale = std::ldexp(1.0, -squarings);
+    for(size_t idx = 0; idx < size; ++idx) {
+        A[idx] = data[idx] * scale;
+    }
 
-    double number = 1.0;
+    mul_square(A2, A, A, n);
+    mul_square(A4, A2, A2, n);
+    mul_square(A6, A4, A2, n);
+
+    // U = A * (A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I)
+    pade_poly(T1, A6, A4, A2, b[13], b[11], b[9], 0.0, n);
+    mul_square(T2, A6, T1, n);
+    pade_poly(T1, A6, A4, A2, b[7], b[5], b[3], b[1], n);
+    for(size_t idx = 0; idx < size; ++idx) T2[idx] += T1[idx];
+
+    // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+    pade_poly(T1, A6, A4, A2, b[12], b[10], b[8], 0.0, n);
+    mul_square(T3, A6, T1, n);
+    pade_poly(T1, A6, A4, A2, b[6], b[4], b[2], b[0], n);
+    for(size_t idx = 0; idx < size; ++idx) T3[idx] += T1[idx];
+
+    mul_square(A2, A, T2, n);
+
+    // (V - U) * R = V + U
+    for(size_t idx = 0; idx < size; ++idx) {
+        T1[idx] = T3[idx] + A2[idx];
+        T3[idx] -= A2[idx];
+    }
+    solve_square(T3, T1, n);
 
-    for(unsigned int k = 2; k <= iteration_count; ++k) {
-        number *= 1.0 / k;
-        tmp *= (*this);
-        tmp *= number;
-        exp_matrix += tmp;
-        tmp *= 1.0 / number;
+    double *current = T1;
+    double *next = T2;
+    for(int k = 0; k < squarings; ++k) {
+        mul_square(next, current, current, n);
+        std::swap(current, next);
     }
 
-    return exp_matrix;
+    return Matrix(current, rows, cols);
 }
 
 
@@ -102,7 +102,7 @@ public:
     double determinant() const;
     Matrix reverse();
     Matrix transpoze();
-    Matrix exp(const unsigned int iteration_count = 50);
+    Matrix exp() const;
     void print(unsigned char accuracy = 3);
 
 
@@ -139,7 +139,7 @@ private:
     int transform_extend_matrix();
 
     // Auxilary function for exp()
-    double find_max_element();
+    double norm_1() const noexcept;
 };
 
 
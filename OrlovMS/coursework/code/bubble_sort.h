@@ -1,12 +1,15 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <utility>
 #include "comparator.h"
 
 
-template<typename Element>
-void bubble_sort(std::vector<Element> &array, const Comparator<Element>comp = is_greater)
+template<typename Element, typename Compare = IsGreater>
+void bubble_sort(std::vector<Element> &array, Compare comp = Compare())
 {
+    if(array.size() < 2) return;
+
     size_t itr_num = array.size() - 1;  // iterations number
 
     for(size_t itr = 0; itr < itr_num; itr++) {
@@ -1,8 +1,27 @@
 #pragma once
 
 
-template<typename Element>
-using Comparator = bool(*)(const Element &, const Element &);
+// Comparator returns true when A has to be placed after B.
+// Functors are passed by value as a template parameter, so the call is inlined;
+// plain functions such as is_greater<int> are still accepted.
+struct IsGreater
+{
+    template<typename Element>
+    bool operator()(const Element &A, const Element &B) const
+    {
+        return A > B;
+    }
+};
+
+
+struct IsLess
+{
+    template<typename Element>
+    bool operator()(const Element &A, const Element &B) const
+    {
+        return A < B;
+    }
+};
 
 
 template<typename Element>
@@ -1,11 +1,12 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <utility>
 #include "comparator.h"
 
 
-template<typename Element>
-void restore_heap(std::vector<Element> &array, size_t root_idx, const size_t heap_size, const Comparator<Element>comp)
+template<typename Element, typename Compare>
+void restore_heap(Element *heap, size_t root_idx, const size_t heap_size, Compare comp)
 {
     while(true)
     {
@@ -13,15 +14,15 @@ void restore_heap(std::vector<Element> &array, size_t root_idx, const size_t hea
         size_t child_right_idx = 2 * root_idx + 2;
 
         size_t largest_idx = root_idx;
-        if(child_left_idx < heap_size && comp(array[child_left_idx], array[largest_idx])) {
+        if(child_left_idx < heap_size && comp(heap[child_left_idx], heap[largest_idx])) {
             largest_idx = child_left_idx;
         }
-        if(child_right_idx < heap_size && comp(array[child_right_idx], array[largest_idx])) {
+        if(child_right_idx < heap_size && comp(heap[child_right_idx], heap[largest_idx])) {
             largest_idx = child_right_idx;
         }
 
         if(largest_idx != root_idx) {
-            std::swap(array[largest_idx], array[root_idx]);
+            std::swap(heap[largest_idx], heap[root_idx]);
             root_idx = largest_idx;
         }
         else break;
@@ -29,24 +30,30 @@ void restore_heap(std::vector<Element> &array, size_t root_idx, const size_t hea
 }
 
 
-template<typename Element>
-void build_heap(std::vector<Element> &array, const Comparator<Element>comp)
+template<typename Element, typename Compare>
+void build_heap(Element *heap, const size_t heap_size, Compare comp)
 {
-    size_t heap_size = array.size();
-
     for(size_t idx = heap_size / 2; idx > 0; idx--) {
-        restore_heap(array, idx - 1, heap_size, comp);
+        restore_heap(heap, idx - 1, heap_size, comp);
     }
 }
 
 
-template<typename Element>
-void heap_sort(std::vector<Element> &array, const Comparator<Element>comp = is_greater)
+// Sorts data[0, size), also used by intro_sort for too deep partitions
+template<typename Element, typename Compare>
+void heap_sort_range(Element *data, const size_t size, Compare comp)
 {
-    build_heap(array, comp);
+    build_heap(data, size, comp);
 
-    for(size_t idx = array.size(); idx > 0; idx--) {
-        std::swap(array[0], array[idx - 1]);
-        restore_heap(array, 0, idx - 1, comp);
+    for(size_t idx = size; idx > 0; idx--) {
+        std::swap(data[0], data[idx - 1]);
+        restore_heap(data, 0, idx - 1, comp);
     }
 }
+
+
+template<typename Element, typename Compare = IsGreater>
+void heap_sort(std::vector<Element> &array, Compare comp = Compare())
+{
+    heap_sort_range(array.data(), array.size(), comp);
+}
@@ -1,21 +1,27 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <utility>
 #include "comparator.h"
 
 
-template<typename Element>
-void insertion_sort(std::vector<Element> &array, const Comparator<Element>comp = is_greater)
+template<typename Element, typename Compare>
+void insertion_sort_range(Element *data, const size_t size, Compare comp)
 {
-    size_t idx_max = array.size();
-
-    for(size_t idx = 1; idx < idx_max; idx++) {
-        Element elem = array[idx];
+    for(size_t idx = 1; idx < size; idx++) {
+        Element elem = std::move(data[idx]);
 
         size_t insert_idx = idx;
-        for(;insert_idx > 0 && comp(array[insert_idx - 1], elem); insert_idx--) {
-            array[insert_idx] = array[insert_idx - 1];
+        for(;insert_idx > 0 && comp(data[insert_idx - 1], elem); insert_idx--) {
+            data[insert_idx] = std::move(data[insert_idx - 1]);
         }
-        array[insert_idx] = elem;
+        data[insert_idx] = std::move(elem);
     }
 }
+
+
+template<typename Element, typename Compare = IsGreater>
+void insertion_sort(std::vector<Element> &array, Compare comp = Compare())
+{
+    insertion_sort_range(array.data(), array.size(), comp);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "comparator.h"
+#include "heap_sort.h"
+#include "insertion_sort.h"
+
+
+const size_t INTRO_SORT_CUTOFF = 16;  // shorter ranges are sorted by insertion
+
+
+// Moves the median of data[idx_a], data[idx_b], data[idx_c] to data[0]
+template<typename Element, typename Compare>
+void move_median_first(Element *data, const size_t idx_a, const size_t idx_b, const size_t idx_c, Compare comp)
+{
+    // comp(B, A) means A goes before B
+    if(comp(data[idx_b], data[idx_a])) {
+        if(comp(data[idx_c], data[idx_b])) std::swap(data[0], data[idx_b]);
+        else if(comp(data[idx_c], data[idx_a])) std::swap(data[0], data[idx_c]);
+        else std::swap(data[0], data[idx_a]);
+    }
+    else if(comp(data[idx_c], data[idx_a])) std::swap(data[0], data[idx_a]);
+    else if(comp(data[idx_c], data[idx_b])) std::swap(data[0], data[idx_c]);
+    else std::swap(data[0], data[idx_b]);
+}
+
+
+// Hoare partition around data[0]. The median of three leaves elements on both sides
+// of the pivot, so the scans need no bounds checks.
+template<typename Element, typename Compare>
+size_t intro_sort_partition(Element *data, const size_t size, Compare comp)
+{
+    move_median_first(data, 1, size / 2, size - 1, comp);
+
+    size_t idx_low = 1;
+    size_t idx_high = size;
+    while(true) {
+        while(comp(data[0], data[idx_low])) idx_low++;
+        idx_high--;
+        while(comp(data[idx_high], data[0])) idx_high--;
+
+        if(idx_low >= idx_high) return idx_low;
+
+        std::swap(data[idx_low], data[idx_high]);
+        idx_low++;
+    }
+}
+
+
+template<typename Element, typename Compare>
+void intro_sort_internal(Element *data, size_t size, size_t depth_limit, Compare comp)
+{
+    while(size > INTRO_SORT_CUTOFF) {
+        if(depth_limit == 0) {
+            heap_sort_range(data, size, comp);  // bad pivots, keep O(n log n)
+            return;
+        }
+        depth_limit--;
+
+        size_t idx_cut = intro_sort_partition(data, size, comp);
+
+        // recursion on the right part, loop on the left one
+        intro_sort_internal(data + idx_cut, size - idx_cut, depth_limit, comp);
+        size = idx_cut;
+    }
+
+    insertion_sort_range(data, size, comp);
+}
+
+
+template<typename Element, typename Compare = IsGreater>
+void intro_sort(std::vector<Element> &array, Compare comp = Compare())
+{
+    size_t depth_limit = 0;
+    for(size_t len = array.size(); len > 1; len >>= 1) {
+        depth_limit += 2;
+    }
+
+    intro_sort_internal(array.data(), array.size(), depth_limit, comp);
+}
@@ -1,41 +1,116 @@
 #include <vector>
 #include <iostream>
 #include <cstdlib>
-#include <ctime>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <string>
 #include "bubble_sort.h"
 #include "heap_sort.h"
 #include "insertion_sort.h"
 #include "merge_sort.h"
 #include "quick_sort.h"
+#include "intro_sort.h"
+#include "radix_sort.h"
+#include "parallel_merge_sort.h"
 
 
-const size_t TEST_LEN[] = {5, 10, 20, 50, 100, 200, 500, 1000, 5000, 10000, 20000};
+const size_t TEST_LEN[] = {10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
 const int TEST_NUM = sizeof(TEST_LEN) / sizeof(size_t);
 
+const size_t QUADRATIC_MAX_LEN = 20000;  // bubble and insertion sort are not run on longer data
 
-int main()
+
+struct SortCase
 {
-    std::cout << "Data length, time (us)" << std::endl;
+    const char *name;
+    void (*sort)(std::vector<int> &);
+    size_t max_len;
+};
+
+
+const SortCase SORTS[] = {
+    {"bubble", [](std::vector<int> &arr) { bubble_sort(arr); }, QUADRATIC_MAX_LEN},
+    {"insertion", [](std::vector<int> &arr) { insertion_sort(arr); }, QUADRATIC_MAX_LEN},
+    {"heap", [](std::vector<int> &arr) { heap_sort(arr); }, SIZE_MAX},
+    {"quick", [](std::vector<int> &arr) { quick_sort(arr); }, SIZE_MAX},
+    {"merge", [](std::vector<int> &arr) { merge_sort(arr); }, SIZE_MAX},
+    {"intro", [](std::vector<int> &arr) { intro_sort(arr); }, SIZE_MAX},
+    {"radix", [](std::vector<int> &arr) { radix_sort(arr); }, SIZE_MAX},
+    {"parallel_merge", [](std::vector<int> &arr) { parallel_merge_sort(arr); }, SIZE_MAX},
+    {"std::sort", [](std::vector<int> &arr) { std::sort(arr.begin(), arr.end()); }, SIZE_MAX},
+};
+
+
+enum Distribution {RANDOM, SORTED, REVERSED, FEW_UNIQUE, NEARLY_SORTED, DISTRIBUTION_NUM};
+const char *DISTRIBUTION_NAME[] = {"random", "sorted", "reversed", "few_unique", "nearly_sorted"};
 
-    for(int num = 0; num < TEST_NUM; num++) {
-        size_t len = TEST_LEN[num];
-        std::vector<int> arr(len);
 
-        for(size_t idx = 0; idx < len; idx++) {
-            arr[idx] = std::rand();
+void fill_data(std::vector<int> &arr, const Distribution distribution, std::mt19937 &rng)
+{
+    size_t len = arr.size();
+
+    switch(distribution) {
+    case RANDOM:
+        for(size_t idx = 0; idx < len; idx++) arr[idx] = (int)rng();
+        break;
+    case SORTED:
+        for(size_t idx = 0; idx < len; idx++) arr[idx] = (int)idx;
+        break;
+    case REVERSED:
+        for(size_t idx = 0; idx < len; idx++) arr[idx] = (int)(len - idx);
+        break;
+    case FEW_UNIQUE:
+        for(size_t idx = 0; idx < len; idx++) arr[idx] = (int)(rng() % 16);
+        break;
+    case NEARLY_SORTED:
+        // sorted data with 1% of random swaps
+        for(size_t idx = 0; idx < len; idx++) arr[idx] = (int)idx;
+        for(size_t swap_num = 0; swap_num < len / 100 + 1; swap_num++) {
+            std::swap(arr[rng() % len], arr[rng() % len]);
         }
+        break;
+    default:
+        break;
+    }
+}
 
-        clock_t clock_start = clock();
 
-        // bubble_sort(arr);
-        // heap_sort(arr);
-        // insertion_sort(arr);
-        // merge_sort(arr);
-        quick_sort(arr);
+// Usage: main [max data length], the longest test is 10^8 elements
+int main(int argc, char **argv)
+{
+    size_t max_len = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : TEST_LEN[TEST_NUM - 1];
+
+    std::mt19937 rng(12345);
+
+    std::cout << "Distribution, algorithm, data length, time (us)" << std::endl;
+
+    for(int distribution = 0; distribution < DISTRIBUTION_NUM; distribution++) {
+        for(int num = 0; num < TEST_NUM && TEST_LEN[num] <= max_len; num++) {
+            size_t len = TEST_LEN[num];
+            std::vector<int> data(len);
+            fill_data(data, (Distribution)distribution, rng);
+
+            std::vector<int> arr;
+            for(const SortCase &sort_case : SORTS) {
+                if(len > sort_case.max_len) continue;
 
-        clock_t clock_end = clock();
+                arr = data;
 
-        std::cout << len << ", " << clock_end - clock_start << std::endl;
+                auto time_start = std::chrono::steady_clock::now();
+
+                sort_case.sort(arr);
+
+                auto time_end = std::chrono::steady_clock::now();
+
+                std::cout << DISTRIBUTION_NAME[distribution] << ", " << sort_case.name << ", " << len << ", "
+                          << std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+                if(!std::is_sorted(arr.begin(), arr.end())) {
+                    std::cout << ", NOT SORTED";
+                }
+                std::cout << std::endl;
+            }
+        }
     }
 
     return 0;
@@ -1,58 +1,60 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <algorithm>
 #include "comparator.h"
+#include "insertion_sort.h"
 
 
-template<typename Element>
-std::vector<Element>& merge_sort_internal(std::vector<Element> &array, std::vector<Element> &buffer, const size_t idx_start, const size_t idx_end, const Comparator<Element>comp)
-{
-    if(idx_start == idx_end) {
-        return array;
-    }
+const size_t MERGE_SORT_CUTOFF = 24;  // shorter ranges are sorted by insertion
 
-    size_t idx_middle = idx_start + (idx_end - idx_start) / 2;
 
-    std::vector<Element> &left_sorted = merge_sort_internal(array, buffer, idx_start, idx_middle, comp);
-    std::vector<Element> &right_sorted = merge_sort_internal(array, buffer, idx_middle + 1, idx_end, comp);
-
-    std::vector<Element> &sorted = (left_sorted == array) ? buffer : array;
-
-    size_t idx_left = idx_start;
-    size_t idx_right = idx_middle + 1;
-    for(size_t idx = idx_start; idx <= idx_end; idx++) {
-        if(idx_left <= idx_middle && idx_right <= idx_end) {
-            if(comp(left_sorted[idx_left], right_sorted[idx_right])) {
-                sorted[idx] = right_sorted[idx_right];
-                idx_right++;
-            }
-            else {
-                sorted[idx] = left_sorted[idx_left];
-                idx_left++;
-            }
-        }
-        else if(idx_left <= idx_middle) {
-            sorted[idx] = left_sorted[idx_left];
-            idx_left++;
+// Stable merge of two sorted runs into out
+template<typename Element, typename Compare>
+void merge_runs(const Element *left, const size_t left_len, const Element *right, const size_t right_len, Element *out, Compare comp)
+{
+    size_t idx_left = 0;
+    size_t idx_right = 0;
+    while(idx_left < left_len && idx_right < right_len) {
+        if(comp(left[idx_left], right[idx_right])) {
+            *out++ = right[idx_right++];
         }
         else {
-            sorted[idx] = right_sorted[idx_right];
-            idx_right++;
+            *out++ = left[idx_left++];
         }
     }
 
-    return sorted;
+    out = std::copy(left + idx_left, left + left_len, out);
+    std::copy(right + idx_right, right + right_len, out);
 }
 
 
-template<typename Element>
-void merge_sort(std::vector<Element> &array, const Comparator<Element>comp = is_greater)
+// Sorts [idx_start, idx_end) into dst. Both buffers hold the same data on entry,
+// the halves are sorted into src and merged back, so each level just swaps the roles
+// instead of choosing the output buffer at run time.
+template<typename Element, typename Compare>
+void merge_sort_internal(Element *src, Element *dst, const size_t idx_start, const size_t idx_end, Compare comp)
 {
-    std::vector<Element>buffer(array.size());
+    if(idx_end - idx_start <= MERGE_SORT_CUTOFF) {
+        insertion_sort_range(dst + idx_start, idx_end - idx_start, comp);
+        return;
+    }
 
-    std::vector<Element> &sorted = merge_sort_internal(array, buffer, 0, array.size() - 1, comp);
+    size_t idx_middle = idx_start + (idx_end - idx_start) / 2;
 
-    if(sorted == buffer) {
-        array = buffer;
-    }
+    merge_sort_internal(dst, src, idx_start, idx_middle, comp);
+    merge_sort_internal(dst, src, idx_middle, idx_end, comp);
+
+    merge_runs(src + idx_start, idx_middle - idx_start, src + idx_middle, idx_end - idx_middle, dst + idx_start, comp);
+}
+
+
+template<typename Element, typename Compare = IsGreater>
+void merge_sort(std::vector<Element> &array, Compare comp = Compare())
+{
+    if(array.size() < 2) return;
+
+    std::vector<Element> buffer(array);
+
+    merge_sort_internal(buffer.data(), array.data(), 0, array.size(), comp);
 }
@@ -0,0 +1,121 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <thread>
+#include "comparator.h"
+#include "merge_sort.h"
+
+
+const size_t PARALLEL_SORT_MIN_CHUNK = 1 << 16;  // smaller arrays are not split
+
+
+// Number of elements taken from left among the first out_idx outputs of a stable merge
+// (merge path split), found by binary search
+template<typename Element, typename Compare>
+size_t merge_split(const Element *left, const size_t left_len, const Element *right, const size_t right_len, const size_t out_idx, Compare comp)
+{
+    size_t low = out_idx > right_len ? out_idx - right_len : 0;
+    size_t high = std::min(out_idx, left_len);
+    while(low < high) {
+        size_t left_taken = low + (high - low) / 2;
+        size_t right_taken = out_idx - left_taken;
+
+        if(!comp(left[left_taken], right[right_taken - 1])) low = left_taken + 1;
+        else high = left_taken;
+    }
+
+    return low;
+}
+
+
+// Merge of two runs split into thread_num independent parts of equal output length
+template<typename Element, typename Compare>
+void parallel_merge(const Element *left, const size_t left_len, const Element *right, const size_t right_len, Element *out, const size_t thread_num, Compare comp)
+{
+    size_t total = left_len + right_len;
+    std::vector<std::thread> threads;
+
+    size_t left_prev = 0;
+    size_t out_prev = 0;
+    for(size_t part = 1; part <= thread_num; part++) {
+        size_t out_idx = total * part / thread_num;
+        size_t left_idx = merge_split(left, left_len, right, right_len, out_idx, comp);
+        size_t right_prev = out_prev - left_prev;
+        size_t right_idx = out_idx - left_idx;
+
+        auto task = [=]() {
+            merge_runs(left + left_prev, left_idx - left_prev, right + right_prev, right_idx - right_prev, out + out_prev, comp);
+        };
+        if(part == thread_num) task();
+        else threads.emplace_back(task);
+
+        left_prev = left_idx;
+        out_prev = out_idx;
+    }
+
+    for(auto &thread : threads) thread.join();
+}
+
+
+// Stable merge sort: chunks are sorted in parallel, then merged pairwise,
+// every merge round uses all threads
+template<typename Element, typename Compare = IsGreater>
+void parallel_merge_sort(std::vector<Element> &array, Compare comp = Compare(), size_t thread_num = std::thread::hardware_concurrency())
+{
+    size_t size = array.size();
+    thread_num = std::max<size_t>(1, std::min(thread_num, size / PARALLEL_SORT_MIN_CHUNK));
+    if(thread_num == 1) {
+        merge_sort(array, comp);
+        return;
+    }
+
+    std::vector<Element> buffer(array);
+
+    std::vector<size_t> bounds(thread_num + 1);
+    for(size_t chunk = 0; chunk <= thread_num; chunk++) {
+        bounds[chunk] = size * chunk / thread_num;
+    }
+
+    std::vector<std::thread> threads;
+    for(size_t chunk = 0; chunk < thread_num; chunk++) {
+        threads.emplace_back([&, chunk]() {
+            merge_sort_internal(buffer.data(), array.data(), bounds[chunk], bounds[chunk + 1], comp);
+        });
+    }
+    for(auto &thread : threads) thread.join();
+
+    Element *src = array.data();
+    Element *dst = buffer.data();
+    while(bounds.size() > 2) {
+        size_t run_num = bounds.size() - 1;
+        size_t pair_num = run_num / 2;
+        size_t threads_per_pair = std::max<size_t>(1, thread_num / pair_num);
+
+        std::vector<size_t> merged_bounds;
+        threads.clear();
+        for(size_t run = 0; run + 1 < run_num; run += 2) {
+            size_t begin = bounds[run];
+            size_t middle = bounds[run + 1];
+            size_t end = bounds[run + 2];
+            merged_bounds.push_back(begin);
+            threads.emplace_back([=]() {
+                parallel_merge(src + begin, middle - begin, src + middle, end - middle, dst + begin, threads_per_pair, comp);
+            });
+        }
+        if(run_num % 2 != 0) {
+            // the last run has no pair and is copied as is
+            merged_bounds.push_back(bounds[run_num - 1]);
+            std::copy(src + bounds[run_num - 1], src + size, dst + bounds[run_num - 1]);
+        }
+        merged_bounds.push_back(size);
+        for(auto &thread : threads) thread.join();
+
+        bounds.swap(merged_bounds);
+        std::swap(src, dst);
+    }
+
+    if(src != array.data()) {
+        std::copy(src, src + size, array.data());
+    }
+}
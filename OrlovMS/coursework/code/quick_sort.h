@@ -2,11 +2,12 @@
 #include <vector>
 #include <cstddef>
 #include <cstdlib>
+#include <utility>
 #include "comparator.h"
 
 
-template<typename Element>
-size_t quick_sort_partition(std::vector<Element> &array, const size_t idx_start, const size_t idx_end, const Comparator<Element>comp)
+template<typename Element, typename Compare>
+size_t quick_sort_partition(std::vector<Element> &array, const size_t idx_start, const size_t idx_end, Compare comp)
 {
     Element ref_element = array[idx_start + (size_t)rand() % (idx_end - idx_start + 1)];
 
@@ -28,8 +29,8 @@ size_t quick_sort_partition(std::vector<Element> &array, const size_t idx_start,
 }
 
 
-template<typename Element>
-void quick_sort_internal(std::vector<Element> &array, const size_t idx_start, const size_t idx_end, const Comparator<Element>comp)
+template<typename Element, typename Compare>
+void quick_sort_internal(std::vector<Element> &array, const size_t idx_start, const size_t idx_end, Compare comp)
 {
     if(idx_start < idx_end) {
         size_t idx_middle = quick_sort_partition(array, idx_start, idx_end, comp);
@@ -39,8 +40,10 @@ void quick_sort_internal(std::vector<Element> &array, const size_t idx_start, co
 }
 
 
-template<typename Element>
-void quick_sort(std::vector<Element> &array, const Comparator<Element>comp = is_greater)
+template<typename Element, typename Compare = IsGreater>
+void quick_sort(std::vector<Element> &array, Compare comp = Compare())
 {
+    if(array.size() < 2) return;
+
     quick_sort_internal(array, 0, array.size() - 1, comp);
 }
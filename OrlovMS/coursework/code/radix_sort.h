@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+
+// LSD radix sort of integer keys in ascending order, one byte per pass.
+// All byte histograms are counted in a single pass over the data, and a pass
+// is skipped when every key has the same byte there.
+template<typename Element>
+void radix_sort(std::vector<Element> &array)
+{
+    static_assert(std::is_integral<Element>::value && !std::is_same<Element, bool>::value,
+                  "radix_sort needs integer keys");
+
+    using Key = typename std::make_unsigned<Element>::type;
+    const size_t RADIX = 256;
+    const size_t PASS_NUM = sizeof(Element);
+    // negative numbers go first when the sign bit is flipped
+    const Key sign_flip = std::is_signed<Element>::value ? (Key)((Key)1 << (sizeof(Key) * 8 - 1)) : 0;
+
+    size_t size = array.size();
+    if(size < 2) return;
+
+    std::vector<size_t> count(PASS_NUM * RADIX, 0);
+    for(size_t idx = 0; idx < size; idx++) {
+        Key key = (Key)array[idx] ^ sign_flip;
+        for(size_t pass = 0; pass < PASS_NUM; pass++) {
+            count[pass * RADIX + ((key >> (8 * pass)) & (RADIX - 1))]++;
+        }
+    }
+
+    std::vector<Element> buffer(size);
+    Element *src = array.data();
+    Element *dst = buffer.data();
+
+    for(size_t pass = 0; pass < PASS_NUM; pass++) {
+        size_t *offset = &count[pass * RADIX];
+        size_t shift = 8 * pass;
+
+        Key first_key = (Key)src[0] ^ sign_flip;
+        if(offset[(first_key >> shift) & (RADIX - 1)] == size) continue;
+
+        size_t sum = 0;
+        for(size_t digit = 0; digit < RADIX; digit++) {
+            size_t digit_count = offset[digit];
+            offset[digit] = sum;
+            sum += digit_count;
+        }
+
+        for(size_t idx = 0; idx < size; idx++) {
+            Key key = (Key)src[idx] ^ sign_flip;
+            dst[offset[(key >> shift) & (RADIX - 1)]++] = src[idx];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if(src != array.data()) {
+        std::copy(src, src + size, array.data());
+    }
+}
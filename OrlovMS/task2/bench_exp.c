@@ -0,0 +1,160 @@
+#include "matrix.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+
+// Accuracy and speed of matrix_exp (Pade + scaling and squaring)
+// against the former 10 term Taylor series.
+//
+// Test matrix is Q * B * Q^T, where B is block diagonal with 2x2 blocks
+// [a -b; b a] and Q is a Householder reflection, so the exact exponent
+// Q * exp(B) * Q^T is known: exp of a block is e^a [cos b -sin b; sin b cos b].
+
+
+static void taylor_exp(Matrix* result, const Matrix M)
+{
+    Matrix term = {0, 0, NULL}, tmp = {0, 0, NULL};
+    matrix_alloc(&term, M.rows, M.cols);
+    matrix_alloc(&tmp, M.rows, M.cols);
+
+    matrix_set_identity(*result);
+    matrix_set_identity(term);
+    for(unsigned num = 1; num < 10; num++) {
+        matrix_mul(&tmp, term, M);
+        matrix_copy(&term, tmp);
+        matrix_mul_num(&term, term, 1 / (double)num);
+        matrix_sum(result, *result, term);
+    }
+
+    matrix_free(&tmp);
+    matrix_free(&term);
+}
+
+
+static double rand_range(double low, double high)
+{
+    return low + (high - low) * rand() / (double)RAND_MAX;
+}
+
+
+// result = Q * B * Q^T with Q = I - 2 v v^T / (v^T v)
+static void householder_similarity(Matrix result, const Matrix B, const double* v)
+{
+    const size_t n = B.rows;
+    double vv = 0.0;
+    for(size_t idx = 0; idx < n; idx++) vv += v[idx] * v[idx];
+
+    Matrix Q = {0, 0, NULL}, tmp = {0, 0, NULL};
+    matrix_alloc(&Q, n, n);
+    matrix_alloc(&tmp, n, n);
+    for(size_t row = 0; row < n; row++) {
+        for(size_t col = 0; col < n; col++) {
+            Q.data[row * n + col] = (row == col ? 1.0 : 0.0) - 2.0 * v[row] * v[col] / vv;
+        }
+    }
+
+    matrix_mul(&tmp, Q, B);
+    matrix_mul(&result, tmp, Q);  // Q is symmetric, Q^T == Q
+
+    matrix_free(&tmp);
+    matrix_free(&Q);
+}
+
+
+static double relative_error(const Matrix A, const Matrix exact)
+{
+    double diff = 0.0, norm = 0.0;
+    for(size_t idx = 0; idx < A.rows * A.cols; idx++) {
+        diff += (A.data[idx] - exact.data[idx]) * (A.data[idx] - exact.data[idx]);
+        norm += exact.data[idx] * exact.data[idx];
+    }
+    return sqrt(diff / norm);
+}
+
+
+static double seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+static void bench(const size_t n, const double scale)
+{
+    Matrix B = {0, 0, NULL}, expB = {0, 0, NULL}, M = {0, 0, NULL}, exact = {0, 0, NULL}, result = {0, 0, NULL};
+    matrix_alloc(&B, n, n);
+    matrix_alloc(&expB, n, n);
+    matrix_alloc(&M, n, n);
+    matrix_alloc(&exact, n, n);
+    matrix_alloc(&result, n, n);
+    matrix_set_zeros(B);
+    matrix_set_zeros(expB);
+
+    for(size_t blk = 0; blk + 1 < n; blk += 2) {
+        double a = rand_range(-scale, scale / 4);
+        double b = rand_range(-scale, scale);
+        B.data[blk * n + blk] = a;
+        B.data[blk * n + blk + 1] = -b;
+        B.data[(blk + 1) * n + blk] = b;
+        B.data[(blk + 1) * n + blk + 1] = a;
+        expB.data[blk * n + blk] = exp(a) * cos(b);
+        expB.data[blk * n + blk + 1] = -exp(a) * sin(b);
+        expB.data[(blk + 1) * n + blk] = exp(a) * sin(b);
+        expB.data[(blk + 1) * n + blk + 1] = exp(a) * cos(b);
+    }
+    if(n % 2) {
+        double a = rand_range(-scale, scale / 4);
+        B.data[n * n - 1] = a;
+        expB.data[n * n - 1] = exp(a);
+    }
+
+    double* v = (double*)malloc(n * sizeof(double));
+    for(size_t idx = 0; idx < n; idx++) v[idx] = rand_range(-1.0, 1.0);
+    householder_similarity(M, B, v);
+    householder_similarity(exact, expB, v);
+    free(v);
+
+    int reps = 0;
+    clock_t start = clock();
+    do {
+        taylor_exp(&result, M);
+        reps++;
+    } while(seconds(start) < 0.2);
+    double taylor_time = seconds(start) / reps;
+    double taylor_err = relative_error(result, exact);
+
+    reps = 0;
+    start = clock();
+    MatrixStatus status;
+    do {
+        status = matrix_exp(&result, M);
+        reps++;
+    } while(status == MAT_OK && seconds(start) < 0.2);
+    double pade_time = seconds(start) / reps;
+    double pade_err = status == MAT_OK ? relative_error(result, exact) : NAN;
+
+    printf("n=%4lu ||A||~%6.1f | taylor %10.6f s err %9.2e | pade %10.6f s err %9.2e\n",
+           (unsigned long)n, scale, taylor_time, taylor_err, pade_time, pade_err);
+
+    matrix_free(&B);
+    matrix_free(&expB);
+    matrix_free(&M);
+    matrix_free(&exact);
+    matrix_free(&result);
+}
+
+
+int main()
+{
+    srand(1);
+    const size_t sizes[] = {4, 16, 64, 256};
+    const double scales[] = {0.1, 1.0, 10.0, 50.0};
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for(size_t j = 0; j < sizeof(scales) / sizeof(scales[0]); j++) {
+            bench(sizes[i], scales[j]);
+        }
+    }
+    return 0;
+}
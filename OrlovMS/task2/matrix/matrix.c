@@ -329,11 +329,15 @@ MatrixStatus matrix_mul(Matrix* result, const Matrix A, const Matrix B)
         result_ptr = &result_tmp;
     }
 
+    // row-idx-col order: inner loop runs along rows of B and result
     for(size_t row = 0; row < A.rows; row++) {
-        for(size_t col = 0; col < B.cols; col++) {
-            result_ptr->data[row * result->cols + col] = 0.0;
-            for(size_t idx = 0; idx < A.cols; idx++) {
-                result_ptr->data[row * result->cols + col] += A.data[row * A.cols + idx] * B.data[idx * B.cols + col];
+        double* result_row = result_ptr->data + row * result->cols;
+        memset(result_row, 0, B.cols * sizeof(double));
+        for(size_t idx = 0; idx < A.cols; idx++) {
+            const double a = A.data[row * A.cols + idx];
+            const double* B_row = B.data + idx * B.cols;
+            for(size_t col = 0; col < B.cols; col++) {
+                result_row[col] += a * B_row[col];
             }
         }
     }
@@ -401,6 +405,120 @@ MatrixStatus matrix_pow(Matrix* result, const Matrix M, const unsigned int pow)
 }
 
 
+static void swap_double(double* first, double* second)
+{
+    double tmp = *first;
+    *first = *second;
+    *second = tmp;
+}
+
+
+static void matrix_swap_rows(const Matrix M, const size_t row_A, const size_t row_B)
+{
+    for(size_t idx = 0; idx < M.cols; idx++) {
+        swap_double(M.data + row_A * M.cols + idx, M.data + row_B * M.cols + idx);
+    }
+}
+
+
+static void matrix_sub_row(const Matrix M, const size_t row, const size_t row_base, const double ratio)
+{
+    for(size_t idx = 0; idx < M.cols; idx++) {
+        M.data[row * M.cols + idx] -= ratio * M.data[row_base * M.cols + idx];
+    }
+}
+
+
+// Pade [13/13] coefficients, Higham 2005
+static const double PADE_COEF[14] = {
+    64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+    1187353796428800.0, 129060195264000.0, 10559470521600.0,
+    670442572800.0, 33522128640.0, 1323241920.0,
+    40840800.0, 960960.0, 16380.0, 182.0, 1.0
+};
+
+
+// Max 1-norm of scaled matrix for which Pade [13/13] error is below double epsilon
+#define PADE_THETA_13 5.371920351148152
+
+#define EXP_WORKSPACE_MATRICES 7
+
+
+static double matrix_norm_1(const Matrix M)
+{
+    double norm = 0.0;
+    for(size_t col = 0; col < M.cols; col++) {
+        double sum = 0.0;
+        for(size_t row = 0; row < M.rows; row++) {
+            sum += fabs(M.data[row * M.cols + col]);
+        }
+        if(sum > norm) norm = sum;
+    }
+    return norm;
+}
+
+
+// result = c6 * A6 + c4 * A4 + c2 * A2 + c0 * I
+static void matrix_pade_poly(const Matrix result, const Matrix A6, const Matrix A4, const Matrix A2,
+                             const double c6, const double c4, const double c2, const double c0)
+{
+    for(size_t idx = 0; idx < result.rows * result.cols; idx++) {
+        result.data[idx] = c6 * A6.data[idx] + c4 * A4.data[idx] + c2 * A2.data[idx];
+    }
+    for(size_t idx = 0; idx < result.rows * result.cols; idx += result.cols + 1) {
+        result.data[idx] += c0;
+    }
+}
+
+
+// Solves A * X = B, X is written to B, A is destroyed (LU with partial pivoting)
+static MatrixStatus matrix_solve_in_place(const Matrix A, const Matrix B)
+{
+    const size_t n = A.rows;
+    for(size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        for(size_t row = col + 1; row < n; row++) {
+            if(fabs(A.data[row * n + col]) > fabs(A.data[pivot * n + col])) pivot = row;
+        }
+        if(pivot != col) {
+            matrix_swap_rows(A, col, pivot);
+            matrix_swap_rows(B, col, pivot);
+        }
+        // also catches NaN pivot
+        if(!(fabs(A.data[col * n + col]) > 0.0)) {
+            print_log(LOG_ERR, "singular matrix in solve\n");
+            return MAT_SINGULAR_ERR;
+        }
+        for(size_t row = col + 1; row < n; row++) {
+            double ratio = A.data[row * n + col] / A.data[col * n + col];
+            A.data[row * n + col] = ratio;
+            for(size_t idx = col + 1; idx < n; idx++) {
+                A.data[row * n + idx] -= ratio * A.data[col * n + idx];
+            }
+            matrix_sub_row(B, row, col, ratio);
+        }
+    }
+
+    for(size_t row = n; row-- > 0;) {
+        double* B_row = B.data + row * B.cols;
+        for(size_t idx = row + 1; idx < n; idx++) {
+            const double u = A.data[row * n + idx];
+            const double* X_row = B.data + idx * B.cols;
+            for(size_t col = 0; col < B.cols; col++) {
+                B_row[col] -= u * X_row[col];
+            }
+        }
+        for(size_t col = 0; col < B.cols; col++) {
+            B_row[col] /= A.data[row * n + row];
+        }
+    }
+
+    return MAT_OK;
+}
+
+
+// Scaling and squaring with Pade [13/13] approximant: 6 multiplications,
+// one linear solve and s squarings. All temporaries live in one workspace.
 MatrixStatus matrix_exp(Matrix* result, const Matrix M)
 {
     print_log(LOG_INFO, "matrix exponent\n");
@@ -417,61 +535,73 @@ MatrixStatus matrix_exp(Matrix* result, const Matrix M)
         print_log(LOG_ERR, "matrix size not equals\n");
         return MAT_SIZE_ERR;
     }
-
-    char is_same_matrix = 0;
-    Matrix* result_ptr = result;
-    Matrix result_tmp = EMPTY;
-    if(M.data == result->data) {
-        is_same_matrix = 1;
-        print_log(LOG_INFO, "input and output is same matrix, allocation temporary result matrix\n");
-        if(matrix_alloc(&result_tmp, result->rows, result->cols) != MAT_OK) return MAT_ALLOC_ERR;
-        result_ptr = &result_tmp;
+    if(matrix_is_empty(M)) {
+        print_log(LOG_WARN, "matrix is empty\n");
+        return MAT_OK;
     }
 
-    matrix_set_identity(*result_ptr);
+    const size_t n = M.rows;
 
-    print_log(LOG_INFO, "allocation temporary matrix for internal usage\n");
-    Matrix term = EMPTY;
-    if(matrix_alloc(&term, M.rows, M.cols) != MAT_OK) {
-        if(is_same_matrix) matrix_free(&result_tmp);
+    print_log(LOG_INFO, "allocation workspace for internal usage\n");
+    double* workspace = (double*)malloc(EXP_WORKSPACE_MATRICES * n * n * sizeof(double));
+    if(workspace == NULL) {
+        print_log(LOG_ERR, "matrix allocation error\n");
         return MAT_ALLOC_ERR;
     }
-    matrix_set_identity(term);
+    Matrix W[EXP_WORKSPACE_MATRICES];
+    for(size_t idx = 0; idx < EXP_WORKSPACE_MATRICES; idx++) {
+        W[idx] = (Matrix){.rows = n, .cols = n, .data = workspace + idx * n * n};
+    }
+    Matrix A = W[0], A2 = W[1], A4 = W[2], A6 = W[3], T1 = W[4], T2 = W[5], T3 = W[6];
+    const double* b = PADE_COEF;
 
-    print_log(LOG_INFO, "allocation temporary matrix for internal usage\n");
-    Matrix tmp = EMPTY;
-    if(matrix_alloc(&tmp, M.rows, M.cols) != MAT_OK) {
-        matrix_free(&term);
-        if(is_same_matrix) matrix_free(&result_tmp);
-        return MAT_ALLOC_ERR;
+    // Scaling: ||A / 2^s|| <= theta_13
+    double norm = matrix_norm_1(M);
+    int squarings = 0;
+    if(norm > PADE_THETA_13) {
+        squarings = (int)ceil(log2(norm / PADE_THETA_13));
     }
+    matrix_mul_num(&A, M, ldexp(1.0, -squarings));
 
-    for(unsigned num = 1; num < 10; num++) {
-        matrix_mul(&tmp, term, M);
-        matrix_copy(&term, tmp);
-        matrix_mul_num(&term, term, 1 / (double)num);
+    matrix_mul(&A2, A, A);
+    matrix_mul(&A4, A2, A2);
+    matrix_mul(&A6, A4, A2);
 
-        matrix_sum(result_ptr, *result_ptr, term);
-    }
+    // U = A * (A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I)
+    matrix_pade_poly(T1, A6, A4, A2, b[13], b[11], b[9], 0.0);
+    matrix_mul(&T2, A6, T1);
+    matrix_pade_poly(T1, A6, A4, A2, b[7], b[5], b[3], b[1]);
+    matrix_sum(&T2, T2, T1);
 
-    matrix_free(&tmp);
-    matrix_free(&term);
+    // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+    matrix_pade_poly(T1, A6, A4, A2, b[12], b[10], b[8], 0.0);
+    matrix_mul(&T3, A6, T1);
+    matrix_pade_poly(T1, A6, A4, A2, b[6], b[4], b[2], b[0]);
+    matrix_sum(&T3, T3, T1);
 
-    if(is_same_matrix) {
-        print_log(LOG_INFO, "input and output is same matrix, copy data from temporary\n");
-        memcpy(result->data, result_tmp.data, result_tmp.rows * result_tmp.cols * sizeof(double));
-        matrix_free(&result_tmp);
+    matrix_mul(&A2, A, T2);
+
+    // (V - U) * R = (V + U)
+    matrix_sum(&T1, T3, A2);
+    matrix_sub(&T3, T3, A2);
+    if(matrix_solve_in_place(T3, T1) != MAT_OK) {
+        free(workspace);
+        return MAT_SINGULAR_ERR;
     }
 
-    return MAT_OK;
-}
+    Matrix* current = &T1;
+    Matrix* next = &T2;
+    for(int cnt = 0; cnt < squarings; cnt++) {
+        matrix_mul(next, *current, *current);
+        Matrix* tmp = current;
+        current = next;
+        next = tmp;
+    }
 
+    memcpy(result->data, current->data, n * n * sizeof(double));
+    free(workspace);
 
-static void swap_double(double* first, double* second)
-{
-    double tmp = *first;
-    *first = *second;
-    *second = tmp;
+    return MAT_OK;
 }
 
 
@@ -505,22 +635,6 @@ static size_t matrix_find_non_zero_in_col(const Matrix M, const size_t row_start
 }
 
 
-static void matrix_swap_rows(const Matrix M, const size_t row_A, const size_t row_B)
-{
-    for(size_t idx = 0; idx < M.cols; idx++) {
-        swap_double(M.data + row_A * M.cols + idx, M.data + row_B * M.cols + idx);
-    }
-}
-
-
-static void matrix_sub_row(const Matrix M, const size_t row, const size_t row_base, const double ratio)
-{
-    for(size_t idx = 0; idx < M.cols; idx++) {
-        M.data[row * M.cols + idx] -= ratio * M.data[row_base * M.cols + idx];
-    }
-}
-
-
 MatrixStatus matrix_det(double* det, const Matrix M)
 {
     print_log(LOG_INFO, "matrix determinant\n");
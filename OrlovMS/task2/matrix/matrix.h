@@ -13,7 +13,8 @@ typedef enum {
     MAT_OK = 0,
     MAT_ALLOC_ERR,
     MAT_EMPTY_ERR,
-    MAT_SIZE_ERR
+    MAT_SIZE_ERR,
+    MAT_SINGULAR_ERR
 } MatrixStatus;
 
 
@@ -117,6 +117,34 @@ int get_g_suff_link(int v)
   return bohr[v].g_suff_link;
 }
 
+void build_automaton() //Заполняет auto_move, suff_link и g_suff_link обходом в ширину, без рекурсии
+{
+  //Суффиксная ссылка ведёт в менее глубокую вершину, поэтому к моменту обработки
+  //вершины v строки переходов её ссылок уже готовы и берутся за одно обращение
+  vector <int> order; //Очередь обхода в ширину
+  order.push_back(0);
+  bohr[0].suff_link = 0;
+  bohr[0].g_suff_link = 0;
+  for (size_t head = 0; head < order.size(); head++)
+  {
+  	int v = order[head];
+  	for (int letter = 0; letter < k; letter++)
+  	{
+  	  int u = bohr[v].next_vertex[letter];
+  	  if (u == -1) //Ребра нет - переход как у суффиксной ссылки
+  	  {
+  	    bohr[v].auto_move[letter] = (v == 0) ? 0 : bohr[bohr[v].suff_link].auto_move[letter];
+  	    continue;
+  	  }
+  	  bohr[v].auto_move[letter] = u;
+  	  bohr[u].suff_link = (v == 0) ? 0 : bohr[bohr[v].suff_link].auto_move[letter];
+  	  int w = bohr[u].suff_link;
+  	  bohr[u].g_suff_link = (w == 0) ? 0 : (bohr[w].flag ? w : bohr[w].g_suff_link);
+  	  order.push_back(u);
+  	}
+  }
+}
+
 void check(int v, int i)// i - последняя рассмотренная буква в искомом слове
 {
   for (int u = v; u != 0; u = get_g_suff_link(u))
@@ -131,7 +159,10 @@ void find_all_pos(const string& s)
   int u = 0;
   for (size_t i = 0; i < s.length(); i++)
   {
-  	u = get_auto_move(u, s[i] - 'a');
+  	if (s[i] < 'a' || s[i] > 'z') //Символа нет в алфавите - ни одно слово через него не проходит
+  	  u = 0;
+  	else
+  	  u = get_auto_move(u, s[i] - 'a');
   	check(u, i + 1);
   }
 }
@@ -144,5 +175,6 @@ int main()
   add_word_to_bohr("ddbb");
   add_word_to_bohr("bcdd");
   add_word_to_bohr("bbbc");
+  build_automaton(); //Таблица переходов строится один раз до поиска
   find_all_pos("dcbcddbbbcccbbbcccbbabc");
 }
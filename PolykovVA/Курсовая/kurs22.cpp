@@ -4,55 +4,50 @@
 #include <string.h>
 
 
+#define STACK_SIZE 2501
+
+
+// Стеки на массиве: push и pop без malloc/free на каждый элемент
 struct stack_char {
-    char data;
-    struct stack_char* next;
+    char data[STACK_SIZE];
+    int size;
 };
 
 
 struct stack_ll {
-    long long data;
-    struct stack_ll* next;
+    long long data[STACK_SIZE];
+    int size;
 };
 
 
-void push_char(struct stack_char** top, char symbol) {
-    struct stack_char* new_node = (struct stack_char*)malloc(sizeof(struct stack_char));
-    if (new_node) {
-        new_node->data = symbol;
-        new_node->next = *top;
-        *top = new_node;
+void push_char(struct stack_char* stack, char symbol) {
+    if (stack->size < STACK_SIZE) {
+        stack->data[stack->size++] = symbol;
     }
 }
 
 
-char pop_char(struct stack_char** top) {
-    if (!*top) return '\0';
-    struct stack_char* temp = *top;
-    char symbol = temp->data;
-    *top = temp->next;
-    free(temp);
-    return symbol;
+char pop_char(struct stack_char* stack) {
+    if (stack->size == 0) return '\0';
+    return stack->data[--stack->size];
 }
 
 
-void push_ll(struct stack_ll** top, long long value) {
-    struct stack_ll* new_node = (struct stack_ll*)malloc(sizeof(struct stack_ll));
-    if (new_node) {
-        new_node->data = value;
-        new_node->next = *top;
-        *top = new_node;
+char top_char(const struct stack_char* stack) {
+    return stack->data[stack->size - 1];
+}
+
+
+void push_ll(struct stack_ll* stack, long long value) {
+    if (stack->size < STACK_SIZE) {
+        stack->data[stack->size++] = value;
     }
 }
 
 
-long long pop_ll(struct stack_ll** top) {
-    if (!*top) return 0;
-    struct stack_ll* temp = *top;
-    long long value = temp->data;
-    *top = temp->next;
-    free(temp);
-    return value;
+long long pop_ll(struct stack_ll* stack) {
+    if (stack->size == 0) return 0;
+    return stack->data[--stack->size];
 }
 
 
@@ -73,8 +68,8 @@ int get_priority(char op) {
 
 
 int main() {
-    struct stack_char* operators = NULL;    
-    struct stack_ll* numbers = NULL;        
+    static struct stack_char operators;
+    static struct stack_ll numbers;
     char polish[2501] = { 0 };                
     int polish_index = 0;
 
@@ -102,11 +97,11 @@ int main() {
             }
 
             else if (symbol == ')') {
-                while (operators && operators->data != '(') {
+                while (operators.size > 0 && top_char(&operators) != '(') {
                     polish[polish_index++] = pop_char(&operators);
                     polish[polish_index++] = ' ';
                 }
-                if (operators) pop_char(&operators);
+                if (operators.size > 0) pop_char(&operators);
                 unary_minus = unary_plus = false;
             }
 
@@ -116,9 +111,9 @@ int main() {
                     polish[polish_index++] = ' ';
                 }
 
-                while (operators && operators->data != '(' &&
-                    (get_priority(operators->data) > get_priority(symbol) ||
-                        (get_priority(operators->data) == get_priority(symbol) &&
+                while (operators.size > 0 && top_char(&operators) != '(' &&
+                    (get_priority(top_char(&operators)) > get_priority(symbol) ||
+                        (get_priority(top_char(&operators)) == get_priority(symbol) &&
                             is_left_associative(symbol)))) {
                     polish[polish_index++] = pop_char(&operators);
                     polish[polish_index++] = ' ';
@@ -129,7 +124,7 @@ int main() {
         }
     }
 
-    while (operators) {
+    while (operators.size > 0) {
         polish[polish_index++] = ' ';
         polish[polish_index++] = pop_char(&operators);
     }
@@ -155,7 +150,7 @@ int main() {
         }
         else if (symbol == '+' || symbol == '-' || symbol == '*' ||
             symbol == '/' || symbol == '^') {
-            if (!numbers || !numbers->next) {
+            if (numbers.size < 2) {
                 printf("Error: insufficient operands\n");
                 return 1;
             }
@@ -192,16 +187,12 @@ int main() {
 
     
     printf("Polska notation: %s\n", polish);
-    if (numbers && !numbers->next) {
+    if (numbers.size == 1) {
         printf("Result: %lld\n", pop_ll(&numbers));
     }
     else {
         printf("Error: invalid expression\n");
     }
 
-    
-    while (operators) pop_char(&operators);
-    while (numbers) pop_ll(&numbers);
-
     return 0;
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include <math.h>
 #include <stdint.h>
 #include <cstring>
+#include <chrono>
+#include <random>
+#include <vector>
 
 class Matrix
 {
@@ -37,12 +40,14 @@ public:
     bool is_zero() const;
     void print();
     void matrix_random();
-    Matrix exp(const int x);
+    Matrix exp() const;
     Matrix transp();
     void matrix_identity();
     void matrix_zero();
     double det();
     Matrix power(int ex) const;
+
+    friend void bench_exp(size_t n, double scale);
 };
 
 
@@ -362,25 +367,175 @@ void Matrix::matrix_random()
 }
 
 
-Matrix Matrix::exp(int x)                  
+// Коэффициенты аппроксиманта Паде [13/13] (Higham, 2005)
+static const double PADE_COEF[14] = {
+    64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+    1187353796428800.0, 129060195264000.0, 10559470521600.0,
+    670442572800.0, 33522128640.0, 1323241920.0,
+    40840800.0, 960960.0, 16380.0, 182.0, 1.0
+};
+
+// Наибольшая 1-норма, при которой Паде [13/13] даёт точность double
+static const double PADE_THETA_13 = 5.371920351148152;
+
+
+// C = A * B для квадратных n x n
+static void mult_square(double* C, const double* A, const double* B, size_t n)
+{
+    memset(C, 0, n * n * sizeof(double));
+    for (size_t row = 0; row < n; row++) {
+        for (size_t idx = 0; idx < n; idx++) {
+            double a = A[row * n + idx];
+            for (size_t col = 0; col < n; col++) {
+                C[row * n + col] += a * B[idx * n + col];
+            }
+        }
+    }
+}
+
+
+// R = c6 * A6 + c4 * A4 + c2 * A2 + c0 * E
+static void pade_poly(double* R, const double* A6, const double* A4, const double* A2,
+    double c6, double c4, double c2, double c0, size_t n)
+{
+    for (size_t idx = 0; idx < n * n; idx++) {
+        R[idx] = c6 * A6[idx] + c4 * A4[idx] + c2 * A2[idx];
+    }
+    for (size_t idx = 0; idx < n * n; idx += n + 1) {
+        R[idx] += c0;
+    }
+}
+
+
+// Решение A * X = B методом Гаусса с выбором главного элемента, X записывается в B, A портится
+static void solve_square(double* A, double* B, size_t n)
+{
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        for (size_t row = col + 1; row < n; row++) {
+            if (fabs(A[row * n + col]) > fabs(A[pivot * n + col])) {
+                pivot = row;
+            }
+        }
+        if (!(fabs(A[pivot * n + col]) > 0.0)) { // NaN тоже не проходит
+            throw MatrixException("Ошибка: вырожденная матрица");
+        }
+        if (pivot != col) {
+            for (size_t idx = 0; idx < n; idx++) {
+                std::swap(A[col * n + idx], A[pivot * n + idx]);
+                std::swap(B[col * n + idx], B[pivot * n + idx]);
+            }
+        }
+        for (size_t row = col + 1; row < n; row++) {
+            double factor = A[row * n + col] / A[col * n + col];
+            for (size_t idx = col + 1; idx < n; idx++) {
+                A[row * n + idx] -= factor * A[col * n + idx];
+            }
+            for (size_t idx = 0; idx < n; idx++) {
+                B[row * n + idx] -= factor * B[col * n + idx];
+            }
+        }
+    }
+
+    for (size_t row = n; row-- > 0;) {
+        for (size_t idx = row + 1; idx < n; idx++) {
+            double u = A[row * n + idx];
+            for (size_t col = 0; col < n; col++) {
+                B[row * n + col] -= u * B[idx * n + col];
+            }
+        }
+        for (size_t col = 0; col < n; col++) {
+            B[row * n + col] /= A[row * n + row];
+        }
+    }
+}
+
+
+// Экспонента методом масштабирования и возведения в квадрат с аппроксимантом Паде [13/13]:
+// 6 умножений, одно решение СЛАУ и s возведений в квадрат. Все временные матрицы - в одном буфере.
+Matrix Matrix::exp() const
 {
     if (cols != rows) {
         throw SIZE_ERROR;
     }
+    if (data == nullptr) {
+        throw DATA_ERROR;
+    }
 
-    Matrix matrix_term(*this);                   
-    Matrix matrix_exponent_result(rows, cols);  
-    matrix_exponent_result.matrix_identity();
+    const size_t n = rows;
+    const size_t size = n * n;
+    const double* b = PADE_COEF;
+
+    double* workspace = new double[7 * size];
+    double* A = workspace;
+    double* A2 = A + size;
+    double* A4 = A2 + size;
+    double* A6 = A4 + size;
+    double* T1 = A6 + size;
+    double* T2 = T1 + size;
+    double* T3 = T2 + size;
+
+    double norm = 0.0;
+    for (size_t col = 0; col < n; col++) {
+        double sum = 0.0;
+        for (size_t row = 0; row < n; row++) {
+            sum += fabs(data[row * n + col]);
+        }
+        if (sum > norm) {
+            norm = sum;
+        }
+    }
+    int squarings = (norm > PADE_THETA_13) ? (int)ceil(log2(norm / PADE_THETA_13)) : 0;
+    double scale = ldexp(1.0, -squarings);
+    for (size_t idx = 0; idx < size; idx++) {
+        A[idx] = data[idx] * scale;
+    }
+
+    mult_square(A2, A, A, n);
+    mult_square(A4, A2, A2, n);
+    mult_square(A6, A4, A2, n);
+
+    // U = A * (A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 E)
+    pade_poly(T1, A6, A4, A2, b[13], b[11], b[9], 0.0, n);
+    mult_square(T2, A6, T1, n);
+    pade_poly(T1, A6, A4, A2, b[7], b[5], b[3], b[1], n);
+    for (size_t idx = 0; idx < size; idx++) {
+        T2[idx] += T1[idx];
+    }
 
-    if (x == 0) {
-        return matrix_exponent_result;
+    // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 E
+    pade_poly(T1, A6, A4, A2, b[12], b[10], b[8], 0.0, n);
+    mult_square(T3, A6, T1, n);
+    pade_poly(T1, A6, A4, A2, b[6], b[4], b[2], b[0], n);
+    for (size_t idx = 0; idx < size; idx++) {
+        T3[idx] += T1[idx];
     }
 
-    for (size_t n = 1; n <= x; n++) {
-        matrix_term = matrix_term * (*this) * (1.0 / n);
-        matrix_exponent_result += matrix_term;
+    mult_square(A2, A, T2, n);
+
+    // (V - U) * R = V + U
+    for (size_t idx = 0; idx < size; idx++) {
+        T1[idx] = T3[idx] + A2[idx];
+        T3[idx] -= A2[idx];
+    }
+    try {
+        solve_square(T3, T1, n);
     }
-    return matrix_exponent_result;
+    catch (...) {
+        delete[] workspace;
+        throw;
+    }
+
+    double* current = T1;
+    double* next = T2;
+    for (int k = 0; k < squarings; k++) {
+        mult_square(next, current, current, n);
+        std::swap(current, next);
+    }
+
+    Matrix result(rows, cols, current);
+    delete[] workspace;
+    return result;
 }
 
 
@@ -482,7 +637,136 @@ Matrix Matrix::power(int ex) const {
 }
 
 
-int main() {
+// Точность и скорость exp() (Паде + масштабирование и возведение в квадрат)
+// в сравнении с рядом Тейлора из 50 членов. Прежний exp(x) брал число членов x
+// у вызывающего и первым добавлял A^2 вместо A, поэтому здесь ряд посчитан верно.
+//
+// Тестовая матрица Q * B * Q^T: B блочно-диагональная из блоков 2x2 [a -b; b a],
+// Q - отражение Хаусхолдера, поэтому точная экспонента Q * exp(B) * Q^T известна:
+// экспонента блока e^a [cos b -sin b; sin b cos b].
+// Конструкторы пишут трассировку в stdout, результаты идут в stderr:
+// запуск "./a.out --bench-exp > /dev/null".
+
+static void taylor_exp(double* R, const double* M, size_t n)
+{
+    std::vector<double> term(n * n, 0.0), tmp(n * n);
+    memset(R, 0, n * n * sizeof(double));
+    for (size_t idx = 0; idx < n * n; idx += n + 1) {
+        R[idx] = 1.0;
+        term[idx] = 1.0;
+    }
+    for (unsigned num = 1; num <= 50; num++) {
+        mult_square(tmp.data(), term.data(), M, n);
+        for (size_t idx = 0; idx < n * n; idx++) {
+            term[idx] = tmp[idx] / num;
+            R[idx] += term[idx];
+        }
+    }
+}
+
+
+// R = Q * B * Q, Q = E - 2 v v^T / (v^T v) симметрична и ортогональна
+static void householder_similarity(double* R, const double* B, const std::vector<double>& v)
+{
+    const size_t n = v.size();
+    double vv = 0.0;
+    for (double x : v) {
+        vv += x * x;
+    }
+    std::vector<double> Q(n * n), tmp(n * n);
+    for (size_t row = 0; row < n; row++) {
+        for (size_t col = 0; col < n; col++) {
+            Q[row * n + col] = (row == col ? 1.0 : 0.0) - 2.0 * v[row] * v[col] / vv;
+        }
+    }
+    mult_square(tmp.data(), Q.data(), B, n);
+    mult_square(R, tmp.data(), Q.data(), n);
+}
+
+
+static double relative_error(const double* A, const double* exact, size_t n)
+{
+    double diff = 0.0, norm = 0.0;
+    for (size_t idx = 0; idx < n * n; idx++) {
+        diff += (A[idx] - exact[idx]) * (A[idx] - exact[idx]);
+        norm += exact[idx] * exact[idx];
+    }
+    return sqrt(diff / norm);
+}
+
+
+// Среднее время одного вызова, повторы не меньше 0.2 с
+template <typename F>
+static double time_per_call(F&& call)
+{
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed;
+    do {
+        call();
+        reps++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.2);
+    return elapsed.count() / reps;
+}
+
+
+void bench_exp(size_t n, double scale)
+{
+    static std::mt19937 rng(1);
+    std::uniform_real_distribution<double> real(-scale, scale / 4);
+    std::uniform_real_distribution<double> imag(-scale, scale);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    std::vector<double> B(n * n, 0.0), expB(n * n, 0.0);
+    for (size_t blk = 0; blk + 1 < n; blk += 2) {
+        double a = real(rng);
+        double b = imag(rng);
+        B[blk * n + blk] = a;
+        B[blk * n + blk + 1] = -b;
+        B[(blk + 1) * n + blk] = b;
+        B[(blk + 1) * n + blk + 1] = a;
+        expB[blk * n + blk] = ::exp(a) * cos(b);
+        expB[blk * n + blk + 1] = -::exp(a) * sin(b);
+        expB[(blk + 1) * n + blk] = ::exp(a) * sin(b);
+        expB[(blk + 1) * n + blk + 1] = ::exp(a) * cos(b);
+    }
+    if (n % 2) {
+        double a = real(rng);
+        B[n * n - 1] = a;
+        expB[n * n - 1] = ::exp(a);
+    }
+
+    std::vector<double> v(n), data(n * n), exact(n * n), taylor(n * n);
+    for (double& x : v) {
+        x = unit(rng);
+    }
+    householder_similarity(data.data(), B.data(), v);
+    householder_similarity(exact.data(), expB.data(), v);
+
+    double taylor_time = time_per_call([&] { taylor_exp(taylor.data(), data.data(), n); });
+    double taylor_err = relative_error(taylor.data(), exact.data(), n);
+
+    Matrix M(n, n, data.data());
+    Matrix result;
+    double pade_time = time_per_call([&] { result = M.exp(); });
+    double pade_err = relative_error(result.data, exact.data(), n);
+
+    fprintf(stderr, "n=%4zu ||A||~%6.1f | taylor %10.6f s err %9.2e | pade %10.6f s err %9.2e\n",
+        n, scale, taylor_time, taylor_err, pade_time, pade_err);
+}
+
+
+int main(int argc, char** argv) {
+
+    if (argc > 1 && strcmp(argv[1], "--bench-exp") == 0) {
+        for (size_t n : { 4, 16, 64, 256 }) {
+            for (double scale : { 0.1, 1.0, 10.0, 50.0 }) {
+                bench_exp(n, scale);
+            }
+        }
+        return 0;
+    }
 
     double data[9] = { 0., 1., 2., 3., 4., 5., 6., 7., 8. };
     Matrix A(3, 3, data);
@@ -6,6 +6,11 @@
 #include <chrono>
 #include <sys/ioctl.h>
 #include <thread>  // Добавлен этот заголовочный файл
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <csignal>
 
 using namespace cv;
 using namespace std;
@@ -15,11 +20,38 @@ const string ARDUINO_PORT = "/dev/ttyACM0";
 const int QR_RESEND_DELAY_MS = 10000;
 const int RECONNECT_DELAY_MS = 2000;
 
+const int FRAME_WIDTH = 640;
+const int FRAME_HEIGHT = 480;
+const int FULL_SCAN_DENSITY = 2;   // полный кадр сканируется через строку и через столбец
+const int ROI_MARGIN = 48;         // запас вокруг последнего найденного QR, пикселей
+const int ROI_MAX_MISSES = 5;      // промахов в ROI подряд до возврата к полному кадру
+const size_t MAX_PENDING_QR = 64;  // очередь на отправку, если порт занят переподключением
+
 int arduino_fd = -1;
 string last_sent_qr;
 chrono::steady_clock::time_point last_send_time;
 bool arduino_ready = false;
 
+atomic<bool> running(true);
+
+// Последний кадр камеры. Поток захвата перезаписывает его, не дожидаясь декодера,
+// поэтому кадры, которые декодер не успел взять, пропускаются, а не копятся.
+// Буферы ходят по кругу через swap: захват -> слот -> декодер -> слот -> захват.
+struct FrameSlot {
+    mutex lock;
+    condition_variable ready;
+    Mat gray;
+    uint64_t sequence = 0;
+} frame_slot;
+
+// Найденные строки для потока Arduino: запись в порт и переподключение
+// (setup_serial ждёт 2 секунды) не задерживают декодирование
+struct QrQueue {
+    mutex lock;
+    condition_variable ready;
+    deque<string> items;
+} qr_queue;
+
 bool is_arduino_connected(int fd) {
     if (fd < 0) return false;
     int status;
@@ -64,7 +96,7 @@ void send_command(const string& cmd) {
 bool should_send_qr(const string& qr_data) {
     auto now = chrono::steady_clock::now();
     auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_send_time).count();
-    
+
     if (qr_data != last_sent_qr || elapsed >= QR_RESEND_DELAY_MS) {
         last_sent_qr = qr_data;
         last_send_time = now;
@@ -73,31 +105,136 @@ bool should_send_qr(const string& qr_data) {
     return false;
 }
 
-int main() {
-    VideoCapture cap(0);
-    if (!cap.isOpened()) {
-        cerr << "ERROR: Camera not found!" << endl;
-        return 1;
+// Плоскость яркости кадра в буфер gray. Камера, по возможности, отдаёт GREY (Y800)
+// или YUYV без перевода в BGR: тогда яркость - это сам кадр или каждый чётный байт.
+// Буфер драйвера переиспользуется при следующем grab, поэтому он один раз
+// копируется в gray; дальше кадр никуда не копируется.
+bool to_gray(const Mat& frame, Mat& gray) {
+    size_t pixels = (size_t)FRAME_WIDTH * FRAME_HEIGHT;
+    if (frame.rows == 1 && frame.type() == CV_8UC1) {  // сырой буфер драйвера
+        if (frame.total() == pixels) {
+            frame.reshape(1, FRAME_HEIGHT).copyTo(gray);
+            return true;
+        }
+        if (frame.total() == 2 * pixels) {
+            extractChannel(frame.reshape(2, FRAME_HEIGHT), gray, 0);
+            return true;
+        }
+        return false;
+    }
+    if (frame.type() == CV_8UC1) frame.copyTo(gray);
+    else if (frame.type() == CV_8UC2) extractChannel(frame, gray, 0);
+    else cvtColor(frame, gray, COLOR_BGR2GRAY);
+    return true;
+}
+
+void capture_loop(VideoCapture& cap) {
+    Mat frame, back;
+    while (running) {
+        if (!cap.grab() || !cap.retrieve(frame) || frame.empty()) continue;
+        if (!to_gray(frame, back)) continue;
+        {
+            lock_guard<mutex> guard(frame_slot.lock);
+            swap(frame_slot.gray, back);
+            frame_slot.sequence++;
+        }
+        frame_slot.ready.notify_one();
     }
-    cap.set(CAP_PROP_FRAME_WIDTH, 640);
-    cap.set(CAP_PROP_FRAME_HEIGHT, 480);
+}
 
+// Сканирование прямоугольника area кадра. zbar читает память Mat напрямую,
+// обрезка задаётся set_crop, density - шаг линий сканирования.
+// Найденные строки и их описанные прямоугольники (в координатах кадра) - в found.
+int scan_area(ImageScanner& scanner, const Mat& gray, const Rect& area, int density,
+              vector<pair<string, Rect>>& found) {
+    scanner.set_config(ZBAR_NONE, ZBAR_CFG_X_DENSITY, density);
+    scanner.set_config(ZBAR_NONE, ZBAR_CFG_Y_DENSITY, density);
+    Image image(gray.cols, gray.rows, "Y800", gray.data, (unsigned long)gray.cols * gray.rows);
+    image.set_crop(area.x, area.y, area.width, area.height);
+
+    int count = scanner.scan(image);
+    for (auto symbol = image.symbol_begin(); symbol != image.symbol_end(); ++symbol) {
+        vector<Point> corners;
+        for (int i = 0; i < symbol->get_location_size(); i++) {
+            corners.emplace_back(symbol->get_location_x(i), symbol->get_location_y(i));
+        }
+        found.emplace_back(symbol->get_data(), corners.empty() ? area : boundingRect(corners));
+    }
+    return count;
+}
+
+void decode_loop() {
     ImageScanner scanner;
     scanner.set_config(ZBAR_NONE, ZBAR_CFG_ENABLE, 1);
 
-    cout << "Initializing..." << endl;
+    Mat work;
+    uint64_t seen = 0;
+    Rect roi;
+    int roi_misses = ROI_MAX_MISSES;
 
-    arduino_fd = setup_serial();
-    if (arduino_fd >= 0) {
-        arduino_ready = true;
-        cout << "Arduino connected successfully!" << endl;
-    } else {
-        cerr << "Failed to connect to Arduino" << endl;
+    int decoded_frames = 0, skipped_frames = 0, roi_hits = 0;
+    auto stats_start = chrono::steady_clock::now();
+
+    while (running) {
+        {
+            unique_lock<mutex> guard(frame_slot.lock);
+            frame_slot.ready.wait_for(guard, chrono::milliseconds(100),
+                                      [&] { return frame_slot.sequence != seen; });
+            if (frame_slot.sequence == seen) continue;
+            if (seen != 0) skipped_frames += (int)(frame_slot.sequence - seen - 1);
+            seen = frame_slot.sequence;
+            swap(frame_slot.gray, work);
+        }
+        const Rect whole(0, 0, work.cols, work.rows);
+
+        // Сначала окрестность последнего QR в полном разрешении, затем весь кадр с прореживанием
+        vector<pair<string, Rect>> found;
+        bool hit = false;
+        if (roi_misses < ROI_MAX_MISSES) {
+            hit = scan_area(scanner, work, roi, 1, found) > 0;
+            roi_misses = hit ? 0 : roi_misses + 1;
+            if (hit) roi_hits++;
+        }
+        if (!hit) hit = scan_area(scanner, work, whole, FULL_SCAN_DENSITY, found) > 0;
+
+        if (hit) {
+            Rect box = found[0].second;
+            for (auto& qr : found) box |= qr.second;
+            roi = Rect(box.x - ROI_MARGIN, box.y - ROI_MARGIN,
+                       box.width + 2 * ROI_MARGIN, box.height + 2 * ROI_MARGIN) & whole;
+            roi_misses = 0;
+
+            {
+                lock_guard<mutex> guard(qr_queue.lock);
+                for (auto& qr : found) {
+                    if (qr_queue.items.size() < MAX_PENDING_QR) qr_queue.items.push_back(qr.first);
+                }
+            }
+            qr_queue.ready.notify_one();
+        }
+
+        decoded_frames++;
+        auto now = chrono::steady_clock::now();
+        double elapsed = chrono::duration<double>(now - stats_start).count();
+        if (elapsed >= 1.0) {
+            cout << "Decoded " << decoded_frames / elapsed << " frames/s, skipped " << skipped_frames
+                 << ", ROI hits " << roi_hits << endl;
+            decoded_frames = skipped_frames = roi_hits = 0;
+            stats_start = now;
+        }
     }
+}
+
+void arduino_loop() {
+    auto last_check = chrono::steady_clock::now();
+    while (running) {
+        deque<string> pending;
+        {
+            unique_lock<mutex> guard(qr_queue.lock);
+            qr_queue.ready.wait_for(guard, chrono::milliseconds(100), [] { return !qr_queue.items.empty(); });
+            pending.swap(qr_queue.items);
+        }
 
-    Mat frame, gray;
-    while (true) {
-        static auto last_check = chrono::steady_clock::now();
         auto now = chrono::steady_clock::now();
         if (chrono::duration_cast<chrono::milliseconds>(now - last_check).count() >= RECONNECT_DELAY_MS) {
             if (!arduino_ready) {
@@ -110,27 +247,56 @@ int main() {
             last_check = now;
         }
 
-        cap >> frame;
-        if (frame.empty()) continue;
-
-        cvtColor(frame, gray, COLOR_BGR2GRAY);
-        Image image(gray.cols, gray.rows, "Y800", gray.data, gray.cols * gray.rows);
-        
-        if (scanner.scan(image) > 0) {
-            for (auto symbol = image.symbol_begin(); symbol != image.symbol_end(); ++symbol) {
-                string qr_data = symbol->get_data();
-                cout << "QR detected: " << qr_data << endl;
+        for (const string& qr_data : pending) {
+            cout << "QR detected: " << qr_data << endl;
 
-                if (should_send_qr(qr_data) && arduino_ready) {
-                    send_command(qr_data);
-                    cout << "Sent to Arduino: " << qr_data << endl;
-                }
+            if (should_send_qr(qr_data) && arduino_ready) {
+                send_command(qr_data);
+                cout << "Sent to Arduino: " << qr_data << endl;
             }
         }
+    }
+}
+
+int main() {
+    VideoCapture cap(0);
+    if (!cap.isOpened()) {
+        cerr << "ERROR: Camera not found!" << endl;
+        return 1;
+    }
+    // Просим у камеры сразу серый кадр (GREY/Y800); если драйвер его не умеет,
+    // подойдёт YUYV, из которого берётся яркость. Остальные форматы - через BGR.
+    cap.set(CAP_PROP_FOURCC, VideoWriter::fourcc('G', 'R', 'E', 'Y'));
+    cap.set(CAP_PROP_FRAME_WIDTH, FRAME_WIDTH);
+    cap.set(CAP_PROP_FRAME_HEIGHT, FRAME_HEIGHT);
+    int fourcc = (int)cap.get(CAP_PROP_FOURCC);
+    bool raw = (fourcc == VideoWriter::fourcc('G', 'R', 'E', 'Y') || fourcc == VideoWriter::fourcc('Y', 'U', 'Y', 'V'))
+               && (int)cap.get(CAP_PROP_FRAME_WIDTH) == FRAME_WIDTH
+               && (int)cap.get(CAP_PROP_FRAME_HEIGHT) == FRAME_HEIGHT;
+    cap.set(CAP_PROP_CONVERT_RGB, raw ? 0 : 1);
+    string format;
+    for (int i = 0; i < 4; i++) format += (char)((fourcc >> (8 * i)) & 0xFF);
+    cout << "Capture format: " << format << (raw ? " (luma plane)" : " (BGR)") << endl;
+
+    cout << "Initializing..." << endl;
 
-        if (waitKey(1) == 27) break;
+    arduino_fd = setup_serial();
+    if (arduino_fd >= 0) {
+        arduino_ready = true;
+        cout << "Arduino connected successfully!" << endl;
+    } else {
+        cerr << "Failed to connect to Arduino" << endl;
     }
 
+    // Окна нет, поэтому выход по Ctrl+C, а не по Esc в waitKey
+    signal(SIGINT, [](int) { running = false; });
+
+    thread capture(capture_loop, ref(cap));
+    thread arduino(arduino_loop);
+    decode_loop();
+    capture.join();
+    arduino.join();
+
     if (arduino_fd >= 0) close(arduino_fd);
     return 0;
 }
@@ -0,0 +1,53 @@
+//скетч SOUTHGARDEN (src/main.cpp) в симуляторе, исходник подключается без изменений
+#include "sim.h"
+#include "../src/main.cpp"
+
+namespace {
+
+struct GardenParam
+{
+  const char* name;
+  int Climate::* field;
+};
+
+const GardenParam PARAMS[] = {
+  {"LIGHT_THRESHOLD", &Climate::LIGHT_THRESHOLD},
+  {"EARTH_HUMIDITY_THRESHOLD", &Climate::EARTH_HUMIDITY_THRESHOLD},
+  {"AIR_HUMIDITY_THRESHOLD", &Climate::AIR_HUMIDITY_THRESHOLD},
+  {"TEMP_HIGH_THRESHOLD", &Climate::TEMP_HIGH_THRESHOLD},
+  {"TEMP_LOW_THRESHOLD", &Climate::TEMP_LOW_THRESHOLD},
+  {"TIME_SUNRISE", &Climate::TIME_SUNRISE},
+  {"TIME_SUNSET", &Climate::TIME_SUNSET},
+  {"VENTILATION_TIMER", &Climate::VENTILATION_TIMER},
+  {"PUMP_ON_MILLISECONDS", &Climate::PUMP_ON_MILLISECONDS},
+  {"PUMP_FF_MILLISECONDS", &Climate::PUMP_FF_MILLISECONDS},
+};
+
+bool garden_set_param(const std::string& name, double value)
+{
+  for (const GardenParam& p : PARAMS) {
+    if (name == p.name) {
+      Garden.*p.field = static_cast<int>(value);
+      return true;
+    }
+  }
+  return false;
+}
+
+void garden_comfort_band(double& low, double& high)
+{
+  low = Garden.TEMP_LOW_THRESHOLD;
+  high = Garden.TEMP_HIGH_THRESHOLD;
+}
+
+}
+
+const sim::SketchAdapter sim::sketch = {
+  "SOUTHGARDEN (SharifyanovAR/Garden/src/main.cpp)",
+  setup,
+  loop,
+  garden_set_param,
+  garden_comfort_band,
+  "поля Climate: LIGHT_THRESHOLD EARTH_HUMIDITY_THRESHOLD AIR_HUMIDITY_THRESHOLD TEMP_HIGH_THRESHOLD "
+  "TEMP_LOW_THRESHOLD TIME_SUNRISE TIME_SUNSET VENTILATION_TIMER PUMP_ON_MILLISECONDS PUMP_FF_MILLISECONDS",
+};
@@ -0,0 +1,11 @@
+//заглушка библиотеки DFRobot_DHT11, показания берутся из модели теплицы
+#pragma once
+
+class DFRobot_DHT11
+{
+public:
+  void read(int pin);
+
+  int temperature = 0;
+  int humidity = 0;
+};
@@ -0,0 +1,15 @@
+//заглушка библиотеки DHT11, показания берутся из модели теплицы
+#pragma once
+
+class DHT11
+{
+public:
+  explicit DHT11(int pin) : pin(pin) {}
+
+  // Каждый вызов - отдельный опрос датчика, как в библиотеке
+  int readTemperature() const;
+  int readHumidity() const;
+
+private:
+  int pin;
+};
@@ -0,0 +1,715 @@
+//симулятор теплицы: скетч собирается вместе с заглушками Arduino и моделью климата
+//и работает в виртуальном времени, поэтому месяцы работы считаются за секунды.
+//
+//  garden_sim --days 90
+//  garden_sim --days 30 --jobs 4 --set TEMP_LOW_THRESHOLD=15,17,19 --set room_mean=14,18
+//
+//каждое сочетание значений --set - отдельный прогон в своем процессе (у скетча глобальное
+//состояние), --jobs задает число одновременно работающих процессов
+
+#include "Arduino.h"
+#include "DFRobot_DHT11.h"
+#include "DHT11.h"
+#include "sim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace sim {
+
+static const double US_PER_HOUR = 3600e6;
+static const int PINS = 20;
+static const int SERIAL_BUFFER = 64;
+
+
+struct ParamInfo
+{
+  const char* name;
+  double ModelParams::* field;
+};
+
+static const ParamInfo MODEL_PARAMS[] = {
+  {"room_mean", &ModelParams::room_mean},
+  {"room_day_amp", &ModelParams::room_day_amp},
+  {"room_season_amp", &ModelParams::room_season_amp},
+  {"room_hum", &ModelParams::room_hum},
+  {"heat_rate", &ModelParams::heat_rate},
+  {"lamp_heat", &ModelParams::lamp_heat},
+  {"sun_heat", &ModelParams::sun_heat},
+  {"k_env", &ModelParams::k_env},
+  {"k_fan", &ModelParams::k_fan},
+  {"hum_k_env", &ModelParams::hum_k_env},
+  {"hum_k_fan", &ModelParams::hum_k_fan},
+  {"transpiration", &ModelParams::transpiration},
+  {"soil_dry_rate", &ModelParams::soil_dry_rate},
+  {"pump_rate", &ModelParams::pump_rate},
+  {"sun_light", &ModelParams::sun_light},
+  {"lamp_light", &ModelParams::lamp_light},
+  {"start_day", &ModelParams::start_day},
+  {"start_hour", &ModelParams::start_hour},
+  {"sensor_noise", &ModelParams::sensor_noise},
+  {"dht_glitch", &ModelParams::dht_glitch},
+};
+
+
+// Модель камеры: температура и влажность воздуха экспоненциально стремятся к равновесию,
+// которое задают помещение, солнце и включенные исполнители; почва сохнет и поливается.
+// Состояние догоняет виртуальное время шагами не больше минуты
+class Model
+{
+public:
+  ModelParams p;
+  bool heater = false, fan = false, pump = false, lamp = false;
+
+  double temp = 0, hum = 0, soil = 40;
+
+  // Накопители статистики по времени
+  double band_low = 0, band_high = 0;
+  double hours = 0, temp_sum = 0, temp_min = 1e9, temp_max = -1e9, in_band = 0;
+  double hum_sum = 0, soil_sum = 0, soil_min = 1e9, dry = 0;
+
+  void start(uint64_t seed)
+  {
+    rng = seed * 2654435761u + 1;
+    temp = room_temp(0);
+    hum = p.room_hum;
+  }
+
+  double hour_of_day(double t) const { return std::fmod(p.start_hour + t, 24); }
+
+  double room_temp(double t) const
+  {
+    double day = p.start_day + (p.start_hour + t) / 24;
+    return p.room_mean
+      + p.room_day_amp * std::sin(2 * M_PI * (hour_of_day(t) - 9) / 24)
+      + p.room_season_amp * std::sin(2 * M_PI * (day - 110) / 365);
+  }
+
+  // Доля полуденного солнца с учетом облачности, облачность своя на каждый день
+  double sun(double t)
+  {
+    long day = static_cast<long>((p.start_hour + t) / 24);
+    if (day != cloud_day) {
+      cloud_day = day;
+      cloud = 0.3 + 0.7 * uniform();
+    }
+    double h = hour_of_day(t);
+    if (h < 6 || h > 18) return 0;
+    return cloud * std::sin(M_PI * (h - 6) / 12);
+  }
+
+  double light() { return std::min(100.0, p.sun_light * sun(hours) + (lamp ? p.lamp_light : 0)); }
+
+  void advance(double dt_hours)
+  {
+    while (dt_hours > 0) {
+      double dt = std::min(dt_hours, 1.0 / 60);
+      double mid = hours + dt / 2;
+      double room = room_temp(mid);
+      double s = sun(mid);
+
+      double k = p.k_env + (fan ? p.k_fan : 0);
+      double power = (heater ? p.heat_rate : 0) + (lamp ? p.lamp_heat : 0) + s * p.sun_heat;
+      double temp_eq = room + power / k;
+      temp = temp_eq + (temp - temp_eq) * std::exp(-k * dt);
+
+      // Теплый воздух суше: относительная влажность падает примерно на 4% на градус
+      double hk = p.hum_k_env + (fan ? p.hum_k_fan : 0);
+      double hum_eq = p.room_hum + p.transpiration * soil / 100 / hk - 4 * (temp - room);
+      hum_eq = std::min(100.0, std::max(5.0, hum_eq));
+      hum = hum_eq + (hum - hum_eq) * std::exp(-hk * dt);
+
+      double drying = p.soil_dry_rate * std::max(0.0, 1 + 0.04 * (temp - 20)) * (0.5 + s);
+      soil += ((pump ? p.pump_rate * 3600 : 0) - drying) * dt;
+      soil = std::min(100.0, std::max(0.0, soil));
+
+      hours += dt;
+      dt_hours -= dt;
+      temp_sum += temp * dt;
+      temp_min = std::min(temp_min, temp);
+      temp_max = std::max(temp_max, temp);
+      if (band_low <= temp && temp <= band_high) in_band += dt;
+      hum_sum += hum * dt;
+      soil_sum += soil * dt;
+      soil_min = std::min(soil_min, soil);
+      if (soil < 10) dry += dt;
+    }
+  }
+
+  double uniform()
+  {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (rng >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  double noise(double amplitude) { return amplitude * (2 * uniform() - 1); }
+
+private:
+  uint64_t rng = 1;
+  long cloud_day = -1;
+  double cloud = 1;
+};
+
+
+// Состояние виртуальной платы
+struct Board
+{
+  Wiring wiring;
+  Timing timing;
+  Model model;
+
+  double now = 0;              // мкс с момента включения
+  double synced = 0;           // до какого момента досчитана модель
+  double sync_quantum = 1e6;   // датчики меняются медленно, модель догоняет время не чаще раза в секунду
+
+  uint8_t level[PINS] = {};
+  double high_since[PINS] = {};
+  double high_time[PINS] = {};
+  double switch_count[PINS] = {};
+
+  double byte_time = 0;        // мкс на байт, 0 пока не вызван Serial.begin()
+  double tx_busy_until = 0;
+  double serial_bytes = 0;
+  bool echo = false;
+};
+
+static Board board;
+
+
+static void sync_model(bool force)
+{
+  if (!force && board.now - board.synced < board.sync_quantum) return;
+  board.model.advance((board.now - board.synced) / US_PER_HOUR);
+  board.synced = board.now;
+}
+
+
+static inline void advance(double us)
+{
+  board.now += us;
+}
+
+
+static bool* actuator_for(int pin)
+{
+  Model& m = board.model;
+  if (pin == board.wiring.heater) return &m.heater;
+  if (pin == board.wiring.fan) return &m.fan;
+  if (pin == board.wiring.pump) return &m.pump;
+  if (pin == board.wiring.lamp) return &m.lamp;
+  return nullptr;
+}
+
+
+static int sensor_raw(double percent)
+{
+  // Оба датчика инвертированы: больше света или влаги - меньше отсчет АЦП
+  double value = percent + board.model.noise(board.model.p.sensor_noise);
+  value = std::min(100.0, std::max(0.0, value));
+  return static_cast<int>(std::lround(1023 - value * 1023 / 100));
+}
+
+
+void read_dht11(int pin, int& temperature, int& humidity)
+{
+  (void)pin;
+  advance(board.timing.dht_read);
+  sync_model(false);
+
+  Model& m = board.model;
+  if (m.p.dht_glitch > 0 && m.uniform() < m.p.dht_glitch) {
+    temperature = humidity = 255;
+    return;
+  }
+  temperature = static_cast<int>(std::lround(m.temp + m.noise(0.5)));
+  humidity = static_cast<int>(std::lround(std::min(95.0, std::max(5.0, m.hum + m.noise(1)))));
+}
+
+}
+
+
+// ---- Arduino API ----
+
+using sim::board;
+
+HardwareSerial Serial;
+
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+  sim::advance(board.timing.digital_io);
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  sim::advance(board.timing.digital_io);
+  if (pin >= sim::PINS) return;
+
+  uint8_t level = val ? HIGH : LOW;
+  if (board.level[pin] == level) return;
+
+  bool* actuator = sim::actuator_for(pin);
+  if (actuator) {
+    sim::sync_model(true);
+    *actuator = level == HIGH;
+  }
+  if (level == HIGH) {
+    board.high_since[pin] = board.now;
+    board.switch_count[pin]++;
+  } else {
+    board.high_time[pin] += board.now - board.high_since[pin];
+  }
+  board.level[pin] = level;
+}
+
+
+int digitalRead(uint8_t pin)
+{
+  sim::advance(board.timing.digital_io);
+  return pin < sim::PINS ? board.level[pin] : LOW;
+}
+
+
+int analogRead(uint8_t pin)
+{
+  sim::advance(board.timing.analog_read);
+  sim::sync_model(false);
+
+  if (pin == board.wiring.light_sensor) return sim::sensor_raw(board.model.light());
+  if (pin == board.wiring.soil_sensor) return sim::sensor_raw(board.model.soil);
+  return 0;
+}
+
+
+unsigned long millis()
+{
+  return static_cast<uint32_t>(static_cast<uint64_t>(board.now / 1000));
+}
+
+
+unsigned long micros()
+{
+  return static_cast<uint32_t>(static_cast<uint64_t>(board.now));
+}
+
+
+void delay(unsigned long ms)
+{
+  sim::advance(ms * 1000.0);
+}
+
+
+void delayMicroseconds(unsigned int us)
+{
+  sim::advance(us);
+}
+
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+
+void HardwareSerial::begin(unsigned long baud)
+{
+  // 8N1: 10 бит на байт
+  board.byte_time = 10e6 / baud;
+  board.tx_busy_until = board.now;
+}
+
+
+size_t HardwareSerial::write(const char* str, size_t size)
+{
+  if (board.byte_time == 0) return 0;
+  board.serial_bytes += size;
+  if (board.echo) fwrite(str, 1, size, stdout);
+
+  // Байты уходят в буфер; если он полон, вызов ждет, пока освободится место
+  board.tx_busy_until = std::max(board.tx_busy_until, board.now) + size * board.byte_time;
+  double wait = board.tx_busy_until - board.now - sim::SERIAL_BUFFER * board.byte_time;
+  if (wait > 0) sim::advance(wait);
+  return size;
+}
+
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  char ch = static_cast<char>(c);
+  return write(&ch, 1);
+}
+
+
+size_t HardwareSerial::print(const char* str)
+{
+  return write(str, strlen(str));
+}
+
+
+size_t HardwareSerial::print(char c)
+{
+  return write(static_cast<uint8_t>(c));
+}
+
+
+size_t HardwareSerial::print_number(unsigned long n, int base, bool negative)
+{
+  if (base < 2) base = DEC;
+  char buffer[8 * sizeof(long) + 2];
+  char* end = buffer + sizeof(buffer);
+  char* str = end;
+  do {
+    unsigned long digit = n % base;
+    *--str = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+    n /= base;
+  } while (n);
+  if (negative) *--str = '-';
+  return write(str, end - str);
+}
+
+
+size_t HardwareSerial::print(unsigned char n, int base)
+{
+  return print_number(n, base, false);
+}
+
+
+size_t HardwareSerial::print(int n, int base)
+{
+  return print(static_cast<long>(n), base);
+}
+
+
+size_t HardwareSerial::print(unsigned int n, int base)
+{
+  return print_number(n, base, false);
+}
+
+
+size_t HardwareSerial::print(long n, int base)
+{
+  if (base == DEC && n < 0) return print_number(-static_cast<unsigned long>(n), base, true);
+  return print_number(static_cast<unsigned long>(n), base, false);
+}
+
+
+size_t HardwareSerial::print(unsigned long n, int base)
+{
+  return print_number(n, base, false);
+}
+
+
+size_t HardwareSerial::print(double n, int digits)
+{
+  char buffer[48];
+  int size = snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+  return write(buffer, size > 0 ? std::min<size_t>(size, sizeof(buffer) - 1) : 0);
+}
+
+
+size_t HardwareSerial::println()
+{
+  return write("\r\n", 2);
+}
+
+
+void DFRobot_DHT11::read(int pin)
+{
+  sim::read_dht11(pin, temperature, humidity);
+}
+
+
+int DHT11::readTemperature() const
+{
+  int temperature, humidity;
+  sim::read_dht11(pin, temperature, humidity);
+  return temperature;
+}
+
+
+int DHT11::readHumidity() const
+{
+  int temperature, humidity;
+  sim::read_dht11(pin, temperature, humidity);
+  return humidity;
+}
+
+
+// ---- прогон ----
+
+namespace sim {
+
+struct Setting
+{
+  std::string name;
+  std::vector<double> values;
+};
+
+
+static bool set_param(const std::string& name, double value)
+{
+  for (const ParamInfo& info : MODEL_PARAMS) {
+    if (name == info.name) {
+      board.model.p.*info.field = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static Result run(double days, uint64_t seed, const std::vector<Setting>& settings, const std::vector<double>& values)
+{
+  Result r = {};
+  auto host_start = std::chrono::steady_clock::now();
+
+  // Параметры модели нужны до setup(), настройки скетча - после: setup() задает их сам
+  std::vector<std::string> sketch_settings;
+  for (size_t i = 0; i < settings.size(); i++) {
+    r.params[i] = values[i];
+    if (!set_param(settings[i].name, values[i])) sketch_settings.push_back(settings[i].name);
+  }
+  board.model.start(seed);
+
+  sketch.setup();
+  for (size_t i = 0; i < settings.size(); i++) {
+    if (std::find(sketch_settings.begin(), sketch_settings.end(), settings[i].name) != sketch_settings.end()) {
+      if (!sketch.set_param(settings[i].name, values[i])) {
+        fprintf(stderr, "unknown parameter %s\n", settings[i].name.c_str());
+        exit(2);
+      }
+    }
+  }
+  sketch.comfort_band(board.model.band_low, board.model.band_high);
+
+  const double end = board.now + days * 24 * US_PER_HOUR;
+  double loops = 0, loop_min = 1e300, loop_max = 0;
+  const double loop_start = board.now;
+
+  while (board.now < end) {
+    double begin = board.now;
+    sketch.loop();
+    advance(board.timing.loop_overhead);
+    double length = board.now - begin;
+    loop_min = std::min(loop_min, length);
+    loop_max = std::max(loop_max, length);
+    loops++;
+  }
+  sync_model(true);
+
+  Model& m = board.model;
+  const int pins[Result::ACTUATORS] = {board.wiring.heater, board.wiring.fan, board.wiring.pump, board.wiring.lamp};
+  for (int i = 0; i < Result::ACTUATORS; i++) {
+    int pin = pins[i];
+    double high = board.high_time[pin] + (board.level[pin] ? board.now - board.high_since[pin] : 0);
+    r.duty[i] = high / board.now;
+    r.switches[i] = board.switch_count[pin];
+  }
+
+  r.sim_hours = m.hours;
+  r.host_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - host_start).count();
+  r.loops = loops;
+  r.loop_min_ms = loop_min / 1000;
+  r.loop_mean_ms = (board.now - loop_start) / loops / 1000;
+  r.loop_max_ms = loop_max / 1000;
+  r.temp_min = m.temp_min;
+  r.temp_mean = m.temp_sum / m.hours;
+  r.temp_max = m.temp_max;
+  r.in_band = m.in_band / m.hours;
+  r.hum_mean = m.hum_sum / m.hours;
+  r.soil_min = m.soil_min;
+  r.soil_mean = m.soil_sum / m.hours;
+  r.dry = m.dry / m.hours;
+  r.serial_bytes = board.serial_bytes;
+  return r;
+}
+
+
+static const char* ACTUATOR_NAMES[Result::ACTUATORS] = {"heater", "fan", "pump", "lamp"};
+
+
+static void print_report(const Result& r)
+{
+  double band_low = 0, band_high = 0;
+  sketch.comfort_band(band_low, band_high);
+
+  printf("sketch: %s\n", sketch.name);
+  printf("simulated: %.1f days in %.2f s (x%.0f)\n", r.sim_hours / 24, r.host_seconds,
+         r.sim_hours * 3600 / r.host_seconds);
+  printf("loop(): %.0f calls, period min/mean/max %.3f/%.3f/%.3f ms, host %.0f ns per call\n",
+         r.loops, r.loop_min_ms, r.loop_mean_ms, r.loop_max_ms, r.host_seconds * 1e9 / r.loops);
+  for (int i = 0; i < Result::ACTUATORS; i++) {
+    printf("%-7s duty %6.2f%%, %8.0f switch-ons, %.1f per day\n", ACTUATOR_NAMES[i],
+           r.duty[i] * 100, r.switches[i], r.switches[i] / (r.sim_hours / 24));
+  }
+  printf("air temperature min/mean/max %.1f/%.1f/%.1f C, %.1f%% of time in %.0f..%.0f C\n",
+         r.temp_min, r.temp_mean, r.temp_max, r.in_band * 100, band_low, band_high);
+  printf("air humidity mean %.1f%%, soil humidity min/mean %.1f/%.1f%%, %.1f%% of time below 10%%\n",
+         r.hum_mean, r.soil_min, r.soil_mean, r.dry * 100);
+  printf("serial: %.0f bytes\n", r.serial_bytes);
+}
+
+
+static void print_table(const std::vector<Setting>& settings, const std::vector<Result>& results)
+{
+  for (const Setting& s : settings) printf("%s\t", s.name.c_str());
+  printf("temp_mean\tin_band%%\tsoil_min\tdry%%");
+  for (const char* name : ACTUATOR_NAMES) printf("\t%s%%\t%s_on/day", name, name);
+  printf("\tloop_ms\tspeedup\n");
+
+  for (const Result& r : results) {
+    for (size_t i = 0; i < settings.size(); i++) printf("%g\t", r.params[i]);
+    if (r.sim_hours == 0) {
+      printf("failed\n");
+      continue;
+    }
+    printf("%.2f\t%.2f\t%.1f\t%.2f", r.temp_mean, r.in_band * 100, r.soil_min, r.dry * 100);
+    for (int i = 0; i < Result::ACTUATORS; i++) {
+      printf("\t%.2f\t%.1f", r.duty[i] * 100, r.switches[i] / (r.sim_hours / 24));
+    }
+    printf("\t%.3f\t%.0f\n", r.loop_mean_ms, r.sim_hours * 3600 / r.host_seconds);
+  }
+}
+
+
+static void usage(const char* program)
+{
+  printf("usage: %s [--days N] [--seed N] [--jobs N] [--echo] [--set name=v1,v2,...]...\n\n", program);
+  printf("model parameters:");
+  ModelParams defaults;
+  for (const ParamInfo& info : MODEL_PARAMS) printf(" %s=%g", info.name, defaults.*info.field);
+  printf("\nsketch parameters: %s\n", sketch.params_help);
+}
+
+
+static std::vector<std::vector<double>> combinations(const std::vector<Setting>& settings)
+{
+  std::vector<std::vector<double>> result(1);
+  for (const Setting& s : settings) {
+    std::vector<std::vector<double>> next;
+    for (const auto& prefix : result) {
+      for (double v : s.values) {
+        next.push_back(prefix);
+        next.back().push_back(v);
+      }
+    }
+    result.swap(next);
+  }
+  return result;
+}
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  using namespace sim;
+
+  double days = 30;
+  uint64_t seed = 1;
+  int jobs = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+  std::vector<Setting> settings;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--days" && has_value) days = atof(argv[++i]);
+    else if (arg == "--seed" && has_value) seed = strtoull(argv[++i], nullptr, 10);
+    else if (arg == "--jobs" && has_value) jobs = atoi(argv[++i]);
+    else if (arg == "--echo") board.echo = true;
+    else if (arg == "--set" && has_value) {
+      std::string spec = argv[++i];
+      size_t eq = spec.find('=');
+      if (eq == std::string::npos) {
+        usage(argv[0]);
+        return 1;
+      }
+      Setting s;
+      s.name = spec.substr(0, eq);
+      for (size_t pos = eq + 1; pos <= spec.size();) {
+        size_t comma = std::min(spec.find(',', pos), spec.size());
+        s.values.push_back(atof(spec.substr(pos, comma - pos).c_str()));
+        pos = comma + 1;
+      }
+      settings.push_back(s);
+    }
+    else {
+      usage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+  if (settings.size() > static_cast<size_t>(Result::MAX_PARAMS) || days <= 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<std::vector<double>> runs = combinations(settings);
+  if (runs.size() == 1) {
+    print_report(run(days, seed, settings, runs[0]));
+    return 0;
+  }
+
+  // Каждый прогон в своем процессе: после fork у него чистые глобальные переменные скетча
+  std::vector<Result> results(runs.size());
+  std::vector<std::pair<pid_t, int>> active;   // процесс и конец pipe для чтения
+  std::vector<size_t> active_run;
+  size_t next = 0, failed = 0;
+  jobs = std::max(1, jobs);
+  fflush(stdout);
+
+  while (next < runs.size() || !active.empty()) {
+    while (next < runs.size() && static_cast<int>(active.size()) < jobs) {
+      int fd[2];
+      if (pipe(fd) != 0) {
+        perror("pipe");
+        return 1;
+      }
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(fd[0]);
+        board.echo = false;
+        Result r = run(days, seed, settings, runs[next]);
+        ssize_t written = write(fd[1], &r, sizeof(r));
+        _exit(written == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+      }
+      close(fd[1]);
+      if (pid < 0) {
+        perror("fork");
+        return 1;
+      }
+      active.push_back({pid, fd[0]});
+      active_run.push_back(next++);
+    }
+
+    int status = 0;
+    pid_t done = wait(&status);
+    for (size_t i = 0; i < active.size(); i++) {
+      if (active[i].first != done) continue;
+      Result& r = results[active_run[i]];
+      if (read(active[i].second, &r, sizeof(r)) != static_cast<ssize_t>(sizeof(r))) {
+        r = Result();
+        std::copy(runs[active_run[i]].begin(), runs[active_run[i]].end(), r.params);
+        failed++;
+      }
+      close(active[i].second);
+      active.erase(active.begin() + i);
+      active_run.erase(active_run.begin() + i);
+      break;
+    }
+  }
+
+  print_table(settings, results);
+  if (failed) fprintf(stderr, "%zu runs failed\n", failed);
+  return failed ? 1 : 0;
+}
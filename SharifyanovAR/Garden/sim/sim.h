@@ -0,0 +1,99 @@
+//симулятор теплицы: виртуальное время, модель климата и учет работы исполнителей
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sim {
+
+// Подключение датчиков и исполнителей, одинаковое у обеих теплиц (см. config.h)
+struct Wiring
+{
+  int light_sensor = 14; // A0
+  int soil_sensor = 15;  // A1
+  int heater = 4;
+  int pump = 5;
+  int lamp = 6;
+  int fan = 7;
+  int dht = 12;
+};
+
+
+// Сколько виртуального времени занимают вызовы Arduino API, мкс
+struct Timing
+{
+  double loop_overhead = 10;   // main() ядра Arduino между вызовами loop()
+  double digital_io = 5;
+  double analog_read = 112;    // преобразование АЦП на ATmega328P
+  double dht_read = 23000;     // стартовый импульс 18 мс + 40 бит ответа
+};
+
+
+// Параметры модели теплицы; время в часах, температура в градусах, влажность в процентах
+struct ModelParams
+{
+  double room_mean = 19;        // средняя температура в помещении
+  double room_day_amp = 3;      // суточное колебание
+  double room_season_amp = 4;   // годовое колебание
+  double room_hum = 45;
+  double heat_rate = 10;        // нагрев нагревателем, градусов в час при закрытой камере
+  double lamp_heat = 1.5;
+  double sun_heat = 2;
+  double k_env = 0.7;           // теплообмен камеры с помещением, 1/ч
+  double k_fan = 4;             // добавка теплообмена при работе вентилятора, 1/ч
+  double hum_k_env = 0.5;
+  double hum_k_fan = 4;
+  double transpiration = 20;    // прибавка влажности воздуха от влажной почвы, %/ч
+  double soil_dry_rate = 0.4;   // высыхание почвы, %/ч
+  double pump_rate = 0.5;       // полив, % влажности почвы в секунду
+  double sun_light = 85;        // освещенность в полдень без облаков, %
+  double lamp_light = 35;
+  double start_day = 0;         // день года в начале моделирования
+  double start_hour = 0;
+  double sensor_noise = 1;      // шум АЦП, % шкалы
+  double dht_glitch = 0;        // вероятность ответа 255 от DHT11
+};
+
+
+// Итоги одного прогона; простая структура, передается из дочернего процесса через pipe
+struct Result
+{
+  static const int MAX_PARAMS = 8;
+  static const int ACTUATORS = 4;
+
+  double params[MAX_PARAMS];
+  double sim_hours;
+  double host_seconds;
+  double loops;
+  double loop_min_ms, loop_mean_ms, loop_max_ms;
+  double duty[ACTUATORS];       // доля времени во включенном состоянии: нагреватель, вентилятор, помпа, лампа
+  double switches[ACTUATORS];   // число включений
+  double temp_min, temp_mean, temp_max;
+  double in_band;               // доля времени в диапазоне температур скетча
+  double hum_mean;
+  double soil_min, soil_mean;
+  double dry;                   // доля времени с влажностью почвы ниже 10%
+  double serial_bytes;
+};
+
+
+// Реализуется отдельно для каждого скетча
+struct SketchAdapter
+{
+  const char* name;
+  void (*setup)();
+  void (*loop)();
+  // Вызывается после setup(): меняет настройку скетча, false если имя неизвестно
+  bool (*set_param)(const std::string& name, double value);
+  // Диапазон температур, который пытается держать скетч
+  void (*comfort_band)(double& low, double& high);
+  const char* params_help;
+};
+
+extern const SketchAdapter sketch;
+
+
+// Для заглушек библиотек датчиков
+void read_dht11(int pin, int& temperature, int& humidity);
+
+}
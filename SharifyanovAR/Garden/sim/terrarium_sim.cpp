@@ -0,0 +1,52 @@
+//скетч террариума (IbragimovAF/terrarium_v2.ino) в симуляторе, исходник подключается без изменений
+#include "Arduino.h"
+#include "sim.h"
+#include "../../../IbragimovAF/terrarium_v2.ino"
+
+namespace {
+
+struct TerrariumParam
+{
+  const char* name;
+  int Climate::* field;
+};
+
+const TerrariumParam PARAMS[] = {
+  {"min_temp", &Climate::min_temp},
+  {"max_temp", &Climate::max_temp},
+  {"min_air_hum", &Climate::min_air_hum},
+  {"max_air_hum", &Climate::max_air_hum},
+  {"min_soil_hum", &Climate::min_soil_hum},
+  {"max_soil_hum", &Climate::max_soil_hum},
+  {"fan_enable_time", &Climate::fan_enable_time},
+  {"fan_disable_time", &Climate::fan_disable_time},
+};
+
+bool terrarium_set_param(const std::string& name, double value)
+{
+  for (const TerrariumParam& p : PARAMS) {
+    if (name == p.name) {
+      plant_1.*p.field = static_cast<int>(value);
+      return true;
+    }
+  }
+  return false;
+}
+
+void terrarium_comfort_band(double& low, double& high)
+{
+  low = plant_1.min_temp;
+  high = plant_1.max_temp;
+}
+
+}
+
+const sim::SketchAdapter sim::sketch = {
+  "terrarium_v2 (IbragimovAF/terrarium_v2.ino)",
+  setup,
+  loop,
+  terrarium_set_param,
+  terrarium_comfort_band,
+  "поля Climate plant_1: min_temp max_temp min_air_hum max_air_hum min_soil_hum max_soil_hum "
+  "fan_enable_time fan_disable_time",
+};
@@ -19,6 +19,9 @@
 #include <algorithm>
 #include <signal.h>
 #include <errno.h>
+#include <poll.h>
+
+#include "../../common/timer_wheel/timer_wheel.h"
 
 #define COMMAND_PORT 8888
 #define DATA_PORT_UDP 5601
@@ -361,7 +364,13 @@ private:
   std::atomic<bool> batchMode{ false };
   std::mutex batchMutex;
   std::atomic<bool> batchActive{ false };
-  std::thread batchThread;
+
+  // Пакетные команды и откат режима lost выполняются по таймерам в одном потоке,
+  // поэтому новая команда отменяет их сразу, а не после очередного sleep
+  enum { BATCH_TIMERS = 1, LOST_TIMERS };
+  TimerWheel timers;
+  std::thread timerThread;
+  std::atomic<bool> timersRunning{ true };
 
   void parseAndLogSensorData(const std::string& data) {
     float distance = 0.0;
@@ -399,55 +408,61 @@ private:
     }
   }
 
+  void timerLoop() {
+    while (timersRunning) {
+      pollfd pfd = { timers.fd(), POLLIN, 0 };
+      if (poll(&pfd, 1, 100) > 0 && (pfd.revents & POLLIN)) {
+        timers.runExpired();
+      }
+    }
+  }
+
+  void printTimerJitter() {
+    auto j = timers.jitter();
+    std::cout << "[TIMER] Jitter: " << j.count << " timers, mean " << j.meanUs
+              << " us, p99 " << j.p99Us << " us, max " << j.maxUs << " us" << std::endl;
+  }
+
+  // Шаги пакета планируются от его начала: опоздавший таймер не сдвигает следующие
   void executeBatchCommand(const std::vector<BatchCommand>& batch) {
+    stopCurrentBatch();
     {
         std::lock_guard<std::mutex> lock(batchMutex);
-        if (batchMode) {
-            std::cout << "[BATCH] Already running, canceling previous..." << std::endl;
-            batchActive = false;
-            if (batchThread.joinable()) {
-                batchThread.join();
-            }
-        }
         batchMode = true;
         std::cout << "[BATCH] Mode ACTIVE" << std::endl;
     }
-   
+
     batchActive = true;
     dataLogger.logBatchCommand("START_BATCH");
 
+    auto at = TimerWheel::Clock::now();
     for (const auto& bc : batch) {
-        if (!batchActive || !clientConnected) {
-            std::cout << "[BATCH] Interrupted\n";
-            break;
-        }
-        
-        std::cout << "[BATCH] Executing: " << bc.cmd << " for " << bc.seconds << "s" << std::endl;
-        arduino.sendToArduino(bc.cmd);
-
-        int steps = bc.seconds * 10;
-        for (int i = 0; i < steps; ++i) {
-            if (!batchActive || !clientConnected) {
-                std::cout << "[BATCH] Interrupted during execution" << std::endl;
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        timers.scheduleAt(at, [this, bc]() {
+            std::cout << "[BATCH] Executing: " << bc.cmd << " for " << bc.seconds << "s" << std::endl;
+            arduino.sendToArduino(bc.cmd);
+        }, BATCH_TIMERS);
+        at += std::chrono::seconds(bc.seconds);
 
-        if (!batchActive || !clientConnected) break;
-
-        std::cout << "[BATCH] Stopping after " << bc.seconds << "s" << std::endl;
-        arduino.sendToArduino(' ');
-        dataLogger.logCommand(bc.cmd, bc.seconds * 1000);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        timers.scheduleAt(at, [this, bc]() {
+            std::cout << "[BATCH] Stopping after " << bc.seconds << "s" << std::endl;
+            arduino.sendToArduino(' ');
+            dataLogger.logCommand(bc.cmd, bc.seconds * 1000);
+        }, BATCH_TIMERS);
+        at += std::chrono::milliseconds(100);
     }
 
-    if (batchActive && clientConnected) {
+    timers.scheduleAt(at, [this]() {
         std::cout << "[BATCH] Batch complete, sending FINAL STOP" << std::endl;
         arduino.sendToArduino(' ');
         dataLogger.logCommand(' ', 100);
-    }
-    
+        finishBatch();
+        printTimerJitter();
+    }, BATCH_TIMERS);
+  }
+
+  void finishBatch() {
+    if (!batchActive.exchange(false)) return;
+
     dataLogger.logBatchCommand("END_BATCH");
 
     {
@@ -455,26 +470,43 @@ private:
         batchMode = false;
         std::cout << "[BATCH] Mode INACTIVE" << std::endl;
     }
-    batchActive = false;
   }
 
   void stopCurrentBatch() {
     if (!batchActive) return;
 
     std::cout << "[BATCH] Stopping current batch..." << std::endl;
-    batchActive = false;
+    timers.cancelGroup(BATCH_TIMERS);
     arduino.sendToArduino(' ');
+    finishBatch();
 
-    if (batchThread.joinable()) {
-        batchThread.join();
-    }
+    std::cout << "[BATCH] Fully stopped\n";
+  }
+
+  void stopLostMode() {
+    if (!lost) return;
+
+    // cancelGroup ждёт уже запущенный колбэк; если это был последний шаг,
+    // режим завершил он, и здесь завершать нечего
+    timers.cancelGroup(LOST_TIMERS);
+    if (!finishLostMode()) return;
+    arduino.sendToArduino(' ');
+    std::cout << "[LOST MODE] Interrupted\n";
+  }
+
+  // Завершает режим ровно один раз: из последнего шага отката или из stopLostMode
+  bool finishLostMode() {
+    if (!lost.exchange(false)) return false;
 
     {
-        std::lock_guard<std::mutex> lock(batchMutex);
-        batchMode = false;
+      std::lock_guard<std::mutex> lock(log_mutex);
+      log.clear();
+      last_cmd = ' ';
+      last_time = std::chrono::steady_clock::now();
     }
 
-    std::cout << "[BATCH] Fully stopped\n";
+    dataLogger.logLostModeEnd();
+    return true;
   }
 
   void clearCommandBuffer() {
@@ -499,6 +531,7 @@ public:
     } else {
       std::cerr << "[ROBOT] Failed to connect to Arduino" << std::endl;
     }
+    timerThread = std::thread(&RobotController::timerLoop, this);
   }
 
   ~RobotController() {
@@ -507,6 +540,10 @@ public:
       sensorLogThread.join();
       
     stopCurrentBatch();
+    stopLostMode();
+    timersRunning = false;
+    if (timerThread.joinable())
+      timerThread.join();
     arduino.stop();
   }
 
@@ -519,6 +556,7 @@ public:
     std::cout << "[ROBOT] Force stopping all motors" << std::endl;
     
     stopCurrentBatch();
+    stopLostMode();
     clearCommandBuffer();
     
     for (int i = 0; i < 3; i++) {
@@ -542,8 +580,6 @@ public:
   }
 
   void handleBatchCommand(const std::string& batchText) {
-    if (lost) return;
-
     if (!clientConnected) {
         std::cout << "[BATCH] No client connected, ignoring" << std::endl;
         return;
@@ -555,38 +591,28 @@ public:
         return;
     }
 
-    if (batchThread.joinable()) {
-        std::cout << "[BATCH] Stopping previous batch..." << std::endl;
-        batchActive = false;
-        batchThread.join();
-    }
-
-    batchThread = std::thread([this, commands]() {
-        this->executeBatchCommand(commands);
-    });
-    
+    stopLostMode();
+    executeBatchCommand(commands);
     std::cout << "[BATCH] Started in background" << std::endl;
   }
 
   void handleCommand(char c) {
-    bool isBatchActive = false;
-    {
-      std::lock_guard<std::mutex> lock(batchMutex);
-      isBatchActive = batchMode;
-    }
-
-    if (isBatchActive) {
-      std::cout << "[CMD] Ignoring WASD command - batch mode active" << std::endl;
-      return;
-    }
-
-    if (lost) return;
-
     if (!clientConnected) {
       std::cout << "[CMD] No client connected, ignoring: " << c << std::endl;
       return;
     }
 
+    // Новая команда прерывает пакет и откат
+    if (batchActive) {
+      std::cout << "[CMD] Batch preempted by: " << c << std::endl;
+      stopCurrentBatch();
+    }
+    if (lost) {
+      if (c == 'l') return;
+      std::cout << "[CMD] Lost mode preempted by: " << c << std::endl;
+      stopLostMode();
+    }
+
     if (c == 'l') {
       dataLogger.logLostModeStart();
       startLostMode();
@@ -596,15 +622,15 @@ public:
     if (c != 'w' && c != 'a' && c != 's' && c != 'd' && c != ' ')
       return;
 
-    auto now = std::chrono::steady_clock::now();
-    auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_time);
-    last_time = now;
-
-    if (delta > std::chrono::milliseconds(500))
-      delta = std::chrono::milliseconds(500);
-
     {
       std::lock_guard<std::mutex> lock(log_mutex);
+      auto now = std::chrono::steady_clock::now();
+      auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_time);
+      last_time = now;
+
+      if (delta > std::chrono::milliseconds(500))
+        delta = std::chrono::milliseconds(500);
+
       if (!log.empty() && last_cmd == c) {
         log.back().duration += delta;
       } else {
@@ -621,50 +647,45 @@ public:
     if (lost) return;
     lost = true;
 
-    std::thread([this]() {
-      std::cout << "\n[LOST MODE] START\n";
+    std::cout << "\n[LOST MODE] START\n";
 
-      std::deque<TimedCommand> copy;
-      {
-        std::lock_guard<std::mutex> lock(log_mutex);
-        copy = log;
-      }
+    std::deque<TimedCommand> copy;
+    {
+      std::lock_guard<std::mutex> lock(log_mutex);
+      copy = log;
+    }
 
-      auto start = std::chrono::steady_clock::now();
+    auto start = TimerWheel::Clock::now();
+    auto at = start;
 
-      for (auto it = copy.rbegin(); it != copy.rend(); ++it) {
-        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(10))
-          break;
+    for (auto it = copy.rbegin(); it != copy.rend(); ++it) {
+      if (at - start > std::chrono::seconds(10))
+        break;
 
-        char inv = invertCommand(it->cmd);
-        if (!inv) continue;
+      char inv = invertCommand(it->cmd);
+      if (!inv) continue;
 
+      auto duration = it->duration;
+      timers.scheduleAt(at, [this, inv, duration]() {
         std::cout << "[LOST] " << inv
-                  << " for " << it->duration.count() << " ms\n";
-
+                  << " for " << duration.count() << " ms\n";
         arduino.sendToArduino(inv);
-        std::this_thread::sleep_for(it->duration);
-
-        dataLogger.logCommand(inv, it->duration.count());
+      }, LOST_TIMERS);
+      at += duration;
 
+      timers.scheduleAt(at, [this, inv, duration]() {
+        dataLogger.logCommand(inv, duration.count());
         arduino.sendToArduino(' ');
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      }
+      }, LOST_TIMERS);
+      at += std::chrono::milliseconds(100);
+    }
 
+    timers.scheduleAt(at, [this]() {
       arduino.sendToArduino(' ');
-
-      {
-        std::lock_guard<std::mutex> lock(log_mutex);
-        log.clear();
-      }
-
-      dataLogger.logLostModeEnd();
-      lost = false;
-      last_cmd = ' ';
-      last_time = std::chrono::steady_clock::now();
-
+      finishLostMode();
       std::cout << "[LOST MODE] END\n\n";
-    }).detach();
+      printTimerJitter();
+    }, LOST_TIMERS);
   }
 };
 
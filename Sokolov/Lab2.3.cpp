@@ -1,13 +1,18 @@
-﻿#include <atomic>
+﻿#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <climits>
 #include <condition_variable>
+#include <cstdint>
 #include <ctime>
 #include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
-#include <list>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <sstream>
@@ -17,9 +22,18 @@
 #include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // constants
 const int min_connection_time = 3600; // 1 hour in seconds
 const int min_frequency = 1;          // minimum flight frequency
+const time_t departure_bucket_seconds = 900;   // departures within 15 minutes share a cache entry
+const size_t route_cache_bytes = 64 << 20;     // memory budget of the route cache
 
 // ===================================================
 // enum for flight_category – to avoid magic strings
@@ -98,185 +112,533 @@ private:
 };
 
 // =====================================================
-// LRU cache for route caching with dynamic resizing
+// journey – flights taken with their actual departure and arrival times
+// =====================================================
+struct journey_leg {
+    flight fl;
+    time_t departure;
+    time_t arrival;
+};
+
+struct journey {
+    std::vector<journey_leg> legs;
+    time_t departure = 0;  // departure of the first flight
+    time_t arrival = 0;    // arrival of the last flight
+    time_t query_time = 0; // departure time the cached answer was computed for
+
+    bool empty() const { return legs.empty(); }
+};
+
+// =====================================================
+// route_key – cache key: (start, destination, departure time bucket)
+// =====================================================
+struct route_key {
+    std::string start;
+    std::string destination;
+    time_t departure_bucket;
+
+    bool operator==(const route_key& other) const {
+        return departure_bucket == other.departure_bucket && start == other.start && destination == other.destination;
+    }
+};
+
+struct route_key_hash {
+    size_t operator()(const route_key& key) const {
+        size_t h = std::hash<std::string>()(key.start);
+        h = h * 0x9E3779B97F4A7C15ull ^ std::hash<std::string>()(key.destination);
+        h = h * 0x9E3779B97F4A7C15ull ^ std::hash<long long>()(static_cast<long long>(key.departure_bucket));
+        return h ^ (h >> 29);
+    }
+};
+
+// Approximate heap footprint of a cached route, used for the byte budget
+size_t route_bytes(const route_key& key, const journey& route) {
+    size_t bytes = sizeof(route_key) + sizeof(journey) + key.start.capacity() + key.destination.capacity();
+    bytes += route.legs.capacity() * sizeof(journey_leg);
+    for (const auto& leg : route.legs) {
+        if (leg.fl.get_origin().capacity() > 15) bytes += leg.fl.get_origin().capacity();
+        if (leg.fl.get_destination().capacity() > 15) bytes += leg.fl.get_destination().capacity();
+    }
+    return bytes;
+}
+
+struct cache_metrics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t rejections = 0;  // new entries refused by the admission filter
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// =====================================================
+// frequency_sketch – TinyLFU popularity estimate (count-min, 4-bit counters with aging)
+// =====================================================
+class frequency_sketch {
+public:
+    explicit frequency_sketch(size_t width) {
+        width_ = 16;
+        while (width_ < width)
+            width_ *= 2;
+        table_.assign(depth_ * width_, 0);
+        sample_size_ = 10 * width_;
+    }
+
+    void increment(size_t hash) {
+        for (size_t row = 0; row < depth_; row++) {
+            uint8_t& counter = table_[index(row, hash)];
+            if (counter < 15)
+                counter++;
+        }
+        // Aging: halving all counters lets new popular routes displace old ones
+        if (++additions_ >= sample_size_) {
+            for (auto& counter : table_)
+                counter >>= 1;
+            additions_ /= 2;
+        }
+    }
+
+    unsigned estimate(size_t hash) const {
+        unsigned result = 15;
+        for (size_t row = 0; row < depth_; row++)
+            result = std::min<unsigned>(result, table_[index(row, hash)]);
+        return result;
+    }
+
+private:
+    static constexpr size_t depth_ = 4;
+
+    size_t index(size_t row, size_t hash) const {
+        static const uint64_t seeds[depth_] = { 0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull,
+                                                0x9ae16a3b2f90404full, 0xcbf29ce484222325ull };
+        uint64_t h = (hash + row) * seeds[row];
+        return row * width_ + static_cast<size_t>((h >> 32) & (width_ - 1));
+    }
+
+    std::vector<uint8_t> table_;
+    size_t width_;
+    size_t additions_ = 0;
+    size_t sample_size_;
+};
+
+// =====================================================
+// sharded_cache – concurrent route cache with a memory budget
 // =====================================================
-template <typename Key, typename Value>
-class dynamic_lru_cache {
+// Keys are spread over shards by hash, each shard has its own mutex, so queries
+// for different routes rarely wait for each other. Inside a shard eviction is
+// CLOCK: a hit only sets the reference bit, no list splicing. A new entry that
+// does not fit is admitted only if the TinyLFU sketch says it is requested more
+// often than the entry it would evict, so one-off routes do not flush popular ones.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class sharded_cache {
 public:
-    dynamic_lru_cache(size_t initial_capacity) : capacity_(initial_capacity), min_capacity_(10), max_capacity_(1000) {}
+    using size_function = std::function<size_t(const Key&, const Value&)>;
+
+    sharded_cache(size_t budget_bytes, size_function size_of, size_t shard_count = 16)
+        : size_of_(size_of) {
+        for (size_t i = 0; i < shard_count; i++)
+            shards_.emplace_back(new shard(budget_bytes / shard_count));
+    }
 
     bool get(const Key& key, Value& value) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        auto it = cache_items_map_.find(key);
-        if (it == cache_items_map_.end())
+        return get(key, value, [](const Value&) { return true; });
+    }
+
+    // Hit only if `accept` approves the cached value; a rejected entry counts as a miss
+    template <typename Accept>
+    bool get(const Key& key, Value& value, Accept accept) {
+        size_t hash = hasher_(key);
+        shard& sh = shard_for(hash);
+        std::lock_guard<std::mutex> lock(sh.mutex_);
+        sh.sketch_.increment(hash);
+        auto it = sh.index_.find(key);
+        if (it == sh.index_.end()) {
+            sh.metrics_.misses++;
+            return false;
+        }
+        slot& s = sh.slots_[it->second];
+        if (!accept(s.value)) {
+            sh.metrics_.misses++;
             return false;
-        // Move item to front
-        cache_items_list_.splice(cache_items_list_.begin(), cache_items_list_, it->second);
-        value = it->second->second;
+        }
+        s.referenced = true;
+        value = s.value;
+        sh.metrics_.hits++;
         return true;
     }
 
     void put(const Key& key, const Value& value) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        auto it = cache_items_map_.find(key);
-        if (it != cache_items_map_.end()) {
-            // Update and move to front
-            it->second->second = value;
-            cache_items_list_.splice(cache_items_list_.begin(), cache_items_list_, it->second);
+        size_t hash = hasher_(key);
+        size_t bytes = size_of_(key, value);
+        shard& sh = shard_for(hash);
+        std::lock_guard<std::mutex> lock(sh.mutex_);
+
+        auto it = sh.index_.find(key);
+        if (it != sh.index_.end()) {
+            slot& s = sh.slots_[it->second];
+            sh.metrics_.bytes += bytes - s.bytes;
+            s.value = value;
+            s.bytes = bytes;
+            s.referenced = true;
+            evict_to_budget(sh, SIZE_MAX);
+            return;
+        }
+        if (bytes > sh.budget_) {
+            sh.metrics_.rejections++;
             return;
         }
+        if (sh.metrics_.bytes + bytes > sh.budget_) {
+            size_t victim = next_victim(sh);
+            if (sh.sketch_.estimate(hash) <= sh.sketch_.estimate(hasher_(sh.slots_[victim].key))) {
+                sh.metrics_.rejections++;
+                return;
+            }
+            evict(sh, victim);
+            evict_to_budget(sh, bytes);
+        }
 
-        // Check if we need to resize the cache
-        adjust_capacity();
+        size_t position;
+        if (!sh.free_.empty()) {
+            position = sh.free_.back();
+            sh.free_.pop_back();
+        }
+        else {
+            position = sh.slots_.size();
+            sh.slots_.emplace_back();
+        }
+        slot& s = sh.slots_[position];
+        s.key = key;
+        s.value = value;
+        s.bytes = bytes;
+        s.used = true;
+        s.referenced = false;
+        sh.index_.emplace(key, position);
+        sh.metrics_.bytes += bytes;
+        sh.metrics_.entries++;
+    }
 
-        if (cache_items_list_.size() >= capacity_) {
-            // Remove least recently used
-            auto last = cache_items_list_.end();
-            last--;
-            cache_items_map_.erase(last->first);
-            cache_items_list_.pop_back();
+    cache_metrics metrics() const {
+        cache_metrics total;
+        for (const auto& sh : shards_) {
+            std::lock_guard<std::mutex> lock(sh->mutex_);
+            total.hits += sh->metrics_.hits;
+            total.misses += sh->metrics_.misses;
+            total.evictions += sh->metrics_.evictions;
+            total.rejections += sh->metrics_.rejections;
+            total.entries += sh->metrics_.entries;
+            total.bytes += sh->metrics_.bytes;
         }
-        cache_items_list_.push_front(std::make_pair(key, value));
-        cache_items_map_[key] = cache_items_list_.begin();
+        return total;
     }
 
 private:
-    void adjust_capacity() {
-        // Example adjustment logic: increase capacity if usage is high, decrease if usage is low
-        size_t current_size = cache_items_list_.size();
-        if (current_size > capacity_ * 0.75 && capacity_ < max_capacity_) {
-            capacity_ *= 2;
-            if (capacity_ > max_capacity_) {
-                capacity_ = max_capacity_;
+    struct slot {
+        Key key;
+        Value value;
+        size_t bytes = 0;
+        bool used = false;
+        bool referenced = false;
+    };
+
+    struct shard {
+        explicit shard(size_t budget) : budget_(budget), sketch_(std::max<size_t>(64, budget / 256)) {}
+
+        mutable std::mutex mutex_;
+        size_t budget_;
+        std::vector<slot> slots_;
+        std::vector<size_t> free_;
+        std::unordered_map<Key, size_t, Hash> index_;
+        size_t hand_ = 0;
+        frequency_sketch sketch_;
+        cache_metrics metrics_;
+    };
+
+    shard& shard_for(size_t hash) {
+        return *shards_[(hash >> 7) % shards_.size()];
+    }
+
+    // CLOCK hand: referenced entries get a second chance, the first unreferenced one is the victim
+    static size_t next_victim(shard& sh) {
+        while (true) {
+            if (sh.hand_ >= sh.slots_.size())
+                sh.hand_ = 0;
+            slot& s = sh.slots_[sh.hand_];
+            if (s.used) {
+                if (!s.referenced)
+                    return sh.hand_;
+                s.referenced = false;
             }
+            sh.hand_++;
+        }
+    }
+
+    void evict(shard& sh, size_t position) {
+        slot& s = sh.slots_[position];
+        sh.index_.erase(s.key);
+        sh.metrics_.bytes -= s.bytes;
+        sh.metrics_.entries--;
+        sh.metrics_.evictions++;
+        s = slot();
+        sh.free_.push_back(position);
+    }
+
+    // Frees space until `incoming` more bytes fit (SIZE_MAX: only bring the shard back under budget)
+    void evict_to_budget(shard& sh, size_t incoming) {
+        size_t extra = incoming == SIZE_MAX ? 0 : incoming;
+        while (sh.metrics_.entries > 0 && sh.metrics_.bytes + extra > sh.budget_)
+            evict(sh, next_victim(sh));
+    }
+
+    std::vector<std::unique_ptr<shard>> shards_;
+    size_function size_of_;
+    Hash hasher_;
+};
+
+// =====================================================
+// class mapped_file – read-only view of a whole file (mmap, or one read on Windows)
+// =====================================================
+class mapped_file {
+public:
+    explicit mapped_file(const std::string& filename) {
+#ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Error opening file: " + filename);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Error reading file: " + filename);
         }
-        else if (current_size < capacity_ * 0.25 && capacity_ > min_capacity_) {
-            capacity_ /= 2;
-            if (capacity_ < min_capacity_) {
-                capacity_ = min_capacity_;
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Error mapping file: " + filename);
             }
+            madvise(mapping, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapping);
         }
+        close(fd);
+#else
+        std::ifstream infile(filename, std::ios::binary | std::ios::ate);
+        if (!infile)
+            throw std::runtime_error("Error opening file: " + filename);
+        buffer_.resize(static_cast<size_t>(infile.tellg()));
+        infile.seekg(0);
+        infile.read(&buffer_[0], buffer_.size());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    ~mapped_file() {
+#ifndef _WIN32
+        if (data_ != nullptr)
+            munmap(const_cast<char*>(data_), size_);
+#endif
     }
 
-    std::list<std::pair<Key, Value>> cache_items_list_;
-    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> cache_items_map_;
-    size_t capacity_;
-    const size_t min_capacity_;
-    const size_t max_capacity_;
-    std::mutex cache_mutex_;
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    std::string buffer_;
+#endif
 };
 
 // =====================================================
-// class file_reader – reads and parses the CSV file using a thread pool (without std::async)
+// class file_reader – parses the CSV file in parallel byte ranges
 // =====================================================
 class file_reader {
 public:
-    static std::vector<flight> read_flights_from_file(const std::string& filename) {
+    // The file body is cut into chunks of several MB aligned to line starts.
+    // Workers claim whole chunks from a shared counter and parse them into the
+    // chunk's own vector, so there is no lock per line; chunks are concatenated
+    // in file order at the end. thread_count == 0 means hardware_concurrency().
+    static std::vector<flight> read_flights_from_file(const std::string& filename, unsigned thread_count = 0) {
         std::vector<flight> flights;
-        std::ifstream infile(filename);
-        if (!infile) {
-            std::cerr << "Error opening file: " << filename << std::endl;
+        std::unique_ptr<mapped_file> file;
+        try {
+            file.reset(new mapped_file(filename));
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
             return flights;
         }
-        std::string header_line;
-        if (!std::getline(infile, header_line)) {
+        const char* begin = file->data();
+        const char* end = begin + file->size();
+
+        const char* header_end = std::find(begin, end, '\n');
+        if (header_end == begin) {
             std::cerr << "Error reading header line." << std::endl;
             return flights;
         }
-        auto header_map = parse_header(header_line);
-
-        // Read all remaining lines into a vector
-        std::vector<std::string> all_lines;
-        std::string line;
-        while (std::getline(infile, line)) {
-            if (!line.empty())
-                all_lines.push_back(line);
+        column_layout columns;
+        try {
+            columns = parse_header(std::string(begin, trim_cr(begin, header_end)));
         }
+        catch (const std::exception& e) {
+            std::cerr << "Error reading header line: " << e.what() << std::endl;
+            return flights;
+        }
+        const char* body = header_end == end ? end : header_end + 1;
 
-        // Determine dynamic pool size: not more than available cores, but also not more than needed.
-        unsigned available_threads = std::thread::hardware_concurrency();
-        unsigned pool_size = std::min(available_threads, static_cast<unsigned>(all_lines.size()));
-        if (pool_size == 0) pool_size = 1;
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        size_t body_size = static_cast<size_t>(end - body);
+        size_t chunk_count = std::max<size_t>(1, std::min<size_t>(body_size / min_chunk_bytes, thread_count * chunks_per_thread));
+        thread_count = static_cast<unsigned>(std::min<size_t>(thread_count, chunk_count));
 
-        std::vector<flight> result;
-        result.reserve(all_lines.size());
-        std::mutex result_mutex;
+        // Chunk k covers [bounds[k], bounds[k + 1]); every bound is the start of a line
+        std::vector<const char*> bounds(chunk_count + 1, end);
+        bounds[0] = body;
+        for (size_t k = 1; k < chunk_count; k++) {
+            const char* guess = std::max(bounds[k - 1], body + body_size / chunk_count * k);
+            const char* newline = std::find(guess, end, '\n');
+            bounds[k] = newline == end ? end : newline + 1;
+        }
 
-        // Shared index for dynamic work distribution
-        std::atomic<size_t> line_index(0);
+        std::vector<std::vector<flight>> parsed(chunk_count);
+        std::vector<std::vector<std::string>> errors(chunk_count);
+        std::atomic<size_t> next_chunk(0);
 
         auto worker = [&]() {
+            std::vector<field> fields;
             while (true) {
-                size_t index = line_index.fetch_add(1);
-                if (index >= all_lines.size())
+                size_t chunk = next_chunk.fetch_add(1);
+                if (chunk >= chunk_count)
                     break;
-                const std::string& curr_line = all_lines[index];
-                try {
-                    // Preliminary filter: if line does not contain 'D' or 'd', skip it.
-                    if (curr_line.find("D") == std::string::npos &&
-                        curr_line.find("d") == std::string::npos)
-                        continue;
-                    flight fl = parse_line(curr_line, header_map);
-                    if (!fl.get_origin().empty()) {
-                        std::lock_guard<std::mutex> lock(result_mutex);
-                        result.push_back(std::move(fl));
-                    }
-                }
-                catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(result_mutex);
-                    std::cerr << "Error parsing line: " << curr_line << "\n" << e.what() << std::endl;
-                }
+                parse_chunk(bounds[chunk], bounds[chunk + 1], columns, fields, parsed[chunk], errors[chunk]);
             }
             };
 
         std::vector<std::thread> threads;
-        for (unsigned i = 0; i < pool_size; ++i)
+        for (unsigned i = 1; i < thread_count; ++i)
             threads.emplace_back(worker);
+        worker();
         for (auto& th : threads)
             th.join();
 
-        return result;
+        size_t total = 0;
+        for (const auto& part : parsed)
+            total += part.size();
+        flights.reserve(total);
+        for (size_t k = 0; k < chunk_count; k++) {
+            std::move(parsed[k].begin(), parsed[k].end(), std::back_inserter(flights));
+            for (const auto& message : errors[k])
+                std::cerr << message << std::endl;
+        }
+        return flights;
     }
 private:
-    static std::unordered_map<std::string, int> parse_header(const std::string& header_line) {
-        std::unordered_map<std::string, int> header_map;
+    static constexpr size_t min_chunk_bytes = 1 << 20;
+    static constexpr size_t chunks_per_thread = 8;  // several chunks per worker even out slow ranges
+    static constexpr size_t min_fields = 50;
+
+    struct field {
+        const char* data;
+        size_t size;
+        std::string str() const { return std::string(data, size); }
+    };
+
+    // Column numbers resolved once from the header instead of a map lookup per field per line
+    struct column_layout {
+        size_t origin = 0, dest = 0, departures = 0, air_time = 0, distance = 0, data_source = 0;
+    };
+
+    static const char* trim_cr(const char* begin, const char* end) {
+        return (end > begin && end[-1] == '\r') ? end - 1 : end;
+    }
+
+    static column_layout parse_header(const std::string& header_line) {
+        std::unordered_map<std::string, size_t> header_map;
         std::istringstream ss(header_line);
         std::string token;
-        int index = 0;
+        size_t index = 0;
         while (std::getline(ss, token, ',')) {
             header_map[token] = index++;
         }
-        return header_map;
+        column_layout columns;
+        columns.origin = header_map.at("ORIGIN");
+        columns.dest = header_map.at("DEST");
+        columns.departures = header_map.at("DEPARTURES_PERFORMED");
+        columns.air_time = header_map.at("AIR_TIME");
+        columns.distance = header_map.at("DISTANCE");
+        columns.data_source = header_map.at("DATA_SOURCE");
+        return columns;
     }
 
-    // Parses a CSV data line into a flight object.
+    static void parse_chunk(const char* begin, const char* end, const column_layout& columns,
+        std::vector<field>& fields, std::vector<flight>& out, std::vector<std::string>& errors) {
+        while (begin < end) {
+            const char* newline = std::find(begin, end, '\n');
+            const char* line_end = trim_cr(begin, newline);
+            if (line_end > begin) {
+                try {
+                    // Preliminary filter: if line does not contain 'D' or 'd', skip it.
+                    if (std::find(begin, line_end, 'D') != line_end || std::find(begin, line_end, 'd') != line_end) {
+                        flight fl = parse_line(begin, line_end, columns, fields);
+                        if (!fl.get_origin().empty())
+                            out.push_back(std::move(fl));
+                    }
+                }
+                catch (const std::exception& e) {
+                    errors.push_back("Error parsing line: " + std::string(begin, line_end) + "\n" + e.what());
+                }
+            }
+            begin = newline == end ? end : newline + 1;
+        }
+    }
+
+    template <typename T>
+    static T parse_number(const field& f) {
+        T value = T();
+        const char* first = f.data;
+        const char* last = f.data + f.size;
+        while (first < last && (*first == ' ' || *first == '\t'))
+            first++;
+        if (first < last && *first == '+')
+            first++;
+        auto result = std::from_chars(first, last, value);
+        if (result.ec != std::errc())
+            throw std::invalid_argument("Bad number: " + f.str());
+        return value;
+    }
+
+    // Parses a CSV data line into a flight object without copying fields.
     // Expected fields: ORIGIN, DEST, DEPARTURES_PERFORMED, AIR_TIME, DISTANCE, DATA_SOURCE.
-    static flight parse_line(const std::string& line,
-        const std::unordered_map<std::string, int>& header_map) {
-        std::istringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+    static flight parse_line(const char* begin, const char* end, const column_layout& columns,
+        std::vector<field>& fields) {
+        fields.clear();
+        for (const char* p = begin;; ) {
+            const char* comma = std::find(p, end, ',');
+            fields.push_back({ p, static_cast<size_t>(comma - p) });
+            if (comma == end)
+                break;
+            p = comma + 1;
         }
-        if (tokens.size() < 50)
+        if (fields.size() < min_fields)
             throw std::runtime_error("Not enough data in line.");
         // Additional checks for required fields:
-        if (tokens.at(header_map.at("ORIGIN")).empty() ||
-            tokens.at(header_map.at("DEST")).empty() ||
-            tokens.at(header_map.at("AIR_TIME")).empty())
+        if (fields.at(columns.origin).size == 0 ||
+            fields.at(columns.dest).size == 0 ||
+            fields.at(columns.air_time).size == 0)
             throw std::runtime_error("Missing required fields.");
 
-        std::string origin = tokens.at(header_map.at("ORIGIN"));
-        std::string dest = tokens.at(header_map.at("DEST"));
-        int freq = std::stoi(tokens.at(header_map.at("DEPARTURES_PERFORMED")));
-        double air_time_minutes = std::stod(tokens.at(header_map.at("AIR_TIME")));
+        int freq = parse_number<int>(fields.at(columns.departures));
+        double air_time_minutes = parse_number<double>(fields.at(columns.air_time));
         time_t duration = static_cast<time_t>(air_time_minutes * 60);
-        double distance = std::stod(tokens.at(header_map.at("DISTANCE")));
-        std::string data_source = tokens.at(header_map.at("DATA_SOURCE"));
-        flight_category cat = parse_flight_category(data_source);
+        double distance = parse_number<double>(fields.at(columns.distance));
+        flight_category cat = parse_flight_category(fields.at(columns.data_source).str());
 
-        return flight(origin, dest, freq, cat, duration, distance);
+        return flight(fields[columns.origin].str(), fields[columns.dest].str(), freq, cat, duration, distance);
     }
 };
 
@@ -304,126 +666,323 @@ private:
 };
 
 // =====================================================
-// class flight_graph – represents the flight graph using std::map
+// Functions for local calendar days
 // =====================================================
+std::tm local_tm(time_t t) {
+    std::tm tm_val = {};
+#ifdef _WIN32
+    localtime_s(&tm_val, &t);
+#else
+    localtime_r(&t, &tm_val);
+#endif
+    return tm_val;
+}
+
+time_t local_midnight(time_t t) {
+    std::tm tm_val = local_tm(t);
+    tm_val.tm_hour = 0;
+    tm_val.tm_min = 0;
+    tm_val.tm_sec = 0;
+    tm_val.tm_isdst = -1;
+    return mktime(&tm_val);
+}
+
+std::string format_time(time_t t) {
+    std::tm tm_val = local_tm(t);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", &tm_val);
+    return buffer;
+}
+
+// =====================================================
+// class flight_graph – daily timetable indexed by integer airport IDs
+// =====================================================
+// The input has monthly DEPARTURES_PERFORMED but no clock times, so every flight
+// record becomes a daily timetable: ceil(frequency / 30) departures a day spread
+// evenly from 06:00 to 22:00. Outgoing records of an airport are stored together
+// (offsets_ into edges_), and the departures of each record are sorted, so the
+// first departure a passenger can still catch is found by binary search.
 class flight_graph {
 public:
+    struct edge {
+        int from;
+        int to;
+        int flight;              // index into flights_
+        size_t first_departure;  // departures_[first_departure, last_departure), seconds after midnight
+        size_t last_departure;
+    };
+
     void add_flight(const flight& fl) {
-        flights_map[fl.get_origin()].push_back(fl);
-    }
-    const std::vector<flight>& get_flights_from(const std::string& airport) const {
-        static const std::vector<flight> empty;
-        auto it = flights_map.find(airport);
-        return (it != flights_map.end()) ? it->second : empty;
+        flights_.push_back(fl);
     }
+
+    // Builds airport IDs and the timetable; call once after the last add_flight
     void sort_flights() {
-        for (auto& pair : flights_map) {
-            std::sort(pair.second.begin(), pair.second.end(),
-                [](const flight& a, const flight& b) {
-                    return a.get_duration() < b.get_duration();
-                });
-        }
-    }
-    // Simple BFS reachability check
-    bool is_reachable(const std::string& start, const std::string& destination) const {
-        std::queue<std::string> q;
-        std::unordered_map<std::string, bool> visited;
-        q.push(start);
-        visited[start] = true;
-        while (!q.empty()) {
-            std::string cur = q.front();
-            q.pop();
-            if (cur == destination)
-                return true;
-            for (const auto& fl : get_flights_from(cur)) {
-                std::string next = fl.get_destination();
-                if (!visited[next]) {
-                    visited[next] = true;
-                    q.push(next);
-                }
-            }
+        airport_ids_.clear();
+        airport_names_.clear();
+        std::vector<int> origin(flights_.size()), dest(flights_.size());
+        for (size_t i = 0; i < flights_.size(); i++) {
+            origin[i] = intern(flights_[i].get_origin());
+            dest[i] = intern(flights_[i].get_destination());
         }
-        return false;
+
+        offsets_.assign(airport_names_.size() + 1, 0);
+        for (int o : origin)
+            offsets_[o + 1]++;
+        for (size_t a = 0; a < airport_names_.size(); a++)
+            offsets_[a + 1] += offsets_[a];
+
+        edges_.resize(flights_.size());
+        departures_.clear();
+        std::vector<size_t> fill(offsets_.begin(), offsets_.end() - 1);
+        for (size_t i = 0; i < flights_.size(); i++) {
+            edge& e = edges_[fill[origin[i]]++];
+            e.from = origin[i];
+            e.to = dest[i];
+            e.flight = static_cast<int>(i);
+            e.first_departure = departures_.size();
+            int per_day = std::min(max_daily_departures, std::max(1, (flights_[i].get_frequency() + 29) / 30));
+            int spacing = (last_departure_hour - first_departure_hour) * 3600 / per_day;
+            int offset = first_departure_hour * 3600 + static_cast<int>(i * 7919 % 60) * 60;
+            for (int k = 0; k < per_day; k++)
+                departures_.push_back(offset + k * spacing);
+            e.last_departure = departures_.size();
+        }
+    }
+
+    int airport_id(const std::string& code) const {
+        auto it = airport_ids_.find(code);
+        return it == airport_ids_.end() ? -1 : it->second;
+    }
+    size_t airport_count() const { return airport_names_.size(); }
+    const flight& get_flight(int index) const { return flights_[index]; }
+    const std::vector<edge>& get_edges() const { return edges_; }
+
+    const edge* edges_begin(int airport) const { return edges_.data() + offsets_[airport]; }
+    const edge* edges_end(int airport) const { return edges_.data() + offsets_[airport + 1]; }
+
+    // First departure of the flight record at or after `ready` (seconds from midnight of day 0)
+    long long next_departure(const edge& e, long long ready) const {
+        long long day = ready >= 0 ? ready / seconds_per_day : -((-ready + seconds_per_day - 1) / seconds_per_day);
+        int time_of_day = static_cast<int>(ready - day * seconds_per_day);
+        auto first = departures_.begin() + e.first_departure;
+        auto last = departures_.begin() + e.last_departure;
+        auto it = std::lower_bound(first, last, time_of_day);
+        if (it == last) {
+            day++;
+            it = first;
+        }
+        return day * seconds_per_day + *it;
     }
+
+    int departure_at(size_t index) const { return departures_[index]; }
+
+    static constexpr long long seconds_per_day = 24 * 3600;
+
 private:
-    std::map<std::string, std::vector<flight>> flights_map;
+    static constexpr int max_daily_departures = 24;
+    static constexpr int first_departure_hour = 6;
+    static constexpr int last_departure_hour = 22;
+
+    int intern(const std::string& code) {
+        auto it = airport_ids_.find(code);
+        if (it != airport_ids_.end())
+            return it->second;
+        int id = static_cast<int>(airport_names_.size());
+        airport_ids_.emplace(code, id);
+        airport_names_.push_back(code);
+        return id;
+    }
+
+    std::vector<flight> flights_;
+    std::unordered_map<std::string, int> airport_ids_;
+    std::vector<std::string> airport_names_;
+    std::vector<size_t> offsets_;  // edges of airport a: edges_[offsets_[a], offsets_[a + 1])
+    std::vector<edge> edges_;
+    std::vector<int> departures_;
 };
 
 // =====================================================
-// class shortest_path_finder – finds the fastest route using A* (with zero heuristic) and caching
+// class shortest_path_finder – earliest arrival and day profiles over the timetable
 // =====================================================
 class shortest_path_finder {
 public:
     shortest_path_finder(const flight_graph& graph) : flight_graph_(graph) {}
 
-    std::vector<flight> find_shortest_path(const std::string& start,
+    static cache_metrics get_cache_metrics() { return route_cache_.metrics(); }
+
+    // Earliest arrival for a departure at or after user_departure_time.
+    // Dijkstra over airports: the label is the arrival time, and each flight record
+    // is relaxed with its first departure after arrival + min_connection_time
+    // (no connection time at the start airport).
+    journey find_shortest_path(const std::string& start,
         const std::string& destination,
         time_t user_departure_time) {
-        std::string key = start + "_" + destination + "_" + std::to_string(user_departure_time);
-        std::vector<flight> cached_route;
-        if (route_cache_.get(key, cached_route))
+        route_key key{ start, destination, user_departure_time / departure_bucket_seconds };
+        journey cached_route;
+        // An entry computed for an earlier time in the same bucket is still the best
+        // answer if its first flight has not left yet. One computed for a later time
+        // may have skipped a flight that is still available now. "No route" does not
+        // depend on the time, the timetable repeats every day.
+        auto still_best = [user_departure_time](const journey& route) {
+            return route.empty() || (route.query_time <= user_departure_time && user_departure_time <= route.departure);
+        };
+        if (route_cache_.get(key, cached_route, still_best))
             return cached_route;
 
-        if (!flight_graph_.is_reachable(start, destination)) {
-            std::cerr << "Destination not reachable from start." << std::endl;
+        int from = flight_graph_.airport_id(start);
+        int to = flight_graph_.airport_id(destination);
+        if (from < 0 || to < 0) {
+            std::cerr << "Unknown airport code." << std::endl;
             return {};
         }
-        std::unordered_map<std::string, time_t> best_time;
-        std::unordered_map<std::string, flight> prev_flight;
-        using node = std::pair<time_t, std::string>;
-        auto cmp = [](const node& a, const node& b) { return a.first > b.first; };
-        std::priority_queue<node, std::vector<node>, decltype(cmp)> pq(cmp);
 
-        best_time[start] = user_departure_time;
-        pq.push({ user_departure_time, start });
+        time_t midnight = local_midnight(user_departure_time);
+        const long long unreached = LLONG_MAX;
+        std::vector<long long> best_time(flight_graph_.airport_count(), unreached);
+        std::vector<const flight_graph::edge*> prev_edge(flight_graph_.airport_count(), nullptr);
+        std::vector<long long> prev_departure(flight_graph_.airport_count(), 0);
+        using node = std::pair<long long, int>;
+        std::priority_queue<node, std::vector<node>, std::greater<node>> pq;
+
+        best_time[from] = user_departure_time - midnight;
+        pq.push({ best_time[from], from });
 
         while (!pq.empty()) {
             node top = pq.top();
             pq.pop();
-            time_t current_time = top.first;
-            std::string airport = top.second;
-            if (airport == destination)
+            long long current_time = top.first;
+            int airport = top.second;
+            if (airport == to)
                 break;
             if (current_time > best_time[airport])
                 continue;
-            const auto& fls = flight_graph_.get_flights_from(airport);
-            for (const auto& fl : fls) {
-                time_t depart_time = (airport == start) ? current_time : current_time + min_connection_time;
-                // A* heuristic: using zero (can be replaced with a proper heuristic)
-                time_t heuristic = 0;
-                time_t estimated_arrival = depart_time + fl.get_duration() + heuristic;
-                if (best_time.find(fl.get_destination()) == best_time.end() ||
-                    estimated_arrival < best_time[fl.get_destination()]) {
-                    best_time[fl.get_destination()] = estimated_arrival;
-                    prev_flight[fl.get_destination()] = fl;
-                    pq.push({ estimated_arrival, fl.get_destination() });
+            long long ready = (airport == from) ? current_time : current_time + min_connection_time;
+            for (const auto* e = flight_graph_.edges_begin(airport); e != flight_graph_.edges_end(airport); ++e) {
+                long long depart_time = flight_graph_.next_departure(*e, ready);
+                long long arrival = depart_time + flight_graph_.get_flight(e->flight).get_duration();
+                if (arrival < best_time[e->to]) {
+                    best_time[e->to] = arrival;
+                    prev_edge[e->to] = e;
+                    prev_departure[e->to] = depart_time;
+                    pq.push({ arrival, e->to });
                 }
             }
         }
-        if (best_time.find(destination) == best_time.end())
+        if (from == to || best_time[to] == unreached) {
+            route_cache_.put(key, journey{});
             return {};
-        std::vector<flight> path;
-        std::string curr = destination;
-        while (curr != start) {
-            if (prev_flight.find(curr) == prev_flight.end())
-                break;
-            flight fl = prev_flight[curr];
-            path.push_back(fl);
-            curr = fl.get_origin();
         }
-        std::reverse(path.begin(), path.end());
+
+        journey path;
+        for (int curr = to; curr != from; curr = prev_edge[curr]->from) {
+            const flight& fl = flight_graph_.get_flight(prev_edge[curr]->flight);
+            time_t departure = midnight + static_cast<time_t>(prev_departure[curr]);
+            path.legs.push_back({ fl, departure, departure + fl.get_duration() });
+        }
+        std::reverse(path.legs.begin(), path.legs.end());
+        path.departure = path.legs.front().departure;
+        path.arrival = path.legs.back().arrival;
+        path.query_time = user_departure_time;
         route_cache_.put(key, path);
         return path;
     }
 
+    // All non-dominated options for leaving on the day of `day`: for every departure
+    // time, the earliest arrival, keeping only options that arrive earlier than any
+    // later departure. One connection scan: flights of this day and the next are
+    // visited from the latest departure to the earliest, and each airport keeps its
+    // own list of (departure, earliest arrival) pairs.
+    std::vector<journey> find_day_profile(const std::string& start,
+        const std::string& destination,
+        time_t day) const {
+        int from = flight_graph_.airport_id(start);
+        int to = flight_graph_.airport_id(destination);
+        if (from < 0 || to < 0 || from == to)
+            return {};
+        time_t midnight = local_midnight(day);
+
+        struct connection {
+            long long departure;
+            long long arrival;
+            const flight_graph::edge* e;
+        };
+        std::vector<connection> connections;
+        for (const auto& e : flight_graph_.get_edges()) {
+            if (e.from == to)
+                continue;  // leaving the destination never helps
+            time_t duration = flight_graph_.get_flight(e.flight).get_duration();
+            for (long long d = 0; d < 2; d++) {
+                for (size_t k = e.first_departure; k < e.last_departure; k++) {
+                    long long departure = d * flight_graph::seconds_per_day + flight_graph_.departure_at(k);
+                    connections.push_back({ departure, departure + duration, &e });
+                }
+            }
+        }
+        std::sort(connections.begin(), connections.end(),
+            [](const connection& a, const connection& b) { return a.departure > b.departure; });
+
+        // profile[a]: departures decreasing, arrivals strictly decreasing
+        struct profile_entry {
+            long long departure;
+            long long arrival;
+            size_t connection;
+        };
+        std::vector<std::vector<profile_entry>> profile(flight_graph_.airport_count());
+        auto earliest = [&](int airport, long long ready) -> const profile_entry* {
+            const auto& p = profile[airport];
+            auto it = std::partition_point(p.begin(), p.end(),
+                [ready](const profile_entry& pe) { return pe.departure >= ready; });
+            return it == p.begin() ? nullptr : &*(it - 1);
+        };
+
+        for (size_t i = 0; i < connections.size(); i++) {
+            const connection& c = connections[i];
+            long long arrival = LLONG_MAX;
+            if (c.e->to == to) {
+                arrival = c.arrival;
+            }
+            else if (const profile_entry* next = earliest(c.e->to, c.arrival + min_connection_time)) {
+                arrival = next->arrival;
+            }
+            if (arrival == LLONG_MAX)
+                continue;
+            auto& p = profile[c.e->from];
+            if (!p.empty() && p.back().arrival <= arrival)
+                continue;
+            if (!p.empty() && p.back().departure == c.departure)
+                p.back() = { c.departure, arrival, i };
+            else
+                p.push_back({ c.departure, arrival, i });
+        }
+
+        std::vector<journey> options;
+        for (auto it = profile[from].rbegin(); it != profile[from].rend(); ++it) {
+            if (it->departure >= flight_graph::seconds_per_day)
+                break;
+            journey option;
+            for (size_t ci = it->connection;; ) {
+                const connection& c = connections[ci];
+                const flight& fl = flight_graph_.get_flight(c.e->flight);
+                option.legs.push_back({ fl, midnight + static_cast<time_t>(c.departure), midnight + static_cast<time_t>(c.arrival) });
+                if (c.e->to == to)
+                    break;
+                ci = earliest(c.e->to, c.arrival + min_connection_time)->connection;
+            }
+            option.departure = option.legs.front().departure;
+            option.arrival = option.legs.back().arrival;
+            options.push_back(std::move(option));
+        }
+        return options;
+    }
+
 private:
     const flight_graph& flight_graph_;
-    static dynamic_lru_cache<std::string, std::vector<flight>> route_cache_;
+    static sharded_cache<route_key, journey, route_key_hash> route_cache_;
 };
 
 // Initialize static member
-template <>
-dynamic_lru_cache<std::string, std::vector<flight>> shortest_path_finder::route_cache_{ 100 };
+sharded_cache<route_key, journey, route_key_hash> shortest_path_finder::route_cache_{ route_cache_bytes, route_bytes };
 
 // =====================================================
 // Function get_user_input – obtains input from the user (in English)
@@ -455,7 +1014,7 @@ bool get_user_input(std::string& start_airport, std::string& destination_airport
 // =====================================================
 // Function print_shortest_path – prints the route and additional statistics
 // =====================================================
-void print_shortest_path(const std::vector<flight>& path, time_t user_departure_time) {
+void print_shortest_path(const journey& path, time_t user_departure_time) {
     if (path.empty()) {
         std::cout << "No route found." << std::endl;
         return;
@@ -463,19 +1022,14 @@ void print_shortest_path(const std::vector<flight>& path, time_t user_departure_
     std::cout << "Route found:" << std::endl;
     double total_distance = 0.0;
     time_t total_flight_duration = 0;
-    for (const auto& fl : path) {
-        fl.print();
-        total_distance += fl.get_distance();
-        total_flight_duration += fl.get_duration();
-    }
-    // Calculate total travel time (flight durations + connection delays)
-    time_t current_time = user_departure_time;
-    for (size_t i = 0; i < path.size(); i++) {
-        if (i > 0)
-            current_time += min_connection_time;
-        current_time += path[i].get_duration();
-    }
-    time_t total_travel_time = current_time - user_departure_time;
+    for (const auto& leg : path.legs) {
+        std::cout << format_time(leg.departure) << " - " << format_time(leg.arrival) << "  ";
+        leg.fl.print();
+        total_distance += leg.fl.get_distance();
+        total_flight_duration += leg.fl.get_duration();
+    }
+    // Total travel time includes waiting for the first flight and for connections
+    time_t total_travel_time = path.arrival - user_departure_time;
     int hours = static_cast<int>(total_travel_time / 3600);
     int minutes = static_cast<int>((total_travel_time % 3600) / 60);
     double avg_speed = (total_flight_duration > 0) ? (total_distance / (total_flight_duration / 3600.0)) : 0.0;
@@ -486,10 +1040,223 @@ void print_shortest_path(const std::vector<flight>& path, time_t user_departure_
     std::cout << "Total travel time: " << hours << " hours " << minutes << " minutes." << std::endl;
 }
 
+// =====================================================
+// Function print_day_profile – prints every non-dominated option of the day
+// =====================================================
+void print_day_profile(const std::vector<journey>& options) {
+    if (options.empty())
+        return;
+    std::cout << "Best options on this day:" << std::endl;
+    for (const auto& option : options) {
+        std::cout << "  depart " << format_time(option.departure) << ", arrive " << format_time(option.arrival)
+            << ", flights: " << option.legs.size() << std::endl;
+    }
+}
+
+// =====================================================
+// Function generate_schedule_file – writes a synthetic T-100 style CSV of the given size
+// =====================================================
+bool generate_schedule_file(const std::string& filename, size_t megabytes) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error creating file: " << filename << std::endl;
+        return false;
+    }
+    out << "DEPARTURES_SCHEDULED,DEPARTURES_PERFORMED,PAYLOAD,SEATS,PASSENGERS,FREIGHT,MAIL,DISTANCE,"
+        "RAMP_TO_RAMP,AIR_TIME,UNIQUE_CARRIER,AIRLINE_ID,UNIQUE_CARRIER_NAME,UNIQUE_CARRIER_ENTITY,REGION,"
+        "CARRIER,CARRIER_NAME,CARRIER_GROUP,CARRIER_GROUP_NEW,ORIGIN_AIRPORT_ID,ORIGIN_AIRPORT_SEQ_ID,"
+        "ORIGIN_CITY_MARKET_ID,ORIGIN,ORIGIN_CITY_NAME,ORIGIN_STATE_ABR,ORIGIN_STATE_FIPS,ORIGIN_STATE_NM,"
+        "ORIGIN_COUNTRY,ORIGIN_COUNTRY_NAME,ORIGIN_WAC,DEST_AIRPORT_ID,DEST_AIRPORT_SEQ_ID,DEST_CITY_MARKET_ID,"
+        "DEST,DEST_CITY_NAME,DEST_STATE_ABR,DEST_STATE_FIPS,DEST_STATE_NM,DEST_COUNTRY,DEST_COUNTRY_NAME,"
+        "DEST_WAC,AIRCRAFT_GROUP,AIRCRAFT_TYPE,AIRCRAFT_CONFIG,YEAR,QUARTER,MONTH,DISTANCE_GROUP,CLASS,DATA_SOURCE\n";
+
+    const char* sources[] = { "DU", "DF", "IU", "IF" };
+    unsigned seed = 12345;
+    auto next = [&seed](unsigned bound) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) % bound;
+    };
+    auto airport = [](unsigned id) {
+        std::string code = "AAA";
+        code[0] = static_cast<char>('A' + id / 676 % 26);
+        code[1] = static_cast<char>('A' + id / 26 % 26);
+        code[2] = static_cast<char>('A' + id % 26);
+        return code;
+    };
+
+    const size_t target = megabytes << 20;
+    std::string row;
+    for (size_t written = 0; written < target; written += row.size()) {
+        unsigned from = next(400), to = next(400);
+        unsigned departures = 1 + next(60), distance = 100 + next(2500);
+        std::ostringstream line;
+        line << departures << "," << departures << ",0,0,0,0,0," << distance << "," << distance / 8 + 20 << ","
+            << distance / 8 + 10 << ",XX,20000,Carrier,1,D,XX,Carrier,1,1,"
+            << 10000 + from << "," << 1000000 + from << "," << 30000 + from << "," << airport(from) << ",City,ST,1,State,US,United States,1,"
+            << 10000 + to << "," << 1000000 + to << "," << 30000 + to << "," << airport(to) << ",City,ST,1,State,US,United States,1,"
+            << "6,612,1,2024," << 1 + next(4) << "," << 1 + next(12) << "," << 1 + distance / 500 << ",F,"
+            << sources[next(4)] << "\n";
+        row = line.str();
+        out << row;
+    }
+    return static_cast<bool>(out);
+}
+
+// =====================================================
+// Function benchmark_reader – parse time for 1, 2, 4 ... max_threads workers
+// =====================================================
+int benchmark_reader(const std::string& filename, unsigned max_threads) {
+    std::ifstream probe(filename, std::ios::binary | std::ios::ate);
+    if (!probe) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return 1;
+    }
+    double megabytes = static_cast<double>(probe.tellg()) / (1 << 20);
+    std::cout << "File: " << filename << ", " << std::fixed << std::setprecision(1) << megabytes << " MB, "
+        << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::setw(8) << "Threads" << std::setw(12) << "Seconds" << std::setw(12) << "MB/s"
+        << std::setw(10) << "Speedup" << std::setw(12) << "Flights" << std::endl;
+
+    double single = 0.0;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<flight> flights = file_reader::read_flights_from_file(filename, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1)
+            single = seconds;
+        std::cout << std::setw(8) << threads << std::setw(12) << std::setprecision(3) << seconds
+            << std::setw(12) << std::setprecision(1) << megabytes / seconds
+            << std::setw(10) << std::setprecision(2) << single / seconds
+            << std::setw(12) << flights.size() << std::endl;
+    }
+    return 0;
+}
+
+// =====================================================
+// Function benchmark_routes – concurrent route queries with Zipf-distributed popularity
+// =====================================================
+int benchmark_routes(const std::string& filename, size_t query_count, unsigned threads) {
+    std::vector<flight> valid_flights = flight_filter::filter_flights(file_reader::read_flights_from_file(filename));
+    if (valid_flights.empty()) {
+        std::cerr << "No valid flights found after filtering." << std::endl;
+        return 1;
+    }
+    flight_graph fg;
+    std::vector<std::string> airports;
+    for (const auto& fl : valid_flights) {
+        fg.add_flight(fl);
+        airports.push_back(fl.get_origin());
+    }
+    fg.sort_flights();
+    std::sort(airports.begin(), airports.end());
+    airports.erase(std::unique(airports.begin(), airports.end()), airports.end());
+
+    // Query k asks for the route with popularity rank r with probability ~ 1 / (r + 1)
+    const size_t distinct_routes = 4096;
+    std::vector<double> cumulative(distinct_routes);
+    double total = 0.0;
+    for (size_t r = 0; r < distinct_routes; r++)
+        cumulative[r] = total += 1.0 / (r + 1);
+    std::vector<route_key> queries(query_count);
+    unsigned seed = 2024;
+    for (auto& q : queries) {
+        seed = seed * 1103515245u + 12345u;
+        double u = (seed >> 8) / 16777216.0 * total;
+        size_t rank = std::lower_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        size_t pair = rank * 2654435761u;
+        q.start = airports[pair % airports.size()];
+        q.destination = airports[pair / airports.size() % airports.size()];
+        q.departure_bucket = 1704103200 + static_cast<time_t>(rank % 96) * departure_bucket_seconds;
+    }
+
+    std::atomic<size_t> next_query(0);
+    auto worker = [&]() {
+        shortest_path_finder spf(fg);
+        for (size_t i = next_query.fetch_add(1); i < queries.size(); i = next_query.fetch_add(1))
+            spf.find_shortest_path(queries[i].start, queries[i].destination, queries[i].departure_bucket);
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++)
+        pool.emplace_back(worker);
+    for (auto& th : pool)
+        th.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    cache_metrics m = shortest_path_finder::get_cache_metrics();
+    std::cout << query_count << " queries on " << threads << " threads: " << std::fixed << std::setprecision(3)
+        << seconds << " s, " << std::setprecision(0) << query_count / seconds << " queries/s" << std::endl;
+    std::cout << "Cache: hits " << m.hits << ", misses " << m.misses << ", evictions " << m.evictions
+        << ", rejected " << m.rejections << ", entries " << m.entries << ", " << m.bytes << " bytes" << std::endl;
+    return 0;
+}
+
+// =====================================================
+// Function self_test_route_cache – cached answers must match fresh searches
+// =====================================================
+int self_test_route_cache() {
+    // One record with 24 departures a day: 06:00, 06:40, 07:20, ...
+    flight_graph fg;
+    fg.add_flight(flight("AAA", "BBB", 24 * 30, flight_category::unknown, 3600, 500.0));
+    fg.add_flight(flight("CCC", "AAA", 30, flight_category::unknown, 3600, 500.0));
+    fg.sort_flights();
+    shortest_path_finder spf(fg);
+    cache_metrics start = shortest_path_finder::get_cache_metrics();
+    int failures = 0;
+    auto check = [&failures](bool ok, const char* what) {
+        if (!ok) {
+            std::cerr << "FAILED: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // Both queries fall into the 06:30-06:45 bucket; the later one is asked first
+    time_t midnight = local_midnight(1704103200);
+    time_t later = midnight + 6 * 3600 + 44 * 60;
+    time_t earlier = midnight + 6 * 3600 + 35 * 60;
+    check(later / departure_bucket_seconds == earlier / departure_bucket_seconds, "queries share a bucket");
+    journey late = spf.find_shortest_path("AAA", "BBB", later);
+    journey early = spf.find_shortest_path("AAA", "BBB", earlier);
+    check(!late.empty() && late.departure == midnight + 7 * 3600 + 20 * 60, "later query takes the 07:20 flight");
+    check(!early.empty() && early.departure == midnight + 6 * 3600 + 40 * 60, "earlier query keeps the 06:40 flight");
+
+    // An entry computed earlier in the bucket is reused until its flight leaves
+    journey reused = spf.find_shortest_path("AAA", "BBB", earlier + 60);
+    check(reused.departure == early.departure, "entry reused before its departure");
+
+    // The entry of the later query was rejected: a miss, not a hit
+    cache_metrics m = shortest_path_finder::get_cache_metrics();
+    check(m.hits - start.hits == 1 && m.misses - start.misses == 2, "rejected entry counts as a miss");
+
+    // "No route" is cached as well
+    spf.find_shortest_path("BBB", "CCC", earlier);
+    spf.find_shortest_path("BBB", "CCC", earlier + 60);
+    spf.find_shortest_path("AAA", "AAA", earlier);
+    spf.find_shortest_path("AAA", "AAA", earlier);
+    m = shortest_path_finder::get_cache_metrics();
+    check(m.hits - start.hits == 3 && m.misses - start.misses == 4, "unreachable destination is cached");
+
+    std::cout << (failures ? "route cache self-test failed" : "route cache self-test passed") << std::endl;
+    return failures ? 1 : 0;
+}
+
 // =====================================================
 // Main function – a balanced overview of program steps
 // =====================================================
-int main() {
+// Lab2.3 --generate <file.csv> <MB>          writes a synthetic schedule file
+// Lab2.3 --benchmark <file.csv> [max_threads]  prints the reader scaling table
+// Lab2.3 --route-benchmark <file.csv> <queries> [threads]  route queries through the cache
+// Lab2.3 --self-test                          checks cached routes against fresh searches
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && std::string(argv[1]) == "--generate")
+        return generate_schedule_file(argv[2], std::stoul(argv[3])) ? 0 : 1;
+    if (argc >= 3 && std::string(argv[1]) == "--benchmark")
+        return benchmark_reader(argv[2], argc >= 4 ? std::stoul(argv[3]) : 32);
+    if (argc >= 4 && std::string(argv[1]) == "--route-benchmark")
+        return benchmark_routes(argv[2], std::stoul(argv[3]), argc >= 5 ? std::stoul(argv[4]) : 4);
+    if (argc >= 2 && std::string(argv[1]) == "--self-test")
+        return self_test_route_cache();
+
     std::string departure_airport, destination_airport;
     time_t departure_time;
 
@@ -513,18 +1280,22 @@ int main() {
         return 1;
     }
 
-    // Step 4: Build flight graph and sort flights
+    // Step 4: Build flight graph and its timetable
     flight_graph fg;
     for (const auto& fl : valid_flights)
         fg.add_flight(fl);
     fg.sort_flights();
 
-    // Step 5: Find fastest route using A* (with zero heuristic) and caching
+    // Step 5: Find earliest arrival over the timetable (with caching) and all options of the day
     shortest_path_finder spf(fg);
-    std::vector<flight> best_path = spf.find_shortest_path(departure_airport, destination_airport, departure_time);
+    journey best_path = spf.find_shortest_path(departure_airport, destination_airport, departure_time);
+    std::vector<journey> day_options = spf.find_day_profile(departure_airport, destination_airport, departure_time);
 
     // Step 6: Print result and additional statistics
+    if (best_path.empty() && fg.airport_id(departure_airport) >= 0 && fg.airport_id(destination_airport) >= 0)
+        std::cerr << "Destination not reachable from start." << std::endl;
     print_shortest_path(best_path, departure_time);
+    print_day_profile(day_options);
 
     return 0;
 }
\ No newline at end of file
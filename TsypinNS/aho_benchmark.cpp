@@ -0,0 +1,268 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+#include "aho_dfa.h"
+
+using namespace std;
+
+// Сравнение прежнего AhoCorasick (map<char, int> в каждой вершине) с FlatAhoCorasick
+// на поиске сигнатур в журнале. Скорость - в ГБ/с прочитанного текста.
+// Запуск: aho_benchmark [число сигнатур] [размер журнала, МБ]
+
+namespace old {
+
+class AhoCorasick {
+private:
+    struct Node {
+        map<char, int> next;
+        int link = -1;
+        int parent;
+        char parent_char;
+        bool is_terminal = false;
+        vector<int> pattern_indices;
+    };
+
+    vector<Node> trie;
+    vector<string> patterns;
+
+public:
+    AhoCorasick();
+    void add_pattern(const string& pattern);
+    void build_links();
+    template <typename Callback>
+    void search(const string& text, size_t size, Callback on_match);
+};
+
+AhoCorasick::AhoCorasick() {
+    trie.emplace_back();
+    trie[0].link = 0;
+    trie[0].parent = -1;
+}
+
+void AhoCorasick::add_pattern(const string& pattern) {
+    int node = 0;
+    size_t i = 0;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        if (trie[node].next.count(c) == 0) {
+            trie[node].next[c] = trie.size();
+            trie.emplace_back();
+            trie.back().parent = node;
+            trie.back().parent_char = c;
+        }
+        node = trie[node].next[c];
+        i++;
+    }
+    trie[node].is_terminal = true;
+    trie[node].pattern_indices.push_back(patterns.size());
+    patterns.push_back(pattern);
+}
+
+void AhoCorasick::build_links() {
+    queue<int> q;
+    q.push(0);
+
+    while (!q.empty()) {
+        int node = q.front();
+        q.pop();
+
+        map<char, int>::iterator it = trie[node].next.begin();
+        while (it != trie[node].next.end()) {
+            q.push(it->second);
+            it++;
+        }
+
+        if (node == 0 || trie[node].parent == 0) {
+            trie[node].link = 0;
+        } else {
+            int parent_link = trie[trie[node].parent].link;
+            char c = trie[node].parent_char;
+
+            while (parent_link != 0 && trie[parent_link].next.count(c) == 0) {
+                parent_link = trie[parent_link].link;
+            }
+
+            if (trie[parent_link].next.count(c)) {
+                trie[node].link = trie[parent_link].next[c];
+            } else {
+                trie[node].link = 0;
+            }
+        }
+    }
+}
+
+// Тот же обход, что в прежнем search, но совпадения отдаются в callback,
+// а не копятся в векторе: так сравнивается только сам автомат
+template <typename Callback>
+void AhoCorasick::search(const string& text, size_t size, Callback on_match) {
+    int node = 0;
+    size_t pos = 0;
+
+    while (pos < size) {
+        char c = text[pos];
+
+        while (node != 0 && trie[node].next.count(c) == 0) {
+            node = trie[node].link;
+        }
+
+        if (trie[node].next.count(c)) {
+            node = trie[node].next[c];
+        }
+
+        int current = node;
+        while (current != 0) {
+            if (trie[current].is_terminal) {
+                size_t j = 0;
+                while (j < trie[current].pattern_indices.size()) {
+                    int pattern_idx = trie[current].pattern_indices[j];
+                    on_match(pattern_idx, pos - patterns[pattern_idx].size() + 1);
+                    j++;
+                }
+            }
+            current = trie[current].link;
+        }
+        pos++;
+    }
+}
+
+} // namespace old
+
+
+template <typename Function>
+double seconds(Function function) {
+    auto start = chrono::high_resolution_clock::now();
+    function();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+// Сигнатуры - фрагменты вида "код.компонент=значение", журнал - строки
+// из тех же слов с редкими вставками сигнатур
+struct Corpus {
+    vector<string> signatures;
+    string log;
+
+    Corpus(size_t count, size_t bytes) {
+        mt19937_64 gen(2024);
+        const string letters = "abcdefghijklmnopqrstuvwxyz";
+        const string digits = "0123456789";
+        const vector<string> words = {
+            "INFO", "WARN", "ERROR", "DEBUG", "user", "session", "request", "timeout",
+            "db", "cache", "auth", "GET", "POST", "/api/v1/", "status=", "latency=", "ms", "id="
+        };
+        auto random_word = [&](size_t length) {
+            string w;
+            for (size_t i = 0; i < length; i++) {
+                w += (gen() % 4 == 0) ? digits[gen() % digits.size()] : letters[gen() % letters.size()];
+            }
+            return w;
+        };
+
+        signatures.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            signatures.push_back(words[gen() % words.size()] + random_word(4 + gen() % 12));
+        }
+
+        log.reserve(bytes + 256);
+        while (log.size() < bytes) {
+            log += "2024-05-17 12:";
+            log += digits[gen() % 6];
+            log += digits[gen() % 10];
+            log += ' ';
+            for (int k = 0; k < 6; k++) {
+                log += words[gen() % words.size()];
+                log += (gen() % 8 == 0) ? signatures[gen() % signatures.size()] : random_word(3 + gen() % 6);
+                log += ' ';
+            }
+            log += '\n';
+        }
+        log.resize(bytes);
+    }
+};
+
+struct Summary {
+    size_t matches = 0;
+    uint64_t checksum = 0;
+
+    void add(int pattern, uint64_t position) {
+        matches++;
+        checksum += (uint64_t)(pattern + 1) * 1000003 ^ position;
+    }
+    bool operator==(const Summary& other) const {
+        return matches == other.matches && checksum == other.checksum;
+    }
+};
+
+void print_row(const char* name, double time, size_t bytes, const Summary& summary) {
+    printf("%-32s %10.3f %10.3f %12zu\n", name, time, bytes / time / 1e9, summary.matches);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    size_t megabytes = argc > 2 ? strtoul(argv[2], nullptr, 10) : 256;
+    const size_t old_bytes = min<size_t>(megabytes, 16) << 20;
+
+    Corpus corpus(count, megabytes << 20);
+    printf("Signatures %zu, log %zu MB\n", count, megabytes);
+
+    old::AhoCorasick old_ac;
+    double old_build = seconds([&] {
+        for (const string& s : corpus.signatures) old_ac.add_pattern(s);
+        old_ac.build_links();
+    });
+
+    unique_ptr<FlatAhoCorasick> flat;
+    double flat_build = seconds([&] { flat.reset(new FlatAhoCorasick(corpus.signatures)); });
+    printf("Build: map %.3f s, flat %.3f s\n", old_build, flat_build);
+    printf("Flat automaton: %zu states, %zu dense, %zu alphabet classes, %.1f MB\n",
+        flat->state_count(), flat->dense_state_count(), flat->alphabet_size(),
+        flat->memory_bytes() / 1048576.0);
+
+    printf("%-32s %10s %10s %12s\n", "Search", "Time, s", "GB/s", "Matches");
+
+    // Прежняя версия медленная, поэтому сравнение совпадений идёт на префиксе журнала
+    Summary old_summary, prefix_summary;
+    double t = seconds([&] {
+        old_ac.search(corpus.log, old_bytes, [&](int p, size_t pos) { old_summary.add(p, pos); });
+    });
+    print_row("map<char,int>, prefix", t, old_bytes, old_summary);
+
+    t = seconds([&] {
+        FlatAhoCorasick::Stream stream;
+        flat->search(stream, corpus.log.data(), old_bytes, [&](int p, uint64_t pos) { prefix_summary.add(p, pos); });
+    });
+    print_row("flat, prefix", t, old_bytes, prefix_summary);
+
+    Summary whole, chunked;
+    t = seconds([&] {
+        FlatAhoCorasick::Stream stream;
+        flat->search(stream, corpus.log.data(), corpus.log.size(), [&](int p, uint64_t pos) { whole.add(p, pos); });
+    });
+    print_row("flat, whole log", t, corpus.log.size(), whole);
+
+    // Блоки по 64 КБ, как при чтении из сокета или файла: совпадения на стыках
+    // должны найтись так же, как при поиске по всему журналу
+    const size_t chunk = 64 << 10;
+    t = seconds([&] {
+        FlatAhoCorasick::Stream stream;
+        for (size_t offset = 0; offset < corpus.log.size(); offset += chunk) {
+            size_t size = min(chunk, corpus.log.size() - offset);
+            flat->search(stream, corpus.log.data() + offset, size, [&](int p, uint64_t pos) { chunked.add(p, pos); });
+        }
+    });
+    print_row("flat, 64 KB chunks", t, corpus.log.size(), chunked);
+
+    if (!(old_summary == prefix_summary) || !(whole == chunked)) {
+        printf("Ошибка: результаты поиска не совпадают\n");
+        return 1;
+    }
+    return 0;
+}
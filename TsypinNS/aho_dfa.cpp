@@ -0,0 +1,207 @@
+#include "aho_dfa.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+FlatAhoCorasick::FlatAhoCorasick(const vector<string>& patterns, size_t dense_budget) {
+    if (patterns.empty()) {
+        throw AhoCorasickException("Нужен хотя бы один шаблон");
+    }
+
+    // Классы байтов: 0 - байт не встречается ни в одном шаблоне
+    memset(classes, 0, sizeof(classes));
+    alphabet = 1;
+    for (const string& p : patterns) {
+        if (p.empty()) {
+            throw AhoCorasickException("Пустой шаблон");
+        }
+        for (unsigned char ch : p) {
+            if (classes[ch] == 0) classes[ch] = (uint8_t)alphabet++;
+        }
+    }
+
+    // Бор строится по отсортированным шаблонам: нужный ребёнок вершины
+    // всегда последний добавленный, поэтому хватает списков first/next
+    vector<int32_t> order(patterns.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int32_t)i;
+    sort(order.begin(), order.end(), [&](int32_t a, int32_t b) { return patterns[a] < patterns[b]; });
+
+    vector<int32_t> first_child(1, -1), last_child(1, -1), next_sibling(1, -1);
+    vector<uint8_t> code(1, 0);
+    vector<int32_t> trie_pattern(1, -1);
+    next_pattern.assign(patterns.size(), -1);
+    pattern_length.resize(patterns.size());
+
+    for (int32_t id : order) {
+        const string& p = patterns[id];
+        int32_t node = 0;
+        for (unsigned char ch : p) {
+            uint8_t c = classes[ch];
+            int32_t child = last_child[node];
+            if (child < 0 || code[child] != c) {
+                int32_t created = (int32_t)code.size();
+                first_child.push_back(-1);
+                last_child.push_back(-1);
+                next_sibling.push_back(-1);
+                code.push_back(c);
+                trie_pattern.push_back(-1);
+                if (child < 0) first_child[node] = created;
+                else next_sibling[child] = created;
+                last_child[node] = created;
+                child = created;
+            }
+            node = child;
+        }
+        next_pattern[id] = trie_pattern[node];
+        trie_pattern[node] = id;
+        pattern_length[id] = (uint32_t)p.size();
+    }
+    states = code.size();
+
+    // Обход в ширину: порядок размещения в двойном массиве и выбор горячих вершин
+    vector<int32_t> bfs;
+    bfs.reserve(states);
+    bfs.push_back(0);
+    for (size_t head = 0; head < bfs.size(); head++) {
+        for (int32_t c = first_child[bfs[head]]; c >= 0; c = next_sibling[c]) bfs.push_back(c);
+    }
+
+    // Размещение: для каждой вершины ищется base, при котором все клетки
+    // base + код ребёнка свободны. Свободные клетки связаны в двусвязный
+    // список (голова - клетка корня 0), перебираются только они. Клетка, которая
+    // много раз не подошла, исключается из списка и остаётся дырой: иначе дыры
+    // в начале массива просматривались бы заново для каждой вершины.
+    // Массив растёт удвоением, лишний хвост отрезается после размещения.
+    vector<int32_t> position(states, -1);
+    vector<int32_t> free_next(1, 0), free_prev(1, 0);
+    vector<uint8_t> misses(1, 0);
+    const uint8_t skip_after = 16;
+    cells.assign(1, Cell{ 0, -2, 0, -1 });
+    position[0] = 0;
+    auto reserve = [&](size_t size) {
+        if (cells.size() >= size) return;
+        size_t old = cells.size(), grown = max(size, 2 * old);
+        cells.resize(grown, Cell{ 0, -1, 0, -1 });
+        free_next.resize(grown);
+        free_prev.resize(grown);
+        misses.resize(grown, 0);
+        int32_t tail = free_prev[0];
+        for (size_t i = old; i < grown; i++) {
+            free_next[tail] = (int32_t)i;
+            free_prev[i] = tail;
+            tail = (int32_t)i;
+        }
+        free_next[tail] = 0;
+        free_prev[0] = tail;
+    };
+    auto take = [&](int32_t i) {
+        free_next[free_prev[i]] = free_next[i];
+        free_prev[free_next[i]] = free_prev[i];
+    };
+    reserve(2 * (states + alphabet));
+
+    size_t used_end = alphabet;  // за последней клеткой, до которой может дотянуться base + c
+    uint8_t child_codes[256];
+    for (int32_t node : bfs) {
+        int32_t s = position[node];
+        int count = 0;
+        for (int32_t c = first_child[node]; c >= 0; c = next_sibling[c]) child_codes[count++] = code[c];
+        if (count == 0) continue;  // лист: base = 0, переходов нет
+
+        int32_t base;
+        int32_t cell = free_next[0];
+        for (;;) {
+            if (cell == 0) {
+                size_t old = cells.size();
+                reserve(old + alphabet);
+                cell = (int32_t)old;
+            }
+            if (cell > child_codes[0]) {
+                base = cell - child_codes[0];
+                reserve((size_t)base + alphabet);
+                bool fits = true;
+                for (int i = 1; i < count && fits; i++) fits = cells[base + child_codes[i]].check == -1;
+                if (fits) break;
+            }
+            int32_t next = free_next[cell];
+            if (++misses[cell] == skip_after) take(cell);
+            cell = next;
+        }
+
+        cells[s].base = base;
+        used_end = max(used_end, (size_t)base + alphabet);
+        for (int32_t c = first_child[node]; c >= 0; c = next_sibling[c]) {
+            position[c] = base + code[c];
+            cells[position[c]].check = s;
+            if (misses[position[c]] < skip_after) take(position[c]);  // исключённая дыра уже не в списке
+        }
+    }
+    cells.resize(used_end);
+    if ((size_t)INT32_MAX < cells.size()) {
+        throw AhoCorasickException("Слишком большой автомат");
+    }
+
+    // Выходы вершин
+    first_pattern.assign(cells.size(), -1);
+    next_report.assign(cells.size(), -1);
+    for (size_t v = 0; v < states; v++) first_pattern[position[v]] = trie_pattern[v];
+
+    // Суффиксные ссылки и ссылки на выход, в порядке обхода в ширину
+    auto go = [&](int32_t s, uint32_t c) {
+        int32_t t = cells[s].base + (int32_t)c;
+        return (c != 0 && cells[t].check == s) ? t : -1;
+    };
+    for (int32_t node : bfs) {
+        int32_t s = position[node];
+        if (node != 0) {
+            int32_t f = cells[s].fail;
+            next_report[s] = cells[f].report;
+            cells[s].report = first_pattern[s] >= 0 ? s : next_report[s];
+        }
+        for (int32_t child = first_child[node]; child >= 0; child = next_sibling[child]) {
+            int32_t t = position[child];
+            int32_t f = cells[s].fail;
+            int32_t target = -1;
+            if (node != 0) {
+                for (;;) {
+                    target = go(f, code[child]);
+                    if (target >= 0 || f == 0) break;
+                    f = cells[f].fail;
+                }
+            }
+            cells[t].fail = target >= 0 ? target : 0;
+        }
+    }
+
+    // Горячие вершины: первые по обходу в ширину, пока строки помещаются в бюджет.
+    // Суффиксная ссылка ведёт в менее глубокую вершину, поэтому её строка уже готова.
+    dense_states = min(states, max<size_t>(1, dense_budget / (sizeof(int32_t) * alphabet)));
+    dense.assign(dense_states * alphabet, 0);
+    for (size_t row = 0; row < dense_states; row++) {
+        int32_t s = position[bfs[row]];
+        int32_t* line = &dense[row * alphabet];
+        const int32_t* fail_line = row == 0 ? nullptr : &dense[(size_t)~cells[cells[s].fail].base * alphabet];
+        for (uint32_t c = 0; c < alphabet; c++) {
+            int32_t t = go(s, c);
+            line[c] = t >= 0 ? t : (row == 0 ? 0 : fail_line[c]);
+        }
+        cells[s].base = ~(int32_t)row;
+    }
+}
+
+vector<pair<int, size_t>> FlatAhoCorasick::search(const string& text) const {
+    vector<pair<int, size_t>> matches;
+    Stream stream;
+    search(stream, text.data(), text.size(), [&](int pattern, uint64_t position) {
+        matches.emplace_back(pattern, (size_t)position);
+    });
+    return matches;
+}
+
+size_t FlatAhoCorasick::memory_bytes() const {
+    return cells.size() * sizeof(Cell) + dense.size() * sizeof(int32_t)
+        + (next_report.size() + first_pattern.size() + next_pattern.size()) * sizeof(int32_t)
+        + pattern_length.size() * sizeof(uint32_t);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Скомпилированный автомат Ахо-Корасик для поиска большого числа сигнатур.
+//
+// Вместо map<char, int> в каждой вершине переходы лежат в плоских массивах:
+//   - байты сворачиваются в классы: все байты, которых нет в шаблонах, дают класс 0;
+//   - "горячие" вершины (первые в порядке обхода в ширину, т.е. ближние к корню)
+//     получают полную строку переходов ДКА - шаг за одно обращение к таблице;
+//   - остальные вершины хранятся в двойном массиве (base/check): переход
+//     s -c-> t существует, если check[base[s] + c] == s; при его отсутствии
+//     идём по суффиксной ссылке, которая быстро приводит к горячей вершине.
+// Для каждой вершины заранее посчитана ссылка на ближайшую терминальную вершину
+// по цепочке суффиксных ссылок, так что вершины без выхода проверяются одним сравнением.
+
+class AhoCorasickException : public std::invalid_argument
+{
+public:
+    AhoCorasickException(const std::string message) : std::invalid_argument{ message } {};
+};
+
+class FlatAhoCorasick {
+public:
+    // Состояние потокового поиска: вершина автомата и число уже прочитанных байт.
+    // Совпадения, пересекающие границу блоков, находятся без повторного чтения.
+    struct Stream {
+        int32_t state = 0;
+        uint64_t offset = 0;
+    };
+
+    // dense_budget - сколько байт можно отдать под полные строки переходов
+    explicit FlatAhoCorasick(const std::vector<std::string>& patterns, size_t dense_budget = 16 << 20);
+
+    // on_match(номер шаблона, позиция первого байта совпадения от начала потока)
+    template <typename Callback>
+    void search(Stream& stream, const char* data, size_t size, Callback&& on_match) const;
+
+    // Поиск по целой строке, результат в формате прежнего AhoCorasick::search
+    std::vector<std::pair<int, size_t>> search(const std::string& text) const;
+
+    size_t pattern_count() const { return pattern_length.size(); }
+    size_t state_count() const { return states; }
+    size_t dense_state_count() const { return dense_states; }
+    size_t alphabet_size() const { return alphabet; }
+    size_t memory_bytes() const;
+
+private:
+    // Всё, что нужно на шаге поиска, лежит в одной 16-байтной ячейке
+    struct Cell {
+        int32_t base;    // < 0: горячая вершина, ~base - номер строки в dense
+        int32_t check;   // родитель ячейки, -1 - ячейка свободна
+        int32_t fail;    // суффиксная ссылка
+        int32_t report;  // ближайшая терминальная вершина (сама или по ссылкам), -1 - нет
+    };
+
+    uint8_t classes[256];
+    uint32_t alphabet;            // число классов, включая класс 0
+    std::vector<Cell> cells;
+    std::vector<int32_t> dense;   // dense_states x alphabet
+    std::vector<int32_t> next_report;   // следующая терминальная вершина по ссылкам
+    std::vector<int32_t> first_pattern; // первый шаблон, оканчивающийся в вершине
+    std::vector<int32_t> next_pattern;  // следующий шаблон с тем же концом (одинаковые строки)
+    std::vector<uint32_t> pattern_length;
+    size_t states = 0;
+    size_t dense_states = 0;
+
+    template <typename Callback>
+    void report_matches(int32_t node, uint64_t end, Callback& on_match) const {
+        for (; node >= 0; node = next_report[node]) {
+            for (int32_t p = first_pattern[node]; p >= 0; p = next_pattern[p]) {
+                on_match(p, end + 1 - pattern_length[p]);
+            }
+        }
+    }
+};
+
+
+template <typename Callback>
+void FlatAhoCorasick::search(Stream& stream, const char* data, size_t size, Callback&& on_match) const {
+    const Cell* cell = cells.data();
+    const int32_t* rows = dense.data();
+    const uint32_t width = alphabet;
+    int32_t s = stream.state;
+
+    for (size_t i = 0; i < size; i++) {
+        uint32_t c = classes[(unsigned char)data[i]];
+        for (;;) {
+            int32_t base = cell[s].base;
+            if (base < 0) {
+                s = rows[(size_t)~base * width + c];
+                break;
+            }
+            int32_t t = base + (int32_t)c;
+            if (cell[t].check == s) {
+                s = t;
+                break;
+            }
+            s = cell[s].fail;
+        }
+        if (cell[s].report >= 0) {
+            report_matches(cell[s].report, stream.offset + i, on_match);
+        }
+    }
+
+    stream.state = s;
+    stream.offset += size;
+}
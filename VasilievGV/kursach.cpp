@@ -4,6 +4,10 @@
 #include <cstdlib>
 #include <ctime>
 #include <algorithm> // для reverse
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
 
 #define COLOR_OF_NODE_GREY 1
 #define COLOR_OF_NODE_BLACK 2
@@ -14,7 +18,6 @@ class node
 {
 private:
     int value;
-    uiVector edges;
 public:
     int color;
 
@@ -35,42 +38,35 @@ public:
         this->value = val;
     }
 
-    unsigned int edge(unsigned int num)
-    {
-        return this->edges[num];
-    }
-
-    unsigned int edgeSize()
-    {
-        return this->edges.size();
-    }
-
     int getValueOfNode()
     {
         return this->value;
     }
-
-    void addEdge(unsigned int link)
-    {
-        edges.push_back(link);
-    }
-
-    ~node()
-    {
-        edges.clear();
-    }
 };
 
+// Рёбра хранятся в графе в формате CSR: рёбра вершины i лежат в
+// links[offsets[i] .. offsets[i + 1]), а не в отдельном векторе каждой вершины
 class graph
 {
 private:
     unsigned int amount;
     node * nodes;
-    bool dfs(unsigned int curNode, uiVector &stack);
+    uiVector offsets;
+    uiVector links;
+    bool dfs(unsigned int startNode, uiVector &stack);
 public:
     graph(unsigned int size);
     void print();
+    unsigned int edge(unsigned int curNode, unsigned int num)
+    {
+        return this->links[this->offsets[curNode] + num];
+    }
+    unsigned int edgeSize(unsigned int curNode)
+    {
+        return this->offsets[curNode + 1] - this->offsets[curNode];
+    }
     bool topological_sort(uiVector &result);
+    bool topological_levels(std::vector<uiVector> &levels, unsigned int threads);
     ~graph()
     {
         delete[] nodes;
@@ -88,33 +84,47 @@ graph::graph(unsigned int size)
     this->nodes = new node[size];
     this->amount = size;
 
-    unsigned int ranks[size][size + 1];
-    memset(ranks, 0, size * (size + 1) * sizeof(int));
-
+    // ranks[r] - вершины ранга r; рёбра идут только от меньшего ранга к большему
+    std::vector<uiVector> ranks(size);
     for (unsigned int i = 0; i < size; i++)
     {
         nodes[i].setValue(i);
-        unsigned int currentRank = random_Range(size);
-        ranks[currentRank][0] += 1;
-        ranks[currentRank][ranks[currentRank][0]] = i;
+        ranks[random_Range(size)].push_back(i);
     }
 
-    for (unsigned int rank = 0; rank < size - 1; rank++)
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    for (unsigned int rank = 0; rank + 1 < size; rank++)
     {
-        for (unsigned int curNode = 1; curNode < ranks[rank][0] + 1; curNode++)
+        for (unsigned int curNode : ranks[rank])
         {
             for (unsigned int rankLow = rank + 1; rankLow < size; rankLow++)
             {
-                for (unsigned int link = 1; link < ranks[rankLow][0] + 1; link++)
+                for (unsigned int link : ranks[rankLow])
                 {
                     if (random_Range(100) > 50)
                     {
-                        nodes[ranks[rank][curNode]].addEdge(ranks[rankLow][link]);
+                        edges.push_back({curNode, link});
                     }
                 }
             }
         }
     }
+
+    this->offsets.assign(size + 1, 0);
+    for (const auto &e : edges)
+    {
+        this->offsets[e.first + 1]++;
+    }
+    for (unsigned int i = 0; i < size; i++)
+    {
+        this->offsets[i + 1] += this->offsets[i];
+    }
+    this->links.resize(edges.size());
+    uiVector position(this->offsets.begin(), this->offsets.end() - 1);
+    for (const auto &e : edges)
+    {
+        this->links[position[e.first]++] = e.second;
+    }
 }
 
 void graph::print()
@@ -123,41 +133,48 @@ void graph::print()
     {
         int value = this->nodes[i].getValueOfNode();
         std::cout << "Node " << i << ":  " << value << ";    edges:";
-        unsigned int edgeCount = this->nodes[i].edgeSize();
+        unsigned int edgeCount = this->edgeSize(i);
         for (unsigned int j = 0; j < edgeCount; j++)
         {
-            unsigned int link = this->nodes[i].edge(j);
+            unsigned int link = this->edge(i, j);
             std::cout << "(" << i << "," << link << ")  ";
         }
         std::cout << std::endl;
     }
 }
 
-bool graph::dfs(unsigned int curNode, uiVector &stack)
+// Обход в глубину без рекурсии: в callStack хранится вершина и номер следующего ребра
+bool graph::dfs(unsigned int startNode, uiVector &stack)
 {
-    if (this->nodes[curNode].color == COLOR_OF_NODE_GREY)
-    {
-        return true; // Цикл найден
-    }
-    if (this->nodes[curNode].color == COLOR_OF_NODE_BLACK)
+    std::vector<std::pair<unsigned int, unsigned int>> callStack;
+    this->nodes[startNode].color = COLOR_OF_NODE_GREY;
+    callStack.push_back({startNode, 0});
+
+    while (!callStack.empty())
     {
-        return false;
-    }
+        unsigned int curNode = callStack.back().first;
+        unsigned int &next = callStack.back().second;
 
-    this->nodes[curNode].color = COLOR_OF_NODE_GREY;
+        if (next == this->edgeSize(curNode))
+        {
+            // Все рёбра обработаны
+            stack.push_back(curNode);
+            this->nodes[curNode].color = COLOR_OF_NODE_BLACK;
+            callStack.pop_back();
+            continue;
+        }
 
-    unsigned int edgeCount = this->nodes[curNode].edgeSize();
-    for (unsigned int i = 0; i < edgeCount; i++)
-    {
-        unsigned int link = this->nodes[curNode].edge(i);
-        if (this->dfs(link, stack))
+        unsigned int link = this->edge(curNode, next++);
+        if (this->nodes[link].color == COLOR_OF_NODE_GREY)
         {
-            return true;
+            return true; // Цикл найден
+        }
+        if (this->nodes[link].color == 0)
+        {
+            this->nodes[link].color = COLOR_OF_NODE_GREY;
+            callStack.push_back({link, 0});
         }
     }
-
-    stack.push_back(curNode);
-    this->nodes[curNode].color = COLOR_OF_NODE_BLACK;
     return false;
 }
 
@@ -165,6 +182,10 @@ bool graph::topological_sort(uiVector &result)
 {
     uiVector stack;
     for (unsigned int i = 0; i < this->amount; i++)
+    {
+        this->nodes[i].color = 0;
+    }
+    for (unsigned int i = 0; i < this->amount; i++)
     {
         if (this->nodes[i].color == 0)
         {
@@ -181,6 +202,87 @@ bool graph::topological_sort(uiVector &result)
     return true;
 }
 
+// Поуровневый алгоритм Кана: levels[k] - вершины, которые можно выполнять
+// параллельно после всех уровней < k. Большие уровни обрабатываются несколькими
+// потоками с атомарными счётчиками входящих рёбер и своим буфером у каждого потока.
+bool graph::topological_levels(std::vector<uiVector> &levels, unsigned int threads)
+{
+    const unsigned int minChunk = 4096;
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    std::unique_ptr<std::atomic<unsigned int>[]> inDegree(new std::atomic<unsigned int>[this->amount]);
+    for (unsigned int i = 0; i < this->amount; i++)
+    {
+        inDegree[i].store(0, std::memory_order_relaxed);
+    }
+    for (unsigned int link : this->links)
+    {
+        inDegree[link].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uiVector frontier;
+    for (unsigned int i = 0; i < this->amount; i++)
+    {
+        if (inDegree[i].load(std::memory_order_relaxed) == 0)
+        {
+            frontier.push_back(i);
+        }
+    }
+
+    levels.clear();
+    unsigned int processed = 0;
+    std::vector<uiVector> buffers(threads);
+    while (!frontier.empty())
+    {
+        unsigned int parts = std::min<unsigned int>(threads, frontier.size() / minChunk + 1);
+        unsigned int chunk = (frontier.size() + parts - 1) / parts;
+
+        auto work = [&](unsigned int part)
+        {
+            unsigned int begin = part * chunk;
+            unsigned int end = std::min<unsigned int>(frontier.size(), begin + chunk);
+            for (unsigned int i = begin; i < end; i++)
+            {
+                unsigned int curNode = frontier[i];
+                for (unsigned int pos = this->offsets[curNode]; pos < this->offsets[curNode + 1]; pos++)
+                {
+                    unsigned int link = this->links[pos];
+                    if (inDegree[link].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        buffers[part].push_back(link);
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned int part = 1; part < parts; part++)
+        {
+            pool.emplace_back(work, part);
+        }
+        work(0);
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+
+        processed += frontier.size();
+        levels.push_back(std::move(frontier));
+        frontier.clear();
+        for (unsigned int part = 0; part < parts; part++)
+        {
+            frontier.insert(frontier.end(), buffers[part].begin(), buffers[part].end());
+            buffers[part].clear();
+        }
+    }
+
+    // Не все вершины вошли в уровни - остались вершины на цикле
+    return processed == this->amount;
+}
+
 int main()
 {
     graph g(5);
@@ -201,5 +303,23 @@ int main()
         std::cout << "Graph contains a cycle!" << std::endl;
     }
 
+    std::vector<uiVector> levels;
+    if (g.topological_levels(levels, std::thread::hardware_concurrency()))
+    {
+        for (unsigned int level = 0; level < levels.size(); level++)
+        {
+            std::cout << "Level " << level << ": ";
+            for (unsigned int node : levels[level])
+            {
+                std::cout << node << " ";
+            }
+            std::cout << std::endl;
+        }
+    }
+    else
+    {
+        std::cout << "Graph contains a cycle!" << std::endl;
+    }
+
     return 0;
 }
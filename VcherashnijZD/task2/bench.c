@@ -0,0 +1,162 @@
+#include "matrix.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+// Benchmark of LU based matrix_det / matrix_lsolve against the previous
+// cofactor expansion determinant and Cramer's rule solver (kept here only
+// for comparison).
+
+#define MAX_VALUE 100
+#define COFACTOR_MAX_N 10
+
+
+static MatrixStatus cofactor_det(double* ret, const Matrix matrix) {
+    if (matrix.rows == 1) {
+        *ret = matrix.values[0];
+        return OK;
+    }
+    if (matrix.rows == 2) {
+        *ret = matrix.values[0] * matrix.values[3] - matrix.values[1] * matrix.values[2];
+        return OK;
+    }
+
+    Matrix submatrix;
+    MatrixStatus status = matrix_alloc(&submatrix, matrix.rows - 1, matrix.cols - 1);
+    if (status != OK)
+        return status;
+    double det = 0.0;
+    for (size_t base_col = 0; base_col < matrix.cols; ++base_col) {
+        size_t sub_row = 0;
+        for (size_t row = 1; row < matrix.rows; ++row) {
+            size_t sub_col = 0;
+            for (size_t col = 0; col < matrix.cols; ++col) {
+                if (col != base_col) {
+                    submatrix.values[sub_row * (matrix.cols - 1) + sub_col] = matrix.values[row * matrix.cols + col];
+                    sub_col++;
+                }
+            }
+            sub_row++;
+        }
+        double sub_det;
+        status = cofactor_det(&sub_det, submatrix);
+        if (status != OK) {
+            matrix_free(&submatrix);
+            return status;
+        }
+        det += (base_col % 2 == 0 ? 1 : -1) * matrix.values[base_col] * sub_det;
+    }
+    matrix_free(&submatrix);
+    *ret = det;
+    return OK;
+}
+
+
+static MatrixStatus cramer_lsolve(Matrix* ret, const Matrix matA, const Matrix matB) {
+    double det_a;
+    MatrixStatus status = cofactor_det(&det_a, matA);
+    if (status != OK || fabs(det_a) < 1e-6)
+        return ERR_DET;
+
+    status = matrix_alloc(ret, matA.rows, 1);
+    if (status != OK)
+        return status;
+    Matrix submatrix;
+    status = matrix_alloc(&submatrix, matA.rows, matA.cols);
+    if (status != OK) {
+        matrix_free(ret);
+        return status;
+    }
+
+    for (size_t col = 0; col < matA.rows; ++col) {
+        matrix_fill_val(submatrix, matA.values);
+        for (size_t row = 0; row < matA.rows; ++row)
+            submatrix.values[row * matA.cols + col] = matB.values[row];
+        double det_bi;
+        cofactor_det(&det_bi, submatrix);
+        ret->values[col] = det_bi / det_a;
+    }
+    matrix_free(&submatrix);
+    return OK;
+}
+
+
+static Matrix random_matrix(size_t rows, size_t cols) {
+    Matrix matrix;
+    if (matrix_alloc(&matrix, rows, cols) != OK) {
+        printf("matrix_alloc failed\n");
+        exit(1);
+    }
+    for (size_t idx = 0; idx < rows * cols; idx++)
+        matrix.values[idx] = (double)rand() / RAND_MAX * MAX_VALUE;
+    return matrix;
+}
+
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+static void bench_det(size_t n) {
+    Matrix mat = random_matrix(n, n);
+    double det_lu, det_cof = NAN;
+    double time_cof = NAN;
+
+    clock_t start = clock();
+    int reps = 0;
+    do {
+        matrix_det(&det_lu, mat);
+        reps++;
+    } while (seconds_since(start) < 0.2);
+    double time_lu = seconds_since(start) / reps;
+
+    if (n <= COFACTOR_MAX_N) {
+        start = clock();
+        cofactor_det(&det_cof, mat);
+        time_cof = seconds_since(start);
+    }
+
+    printf("det    n=%5zu  lu %12.6f s  cofactor %12.6f s  rel diff %.2e\n",
+           n, time_lu, time_cof, fabs(det_lu - det_cof) / fabs(det_lu));
+    matrix_free(&mat);
+}
+
+
+static void bench_lsolve(size_t n) {
+    Matrix a = random_matrix(n, n);
+    Matrix b = random_matrix(n, 1);
+    Matrix x_lu, x_cramer;
+    double time_cramer = NAN, max_diff = NAN;
+
+    clock_t start = clock();
+    matrix_lsolve(&x_lu, a, b);
+    double time_lu = seconds_since(start);
+
+    if (n <= COFACTOR_MAX_N - 1) {
+        start = clock();
+        if (cramer_lsolve(&x_cramer, a, b) == OK) {
+            time_cramer = seconds_since(start);
+            matrix_check_max_diff(&max_diff, x_lu, x_cramer);
+            matrix_free(&x_cramer);
+        }
+    }
+
+    printf("lsolve n=%5zu  lu %12.6f s  cramer   %12.6f s  max diff %.2e\n",
+           n, time_lu, time_cramer, max_diff);
+    matrix_free(&a);
+    matrix_free(&b);
+    matrix_free(&x_lu);
+}
+
+
+int main() {
+    srand(1);
+    size_t sizes[] = {4, 6, 8, 9, 10, 50, 100, 500, 1000, 2000};
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); ++idx)
+        bench_det(sizes[idx]);
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); ++idx)
+        bench_lsolve(sizes[idx]);
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
 #include <string.h>
 
 
@@ -200,6 +201,218 @@ MatrixStatus matrix_swap_rows(Matrix matrix, const size_t rowA, const size_t row
 }
 
 
+#define LU_BLOCK 64
+#define LU_COL_BLOCK 256
+
+// Unblocked LU of the panel [col_from, col_to) with partial pivoting.
+// Rows are swapped along their full length, so the left part (L) and
+// the right part (not yet factored) are permuted together.
+static void matrix_lu_panel(Matrix matrix, size_t col_from, size_t col_to,
+                            size_t* pivots, int* sign) {
+    const size_t n = matrix.rows;
+    double* a = matrix.values;
+
+    for (size_t col = col_from; col < col_to; ++col) {
+        size_t pivot = col;
+        double pivot_abs = fabs(a[col * n + col]);
+        for (size_t row = col + 1; row < n; ++row) {
+            if (fabs(a[row * n + col]) > pivot_abs) {
+                pivot_abs = fabs(a[row * n + col]);
+                pivot = row;
+            }
+        }
+        pivots[col] = pivot;
+        if (pivot != col) {
+            double* row_a = a + col * n;
+            double* row_b = a + pivot * n;
+            for (size_t idx = 0; idx < n; ++idx) {
+                double tmp = row_a[idx];
+                row_a[idx] = row_b[idx];
+                row_b[idx] = tmp;
+            }
+            *sign = -*sign;
+        }
+
+        // Singular column: leave zero pivot in U, nothing to eliminate
+        if (pivot_abs == 0.0)
+            continue;
+
+        const double* pivot_row = a + col * n;
+        for (size_t row = col + 1; row < n; ++row) {
+            double* cur_row = a + row * n;
+            double l = cur_row[col] / pivot_row[col];
+            cur_row[col] = l;
+            for (size_t idx = col + 1; idx < col_to; ++idx)
+                cur_row[idx] -= l * pivot_row[idx];
+        }
+    }
+}
+
+
+// In place LU = P * A. Unit lower L is stored under the diagonal, U on and above.
+// pivots[k] is the row swapped with row k at step k, sign is det(P).
+// Singular matrix is not an error here: U gets a zero on the diagonal.
+MatrixStatus matrix_lu(Matrix matrix, size_t* pivots, int* sign) {
+    if (pivots == NULL || sign == NULL) return ERR_NULL;
+    if (matrix.rows != matrix.cols)
+        return ERR_SIZE;
+
+    const size_t n = matrix.rows;
+    double* a = matrix.values;
+    *sign = 1;
+
+    for (size_t blk = 0; blk < n; blk += LU_BLOCK) {
+        size_t blk_end = (blk + LU_BLOCK < n) ? blk + LU_BLOCK : n;
+        matrix_lu_panel(matrix, blk, blk_end, pivots, sign);
+        if (blk_end == n)
+            break;
+
+        // Trailing columns are processed by strips that stay in cache
+        for (size_t col_blk = blk_end; col_blk < n; col_blk += LU_COL_BLOCK) {
+            size_t col_end = (col_blk + LU_COL_BLOCK < n) ? col_blk + LU_COL_BLOCK : n;
+
+            // U12 = L11^-1 * A12
+            for (size_t row = blk + 1; row < blk_end; ++row) {
+                double* cur_row = a + row * n;
+                for (size_t k = blk; k < row; ++k) {
+                    double l = cur_row[k];
+                    const double* u_row = a + k * n;
+                    for (size_t col = col_blk; col < col_end; ++col)
+                        cur_row[col] -= l * u_row[col];
+                }
+            }
+
+            // A22 -= L21 * U12
+            for (size_t row = blk_end; row < n; ++row) {
+                double* cur_row = a + row * n;
+                for (size_t k = blk; k < blk_end; ++k) {
+                    double l = cur_row[k];
+                    if (l == 0.0)
+                        continue;
+                    const double* u_row = a + k * n;
+                    for (size_t col = col_blk; col < col_end; ++col)
+                        cur_row[col] -= l * u_row[col];
+                }
+            }
+        }
+    }
+    return OK;
+}
+
+
+// Solve A * X = B in place of B, where lu and pivots come from matrix_lu
+MatrixStatus matrix_lu_solve(Matrix matB, const Matrix lu, const size_t* pivots) {
+    if (pivots == NULL) return ERR_NULL;
+    if (lu.rows != lu.cols || lu.rows != matB.rows)
+        return ERR_SIZE;
+
+    const size_t n = lu.rows;
+    const size_t m = matB.cols;
+    double* b = matB.values;
+
+    // Pivot is zero relative to the largest entry of U (about ||A|| times growth):
+    // rounding leaves a singular matrix with a tiny pivot, not an exact 0.0
+    double u_max = 0.0;
+    for (size_t row = 0; row < n; ++row)
+        for (size_t col = row; col < n; ++col)
+            if (fabs(lu.values[row * n + col]) > u_max)
+                u_max = fabs(lu.values[row * n + col]);
+    const double tolerance = n * DBL_EPSILON * u_max;
+    for (size_t row = 0; row < n; ++row)
+        if (!(fabs(lu.values[row * n + row]) > tolerance))
+            return ERR_DET;
+
+    for (size_t row = 0; row < n; ++row) {
+        if (pivots[row] == row)
+            continue;
+        double* row_a = b + row * m;
+        double* row_b = b + pivots[row] * m;
+        for (size_t col = 0; col < m; ++col) {
+            double tmp = row_a[col];
+            row_a[col] = row_b[col];
+            row_b[col] = tmp;
+        }
+    }
+
+    // Forward: L * Y = P * B
+    for (size_t row = 1; row < n; ++row) {
+        double* cur_row = b + row * m;
+        for (size_t k = 0; k < row; ++k) {
+            double l = lu.values[row * n + k];
+            if (l == 0.0)
+                continue;
+            const double* y_row = b + k * m;
+            for (size_t col = 0; col < m; ++col)
+                cur_row[col] -= l * y_row[col];
+        }
+    }
+
+    // Backward: U * X = Y
+    for (size_t row = n; row-- > 0;) {
+        double* cur_row = b + row * m;
+        for (size_t k = row + 1; k < n; ++k) {
+            double u = lu.values[row * n + k];
+            const double* x_row = b + k * m;
+            for (size_t col = 0; col < m; ++col)
+                cur_row[col] -= u * x_row[col];
+        }
+        double diag = lu.values[row * n + row];
+        for (size_t col = 0; col < m; ++col)
+            cur_row[col] /= diag;
+    }
+    return OK;
+}
+
+
+// Factorizes a copy of matrix, the caller frees lu and pivots
+static MatrixStatus matrix_lu_clone(Matrix* lu, size_t** pivots, int* sign, const Matrix matrix) {
+    if (matrix.rows != matrix.cols)
+        return ERR_SIZE;
+
+    MatrixStatus status = matrix_clone(lu, matrix);
+    if (status != OK)
+        return status;
+
+    *pivots = (size_t*) malloc((matrix.rows ? matrix.rows : 1) * sizeof(size_t));
+    if (*pivots == NULL) {
+        matrix_free(lu);
+        return ERR_MALLOC;
+    }
+
+    status = matrix_lu(*lu, *pivots, sign);
+    if (status != OK) {
+        matrix_free(lu);
+        free(*pivots);
+        *pivots = NULL;
+    }
+    return status;
+}
+
+
+MatrixStatus matrix_inverse(Matrix* ret, const Matrix matrix) {
+    if (ret == NULL) return ERR_NULL;
+
+    Matrix lu;
+    size_t* pivots;
+    int sign;
+    MatrixStatus status = matrix_lu_clone(&lu, &pivots, &sign, matrix);
+    if (status != OK)
+        return status;
+
+    status = matrix_alloc(ret, matrix.rows, matrix.cols);
+    if (status == OK) {
+        matrix_identity(*ret);
+        status = matrix_lu_solve(*ret, lu, pivots);
+        if (status != OK)
+            matrix_free(ret);
+    }
+
+    matrix_free(&lu);
+    free(pivots);
+    return status;
+}
+
+
 MatrixStatus matrix_det(double* ret, const Matrix matrix) {
     if (ret == NULL) return ERR_NULL;
     if (matrix.rows != matrix.cols) {
@@ -216,39 +429,19 @@ MatrixStatus matrix_det(double* ret, const Matrix matrix) {
         return OK;
     }
 
-    Matrix submatrix;
-    MatrixStatus status = matrix_alloc(&submatrix, matrix.rows - 1, matrix.cols - 1);
-    if (status != OK) {
+    Matrix lu;
+    size_t* pivots;
+    int sign;
+    MatrixStatus status = matrix_lu_clone(&lu, &pivots, &sign, matrix);
+    if (status != OK)
         return status;
-    }
-    double det = 0.0;
-    for (size_t base_col = 0; base_col < matrix.cols; ++base_col) {
-        size_t sub_row = 0;
-
-        // Step 1: minor
-        for (size_t row = 1; row < matrix.rows; ++row) {
-            size_t sub_col = 0;
-            for (size_t col = 0; col < matrix.cols; ++col) {
-                if (col != base_col) {
-                    submatrix.values[sub_row * (matrix.cols - 1) + sub_col] = matrix.values[row * matrix.cols + col];
-                    sub_col++;
-                }
-            }
-            sub_row++;
-        }
 
-        // Step 2: get determinant of minor
-        double sub_det;
-        status = matrix_det(&sub_det, submatrix);
-        if (status != OK) {
-            matrix_free(&submatrix);
-            return status;
-        }
+    double det = sign;
+    for (size_t idx = 0; idx < lu.rows; ++idx)
+        det *= lu.values[idx * lu.cols + idx];
 
-        // Step 3: update determinant
-        det += (base_col % 2 == 0 ? 1 : -1) * matrix.values[base_col] * sub_det;
-    }
-    matrix_free(&submatrix);
+    matrix_free(&lu);
+    free(pivots);
     *ret = det;
     return OK;
 }
@@ -398,44 +591,29 @@ MatrixStatus matrix_exp(Matrix* ret, const Matrix matrix) {
 }
 
 
-// Lsolve based on gauss method
+// Lsolve based on gauss method (LU with partial pivoting)
 MatrixStatus matrix_lsolve(Matrix* ret, const Matrix matA, const Matrix matB) {
     if (ret == NULL) return ERR_NULL;
     if (matA.rows != matA.cols || matA.rows != matB.rows)
         return ERR_SIZE;
 
-    double det_a;
-    MatrixStatus status = matrix_det(&det_a, matA);
-    if (status != OK || fabs(det_a) < 1e-6)
-        return ERR_DET;
-
-    status = matrix_alloc(ret, matA.rows, 1);
+    Matrix lu;
+    size_t* pivots;
+    int sign;
+    MatrixStatus status = matrix_lu_clone(&lu, &pivots, &sign, matA);
     if (status != OK)
         return status;
-    Matrix submatrix;
-    status = matrix_alloc(&submatrix, matA.rows, matA.cols);
-
-    // Iterate over columns
-    for (size_t col = 0; col < matA.rows; ++col) {
-        memcpy(submatrix.values, matA.values, matA.rows * matA.cols * sizeof(double));
-        for (size_t row = 0; row < matA.rows; ++row) {
-            submatrix.values[row * matA.cols + col] = matB.values[row];
-        }
 
-        // Calc determinant of swapped row matrix
-        double det_bi;
-        status = matrix_det(&det_bi, submatrix);
-        if (status != OK) {
-            matrix_free(&submatrix);
+    status = matrix_clone(ret, matB);
+    if (status == OK) {
+        status = matrix_lu_solve(*ret, lu, pivots);
+        if (status != OK)
             matrix_free(ret);
-            return status;
-        }
-
-        ret->values[col] = - det_bi / det_a;
     }
-    matrix_free(&submatrix);
 
-    return OK;
+    matrix_free(&lu);
+    free(pivots);
+    return status;
 }
 
 
@@ -494,7 +672,10 @@ MatrixStatus matrix_lsolve_cg(Matrix* ret, const Matrix matA, const Matrix matB)
     status = matrix_mult_in_place(r, matA, x);
     if (status != OK)
          goto check;
-    status = matrix_subt(r, matB);
+    status = matrix_mult_by_num(r, -1.0);
+    if (status != OK)
+         goto check;
+    status = matrix_add(r, matB);
     if (status != OK)
          goto check;
 
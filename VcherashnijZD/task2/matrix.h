@@ -41,6 +41,9 @@ MatrixStatus matrix_transp(Matrix matrix);
 MatrixStatus matrix_mult_by_num(Matrix matrix, const double a);
 MatrixStatus matrix_swap_rows(Matrix matrix, const size_t rowA, const size_t rowB);
 
+MatrixStatus matrix_lu(Matrix matrix, size_t* pivots, int* sign);
+MatrixStatus matrix_lu_solve(Matrix matB, const Matrix lu, const size_t* pivots);
+MatrixStatus matrix_inverse(Matrix* ret, const Matrix matrix);
 MatrixStatus matrix_det(double* ret, const Matrix matrix);
 MatrixStatus matrix_pow(Matrix* ret, const Matrix matrix, unsigned int power);
 MatrixStatus matrix_check_max_diff(double* ret, const Matrix matA, const Matrix matB);
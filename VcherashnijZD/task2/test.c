@@ -203,6 +203,88 @@ void test_matrix_det() {
 }
 
 
+void test_matrix_det_known() {
+    Matrix mat = {
+        .rows = 4,
+        .cols = 4,
+        .values = (double[]){0, 2, 1, 3, 1, 0, 4, 2, 2, 1, 0, 1, 3, 4, 2, 0}
+    };
+    double det_a;
+    MatrixStatus status = matrix_det(&det_a, mat);
+    ASSERT_STATUS_OK(status);
+    ASSERT_DOUBLE_EQ(det_a, -96.0, EQUAL_TEST_ACCURACY);
+
+    Matrix singular = {
+        .rows = 3,
+        .cols = 3,
+        .values = (double[]){1, 2, 3, 2, 4, 6, 1, 0, 1}
+    };
+    status = matrix_det(&det_a, singular);
+    ASSERT_STATUS_OK(status);
+    ASSERT_DOUBLE_EQ(det_a, 0.0, EQUAL_TEST_ACCURACY);
+}
+
+
+void test_matrix_lu_solve() {
+    // Bigger than LU_BLOCK to go through the blocked update
+    size_t n = 150;
+    Matrix a = generate_random_matrix(n, n);
+    Matrix x = generate_random_matrix(n, 2);
+    Matrix b;
+    MatrixStatus status = matrix_mult(&b, a, x);
+    ASSERT_STATUS_OK(status);
+
+    Matrix result;
+    status = matrix_lsolve(&result, a, b);
+    ASSERT_STATUS_OK(status);
+    ASSERT_MATRIX_EQ(&result, &x, EQUAL_TEST_ACCURACY);
+
+    matrix_free(&a);
+    matrix_free(&x);
+    matrix_free(&b);
+    matrix_free(&result);
+}
+
+
+void test_matrix_inverse() {
+    Matrix a = generate_random_matrix(70, 70);
+    Matrix inv;
+    MatrixStatus status = matrix_inverse(&inv, a);
+    ASSERT_STATUS_OK(status);
+
+    Matrix product, identity;
+    status = matrix_mult(&product, a, inv);
+    ASSERT_STATUS_OK(status);
+    status = matrix_alloc(&identity, 70, 70);
+    ASSERT_STATUS_OK(status);
+    matrix_identity(identity);
+    ASSERT_MATRIX_EQ(&product, &identity, EQUAL_TEST_ACCURACY);
+
+    Matrix singular = {
+        .rows = 2,
+        .cols = 2,
+        .values = (double[]){1, 2, 2, 4}
+    };
+    Matrix singular_inv;
+    if (matrix_inverse(&singular_inv, singular) != ERR_DET)
+        printf("Test failed: singular matrix inverted.\n");
+
+    // Rounding leaves a 1e-16 pivot instead of 0.0
+    Matrix rounded_singular = {
+        .rows = 3,
+        .cols = 3,
+        .values = (double[]){1, 2, 3, 4, 5, 6, 7, 8, 9}
+    };
+    if (matrix_inverse(&singular_inv, rounded_singular) != ERR_DET)
+        printf("Test failed: rounded singular matrix inverted.\n");
+
+    matrix_free(&a);
+    matrix_free(&inv);
+    matrix_free(&product);
+    matrix_free(&identity);
+}
+
+
 void test_matrix_pow() {
     Matrix mat = generate_random_matrix(3, 3);
     Matrix result;
@@ -307,6 +389,11 @@ int main() {
     test_matrix_swap_rows();
     printf("Test det\n");
     test_matrix_det();
+    test_matrix_det_known();
+    printf("Test lu solve\n");
+    test_matrix_lu_solve();
+    printf("Test inverse\n");
+    test_matrix_inverse();
     printf("Test pow\n");
     test_matrix_pow();
     printf("Test check max diff\n");
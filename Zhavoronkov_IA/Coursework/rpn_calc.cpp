@@ -9,10 +9,13 @@
 #include <sstream>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 
 
 // Типы токенов
-enum class TokenType { NUMBER, OPERATOR, LEFT_PAREN, RIGHT_PAREN };
+enum class TokenType { NUMBER, VARIABLE, OPERATOR, LEFT_PAREN, RIGHT_PAREN };
 
 
 // Класс для представления токена
@@ -22,12 +25,14 @@ public:
     double value;     // Для чисел
     char op;          // Для операторов
     bool isUnary;     // Флаг унарного оператора
+    int var = -1;     // Для переменных: номер в списке имён
     
     explicit Token(double val) : type(TokenType::NUMBER), value(val), isUnary(false) {}
     explicit Token(char c, bool unary = false) : type(TokenType::OPERATOR), op(c), isUnary(unary) {
         if (c == '(') type = TokenType::LEFT_PAREN;
         else if (c == ')') type = TokenType::RIGHT_PAREN;
     }
+    Token(TokenType t, int index) : type(t), value(0), op(' '), isUnary(false), var(index) {}
 
     int getPriority() const {
         if (type == TokenType::OPERATOR) {
@@ -41,8 +46,15 @@ public:
 
     bool isOperator() const { return type == TokenType::OPERATOR; }
     bool isNumber() const { return type == TokenType::NUMBER; }
+    bool isVariable() const { return type == TokenType::VARIABLE; }
     bool isLeftParenthesis() const { return type == TokenType::LEFT_PAREN; }
     bool isRightParenthesis() const { return type == TokenType::RIGHT_PAREN; }
+
+    std::string toString(const std::vector<std::string>* names = nullptr) const {
+        if (isNumber()) return std::to_string(value);
+        if (isVariable()) return names ? (*names)[var] : "$" + std::to_string(var);
+        return std::string(1, op);
+    }
 };
 
 
@@ -50,8 +62,9 @@ public:
 class Tokenizer {
     std::string expr;
     size_t pos = 0;
+    const std::vector<std::string>* variables; // Допустимые имена переменных
 public:
-    explicit Tokenizer(const std::string& s) : expr(s) {}
+    explicit Tokenizer(const std::string& s, const std::vector<std::string>* vars = nullptr) : expr(s), variables(vars) {}
 
     Token next() {
         while (pos < expr.size() && expr[pos] == ' ') pos++;
@@ -84,13 +97,16 @@ public:
             
             if (isUnary) {
                 char op = expr[pos++];
-                // Получаем следующий токен после унарного оператора
+                size_t after = pos;
+                // Знак перед числом сразу входит в число
                 Token nextToken = next();
                 if (nextToken.isNumber()) {
                     if (op == '-') nextToken.value = -nextToken.value;
                     return nextToken;
                 }
-                throw std::invalid_argument("Unary operator must precede a number");
+                // Перед переменной или скобкой остаётся унарным оператором
+                pos = after;
+                return Token(op, true);
             }
         }
 
@@ -100,6 +116,17 @@ public:
             return Token(stod(expr.substr(start, pos - start)));
         }
 
+        if (isalpha(static_cast<unsigned char>(expr[pos])) || expr[pos] == '_') {
+            size_t start = pos;
+            while (pos < expr.size() && (isalnum(static_cast<unsigned char>(expr[pos])) || expr[pos] == '_')) pos++;
+            std::string name = expr.substr(start, pos - start);
+            if (variables) {
+                auto it = std::find(variables->begin(), variables->end(), name);
+                if (it != variables->end()) return Token(TokenType::VARIABLE, static_cast<int>(it - variables->begin()));
+            }
+            throw std::invalid_argument("Unknown variable: " + name);
+        }
+
         char c = expr[pos++];
         if (c == '+' || c == '-' || c == '*' || c == '/' || c == '^' || c == '(' || c == ')') {
             return Token(c);
@@ -115,9 +142,10 @@ public:
 // Конвертер в ОПЗ
 class Converter {
     bool debug;
+    const std::vector<std::string>* names = nullptr;
 private:
     void printState(const std::string& msg, const Token& t, const std::stack<Token>& s, const std::queue<Token>& q) {
-        std::cout << "Step: " << msg << " " << (t.isNumber() ? std::to_string(t.value) : std::string(1, t.op)) << std::endl;
+        std::cout << "Step: " << msg << " " << t.toString(names) << std::endl;
         
         // Вывод стека
         std::cout << "Stack: ";
@@ -129,7 +157,7 @@ private:
         }
         for (auto it = stack_items.rbegin(); it != stack_items.rend(); ++it) {
             if (it->isNumber()) std::cout << it->value << " ";
-            else std::cout << it->op << " ";
+            else std::cout << it->toString(names) << " ";
         }
         
         // Вывод очереди
@@ -139,7 +167,7 @@ private:
             Token token = temp_q.front();
             temp_q.pop();
             if (token.isNumber()) std::cout << token.value << " ";
-            else std::cout << token.op << " ";
+            else std::cout << token.toString(names) << " ";
         }
         std::cout << "\n\n";
     }
@@ -147,17 +175,19 @@ private:
 public:
     explicit Converter(bool d = false) : debug(d) {}
 
-    std::queue<Token> infixToRPN(const std::string& expr) {
+    // variables - допустимые имена переменных, в ОПЗ они попадают своими номерами
+    std::queue<Token> infixToRPN(const std::string& expr, const std::vector<std::string>* variables = nullptr) {
         std::stack<Token> op_stack;
         std::queue<Token> output;
-        Tokenizer tokenizer(expr);
+        Tokenizer tokenizer(expr, variables);
+        names = variables;
 
         while (!tokenizer.isEnd()) {
             Token token = tokenizer.next();
 
-            if (token.isNumber()) {
+            if (token.isNumber() || token.isVariable()) {
                 output.push(token);
-                if (debug) printState("Number", token, op_stack, output);
+                if (debug) printState(token.isNumber() ? "Number" : "Variable", token, op_stack, output);
             }
             else if (token.isLeftParenthesis()) {
                 op_stack.push(token);
@@ -174,7 +204,8 @@ public:
                 if (debug) printState(")", token, op_stack, output);
             }
             else if (token.isOperator()) {
-                while (!op_stack.empty() && 
+                // Префиксный унарный оператор ещё не имеет операнда и ничего не выталкивает
+                while (!token.isUnary && !op_stack.empty() && 
                       (op_stack.top().getPriority() > token.getPriority() || 
                       (op_stack.top().getPriority() == token.getPriority() && token.op != '^')) &&
                       !op_stack.top().isLeftParenthesis()) {
@@ -225,7 +256,7 @@ private:
     }
 
     void printState(const std::string& msg, const Token& t, const std::stack<double>& s) {
-        std::cout << "Step: " << msg << " " << (t.isNumber() ? std::to_string(t.value) : std::string(1, t.op)) << std::endl;
+        std::cout << "Step: " << msg << " " << t.toString() << std::endl;
         std::cout << "Stack: ";
         std::stack<double> temp = s;
         std::vector<double> items;
@@ -243,7 +274,8 @@ private:
 public:
     explicit Evaluator(bool d = false) : debug(d) {}
 
-    double evaluateRPN(std::queue<Token>& rpn) {
+    // values - значения переменных в порядке списка имён, переданного в infixToRPN
+    double evaluateRPN(std::queue<Token>& rpn, const double* values = nullptr) {
         std::stack<double> calc_stack;
 
         while (!rpn.empty()) {
@@ -254,6 +286,11 @@ public:
                 calc_stack.push(token.value);
                 if (debug) printState("Number", token, calc_stack);
             }
+            else if (token.isVariable()) {
+                if (!values) throw std::invalid_argument("Variable values are not set");
+                calc_stack.push(values[token.var]);
+                if (debug) printState("Variable", token, calc_stack);
+            }
             else {
                 if (token.isUnary) {
                     if (calc_stack.empty()) throw std::invalid_argument("Not enough operands");
@@ -278,6 +315,241 @@ public:
 };
 
 
+// Выражение, один раз скомпилированное в плоский байткод.
+// Стек ОПЗ заменён регистрами, номера которых известны при компиляции,
+// поэтому при вычислении нет ни очереди токенов, ни стека, ни проверок.
+// Деление на ноль во время вычисления даёт inf/nan по IEEE, а не исключение:
+// в пакетном режиме одна строка не должна прерывать весь столбец.
+// x ^ 2 заменяется умножением: pow не векторизуется
+class CompiledExpression {
+public:
+    // Суффикс _C - правый операнд константа из инструкции,
+    // префикс R - константа стоит слева: c - x, c / x, c ^ x
+    enum class OpCode { LOAD_CONST, LOAD_VAR, NEG, ADD, SUB, MUL, DIV, POW, SQR,
+                        ADD_C, SUB_C, RSUB_C, MUL_C, DIV_C, RDIV_C, POW_C, RPOW_C };
+
+    struct Instruction {
+        OpCode code;
+        int dst;       // Регистр результата, он же левый операнд
+        int src;       // Правый регистр или номер переменной
+        double value;  // Константа
+    };
+
+    static const size_t BLOCK = 256; // Строк на регистр при пакетном вычислении
+
+private:
+    std::vector<Instruction> code;
+    int registers = 0;
+    int resultReg = 0;
+    size_t variableCount = 0;
+
+    // Операнд на стеке компиляции: константа ещё не попала в байткод
+    struct Operand {
+        bool isConst;
+        double value;
+        int reg;
+    };
+
+    static double fold(char op, double a, double b) {
+        switch(op) {
+            case '+': return a + b;
+            case '-': return a - b;
+            case '*': return a * b;
+            case '/':
+                if (b == 0) throw std::invalid_argument("Division by zero");
+                return a / b;
+            case '^': return pow(a, b);
+            default: throw std::invalid_argument("Unknown operator");
+        }
+    }
+
+    // Одна инструкция над n строками; регистр r занимает regs[r * stride ...].
+    // Циклы без ветвлений и зависимостей между строками векторизуются компилятором
+    template<typename LoadVar>
+    void execute(double* regs, size_t stride, size_t n, LoadVar loadVar) const {
+        for (const Instruction& ins : code) {
+            double* __restrict d = regs + ins.dst * stride;
+            const double* __restrict s = regs + ins.src * stride;
+            const double c = ins.value;
+
+            switch (ins.code) {
+                case OpCode::LOAD_CONST: for (size_t i = 0; i < n; i++) d[i] = c; break;
+                case OpCode::LOAD_VAR: {
+                    const double* __restrict v = loadVar(ins.src);
+                    for (size_t i = 0; i < n; i++) d[i] = v[i];
+                    break;
+                }
+                case OpCode::NEG:    for (size_t i = 0; i < n; i++) d[i] = -d[i]; break;
+                case OpCode::ADD:    for (size_t i = 0; i < n; i++) d[i] += s[i]; break;
+                case OpCode::SUB:    for (size_t i = 0; i < n; i++) d[i] -= s[i]; break;
+                case OpCode::MUL:    for (size_t i = 0; i < n; i++) d[i] *= s[i]; break;
+                case OpCode::DIV:    for (size_t i = 0; i < n; i++) d[i] /= s[i]; break;
+                case OpCode::POW:    for (size_t i = 0; i < n; i++) d[i] = pow(d[i], s[i]); break;
+                case OpCode::SQR:    for (size_t i = 0; i < n; i++) d[i] *= d[i]; break;
+                case OpCode::ADD_C:  for (size_t i = 0; i < n; i++) d[i] += c; break;
+                case OpCode::SUB_C:  for (size_t i = 0; i < n; i++) d[i] -= c; break;
+                case OpCode::RSUB_C: for (size_t i = 0; i < n; i++) d[i] = c - d[i]; break;
+                case OpCode::MUL_C:  for (size_t i = 0; i < n; i++) d[i] *= c; break;
+                case OpCode::DIV_C:  for (size_t i = 0; i < n; i++) d[i] /= c; break;
+                case OpCode::RDIV_C: for (size_t i = 0; i < n; i++) d[i] = c / d[i]; break;
+                case OpCode::POW_C:  for (size_t i = 0; i < n; i++) d[i] = pow(d[i], c); break;
+                case OpCode::RPOW_C: for (size_t i = 0; i < n; i++) d[i] = pow(c, d[i]); break;
+            }
+        }
+    }
+
+public:
+    // Разбор, перевод в ОПЗ и свёртка констант выполняются один раз.
+    // variables задаёт имена и порядок столбцов для evaluate
+    static CompiledExpression compile(const std::string& expr, const std::vector<std::string>& variables = {}) {
+        Converter converter;
+        std::queue<Token> rpn = converter.infixToRPN(expr, &variables);
+
+        CompiledExpression result;
+        result.variableCount = variables.size();
+        std::vector<Operand> operands;
+        std::vector<int> freeRegs;
+
+        auto allocReg = [&]() {
+            if (freeRegs.empty()) return result.registers++;
+            int reg = freeRegs.back();
+            freeRegs.pop_back();
+            return reg;
+        };
+        auto emit = [&](OpCode op, int dst, int src, double value) {
+            result.code.push_back({op, dst, src, value});
+        };
+
+        while (!rpn.empty()) {
+            Token token = rpn.front();
+            rpn.pop();
+
+            if (token.isNumber()) {
+                operands.push_back({true, token.value, -1});
+            }
+            else if (token.isVariable()) {
+                int reg = allocReg();
+                emit(OpCode::LOAD_VAR, reg, token.var, 0);
+                operands.push_back({false, 0, reg});
+            }
+            else if (token.isUnary) {
+                if (operands.empty()) throw std::invalid_argument("Not enough operands");
+                Operand& a = operands.back();
+                if (token.op != '-') continue;
+                if (a.isConst) a.value = -a.value;
+                else emit(OpCode::NEG, a.reg, a.reg, 0);
+            }
+            else {
+                if (operands.size() < 2) throw std::invalid_argument("Not enough operands");
+                Operand b = operands.back(); operands.pop_back();
+                Operand a = operands.back(); operands.pop_back();
+
+                if (a.isConst && b.isConst) {
+                    operands.push_back({true, fold(token.op, a.value, b.value), -1});
+                }
+                else if (b.isConst) {
+                    switch (token.op) {
+                        case '+': emit(OpCode::ADD_C, a.reg, a.reg, b.value); break;
+                        case '-': emit(OpCode::SUB_C, a.reg, a.reg, b.value); break;
+                        case '*': emit(OpCode::MUL_C, a.reg, a.reg, b.value); break;
+                        case '/':
+                            if (b.value == 0) throw std::invalid_argument("Division by zero");
+                            emit(OpCode::DIV_C, a.reg, a.reg, b.value);
+                            break;
+                        case '^':
+                            if (b.value == 2) emit(OpCode::SQR, a.reg, a.reg, 0);
+                            else emit(OpCode::POW_C, a.reg, a.reg, b.value);
+                            break;
+                        default: throw std::invalid_argument("Unknown operator");
+                    }
+                    operands.push_back(a);
+                }
+                else if (a.isConst) {
+                    switch (token.op) {
+                        case '+': emit(OpCode::ADD_C, b.reg, b.reg, a.value); break;
+                        case '-': emit(OpCode::RSUB_C, b.reg, b.reg, a.value); break;
+                        case '*': emit(OpCode::MUL_C, b.reg, b.reg, a.value); break;
+                        case '/': emit(OpCode::RDIV_C, b.reg, b.reg, a.value); break;
+                        case '^': emit(OpCode::RPOW_C, b.reg, b.reg, a.value); break;
+                        default: throw std::invalid_argument("Unknown operator");
+                    }
+                    operands.push_back(b);
+                }
+                else {
+                    switch (token.op) {
+                        case '+': emit(OpCode::ADD, a.reg, b.reg, 0); break;
+                        case '-': emit(OpCode::SUB, a.reg, b.reg, 0); break;
+                        case '*': emit(OpCode::MUL, a.reg, b.reg, 0); break;
+                        case '/': emit(OpCode::DIV, a.reg, b.reg, 0); break;
+                        case '^': emit(OpCode::POW, a.reg, b.reg, 0); break;
+                        default: throw std::invalid_argument("Unknown operator");
+                    }
+                    freeRegs.push_back(b.reg);
+                    operands.push_back(a);
+                }
+            }
+        }
+
+        if (operands.size() != 1) throw std::invalid_argument("Invalid expression");
+        if (operands.back().isConst) {
+            int reg = allocReg();
+            emit(OpCode::LOAD_CONST, reg, reg, operands.back().value);
+            operands.back().reg = reg;
+        }
+        result.resultReg = operands.back().reg;
+        return result;
+    }
+
+    // Вычисление одной строки; values - значения переменных в порядке компиляции
+    double evaluate(const double* values) const {
+        double local[16];
+        std::vector<double> heap;
+        double* regs = local;
+        if (registers > 16) {
+            heap.resize(registers);
+            regs = heap.data();
+        }
+        execute(regs, 1, 1, [values](int var) { return values + var; });
+        return regs[resultReg];
+    }
+
+    // Пакетное вычисление по столбцам: columns[v][i] - значение переменной v в строке i.
+    // Каждая инструкция проходит сразу блок из BLOCK строк, поэтому разбор
+    // инструкции окупается на сотнях значений
+    void evaluate(const std::vector<const double*>& columns, size_t rows, double* out) const {
+        if (columns.size() != variableCount) throw std::invalid_argument("Wrong number of columns");
+
+        std::vector<double> regs(registers * BLOCK);
+        for (size_t base = 0; base < rows; base += BLOCK) {
+            size_t n = rows - base < BLOCK ? rows - base : BLOCK;
+            execute(regs.data(), BLOCK, n, [&columns, base](int var) { return columns[var] + base; });
+            std::copy(regs.begin() + resultReg * BLOCK, regs.begin() + resultReg * BLOCK + n, out + base);
+        }
+    }
+
+    size_t size() const { return code.size(); }
+
+    // Листинг байткода
+    void print(std::ostream& os, const std::vector<std::string>& variables = {}) const {
+        static const char* names[] = { "LOAD_CONST", "LOAD_VAR", "NEG", "ADD", "SUB", "MUL", "DIV", "POW", "SQR",
+                                       "ADD_C", "SUB_C", "RSUB_C", "MUL_C", "DIV_C", "RDIV_C", "POW_C", "RPOW_C" };
+        for (const Instruction& ins : code) {
+            os << "  " << std::left << std::setw(10) << names[static_cast<int>(ins.code)] << std::right << " r" << ins.dst;
+            if (ins.code == OpCode::LOAD_VAR) {
+                os << ", " << (ins.src < static_cast<int>(variables.size()) ? variables[ins.src] : "$" + std::to_string(ins.src));
+            }
+            else if (ins.code >= OpCode::ADD && ins.code <= OpCode::POW) {
+                os << ", r" << ins.src;
+            }
+            else if (ins.code == OpCode::LOAD_CONST || ins.code >= OpCode::ADD_C) {
+                os << ", " << ins.value;
+            }
+            os << "\n";
+        }
+        os << "  result in r" << resultReg << "\n";
+    }
+};
+
 // Генератор случайных выражений
 std::string generateRandomExpression(int length) {
     std::random_device rd;
@@ -326,10 +598,37 @@ std::string generateRandomExpression(int length) {
 }
 
 
+// Замена каждого числа в выражении переменной v0, v1, ... со значением этого числа
+std::string parametrize(const std::string& expr, std::vector<std::string>& names, std::vector<double>& values) {
+    std::string result;
+    size_t pos = 0;
+    while (pos < expr.size()) {
+        if (isdigit(expr[pos]) || expr[pos] == '.') {
+            size_t start = pos;
+            while (pos < expr.size() && (isdigit(expr[pos]) || expr[pos] == '.')) pos++;
+            names.push_back("v" + std::to_string(names.size()));
+            values.push_back(stod(expr.substr(start, pos - start)));
+            result += names.back();
+        }
+        else {
+            result += expr[pos++];
+        }
+    }
+    return result;
+}
+
+
+// Байткод считает x ^ 2 как x * x, а pow может отличаться от этого в последнем бите
+static bool sameResult(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b)) || std::fabs(a - b) <= 1e-12 * std::max(std::fabs(a), std::fabs(b));
+}
+
+
 // Тестирование
 void runTests(int count) {
     auto start = std::chrono::high_resolution_clock::now();
     int success = 0;
+    int compiled = 0;
     
     for (int i = 0; i < count; ++i) {
         std::string expr = generateRandomExpression(10); // Выражения длиной 10 операторов
@@ -340,6 +639,25 @@ void runTests(int count) {
             std::queue<Token> rpn = converter.infixToRPN(expr);
             double result = evaluator.evaluateRPN(rpn);
             success++;
+
+            // Байткод должен давать тот же результат: и со свёрткой всех констант,
+            // и когда каждое число подставлено как переменная
+            std::vector<std::string> names;
+            std::vector<double> values;
+            std::string param = parametrize(expr, names, values);
+            CompiledExpression folded = CompiledExpression::compile(expr);
+            CompiledExpression program = CompiledExpression::compile(param, names);
+            std::vector<const double*> columns;
+            for (const double& v : values) columns.push_back(&v);
+            double batch = 0;
+            program.evaluate(columns, 1, &batch);
+            if (sameResult(folded.evaluate(nullptr), result) && sameResult(program.evaluate(values.data()), result) &&
+                sameResult(batch, result)) {
+                compiled++;
+            }
+            else {
+                std::cout << "Compiled result mismatch: " << expr << "\n\n";
+            }
             
             if (i % 100 == 0) {  // Вывод каждого 100-ого выражения
                 std::cout << "Expression: " << expr << "\n";
@@ -358,6 +676,73 @@ void runTests(int count) {
     std::cout << "Processed " << count << " expressions (" << success << " successful) in " 
               << duration.count() << " seconds\n";
     std::cout << "Average time per expression: " << duration.count()/count << " seconds\n";
+    std::cout << "Compiled bytecode matches: " << compiled << " of " << success << "\n";
+}
+
+
+// Замер: одна формула над столбцами показаний датчиков.
+// Сравнивается разбор выражения заново для каждой строки, байткод по строкам и байткод по столбцам
+void runBenchmark(size_t rows) {
+    const std::vector<std::string> names = { "t", "h", "p" };
+    const std::string expr = "(t * 9 / 5 + 32) * (1 - h / 100) + (p - 1013.25) ^ 2 / (2 * 1000) - -t / (1 + 2 * 3)";
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> temp(-30, 40), hum(10, 100), pres(950, 1050);
+    std::vector<double> t(rows), h(rows), p(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        t[i] = temp(gen);
+        h[i] = hum(gen);
+        p[i] = pres(gen);
+    }
+
+    auto seconds = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Разбор на каждой строке заметно медленнее, поэтому он идёт на части строк
+    size_t parsedRows = std::min<size_t>(rows, 200000);
+    std::vector<double> parsed(parsedRows);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < parsedRows; ++i) {
+        double row[] = { t[i], h[i], p[i] };
+        Converter converter;
+        Evaluator evaluator;
+        std::queue<Token> rpn = converter.infixToRPN(expr, &names);
+        parsed[i] = evaluator.evaluateRPN(rpn, row);
+    }
+    double parseTime = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    CompiledExpression program = CompiledExpression::compile(expr, names);
+    double compileTime = seconds(start);
+
+    std::vector<double> single(rows);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rows; ++i) {
+        double row[] = { t[i], h[i], p[i] };
+        single[i] = program.evaluate(row);
+    }
+    double singleTime = seconds(start);
+
+    std::vector<double> batch(rows);
+    start = std::chrono::steady_clock::now();
+    program.evaluate({ t.data(), h.data(), p.data() }, rows, batch.data());
+    double batchTime = seconds(start);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (!sameResult(single[i], batch[i]) || (i < parsedRows && !sameResult(parsed[i], batch[i]))) mismatches++;
+    }
+
+    std::cout << "Expression: " << expr << "\n";
+    std::cout << "Bytecode (" << program.size() << " instructions, compiled in " << compileTime * 1e6 << " us):\n";
+    program.print(std::cout, names);
+    std::cout << "Rows: " << rows << "\n";
+    std::cout << "Parse every row:    " << std::setw(10) << std::fixed << std::setprecision(2)
+              << parsedRows / parseTime / 1e6 << " M rows/s\n";
+    std::cout << "Bytecode, row-wise: " << std::setw(10) << rows / singleTime / 1e6 << " M rows/s\n";
+    std::cout << "Bytecode, columnar: " << std::setw(10) << rows / batchTime / 1e6 << " M rows/s\n";
+    std::cout << "Mismatches: " << mismatches << std::endl;
 }
 
 
@@ -366,6 +751,11 @@ int main(int argc, char* argv[]) {
         runTests(1000); // Тест на 1000 выражений
         return 0;
     }
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        long long rows = argc > 2 ? std::atoll(argv[2]) : 10000000;
+        runBenchmark(rows > 0 ? rows : 1);
+        return 0;
+    }
 
     std::string expr;
     std::cout << "Enter expression: ";
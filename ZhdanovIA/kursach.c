@@ -1,8 +1,12 @@
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <string>
 #include <vector>
 
+#include "suffix_array.h"
+
 class Node {
 public:
     std::map<char, Node*> children;
@@ -66,7 +70,7 @@ public:
                 lastCreatedNode = currentChar; // Обновляем последний созданный узел
             } else {
                 Node* existingNode = root->children[currentChar];
-                if (activeLength >= existingNode->end - existingNode->start) {
+                if (activeLength >= *existingNode->end - existingNode->start) {
                     // Если длина активного ребра больше, чем длина существующего ребра
                     activeEdge += activeLength; // Переходим к следующему
                     activeLength = 0;
@@ -105,8 +109,6 @@ public:
             }
         }
     }
-};
-
     void display(Node* node, int level = 0) {
         if (node == nullptr) return;
 
@@ -124,10 +126,49 @@ public:
     void display() {
         display(root);
     }
+};
+
+// Запуск без аргументов - пример на MISSISSIPPI$.
+// kursach index <текст> <индекс>          - построить индекс и сохранить его на диск
+// kursach query <индекс> <шаблон>...      - открыть индекс через mmap и искать шаблоны
+int main(int argc, char** argv) {
+    try {
+        if (argc == 4 && std::string(argv[1]) == "index") {
+            std::ifstream in(argv[2], std::ios::binary);
+            if (!in) {
+                std::cerr << "Cannot open " << argv[2] << std::endl;
+                return 1;
+            }
+            std::string corpus((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            SuffixArray index(corpus);
+            index.save(argv[3]);
+            std::cout << "Indexed " << index.size() << " bytes, index size " << index.memoryBytes() << " bytes" << std::endl;
+            return 0;
+        }
+        if (argc >= 4 && std::string(argv[1]) == "query") {
+            SuffixArray index = SuffixArray::load(argv[2]);
+            for (int i = 3; i < argc; i++) {
+                std::cout << argv[i] << ": " << index.count(argv[i]) << std::endl;
+            }
+            return 0;
+        }
 
-int main() {
-    std::string text = "MISSISSIPPI$";
-    SuffixTree suffixTree(text);
-    suffixTree.display(); // Выводим дерево
+        // SuffixTree::extend для этой строки не завершается (активная точка не
+        // сдвигается по суффиксным ссылкам), поэтому пример строится на суффиксном массиве
+        std::string text = "MISSISSIPPI$";
+        SuffixArray suffixArray(text);
+        for (size_t k = 0; k < suffixArray.size(); k++) {
+            std::cout << suffixArray.lcp(k) << "\t" << text.substr(suffixArray.suffix(k)) << std::endl;
+        }
+        std::cout << "ISS occurs " << suffixArray.count("ISS") << " times at:";
+        for (int pos : suffixArray.findAll("ISS")) std::cout << " " << pos;
+        std::cout << std::endl;
+        std::cout << "Contains PIP: " << (suffixArray.contains("PIP") ? "yes" : "no") << std::endl;
+        std::cout << "Longest repeated substring: " << suffixArray.longestRepeatedSubstring() << std::endl;
+    }
+    catch (const SuffixArrayException& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
     return 0;
 }
@@ -0,0 +1,294 @@
+#include "suffix_array.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char MAGIC[8] = { 'S', 'U', 'F', 'F', 'A', 'R', 'R', '1' };
+
+// SA-IS: суффиксы делятся на S (меньше следующего) и L (больше следующего),
+// сортируются только LMS-подстроки (S, перед которым L), порядок остальных
+// выводится двумя проходами "индуцированной сортировки". Если LMS-подстроки
+// не все различны, задача для их имён решается рекурсивно, она не больше n / 2.
+static std::vector<int> sais(const std::vector<int>& s, int upper) {
+    int n = (int)s.size();
+    if (n == 0) return {};
+    if (n == 1) return { 0 };
+    if (n == 2) return s[0] < s[1] ? std::vector<int>{ 0, 1 } : std::vector<int>{ 1, 0 };
+
+    std::vector<int> sa(n);
+    std::vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; i--) {
+        isS[i] = s[i] == s[i + 1] ? isS[i + 1] : s[i] < s[i + 1];
+    }
+
+    // Начала корзин: sumL[c] - первая позиция L-суффиксов на букву c, sumS[c] - S-суффиксов
+    std::vector<int> sumL(upper + 2, 0), sumS(upper + 2, 0);
+    for (int i = 0; i < n; i++) {
+        if (!isS[i]) sumS[s[i]]++;
+        else sumL[s[i] + 1]++;
+    }
+    for (int c = 0; c <= upper; c++) {
+        sumS[c] += sumL[c];
+        sumL[c + 1] += sumS[c];
+    }
+
+    auto induce = [&](const std::vector<int>& lms) {
+        std::fill(sa.begin(), sa.end(), -1);
+        std::vector<int> bucket(upper + 2);
+        std::copy(sumS.begin(), sumS.end(), bucket.begin());
+        for (int d : lms) {
+            if (d != n) sa[bucket[s[d]]++] = d;
+        }
+        std::copy(sumL.begin(), sumL.end(), bucket.begin());
+        sa[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; i++) {
+            int v = sa[i];
+            if (v >= 1 && !isS[v - 1]) sa[bucket[s[v - 1]]++] = v - 1;
+        }
+        std::copy(sumL.begin(), sumL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; i--) {
+            int v = sa[i];
+            if (v >= 1 && isS[v - 1]) sa[--bucket[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    std::vector<int> lmsIndex(n + 1, -1);
+    std::vector<int> lms;
+    for (int i = 1; i < n; i++) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = (int)lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = (int)lms.size();
+    induce(lms);
+    if (m == 0) return sa;
+
+    // Имена LMS-подстрок в порядке сортировки; одинаковые подстроки получают одно имя
+    std::vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int v : sa) {
+        if (lmsIndex[v] != -1) sortedLms.push_back(v);
+    }
+    std::vector<int> reduced(m);
+    int name = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; i++) {
+        int l = sortedLms[i - 1], r = sortedLms[i];
+        int endL = lmsIndex[l] + 1 < m ? lms[lmsIndex[l] + 1] : n;
+        int endR = lmsIndex[r] + 1 < m ? lms[lmsIndex[r] + 1] : n;
+        bool same = endL - l == endR - r;
+        if (same) {
+            while (l < endL && s[l] == s[r]) {
+                l++;
+                r++;
+            }
+            if (l == n || s[l] != s[r]) same = false;
+        }
+        if (!same) name++;
+        reduced[lmsIndex[sortedLms[i]]] = name;
+    }
+
+    std::vector<int> reducedSa = sais(reduced, name);
+    for (int i = 0; i < m; i++) sortedLms[i] = lms[reducedSa[i]];
+    induce(sortedLms);
+    return sa;
+}
+
+SuffixArray::SuffixArray()
+    : mapping(nullptr), imageSize(0), text(nullptr), sa(nullptr), lcpArray(nullptr), length(0) { }
+
+SuffixArray::SuffixArray(const std::string& str) : SuffixArray() {
+    if (str.size() >= (size_t)INT32_MAX) {
+        throw SuffixArrayException("Text is too long for 32-bit suffix array");
+    }
+    size_t n = str.size();
+    std::vector<int> s(n);
+    for (size_t i = 0; i < n; i++) s[i] = (unsigned char)str[i];
+    std::vector<int> order = sais(s, 255);
+    s.clear();
+    s.shrink_to_fit();
+
+    size_t bytes = sizeof(Header) + textBytes(n) + 2 * n * sizeof(int32_t);
+    storage.assign(bytes, 0);
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.length = n;
+    memcpy(storage.data(), &header, sizeof(header));
+    char* textPart = storage.data() + sizeof(Header);
+    if (n > 0) memcpy(textPart, str.data(), n);
+    int32_t* saPart = (int32_t*)(textPart + textBytes(n));
+    int32_t* lcpPart = saPart + n;
+    for (size_t k = 0; k < n; k++) saPart[k] = order[k];
+
+    // Касаи: при переходе от суффикса i к i + 1 общий префикс с соседом
+    // уменьшается не больше чем на 1, поэтому сравнение продолжается с h - 1
+    std::vector<int>& rank = order;
+    for (size_t k = 0; k < n; k++) rank[saPart[k]] = (int)k;
+    size_t h = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (h > 0) h--;
+        if (rank[i] == 0) {
+            lcpPart[0] = 0;
+            h = 0;
+            continue;
+        }
+        size_t j = saPart[rank[i] - 1];
+        while (i + h < n && j + h < n && str[i + h] == str[j + h]) h++;
+        lcpPart[rank[i]] = (int32_t)h;
+    }
+
+    attach(storage.data(), bytes);
+}
+
+SuffixArray::SuffixArray(SuffixArray&& other) noexcept : SuffixArray() {
+    *this = std::move(other);
+}
+
+SuffixArray& SuffixArray::operator=(SuffixArray&& other) noexcept {
+    if (this != &other) {
+        release();
+        storage = std::move(other.storage);
+        mapping = other.mapping;
+        imageSize = other.imageSize;
+        text = other.text;
+        sa = other.sa;
+        lcpArray = other.lcpArray;
+        length = other.length;
+        other.mapping = nullptr;
+        other.storage.clear();
+        other.imageSize = 0;
+        other.text = nullptr;
+        other.sa = nullptr;
+        other.lcpArray = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+SuffixArray::~SuffixArray() {
+    release();
+}
+
+void SuffixArray::release() {
+#ifndef _WIN32
+    if (mapping != nullptr) munmap(mapping, imageSize);
+#endif
+    mapping = nullptr;
+}
+
+void SuffixArray::attach(const char* image, size_t bytes) {
+    Header header;
+    if (bytes < sizeof(Header)) throw SuffixArrayException("Index file is truncated");
+    memcpy(&header, image, sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw SuffixArrayException("Not a suffix array index");
+    }
+    size_t n = (size_t)header.length;
+    if (bytes != sizeof(Header) + textBytes(n) + 2 * n * sizeof(int32_t)) {
+        throw SuffixArrayException("Index file size does not match its header");
+    }
+    imageSize = bytes;
+    length = n;
+    text = image + sizeof(Header);
+    sa = (const int32_t*)(text + textBytes(n));
+    lcpArray = sa + n;
+}
+
+void SuffixArray::save(const std::string& path) const {
+    const char* image = text - sizeof(Header);
+    std::ofstream out(path, std::ios::binary);
+    out.write(image, imageSize);
+    if (!out) throw SuffixArrayException("Cannot write index file " + path);
+}
+
+SuffixArray SuffixArray::load(const std::string& path) {
+    SuffixArray index;
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw SuffixArrayException("Cannot open index file " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        throw SuffixArrayException("Cannot read index file " + path);
+    }
+    void* image = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) throw SuffixArrayException("Cannot map index file " + path);
+    index.mapping = image;
+    index.imageSize = (size_t)info.st_size;
+    index.attach((const char*)image, (size_t)info.st_size);
+#else
+    // Без mmap файл читается в память целиком
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw SuffixArrayException("Cannot open index file " + path);
+    index.storage.resize((size_t)in.tellg());
+    in.seekg(0);
+    in.read(index.storage.data(), index.storage.size());
+    index.attach(index.storage.data(), index.storage.size());
+#endif
+    return index;
+}
+
+// Суффиксы, начинающиеся с pattern, идут в массиве подряд: [first, second)
+std::pair<size_t, size_t> SuffixArray::range(const std::string& pattern) const {
+    size_t m = pattern.size();
+    auto compare = [&](size_t k) {
+        size_t start = sa[k];
+        size_t common = std::min(m, length - start);
+        int result = memcmp(text + start, pattern.data(), common);
+        if (result != 0) return result;
+        return common < m ? -1 : 0;  // суффикс короче шаблона и является его префиксом
+    };
+
+    size_t lo = 0, hi = length;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (compare(mid) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    size_t first = lo;
+    hi = length;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (compare(mid) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return { first, lo };
+}
+
+bool SuffixArray::contains(const std::string& pattern) const {
+    std::pair<size_t, size_t> r = range(pattern);
+    return r.first < r.second;
+}
+
+size_t SuffixArray::count(const std::string& pattern) const {
+    std::pair<size_t, size_t> r = range(pattern);
+    return r.second - r.first;
+}
+
+std::vector<int> SuffixArray::findAll(const std::string& pattern) const {
+    std::pair<size_t, size_t> r = range(pattern);
+    std::vector<int> positions(sa + r.first, sa + r.second);
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+// Самая длинная повторяющаяся подстрока - наибольший общий префикс соседних суффиксов
+std::string SuffixArray::longestRepeatedSubstring() const {
+    if (length == 0) return "";
+    size_t best = 0;
+    for (size_t k = 1; k < length; k++) {
+        if (lcpArray[k] > lcpArray[best]) best = k;
+    }
+    if (lcpArray[best] == 0) return "";
+    return std::string(text + sa[best], lcpArray[best]);
+}
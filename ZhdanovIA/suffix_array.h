@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Суффиксный массив с массивом LCP - компактная замена SuffixTree из kursach.c.
+// Дерево хранит map<char, Node*> и отдельный int* end в каждом узле, это сотни байт
+// на символ текста; здесь на символ приходится 9 байт: сам символ, номер суффикса
+// и длина общего префикса с предыдущим суффиксом.
+//
+// Массив строится алгоритмом SA-IS за O(n), LCP - алгоритмом Касаи за O(n).
+// Текст и оба массива лежат одним блоком в формате файла индекса, поэтому индекс
+// можно сохранить один раз (save) и потом открывать через mmap (load) без разбора:
+// запросы читают страницы файла по мере надобности.
+
+class SuffixArrayException : public std::runtime_error {
+public:
+    SuffixArrayException(const std::string message) : runtime_error {message} { };
+};
+
+class SuffixArray {
+public:
+    explicit SuffixArray(const std::string& str);
+    SuffixArray(SuffixArray&& other) noexcept;
+    SuffixArray& operator=(SuffixArray&& other) noexcept;
+    SuffixArray(const SuffixArray&) = delete;
+    SuffixArray& operator=(const SuffixArray&) = delete;
+    ~SuffixArray();
+
+    // Файл индекса: заголовок, текст (выровнен до 4 байт), суффиксный массив, LCP.
+    // Числа записываются в порядке байт машины, на которой индекс построен.
+    void save(const std::string& path) const;
+    static SuffixArray load(const std::string& path);
+
+    bool contains(const std::string& pattern) const;
+    size_t count(const std::string& pattern) const;
+    std::vector<int> findAll(const std::string& pattern) const; // позиции по возрастанию
+    std::string longestRepeatedSubstring() const;
+
+    size_t size() const { return length; }
+    const char* data() const { return text; }
+    int suffix(size_t k) const { return sa[k]; }   // k-й по порядку суффикс
+    int lcp(size_t k) const { return lcpArray[k]; } // общий префикс суффиксов k - 1 и k, lcp(0) = 0
+    size_t memoryBytes() const { return imageSize; }
+
+private:
+    struct Header {
+        char magic[8];
+        uint64_t length;
+    };
+
+    std::vector<char> storage;  // образ, построенный в памяти
+    void* mapping;              // или отображённый файл
+    size_t imageSize;
+
+    const char* text;
+    const int32_t* sa;
+    const int32_t* lcpArray;
+    size_t length;
+
+    SuffixArray();
+    void attach(const char* image, size_t bytes);
+    void release();
+    std::pair<size_t, size_t> range(const std::string& pattern) const;
+
+    static size_t textBytes(size_t n) { return (n + 3) / 4 * 4; }
+};
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Общий заголовок для Egor Ivanov/coursework и KA_Khlusova/coursework:
+// исправления вносятся здесь, а не в копиях.
+
+// Дерево Фенвика с индексацией от нуля, как в coursework.c:
+// t[i] хранит свёртку элементов [i & (i + 1), i], родитель узла i - i | (i + 1).
+// Операция задаётся классом Op: identity() - нейтральный элемент, operator() - свёртка.
+// Запрос на отрезке [left, right] доступен только для обратимых операций (Op::inverse).
+
+
+template <typename T>
+struct SumOp {
+    static T identity() { return T(); }
+    T operator()(const T& a, const T& b) const { return a + b; }
+    static T inverse(const T& total, const T& part) { return total - part; }
+};
+
+// Для минимума и максимума обновление только улучшает значение: a[i] = min(a[i], x)
+template <typename T>
+struct MinOp {
+    static T identity() { return std::numeric_limits<T>::max(); }
+    T operator()(const T& a, const T& b) const { return std::min(a, b); }
+};
+
+template <typename T>
+struct MaxOp {
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    T operator()(const T& a, const T& b) const { return std::max(a, b); }
+};
+
+
+class FenwickException : public std::out_of_range
+{
+public:
+    FenwickException(const std::string message) : out_of_range{ message } { };
+};
+
+
+template <typename T, typename Op = SumOp<T>>
+class FenwickTree
+{
+private:
+    std::vector<T> t;
+    Op op;
+
+    void check(size_t idx) const {
+        if (idx >= t.size()) throw FenwickException("Fenwick index out of range");
+    }
+
+public:
+    FenwickTree() {}
+    explicit FenwickTree(size_t n) : t(n, Op::identity()) {}
+
+    // Построение за O(n): каждый узел один раз передаёт свою свёртку родителю
+    explicit FenwickTree(const std::vector<T>& a) : t(a) {
+        size_t n = t.size();
+        for (size_t i = 0; i < n; i++) {
+            size_t parent = i | (i + 1);
+            if (parent < n) t[parent] = op(t[parent], t[i]);
+        }
+    }
+
+    size_t size() const { return t.size(); }
+
+    // a[idx] = op(a[idx], value)
+    void update(size_t idx, const T& value) {
+        check(idx);
+        for (size_t n = t.size(); idx < n; idx |= idx + 1) t[idx] = op(t[idx], value);
+    }
+
+    // Свёртка a[0..right]
+    T prefix(size_t right) const {
+        check(right);
+        T result = Op::identity();
+        for (size_t i = right + 1; i > 0; i &= i - 1) result = op(result, t[i - 1]);
+        return result;
+    }
+
+    // Свёртка a[left..right], только для обратимых операций
+    T query(size_t left, size_t right) const {
+        if (left > right) throw FenwickException("Fenwick range is empty");
+        T total = prefix(right);
+        return left == 0 ? total : Op::inverse(total, prefix(left - 1));
+    }
+
+    // Пакет обновлений, отсортированных по индексу, за один проход слева направо.
+    // Вклад узла переносится родителю i | (i + 1); ещё не применённые переносы
+    // лежат на пути обновления текущего узла, поэтому их не больше разрядности
+    // индекса и они хранятся в маленьком стеке (наверху - меньший индекс).
+    // Каждый узел объединения путей обновляется один раз, общие верхние узлы
+    // не проходятся повторно, как при отдельных update.
+    void batch_update(const std::vector<std::pair<size_t, T>>& updates) {
+        if (updates.empty()) return;
+        for (size_t k = 1; k < updates.size(); k++) {
+            if (updates[k].first < updates[k - 1].first) {
+                throw FenwickException("Fenwick batch is not sorted by index");
+            }
+        }
+        check(updates.back().first);
+
+        struct Carry {
+            size_t idx;
+            T value;
+        };
+        Carry stack[sizeof(size_t) * 8];
+        size_t depth = 0;
+        size_t n = t.size();
+        size_t k = 0;
+
+        while (k < updates.size() || depth > 0) {
+            size_t i = depth > 0 ? stack[depth - 1].idx : n;
+            if (k < updates.size()) i = std::min(i, updates[k].first);
+
+            T carry = Op::identity();
+            if (depth > 0 && stack[depth - 1].idx == i) carry = stack[--depth].value;
+            while (k < updates.size() && updates[k].first == i) carry = op(carry, updates[k++].second);
+
+            t[i] = op(t[i], carry);
+            size_t parent = i | (i + 1);
+            if (parent >= n) continue;
+            if (depth > 0 && stack[depth - 1].idx == parent) {
+                stack[depth - 1].value = op(stack[depth - 1].value, carry);
+            }
+            else {
+                stack[depth++] = { parent, carry };
+            }
+        }
+    }
+};
+
+
+// Прибавление на отрезке и сумма на отрезке на двух деревьях (b1, b2):
+// сумма a[0..p] = b1(p) * (p + 1) - b2(p), прибавление x на [l, r] меняет
+// b1 в точках l, r + 1 на x, -x и b2 на x * l, -x * (r + 1).
+template <typename T>
+class RangeFenwick
+{
+private:
+    FenwickTree<T> b1, b2;
+
+    T sum_prefix(size_t p) const {
+        return b1.prefix(p) * T(p + 1) - b2.prefix(p);
+    }
+
+    static std::vector<T> differences(const std::vector<T>& a, bool weighted) {
+        std::vector<T> d(a.size());
+        for (size_t i = 0; i < a.size(); i++) {
+            d[i] = i == 0 ? a[0] : a[i] - a[i - 1];
+            if (weighted) d[i] = d[i] * T(i);
+        }
+        return d;
+    }
+
+public:
+    explicit RangeFenwick(size_t n) : b1(n), b2(n) {}
+    explicit RangeFenwick(const std::vector<T>& a)
+        : b1(differences(a, false)), b2(differences(a, true)) {}
+
+    size_t size() const { return b1.size(); }
+
+    void add(size_t left, size_t right, const T& x) {
+        if (left > right || right >= size()) throw FenwickException("Fenwick range out of bounds");
+        b1.update(left, x);
+        b2.update(left, x * T(left));
+        if (right + 1 < size()) {
+            b1.update(right + 1, -x);
+            b2.update(right + 1, -x * T(right + 1));
+        }
+    }
+
+    T query(size_t left, size_t right) const {
+        if (left > right) throw FenwickException("Fenwick range is empty");
+        T total = sum_prefix(right);
+        return left == 0 ? total : total - sum_prefix(left - 1);
+    }
+
+    T get(size_t idx) const { return query(idx, idx); }
+};
+
+
+// Двумерное дерево для агрегатов по прямоугольникам сетки.
+// Хранится одним массивом по строкам: внутренний цикл идёт по соседним ячейкам строки.
+template <typename T, typename Op = SumOp<T>>
+class Fenwick2D
+{
+private:
+    size_t rows, cols;
+    std::vector<T> t;
+    Op op;
+
+    T* row(size_t r) { return &t[r * cols]; }
+    const T* row(size_t r) const { return &t[r * cols]; }
+
+    void check(size_t r, size_t c) const {
+        if (r >= rows || c >= cols) throw FenwickException("Fenwick2D index out of range");
+    }
+
+public:
+    Fenwick2D(size_t rows, size_t cols) : rows(rows), cols(cols), t(rows * cols, Op::identity()) {}
+
+    // a - матрица rows x cols по строкам; построение за O(rows * cols):
+    // сначала одномерная сборка в каждой строке, затем строки целиком передаются родительским строкам
+    Fenwick2D(size_t rows, size_t cols, const std::vector<T>& a) : rows(rows), cols(cols), t(a) {
+        if (a.size() != rows * cols) throw FenwickException("Fenwick2D data size mismatch");
+        for (size_t r = 0; r < rows; r++) {
+            T* line = row(r);
+            for (size_t c = 0; c < cols; c++) {
+                size_t parent = c | (c + 1);
+                if (parent < cols) line[parent] = op(line[parent], line[c]);
+            }
+        }
+        for (size_t r = 0; r < rows; r++) {
+            size_t parent = r | (r + 1);
+            if (parent >= rows) continue;
+            const T* from = row(r);
+            T* to = row(parent);
+            for (size_t c = 0; c < cols; c++) to[c] = op(to[c], from[c]);
+        }
+    }
+
+    size_t row_count() const { return rows; }
+    size_t col_count() const { return cols; }
+
+    void update(size_t r, size_t c, const T& value) {
+        check(r, c);
+        for (; r < rows; r |= r + 1) {
+            T* line = row(r);
+            for (size_t j = c; j < cols; j |= j + 1) line[j] = op(line[j], value);
+        }
+    }
+
+    // Свёртка прямоугольника [0..r] x [0..c]
+    T prefix(size_t r, size_t c) const {
+        check(r, c);
+        T result = Op::identity();
+        for (size_t i = r + 1; i > 0; i &= i - 1) {
+            const T* line = row(i - 1);
+            for (size_t j = c + 1; j > 0; j &= j - 1) result = op(result, line[j - 1]);
+        }
+        return result;
+    }
+
+    // Свёртка прямоугольника [r1..r2] x [c1..c2], только для обратимых операций
+    T query(size_t r1, size_t c1, size_t r2, size_t c2) const {
+        if (r1 > r2 || c1 > c2) throw FenwickException("Fenwick2D range is empty");
+        T result = prefix(r2, c2);
+        if (r1 > 0) result = Op::inverse(result, prefix(r1 - 1, c2));
+        if (c1 > 0) result = Op::inverse(result, prefix(r2, c1 - 1));
+        if (r1 > 0 && c1 > 0) result = op(result, prefix(r1 - 1, c1 - 1));
+        return result;
+    }
+};
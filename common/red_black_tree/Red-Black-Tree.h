@@ -0,0 +1,615 @@
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <new>
+
+// Красно-чёрное дерево из курсовой Bryuhanov Denis/CourseWork.
+// Общее для неё и стенда BakhvalovPA/Coursework/ordered_bench.cpp:
+// исправления вносятся здесь, а не в копиях.
+
+enum Color {
+    BLACK,
+    RED
+};
+
+
+struct Node {
+	int    key;
+	int    val;
+	int    count;	// Размер поддерева с корнем в этом узле
+	Color	color;
+	Node	*parent;
+	Node	*left;
+	Node	*right;
+};
+
+
+// Пул узлов: память выделяется блоками по BLOCK_SIZE узлов,
+// освобождённые узлы уходят в список свободных (связаны через right).
+// clear() дерева возвращает весь пул за O(число блоков) без обхода узлов.
+class NodePool {
+	public:
+		NodePool():freeList(nullptr),current(0),carved(0),used(BLOCK_SIZE){};
+		~NodePool();
+		NodePool(const NodePool&) = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		Node*	allocate();
+		void	release(Node *node);
+		void	reset();
+	private:
+		static const int BLOCK_SIZE = 4096;
+
+		std::vector<Node*> blocks;
+		Node	*freeList;
+		size_t	current;	// Блок, из которого выдаются новые узлы
+		size_t	carved;		// Сколько блоков уже начато с последнего reset()
+		int	used;		// Занято узлов в текущем блоке
+};
+
+
+NodePool::~NodePool()
+{
+	for (Node *block : blocks)
+		std::free(block);
+}
+
+
+Node* NodePool::allocate()
+{
+	if (freeList != nullptr) {
+		Node *node = freeList;
+		freeList = node->right;
+		return node;
+	}
+
+	if (used == BLOCK_SIZE) {
+		if (carved == blocks.size()) {
+			Node *block = static_cast<Node*>(std::malloc(BLOCK_SIZE * sizeof(Node)));
+			if (block == nullptr)
+				throw std::bad_alloc();
+			blocks.push_back(block);
+		}
+		current = carved++;
+		used = 0;
+	}
+	return &blocks[current][used++];
+}
+
+
+void NodePool::release(Node *node)
+{
+	node->right = freeList;
+	freeList = node;
+}
+
+
+void NodePool::reset()
+{
+	// Блоки остаются выделенными и переиспользуются следующими вставками
+	freeList = nullptr;
+	current = 0;
+	carved = 0;
+	used = BLOCK_SIZE;
+}
+
+
+class Tree {
+	public:
+		Tree();
+		~Tree();
+		Tree(const Tree&) = delete;
+		Tree& operator=(const Tree&) = delete;
+
+		void	insert(int &key, int &val);
+		bool	remove(const int &key);
+		bool	search(const int &key, int &val) const;
+		void	clear();
+		void	printTree() const;
+		int     getSize() const;
+
+		// Порядковые статистики
+		int	rank(const int &key) const;			// Число ключей, меньших key
+		bool	select(int index, int &key, int &val) const;	// index-й по возрастанию ключ (с нуля)
+
+		// Построение за O(n) из пар (ключ, значение), отсортированных по ключу без повторов
+		void	buildFromSorted(const std::vector<std::pair<int, int>> &items);
+
+		// Проверка свойств красно-чёрного дерева и размеров поддеревьев
+		bool	isValid() const;
+	private:
+		int   size;
+		Node *root;
+		Node  nilNode;	// Общий лист-страж: чёрный, размер 0
+		Node *nil;
+		NodePool pool;
+
+		int 	cmp(const int &a, const int &b) const;
+		Node*	createNode(int key, int val, Color color);
+		void	leftRotate(Node *node);
+		void	rightRotate(Node *node);
+		void	insertFixup(Node *node);
+		void	removeFixup(Node *node);
+		void	transplant(Node *from, Node *to);
+		Node*	findNode(const int &key) const;
+		Node*	buildRange(const std::vector<std::pair<int, int>> &items, int from, int to,
+				   int depth, int redDepth, Node *parent);
+		int	checkSubtree(const Node *node, bool &ok) const;
+};
+
+
+Tree::Tree():size(0)
+{
+	nilNode.key = 0;
+	nilNode.val = 0;
+	nilNode.count = 0;
+	nilNode.color = BLACK;
+	nilNode.parent = nilNode.left = nilNode.right = &nilNode;
+	nil = &nilNode;
+	root = nil;
+}
+
+
+Tree::~Tree()
+{
+	// Узлы принадлежат пулу, рекурсивного обхода нет
+}
+
+
+int Tree::cmp(const int &a, const int &b) const
+{
+  	if (a < b) return -1;
+	if (a == b) return 0;
+	return 1;
+}
+
+
+Node* Tree::createNode(int key, int val, Color color)
+{
+	Node *node = pool.allocate();
+	node->key = key;
+	node->val = val;
+	node->count = 1;
+	node->color = color;
+	node->parent = nil;
+	node->left = nil;
+	node->right = nil;
+	return node;
+}
+
+
+Node* Tree::findNode(const int &key) const
+{
+	Node *curr = root;
+	while (curr != nil)
+	{
+		int c = cmp(key, curr->key);
+		if (c == 0)
+			return curr;
+		curr = (c < 0) ? curr->left : curr->right;
+	}
+	return nil;
+}
+
+
+void Tree::insert(int &key, int &val)
+{
+	Node *found = findNode(key);
+	if (found != nil) {
+		found->val = val;
+		return;
+	}
+
+	Node *parent = nil;
+	Node *curr = root;
+	while (curr != nil)
+	{
+		curr->count++;
+		parent = curr;
+		curr = (cmp(key, curr->key) < 0) ? curr->left : curr->right;
+	}
+
+	Node *node = createNode(key, val, RED);
+	node->parent = parent;
+	if (parent == nil)
+		root = node;
+	else if (cmp(key, parent->key) < 0)
+		parent->left = node;
+	else
+		parent->right = node;
+
+	insertFixup(node);
+	this->size++;
+}
+
+
+void Tree::insertFixup(Node *node)
+{
+	while (node->parent->color == RED)
+	{
+		Node *parent = node->parent;
+		Node *grand = parent->parent;
+		if (parent == grand->left) {
+			Node *uncle = grand->right;
+			if (uncle->color == RED) {
+				parent->color = BLACK;
+				uncle->color = BLACK;
+				grand->color = RED;
+				node = grand;
+			}else {
+				if (node == parent->right) {
+					node = parent;
+					leftRotate(node);
+					parent = node->parent;
+				}
+				parent->color = BLACK;
+				grand->color = RED;
+				rightRotate(grand);
+			}
+		}else {
+			Node *uncle = grand->left;
+			if (uncle->color == RED) {
+				parent->color = BLACK;
+				uncle->color = BLACK;
+				grand->color = RED;
+				node = grand;
+			}else {
+				if (node == parent->left) {
+					node = parent;
+					rightRotate(node);
+					parent = node->parent;
+				}
+				parent->color = BLACK;
+				grand->color = RED;
+				leftRotate(grand);
+			}
+		}
+	}
+	root->color = BLACK;
+}
+
+
+void Tree::transplant(Node *from, Node *to)
+{
+	if (from->parent == nil)
+		root = to;
+	else if (from == from->parent->left)
+		from->parent->left = to;
+	else
+		from->parent->right = to;
+	to->parent = from->parent;
+}
+
+
+bool Tree::remove(const int &key)
+{
+	Node *node = findNode(key);
+	if (node == nil)
+		return 0;
+
+	// Узел, который физически покидает своё место
+	Node *moved = node;
+	if (node->left != nil && node->right != nil) {
+		moved = node->right;
+		while (moved->left != nil)
+			moved = moved->left;
+	}
+	for (Node *p = moved->parent; p != nil; p = p->parent)
+		p->count--;
+
+	Color removedColor = moved->color;
+	Node *child;
+	if (node->left == nil) {
+		child = node->right;
+		transplant(node, node->right);
+	}else if (node->right == nil) {
+		child = node->left;
+		transplant(node, node->left);
+	}else {
+		child = moved->right;
+		if (moved->parent == node) {
+			child->parent = moved;
+		}else {
+			transplant(moved, moved->right);
+			moved->right = node->right;
+			moved->right->parent = moved;
+		}
+		transplant(node, moved);
+		moved->left = node->left;
+		moved->left->parent = moved;
+		moved->color = node->color;
+		moved->count = node->count;
+	}
+
+	if (removedColor == BLACK)
+		removeFixup(child);
+
+	nil->parent = nil;
+	pool.release(node);
+	(this->size)--;
+	return 1;
+}
+
+
+void Tree::removeFixup(Node *node)
+{
+	while (node != root && node->color == BLACK)
+	{
+		Node *parent = node->parent;
+		if (node == parent->left) {
+			Node *brother = parent->right;
+			if (brother->color == RED) {
+				brother->color = BLACK;
+				parent->color = RED;
+				leftRotate(parent);
+				brother = parent->right;
+			}
+			if (brother->left->color == BLACK && brother->right->color == BLACK) {
+				brother->color = RED;
+				node = parent;
+			}else {
+				if (brother->right->color == BLACK) {
+					brother->left->color = BLACK;
+					brother->color = RED;
+					rightRotate(brother);
+					brother = parent->right;
+				}
+				brother->color = parent->color;
+				parent->color = BLACK;
+				brother->right->color = BLACK;
+				leftRotate(parent);
+				node = root;
+			}
+		}else {
+			Node *brother = parent->left;
+			if (brother->color == RED) {
+				brother->color = BLACK;
+				parent->color = RED;
+				rightRotate(parent);
+				brother = parent->left;
+			}
+			if (brother->right->color == BLACK && brother->left->color == BLACK) {
+				brother->color = RED;
+				node = parent;
+			}else {
+				if (brother->left->color == BLACK) {
+					brother->right->color = BLACK;
+					brother->color = RED;
+					leftRotate(brother);
+					brother = parent->left;
+				}
+				brother->color = parent->color;
+				parent->color = BLACK;
+				brother->left->color = BLACK;
+				rightRotate(parent);
+				node = root;
+			}
+		}
+	}
+	node->color = BLACK;
+}
+
+
+bool Tree::search(const int &key, int &val) const
+{
+	Node *node = findNode(key);
+	if (node == nil)
+		return 0;
+	val = node->val;
+	return 1;
+}
+
+
+int Tree::rank(const int &key) const
+{
+	int result = 0;
+	Node *curr = root;
+	while (curr != nil)
+	{
+		if (cmp(key, curr->key) <= 0) {
+			curr = curr->left;
+		}else {
+			result += curr->left->count + 1;
+			curr = curr->right;
+		}
+	}
+	return result;
+}
+
+
+bool Tree::select(int index, int &key, int &val) const
+{
+	if (index < 0 || index >= size)
+		return 0;
+
+	Node *curr = root;
+	while (true)
+	{
+		int leftCount = curr->left->count;
+		if (index < leftCount) {
+			curr = curr->left;
+		}else if (index == leftCount) {
+			key = curr->key;
+			val = curr->val;
+			return 1;
+		}else {
+			index -= leftCount + 1;
+			curr = curr->right;
+		}
+	}
+}
+
+
+void Tree::leftRotate(Node *node)
+{
+	Node *temp = node->right;
+	assert(temp != nil);
+
+	node->right = temp->left;
+	if (temp->left != nil)
+		temp->left->parent = node;
+	temp->parent = node->parent;
+	if (node->parent == nil)
+		root = temp;
+	else if (node == node->parent->left)
+		node->parent->left = temp;
+	else
+		node->parent->right = temp;
+	temp->left = node;
+	node->parent = temp;
+
+	temp->count = node->count;
+	node->count = node->left->count + node->right->count + 1;
+}
+
+
+void Tree::rightRotate(Node *node)
+{
+	Node *temp = node->left;
+	assert(temp != nil);
+
+	node->left = temp->right;
+	if (temp->right != nil)
+		temp->right->parent = node;
+	temp->parent = node->parent;
+	if (node->parent == nil)
+		root = temp;
+	else if (node == node->parent->right)
+		node->parent->right = temp;
+	else
+		node->parent->left = temp;
+	temp->right = node;
+	node->parent = temp;
+
+	temp->count = node->count;
+	node->count = node->left->count + node->right->count + 1;
+}
+
+
+Node* Tree::buildRange(const std::vector<std::pair<int, int>> &items, int from, int to,
+		       int depth, int redDepth, Node *parent)
+{
+	if (from >= to)
+		return nil;
+
+	int middle = from + (to - from) / 2;
+	Node *node = createNode(items[middle].first, items[middle].second, depth == redDepth ? RED : BLACK);
+	node->parent = parent;
+	node->count = to - from;
+	node->left = buildRange(items, from, middle, depth + 1, redDepth, node);
+	node->right = buildRange(items, middle + 1, to, depth + 1, redDepth, node);
+	return node;
+}
+
+
+void Tree::buildFromSorted(const std::vector<std::pair<int, int>> &items)
+{
+	for (size_t i = 1; i < items.size(); i++)
+		assert(items[i - 1].first < items[i].first);
+
+	clear();
+
+	// Деление пополам даёт дерево, у которого заполнены все уровни, кроме,
+	// возможно, последнего. Узлы неполного последнего уровня красные, остальные чёрные.
+	int n = items.size();
+	int fullLevels = 0;
+	while ((2 << fullLevels) - 1 <= n)
+		fullLevels++;
+	int redDepth = ((1 << fullLevels) - 1 == n) ? -1 : fullLevels;
+
+	root = buildRange(items, 0, n, 0, redDepth, nil);
+	size = n;
+}
+
+
+int Tree::checkSubtree(const Node *node, bool &ok) const
+{
+	if (node == nil)
+		return 1;
+	if (node->color == RED && (node->left->color == RED || node->right->color == RED))
+		ok = false;
+	if (node->count != node->left->count + node->right->count + 1)
+		ok = false;
+	if (node->left != nil && (node->left->parent != node || node->left->key >= node->key))
+		ok = false;
+	if (node->right != nil && (node->right->parent != node || node->right->key <= node->key))
+		ok = false;
+
+	// Глубина рекурсии ограничена высотой дерева (не больше 2 log n)
+	int leftHeight = checkSubtree(node->left, ok);
+	int rightHeight = checkSubtree(node->right, ok);
+	if (leftHeight != rightHeight)
+		ok = false;
+	return leftHeight + (node->color == BLACK ? 1 : 0);
+}
+
+
+bool Tree::isValid() const
+{
+	bool ok = root->color == BLACK && root->count == size;
+	checkSubtree(root, ok);
+	return ok;
+}
+
+
+void Tree::printTree() const
+{
+	std::cout << "----------------" << std::endl;
+	std::queue<Node*> q;
+	if (root != nil)
+		q.push(root);
+	while (!q.empty())
+	{
+		Node *top = q.front(); // Заменил auto
+		q.pop();
+		if (top->color == RED)
+			std::cout << "R" ;
+		else
+			std::cout << "B" ;
+		std::cout << top->key;
+		std::cout << " ";
+		if (top->left != nil) {
+			q.push(top->left);
+			if (top->left->color == RED)
+				std::cout << "R" ;
+			else
+				std::cout << "B" ;
+			std::cout << top->left->key;
+			std::cout << " ";
+		}else {
+			std::cout << "NULL" << " ";
+		}
+		if (top->right != nil) {
+			q.push(top->right);
+			if (top->right->color == RED)
+				std::cout << "R" ;
+			else
+				std::cout << "B" ;
+			std::cout << top->right->key;
+			std::cout << " ";
+		}else {
+			std::cout << "NULL" << " ";
+		}
+		std::cout << std::endl;
+	}
+	std::cout << std::endl;
+	std::cout << "----------------" << std::endl;
+}
+
+
+int Tree::getSize() const
+{
+	return this->size;
+}
+
+
+void Tree::clear()
+{
+	pool.reset();
+	this->root = nil;
+	this->size = 0;
+}
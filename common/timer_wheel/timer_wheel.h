@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+// Hierarchical timer wheel with 1 ms ticks: 256 slots of 1 ms, then three levels
+// of 64 slots (256 ms, 16.4 s, 17.5 min). One timerfd is armed for the next tick
+// that has work; the owner polls fd() and calls runExpired() when it is readable.
+// schedule/cancel are O(1) and may be called from any thread, including callbacks.
+//
+// Shared by the robot servers (LapkinYD/robot_yolo/server2-main,
+// SharifyanovAR/Zryachiy_ezdun, BazeltsevAA/MVP_bot); fix it here, not in copies.
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+
+    struct JitterStats
+    {
+        uint64_t count;
+        double meanUs;
+        int64_t p99Us;
+        int64_t maxUs;
+    };
+
+    TimerWheel()
+        : fd_(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+          epoch_(Clock::now()),
+          heads_(SLOT_COUNT + 1, -1)
+    {
+        resetJitter();
+    }
+
+    ~TimerWheel()
+    {
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    int fd() const { return fd_; }
+
+    TimerId scheduleAt(Clock::time_point deadline, Callback cb, int group = 0)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        int32_t n = allocate();
+        Node &node = nodes_[n];
+        node.deadline = deadline;
+        node.group = group;
+        node.cb = std::move(cb);
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - epoch_).count();
+        node.expires = ns <= 0 ? 0 : (ns + TICK_NS - 1) / TICK_NS;
+        insert(n);
+        armLocked();
+        return ((TimerId)node.generation << 32) | (uint32_t)n;
+    }
+
+    TimerId schedule(std::chrono::milliseconds delay, Callback cb, int group = 0)
+    {
+        return scheduleAt(Clock::now() + delay, std::move(cb), group);
+    }
+
+    // After cancel returns, the callback is not running and will not run
+    bool cancel(TimerId id)
+    {
+        std::lock_guard<std::recursive_mutex> dispatch(dispatchMutex_);
+        std::lock_guard<std::mutex> lk(mutex_);
+        uint32_t n = (uint32_t)id;
+        if (n >= nodes_.size() || nodes_[n].generation != (uint32_t)(id >> 32) || nodes_[n].slot < 0)
+            return false;
+        unlink(n);
+        release(n);
+        return true;
+    }
+
+    size_t cancelGroup(int group)
+    {
+        std::lock_guard<std::recursive_mutex> dispatch(dispatchMutex_);
+        std::lock_guard<std::mutex> lk(mutex_);
+        size_t cancelled = 0;
+        for (int32_t n = 0; n < (int32_t)nodes_.size(); n++)
+        {
+            if (nodes_[n].slot >= 0 && nodes_[n].group == group)
+            {
+                unlink(n);
+                release(n);
+                cancelled++;
+            }
+        }
+        return cancelled;
+    }
+
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return active_;
+    }
+
+    void runExpired()
+    {
+        uint64_t expirations;
+        while (read(fd_, &expirations, sizeof(expirations)) > 0)
+        {
+        }
+
+        std::lock_guard<std::recursive_mutex> dispatch(dispatchMutex_);
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            Clock::time_point now = Clock::now();
+            advance(std::chrono::duration_cast<std::chrono::nanoseconds>(now - epoch_).count() / TICK_NS);
+            armedNs_ = -1;
+            // The slot of the current tick may already hold timers that are due
+            int32_t n = heads_[current_ & (LEVEL0_SLOTS - 1)];
+            while (n >= 0)
+            {
+                int32_t next = nodes_[n].next;
+                if (nodes_[n].deadline <= now)
+                {
+                    unlink(n);
+                    link(n, READY);
+                }
+                n = next;
+            }
+        }
+        for (;;)
+        {
+            Callback cb;
+            Clock::time_point deadline;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                int32_t n = heads_[READY];
+                if (n < 0)
+                {
+                    armLocked();
+                    break;
+                }
+                for (int32_t m = nodes_[n].next; m >= 0; m = nodes_[m].next)
+                {
+                    if (nodes_[m].deadline < nodes_[n].deadline)
+                        n = m;
+                }
+                unlink(n);
+                cb = std::move(nodes_[n].cb);
+                deadline = nodes_[n].deadline;
+                release(n);
+            }
+            recordLateness(Clock::now() - deadline);
+            cb();
+        }
+    }
+
+    JitterStats jitter() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        JitterStats stats{latenessCount_, 0.0, 0, latenessMaxUs_};
+        if (latenessCount_ == 0)
+            return stats;
+        stats.meanUs = (double)latenessSumUs_ / latenessCount_;
+        uint64_t rank = (latenessCount_ * 99 + 99) / 100, seen = 0;
+        for (size_t b = 0; b < histogram_.size(); b++)
+        {
+            seen += histogram_[b];
+            if (seen >= rank)
+            {
+                stats.p99Us = std::min<int64_t>((int64_t)(b + 1) * HISTOGRAM_STEP_US, latenessMaxUs_);
+                break;
+            }
+        }
+        return stats;
+    }
+
+    void resetJitter()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        histogram_.assign(HISTOGRAM_BUCKETS, 0);
+        latenessCount_ = 0;
+        latenessSumUs_ = 0;
+        latenessMaxUs_ = 0;
+    }
+
+private:
+    static constexpr int64_t TICK_NS = 1000000;
+    static constexpr int LEVEL0_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS = 4;
+    static constexpr int LEVEL0_SLOTS = 1 << LEVEL0_BITS;
+    static constexpr int LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static constexpr int SLOT_COUNT = LEVEL0_SLOTS + (LEVELS - 1) * LEVEL_SLOTS;
+    static constexpr int READY = SLOT_COUNT;  // due timers waiting for their callback
+    static constexpr int64_t MAX_DELTA = ((int64_t)1 << (LEVEL0_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1;
+    static constexpr int64_t HISTOGRAM_STEP_US = 50;
+    static constexpr size_t HISTOGRAM_BUCKETS = 200;
+
+    struct Node
+    {
+        uint32_t generation = 0;
+        int32_t prev = -1;
+        int32_t next = -1;
+        int32_t slot = -1;  // -1 while the node is free
+        int group = 0;
+        int64_t expires = 0;
+        Clock::time_point deadline;
+        Callback cb;
+    };
+
+    int fd_;
+    Clock::time_point epoch_;
+    int64_t current_ = 0;  // next tick to process
+    int64_t armedNs_ = -1;  // armed time, ns after epoch_
+    std::vector<Node> nodes_;
+    std::vector<int32_t> heads_;
+    int32_t freeList_ = -1;
+    size_t active_ = 0;
+    size_t ready_ = 0;
+    size_t upperLevels_ = 0;  // timers above level 0
+    mutable std::mutex mutex_;
+    std::recursive_mutex dispatchMutex_;
+
+    std::vector<uint64_t> histogram_;
+    uint64_t latenessCount_;
+    int64_t latenessSumUs_;
+    int64_t latenessMaxUs_;
+
+    int32_t allocate()
+    {
+        if (freeList_ < 0)
+        {
+            nodes_.emplace_back();
+            return (int32_t)nodes_.size() - 1;
+        }
+        int32_t n = freeList_;
+        freeList_ = nodes_[n].next;
+        return n;
+    }
+
+    void release(int32_t n)
+    {
+        Node &node = nodes_[n];
+        node.generation++;
+        node.slot = -1;
+        node.cb = nullptr;
+        node.next = freeList_;
+        freeList_ = n;
+    }
+
+    void link(int32_t n, int slot)
+    {
+        Node &node = nodes_[n];
+        node.slot = slot;
+        node.prev = -1;
+        node.next = heads_[slot];
+        if (node.next >= 0)
+            nodes_[node.next].prev = n;
+        heads_[slot] = n;
+        active_++;
+        if (slot == READY)
+            ready_++;
+        else if (slot >= LEVEL0_SLOTS)
+            upperLevels_++;
+    }
+
+    void unlink(int32_t n)
+    {
+        Node &node = nodes_[n];
+        if (node.prev >= 0)
+            nodes_[node.prev].next = node.next;
+        else
+            heads_[node.slot] = node.next;
+        if (node.next >= 0)
+            nodes_[node.next].prev = node.prev;
+        active_--;
+        if (node.slot == READY)
+            ready_--;
+        else if (node.slot >= LEVEL0_SLOTS)
+            upperLevels_--;
+        node.slot = -1;
+    }
+
+    void insert(int32_t n)
+    {
+        Node &node = nodes_[n];
+        int64_t expires = std::max(node.expires, current_);
+        int64_t delta = std::min(expires - current_, MAX_DELTA);
+        expires = current_ + delta;
+        if (delta < LEVEL0_SLOTS)
+        {
+            link(n, (int)(expires & (LEVEL0_SLOTS - 1)));
+            return;
+        }
+        for (int level = 1; level < LEVELS; level++)
+        {
+            int shift = LEVEL0_BITS + level * LEVEL_BITS;
+            if (level == LEVELS - 1 || delta < ((int64_t)1 << shift))
+            {
+                int index = (int)((expires >> (shift - LEVEL_BITS)) & (LEVEL_SLOTS - 1));
+                link(n, LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS + index);
+                return;
+            }
+        }
+    }
+
+    // Moves the timers of a higher-level slot down to the levels below
+    void cascade(int level)
+    {
+        int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+        int slot = LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS + (int)((current_ >> shift) & (LEVEL_SLOTS - 1));
+        int32_t n = heads_[slot];
+        while (n >= 0)
+        {
+            int32_t next = nodes_[n].next;
+            unlink(n);
+            insert(n);
+            n = next;
+        }
+    }
+
+    void advance(int64_t now)
+    {
+        while (current_ <= now)
+        {
+            if (active_ == ready_)
+            {
+                current_ = now + 1;  // nothing left in the wheel, skip the idle ticks
+                break;
+            }
+            int index = (int)(current_ & (LEVEL0_SLOTS - 1));
+            for (int level = 1; index == 0 && level < LEVELS; level++)
+            {
+                int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+                cascade(level);
+                if (((current_ >> shift) & (LEVEL_SLOTS - 1)) != 0)
+                    break;
+            }
+            int32_t n = heads_[index];
+            while (n >= 0)
+            {
+                int32_t next = nodes_[n].next;
+                unlink(n);
+                link(n, READY);
+                n = next;
+            }
+            current_++;
+        }
+    }
+
+    // The timerfd is armed for the earliest deadline in the first busy level-0 slot,
+    // not for the tick boundary, so a timer does not wait up to a tick for its slot.
+    // If higher levels hold timers, it is armed no later than the next cascade.
+    void armLocked()
+    {
+        int64_t next = -1;
+        if (heads_[READY] >= 0)
+            next = 0;
+        for (int i = 0; next < 0 && i < LEVEL0_SLOTS; i++)
+        {
+            for (int32_t n = heads_[(current_ + i) & (LEVEL0_SLOTS - 1)]; n >= 0; n = nodes_[n].next)
+            {
+                int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(nodes_[n].deadline - epoch_).count();
+                if (next < 0 || ns < next)
+                    next = std::max<int64_t>(ns, 0);
+            }
+        }
+        if (upperLevels_ > 0)
+        {
+            int64_t boundary = ((current_ + LEVEL0_SLOTS - 1) & ~(int64_t)(LEVEL0_SLOTS - 1)) * TICK_NS;
+            if (next < 0 || boundary < next)
+                next = boundary;
+        }
+        if (next == armedNs_)
+            return;
+        armedNs_ = next;
+        itimerspec spec{};
+        if (next >= 0)
+        {
+            auto at = epoch_ + std::chrono::nanoseconds(next);
+            int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(at.time_since_epoch()).count();
+            spec.it_value.tv_sec = ns / 1000000000;
+            spec.it_value.tv_nsec = ns % 1000000000;
+            if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+                spec.it_value.tv_nsec = 1;
+        }
+        timerfd_settime(fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void recordLateness(Clock::duration late)
+    {
+        int64_t us = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(late).count());
+        std::lock_guard<std::mutex> lk(mutex_);
+        histogram_[std::min<size_t>(us / HISTOGRAM_STEP_US, HISTOGRAM_BUCKETS - 1)]++;
+        latenessCount_++;
+        latenessSumUs_ += us;
+        latenessMaxUs_ = std::max(latenessMaxUs_, us);
+    }
+};